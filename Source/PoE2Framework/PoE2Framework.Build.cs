@@ -24,7 +24,9 @@ public class PoE2Framework : ModuleRules
             new string[]
             {
                 "NetCore",
-                "ReplicationGraph"
+                "ReplicationGraph",
+                "AssetRegistry",
+                "Projects"
             }
         );
         // This block is ESSENTIAL for Automation Tests to be discovered.
@@ -1,6 +1,7 @@
 #include "PoE2Framework.h"
 #include "Core/PoE2Log.h"
 #include "Core/PoE2Tags.h"
+#include "Core/PoE2TagBits.h"
 
 #define LOCTEXT_NAMESPACE "FPoE2FrameworkModule"
 
@@ -10,6 +11,7 @@ void FPoE2FrameworkModule::StartupModule()
 {
     // This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file
     FPoE2Tags::InitializeNativeTags();
+    FPoE2TagBitTable::Initialize();
 
     UE_LOG(LogPoE2Framework, Warning, TEXT("PoE2Framework module has started!"));
 }
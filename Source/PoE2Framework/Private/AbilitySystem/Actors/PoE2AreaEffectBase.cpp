@@ -2,9 +2,9 @@
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "Components/SphereComponent.h"
-#include "Core/PoE2Tags.h"
+#include "Effects/PoE2HitAccumulator.h"
+#include "Effects/PoE2DamageKernel.h"
 #include "Net/UnrealNetwork.h"
-#include "UObject/UObjectGlobals.h"
 
 APoE2AreaEffectBase::APoE2AreaEffectBase()
 {
@@ -51,25 +51,12 @@ void APoE2AreaEffectBase::Tick(float DeltaSeconds)
         }
     }
 
-    for (const TScriptInterface<IMechanicHandler>& Handler : ActiveHandlers)
-    {
-        if (Handler)
-        {
-            IMechanicHandler::Execute_OnTick(Handler.GetObject(), this, DeltaSeconds, CurrentSpec);
-        }
-    }
+    ActiveHandlers.DispatchTick(this, DeltaSeconds, CurrentSpec);
 }
 
 void APoE2AreaEffectBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    for (const TScriptInterface<IMechanicHandler>& Handler : ActiveHandlers)
-    {
-        if (Handler)
-        {
-            IMechanicHandler::Execute_OnEnd(Handler.GetObject(), this, CurrentSpec);
-        }
-    }
-    ActiveHandlers.Reset();
+    ActiveHandlers.DispatchEndAndReset(this, CurrentSpec);
 
     Super::EndPlay(EndPlayReason);
 }
@@ -82,33 +69,9 @@ void APoE2AreaEffectBase::InitFromSpec(const FSkillSpec& InSpec, UAbilitySystemC
     DamageTickInterval = FMath::Max(0.05f, CurrentSpec.GetCustomParam(AreaTickIntervalKey, 1.0f));
     TimeSinceLastPulse = DamageTickInterval;
 
-    ActiveHandlers.Reset();
-    for (const TScriptInterface<IMechanicHandler>& HandlerPrototype : HandlerPrototypes)
-    {
-        UObject* PrototypeObject = HandlerPrototype.GetObject();
-        if (!PrototypeObject)
-        {
-            continue;
-        }
-
-        UObject* DuplicatedObject = DuplicateObject(PrototypeObject, this);
-        if (!DuplicatedObject)
-        {
-            continue;
-        }
-
-        TScriptInterface<IMechanicHandler> HandlerInstance;
-        HandlerInstance.SetObject(DuplicatedObject);
-        HandlerInstance.SetInterface(Cast<IMechanicHandler>(DuplicatedObject));
+    HitDamage = PoE2DamageKernel::MakeHitDamage(CurrentSpec);
 
-        if (!HandlerInstance.GetInterface())
-        {
-            continue;
-        }
-
-        ActiveHandlers.Add(HandlerInstance);
-        IMechanicHandler::Execute_OnSpawn(DuplicatedObject, this, CurrentSpec);
-    }
+    ActiveHandlers.Initialize(this, CurrentSpec, HandlerPrototypes);
 
     if (CurrentSpec.Lifetime > 0.0f)
     {
@@ -122,7 +85,7 @@ void APoE2AreaEffectBase::InitFromSpec(const FSkillSpec& InSpec, UAbilitySystemC
         AreaComponent->UpdateOverlaps();
     }
 
-    const bool bShouldTick = (ActiveHandlers.Num() > 0) || (CurrentSpec.DamageEffectClass != nullptr);
+    const bool bShouldTick = ActiveHandlers.HasHook(EMechanicHandlerHooks::Tick) || (CurrentSpec.DamageEffectClass != nullptr);
     SetActorTickEnabled(bShouldTick);
 
     if (HasAuthority() && CurrentSpec.DamageEffectClass)
@@ -165,32 +128,17 @@ void APoE2AreaEffectBase::ApplyEffectToActor(AActor* TargetActor)
         return;
     }
 
-    if (OwnerASC && CurrentSpec.DamageEffectClass)
-    {
-        if (UAbilitySystemComponent* TargetASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(TargetActor))
-        {
-            FGameplayEffectContextHandle ContextHandle = OwnerASC->MakeEffectContext();
-            ContextHandle.AddSourceObject(this);
-
-            FGameplayEffectSpecHandle SpecHandle = OwnerASC->MakeOutgoingSpec(CurrentSpec.DamageEffectClass, 1.0f, ContextHandle);
-
-            if (SpecHandle.IsValid())
-            {
-                SpecHandle.Data->SetSetByCallerMagnitude(FPoE2Tags::Get().Data_Damage, CurrentSpec.FinalDamage);
-                OwnerASC->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), TargetASC);
-            }
-        }
-    }
-
     FHitResult DummyHit;
     DummyHit.Location = TargetActor->GetActorLocation();
     DummyHit.ImpactPoint = DummyHit.Location;
 
-    for (const TScriptInterface<IMechanicHandler>& Handler : ActiveHandlers)
+    if (!ActiveHandlers.RunHitFilters(this, TargetActor, DummyHit, CurrentSpec))
     {
-        if (Handler)
-        {
-            IMechanicHandler::Execute_OnHit(Handler.GetObject(), this, TargetActor, DummyHit, CurrentSpec);
-        }
+        return;
     }
+
+    UPoE2HitAccumulatorSubsystem::SubmitHit(this, OwnerASC, UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(TargetActor), CurrentSpec, HitDamage, DummyHit);
+
+    // Areas persist through their lifetime, so the decision itself is not used here
+    ActiveHandlers.ResolveHit(this, TargetActor, DummyHit, CurrentSpec);
 }
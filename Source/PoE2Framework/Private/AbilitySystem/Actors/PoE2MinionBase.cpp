@@ -1,50 +1,78 @@
 #include "AbilitySystem/Actors/PoE2MinionBase.h"
 #include "AbilitySystemComponent.h"
+#include "AbilitySystem/PoE2_AbilitySystemComponent.h"
+#include "Minions/PoE2MinionCrowdSubsystem.h"
+#include "Minions/PoE2MinionSignificanceSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
 #include "Net/UnrealNetwork.h"
-#include "UObject/UObjectGlobals.h"
 
 APoE2MinionBase::APoE2MinionBase()
 {
     PrimaryActorTick.bCanEverTick = true;
     SetActorTickEnabled(false);
     bReplicates = true;
+    SetReplicatingMovement(true);
+
+    // Steered by the owner's crowd; a controller per minion would only add ticks
+    AutoPossessAI = EAutoPossessAI::Disabled;
+    AIControllerClass = nullptr;
 }
 
 void APoE2MinionBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-    DOREPLIFETIME(APoE2MinionBase, CurrentSpec);
+    // Clients keep the summon-time spec; live changes only matter where damage is settled, and re-sending
+    // a whole spec to every minion on each stat change would be a burst per summoner
+    DOREPLIFETIME_CONDITION(APoE2MinionBase, CurrentSpec, COND_InitialOnly);
 }
 
 void APoE2MinionBase::BeginPlay()
 {
     Super::BeginPlay();
+
+    Significance = GetWorld()->GetSubsystem<UPoE2MinionSignificanceSubsystem>();
+    if (Significance)
+    {
+        Significance->RegisterMinion(this);
+    }
 }
 
 void APoE2MinionBase::Tick(float DeltaSeconds)
 {
+    const uint32 StartCycles = FPlatformTime::Cycles();
+
     Super::Tick(DeltaSeconds);
 
-    for (const TScriptInterface<IMechanicHandler>& Handler : ActiveHandlers)
+    PendingHandlerDeltaTime += DeltaSeconds;
+    if (PendingHandlerDeltaTime >= HandlerTickInterval)
     {
-        if (Handler)
-        {
-            IMechanicHandler::Execute_OnTick(Handler.GetObject(), this, DeltaSeconds, CurrentSpec);
-        }
+        ActiveHandlers.DispatchTick(this, PendingHandlerDeltaTime, GetSpec());
+        PendingHandlerDeltaTime = 0.0f;
+    }
+
+    if (Significance)
+    {
+        Significance->RecordTickCost(FPlatformTime::Cycles() - StartCycles);
     }
 }
 
 void APoE2MinionBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    for (const TScriptInterface<IMechanicHandler>& Handler : ActiveHandlers)
+    if (Significance)
     {
-        if (Handler)
-        {
-            IMechanicHandler::Execute_OnEnd(Handler.GetObject(), this, CurrentSpec);
-        }
+        Significance->UnregisterMinion(this);
+        Significance = nullptr;
     }
-    ActiveHandlers.Reset();
+
+    if (UPoE2MinionCrowdSubsystem* Crowds = GetWorld()->GetSubsystem<UPoE2MinionCrowdSubsystem>())
+    {
+        Crowds->UnregisterMinion(this);
+    }
+
+    ActiveHandlers.DispatchEndAndReset(this, GetSpec());
+    SharedSpec.Reset();
 
     Super::EndPlay(EndPlayReason);
 }
@@ -54,43 +82,67 @@ void APoE2MinionBase::InitFromSpec(const FSkillSpec& InSpec, UAbilitySystemCompo
     CurrentSpec = InSpec;
     OwnerASC = InOwnerASC;
 
-    ActiveHandlers.Reset();
-    for (const TScriptInterface<IMechanicHandler>& HandlerPrototype : HandlerPrototypes)
-    {
-        UObject* PrototypeObject = HandlerPrototype.GetObject();
-        if (!PrototypeObject)
-        {
-            continue;
-        }
-
-        UObject* DuplicatedObject = DuplicateObject(PrototypeObject, this);
-        if (!DuplicatedObject)
-        {
-            continue;
-        }
-
-        TScriptInterface<IMechanicHandler> HandlerInstance;
-        HandlerInstance.SetObject(DuplicatedObject);
-        HandlerInstance.SetInterface(Cast<IMechanicHandler>(DuplicatedObject));
-
-        if (!HandlerInstance.GetInterface())
-        {
-            continue;
-        }
-
-        ActiveHandlers.Add(HandlerInstance);
-        IMechanicHandler::Execute_OnSpawn(DuplicatedObject, this, CurrentSpec);
-    }
+    // Hold the owner's live spec instead of relying on the copy; the copy is what replicates
+    UPoE2_AbilitySystemComponent* PoE2OwnerASC = Cast<UPoE2_AbilitySystemComponent>(InOwnerASC);
+    SharedSpec = PoE2OwnerASC && HasAuthority() ? PoE2OwnerASC->FindSharedSkillSpec(InSpec) : nullptr;
+    SeenSpecVersion = SharedSpec.IsValid() ? SharedSpec->GetVersion() : 0;
+
+    ActiveHandlers.Initialize(this, CurrentSpec, HandlerPrototypes);
 
     if (CurrentSpec.Lifetime > 0.0f)
     {
         SetLifeSpan(CurrentSpec.Lifetime);
     }
 
-    SetActorTickEnabled(ActiveHandlers.Num() > 0);
+    SetActorTickEnabled(ActiveHandlers.HasHook(EMechanicHandlerHooks::Tick));
+
+    if (UPoE2MinionCrowdSubsystem* Crowds = GetWorld()->GetSubsystem<UPoE2MinionCrowdSubsystem>())
+    {
+        Crowds->RegisterMinion(this, OwnerASC);
+    }
 }
 
 int32 APoE2MinionBase::GetActiveHandlerCount() const
 {
     return ActiveHandlers.Num();
 }
+
+const FSkillSpec& APoE2MinionBase::GetSpec()
+{
+    if (!SharedSpec.IsValid())
+    {
+        return CurrentSpec;
+    }
+
+    // One dirty check on the owner; the rebuild, if any, is shared with every other holder
+    if (UPoE2_AbilitySystemComponent* PoE2OwnerASC = Cast<UPoE2_AbilitySystemComponent>(OwnerASC))
+    {
+        PoE2OwnerASC->UpdateSharedSkillSpec(*SharedSpec);
+    }
+
+    if (SharedSpec->GetVersion() != SeenSpecVersion)
+    {
+        SeenSpecVersion = SharedSpec->GetVersion();
+        OnSpecUpdated();
+    }
+    return SharedSpec->Get();
+}
+
+void APoE2MinionBase::ApplySignificance(EPoE2MinionTier Tier, const FPoE2MinionTierSettings& TierSettings)
+{
+    SignificanceTier = Tier;
+
+    SetActorTickInterval(TierSettings.TickInterval);
+    HandlerTickInterval = TierSettings.HandlerTickInterval;
+
+    TInlineComponentArray<USkeletalMeshComponent*> Meshes(this);
+    for (USkeletalMeshComponent* Mesh : Meshes)
+    {
+        Mesh->SetComponentTickInterval(TierSettings.AnimTickInterval);
+    }
+
+    if (HasAuthority())
+    {
+        SetNetUpdateFrequency(TierSettings.NetUpdateFrequency);
+    }
+}
\ No newline at end of file
@@ -1,16 +1,18 @@
 #include "AbilitySystem/Actors/PoE2ProjectileBase.h"
 #include "Spec/SkillSpec.h"
 #include "Core/PoE2Log.h"
+#include "Core/PoE2Tags.h"
 #include "CueSystem/PoE2CueManager.h"
 #include "AbilitySystem/Handlers/MechanicHandler.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemBlueprintLibrary.h"
-#include "Core/PoE2Tags.h"
+#include "Effects/PoE2HitAccumulator.h"
+#include "Effects/PoE2DamageKernel.h"
+#include "Targeting/PoE2TargetingSubsystem.h"
 #include "Components/SphereComponent.h"
 #include "Engine/Engine.h"
 #include "Net/UnrealNetwork.h"
-#include "UObject/UObjectGlobals.h"
 
 APoE2ProjectileBase::APoE2ProjectileBase()
 {
@@ -51,36 +53,12 @@ void APoE2ProjectileBase::InitFromSpec(const FSkillSpec& InSpec, UAbilitySystemC
     CurrentSpec = InSpec;
     OwnerASC = InOwnerASC;
 
-    ActiveHandlers.Reset();
+    HitDamage = PoE2DamageKernel::MakeHitDamage(CurrentSpec);
 
-    for (const TScriptInterface<IMechanicHandler>& HandlerPrototype : HandlerPrototypes)
-    {
-        UObject* PrototypeObject = HandlerPrototype.GetObject();
-        if (!PrototypeObject)
-        {
-            continue;
-        }
+    ActiveHandlers.Initialize(this, CurrentSpec, HandlerPrototypes);
 
-        UObject* DuplicatedObject = DuplicateObject(PrototypeObject, this);
-        if (!DuplicatedObject)
-        {
-            continue;
-        }
-
-        TScriptInterface<IMechanicHandler> HandlerInstance;
-        HandlerInstance.SetObject(DuplicatedObject);
-        HandlerInstance.SetInterface(Cast<IMechanicHandler>(DuplicatedObject));
-
-        if (!HandlerInstance.GetInterface())
-        {
-            continue;
-        }
-
-        ActiveHandlers.Add(HandlerInstance);
-        IMechanicHandler::Execute_OnSpawn(DuplicatedObject, this, CurrentSpec);
-    }
-
-    SetActorTickEnabled(ActiveHandlers.Num() > 0);
+    // Only tick when a handler actually implements OnTick
+    SetActorTickEnabled(ActiveHandlers.HasHook(EMechanicHandlerHooks::Tick));
 
     // Set projectile speed
     if (MovementComponent && CurrentSpec.ProjectileSpeed > 0.0f)
@@ -112,14 +90,7 @@ void APoE2ProjectileBase::BeginPlay()
 
 void APoE2ProjectileBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    for (const TScriptInterface<IMechanicHandler>& Handler : ActiveHandlers)
-    {
-        if (Handler)
-        {
-            IMechanicHandler::Execute_OnEnd(Handler.GetObject(), this, CurrentSpec);
-        }
-    }
-    ActiveHandlers.Reset();
+    ActiveHandlers.DispatchEndAndReset(this, CurrentSpec);
 
     Super::EndPlay(EndPlayReason);
 }
@@ -128,13 +99,7 @@ void APoE2ProjectileBase::Tick(float DeltaSeconds)
 {
     Super::Tick(DeltaSeconds);
 
-    for (const TScriptInterface<IMechanicHandler>& Handler : ActiveHandlers)
-    {
-        if (Handler)
-        {
-            IMechanicHandler::Execute_OnTick(Handler.GetObject(), this, DeltaSeconds, CurrentSpec);
-        }
-    }
+    ActiveHandlers.DispatchTick(this, DeltaSeconds, CurrentSpec);
 }
 
 void APoE2ProjectileBase::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
@@ -155,25 +120,16 @@ void APoE2ProjectileBase::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor
         OtherActor ? *OtherActor->GetName() : TEXT("NULL"),
         *Hit.Location.ToString());
 
-    // Apply damage effect if available
-    if (CurrentSpec.DamageEffectClass && OwnerASC)
+    // Filter phase: a rejected hit is ignored entirely and the projectile keeps flying
+    if (!ActiveHandlers.RunHitFilters(this, OtherActor, Hit, CurrentSpec))
     {
-        if (UAbilitySystemComponent* TargetASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(OtherActor))
-        {
-            FGameplayEffectContextHandle ContextHandle = OwnerASC->MakeEffectContext();
-            ContextHandle.AddSourceObject(this);
-
-            FGameplayEffectSpecHandle SpecHandle = OwnerASC->MakeOutgoingSpec(CurrentSpec.DamageEffectClass, 1.0f, ContextHandle);
-
-            if (SpecHandle.IsValid())
-            {
-                // Use our static tag to pass the damage value to Exec_Damage
-                SpecHandle.Data->SetSetByCallerMagnitude(FPoE2Tags::Get().Data_Damage, CurrentSpec.FinalDamage);
-                OwnerASC->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), TargetASC);
-            }
-        }
+        UE_LOG(LogPoE2Framework, Log, TEXT("Hit on %s rejected by a filter handler"), OtherActor ? *OtherActor->GetName() : TEXT("NULL"));
+        return;
     }
 
+    // Queue damage; hits on the same target this frame are applied as one execution
+    UPoE2HitAccumulatorSubsystem::SubmitHit(this, OwnerASC, UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(OtherActor), CurrentSpec, HitDamage, Hit);
+
     // Play impact cue
     FGameplayCueParameters CueParams;
     CueParams.Location = Hit.Location;
@@ -181,39 +137,91 @@ void APoE2ProjectileBase::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor
     CueParams.PhysicalMaterial = Hit.PhysMaterial;
 
     // Use a generic impact cue tag
-    FGameplayTag ImpactCueTag = FGameplayTag::RequestGameplayTag(TEXT("GameplayCue.Projectile.Impact"));
-    UPoE2CueManager::PlayNetCue(this, ImpactCueTag, CueParams);
+    UPoE2CueManager::PlayNetCue(this, FPoE2Tags::Get().GameplayCue_Projectile_Impact, CueParams);
 
-    // Handle projectile mechanics by iterating through handler instances
-    for (const TScriptInterface<IMechanicHandler>& Handler : ActiveHandlers)
+    // Modify and Decide phases: the first decision short-circuits the remaining Decide handlers
+    const EHitHandlerResult Result = ActiveHandlers.ResolveHit(this, OtherActor, Hit, CurrentSpec);
+
+    if (Result == EHitHandlerResult::Pierce)
     {
-        if (!Handler)
-        {
-            continue;
-        }
+        UE_LOG(LogPoE2Framework, Log, TEXT("Handler allowed projectile to pierce through target"));
+        return;
+    }
 
-        EHitHandlerResult Result = IMechanicHandler::Execute_OnHit(Handler.GetObject(), this, OtherActor, Hit, CurrentSpec);
+    if (Result == EHitHandlerResult::Chain)
+    {
+        UE_LOG(LogPoE2Framework, Log, TEXT("Handler requested chain from %s"), OtherActor ? *OtherActor->GetName() : TEXT("NULL"));
+        ChainFrom(OtherActor);
+        return;
+    }
 
-        if (Result == EHitHandlerResult::Stop)
-        {
-            UE_LOG(LogPoE2Framework, Log, TEXT("Handler stopped projectile"));
-            Destroy();
-            return;
-        }
-        else if (Result == EHitHandlerResult::Pierce)
+    if (Result == EHitHandlerResult::Stop)
+    {
+        UE_LOG(LogPoE2Framework, Log, TEXT("Handler stopped projectile"));
+    }
+    else
+    {
+        // If no handler made a decision, default behavior is to destroy
+        UE_LOG(LogPoE2Framework, Log, TEXT("No handler made a pierce decision, projectile destroyed"));
+    }
+    Destroy();
+}
+
+void APoE2ProjectileBase::ChainFrom(AActor* HitActor)
+{
+    UPoE2TargetingSubsystem* Targeting = UWorld::GetSubsystem<UPoE2TargetingSubsystem>(GetWorld());
+    if (!Targeting)
+    {
+        UE_LOG(LogPoE2Framework, Log, TEXT("No targeting service to chain with, projectile destroyed"));
+        Destroy();
+        return;
+    }
+
+    // Fly through the target just hit instead of hitting it again while the next one is looked up
+    ChainedTargets.Add(HitActor);
+    if (UPrimitiveComponent* RootPrimitive = Cast<UPrimitiveComponent>(GetRootComponent()))
+    {
+        RootPrimitive->IgnoreActorWhenMoving(HitActor, true);
+    }
+
+    FPoE2TargetRequest Request;
+    Request.Origin = GetActorLocation();
+    Request.Radius = ChainRadius;
+    Request.Instigator = OwnerASC ? OwnerASC->GetAvatarActor() : GetOwner();
+    Request.Exclude.Add(this);
+    Request.Exclude.Append(ChainedTargets);
+
+    Targeting->RequestTarget(MoveTemp(Request), [WeakThis = TWeakObjectPtr<APoE2ProjectileBase>(this)](AActor* NextTarget)
+    {
+        if (APoE2ProjectileBase* Projectile = WeakThis.Get())
         {
-            UE_LOG(LogPoE2Framework, Log, TEXT("Handler allowed projectile to pierce through target"));
-            return;
+            Projectile->RedirectTo(NextTarget);
         }
-        else if (Result == EHitHandlerResult::Chain)
+    });
+}
+
+void APoE2ProjectileBase::RedirectTo(AActor* NextTarget)
+{
+    if (!NextTarget)
+    {
+        UE_LOG(LogPoE2Framework, Log, TEXT("No target left to chain to, projectile destroyed"));
+        Destroy();
+        return;
+    }
+
+    const FVector Direction = (NextTarget->GetActorLocation() - GetActorLocation()).GetSafeNormal();
+    SetActorRotation(Direction.Rotation());
+
+    if (MovementComponent)
+    {
+        // A blocking hit stops the movement component, so hand it the root again before relaunching
+        if (!MovementComponent->UpdatedComponent)
         {
-            UE_LOG(LogPoE2Framework, Log, TEXT("Handler requested chain - not yet implemented, continuing"));
+            MovementComponent->SetUpdatedComponent(GetRootComponent());
         }
+        MovementComponent->Velocity = Direction * MovementComponent->InitialSpeed;
+        MovementComponent->UpdateComponentVelocity();
     }
-
-    // If no handler made a decision, default behavior is to destroy
-    UE_LOG(LogPoE2Framework, Log, TEXT("No handler made a pierce decision, projectile destroyed"));
-    Destroy();
 }
 
 int32 APoE2ProjectileBase::GetActiveHandlerCount() const
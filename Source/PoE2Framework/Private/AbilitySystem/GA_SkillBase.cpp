@@ -3,11 +3,13 @@
 #include "Data/SkillDataAsset.h"
 #include "Spec/Patch.h"
 #include "Spec/SkillSpec.h"
+#include "Spec/SkillSpecBuilder.h"
 #include "AbilitySystem/Actors/PoE2ProjectileBase.h"
 #include "AbilitySystem/Actors/PoE2AreaEffectBase.h"
 #include "AbilitySystem/Actors/PoE2MinionBase.h"
+#include "Minions/PoE2SummonSpawnSubsystem.h"
 #include "AbilitySystem/Handlers/MechanicHandler.h"
-#include "AbilitySystem/Handlers/MechanicHandlerBase.h"
+#include "AbilitySystem/Handlers/MechanicHandlerDispatch.h"
 #include "CueSystem/PoE2CueManager.h"
 #include "CueSystem/CueParams.h"
 #include "AbilitySystemComponent.h"
@@ -22,6 +24,36 @@ UGA_SkillBase::UGA_SkillBase()
 {
 }
 
+bool UGA_SkillBase::CanActivateAbility(const FGameplayAbilitySpecHandle Handle,
+    const FGameplayAbilityActorInfo* ActorInfo,
+    const FGameplayTagContainer* SourceTags,
+    const FGameplayTagContainer* TargetTags,
+    FGameplayTagContainer* OptionalRelevantTags) const
+{
+    if (!Super::CanActivateAbility(Handle, ActorInfo, SourceTags, TargetTags, OptionalRelevantTags))
+    {
+        return false;
+    }
+
+    // Carrier and effect classes are soft references; activating before they stream in would spawn nothing
+    UAbilitySystemComponent* ASC = ActorInfo ? ActorInfo->AbilitySystemComponent.Get() : nullptr;
+    const FGameplayAbilitySpec* Spec = ASC ? ASC->FindAbilitySpecFromHandle(Handle) : nullptr;
+
+    if (const USkillDataAsset* SkillDA = Spec ? Cast<USkillDataAsset>(Spec->SourceObject.Get()) : nullptr)
+    {
+        // The PoE2 ASC caches the load state when the bundle finishes; only a foreign ASC pays for the per-asset check
+        const UPoE2_AbilitySystemComponent* PoE2ASC = Cast<UPoE2_AbilitySystemComponent>(ASC);
+        const bool bLoaded = PoE2ASC ? PoE2ASC->IsSkillReady(SkillDA) : SkillDA->AreBundlesLoaded({ USkillDataAsset::GameplayBundle });
+        if (!bLoaded)
+        {
+            UE_LOG(LogPoE2Framework, Verbose, TEXT("UGA_SkillBase::CanActivateAbility: Skill %s is still loading"), *SkillDA->SkillId.ToString());
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void UGA_SkillBase::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
     const FGameplayAbilityActorInfo* ActorInfo,
     const FGameplayAbilityActivationInfo ActivationInfo,
@@ -31,7 +63,6 @@ void UGA_SkillBase::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
     
     // 1. 获取数据源
     const USkillDataAsset* SkillDA = nullptr;
-    TArray<FPatch> Patches; 
     
     // 多种方式提取 SkillDataAsset
     if (TriggerEventData)
@@ -72,17 +103,19 @@ void UGA_SkillBase::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 
     // 1. 从 ActorInfo 获取我们的自定义 AbilitySystemComponent
     UPoE2_AbilitySystemComponent* PoE2_ASC = Cast<UPoE2_AbilitySystemComponent>(GetAbilitySystemComponentFromActorInfo());
-
-    // 2. 如果成功获取，就调用核心函数来搜集 Patches
-    if (PoE2_ASC)
-    {
-        Patches = PoE2_ASC->GetPatchesForSkill(SkillDA);
-    }
     // ====================================================================
     
-    // 2. 构建局部 SkillSpec
+    // 2. 构建局部 SkillSpec：已装备的技能取 ASC 缓存（含角色属性），否则现场搜集 Patches 合成
     FSkillSpec LocalSkillSpec;
-    BuildSkillSpec(SkillDA, Patches, LocalSkillSpec);
+    if (!PoE2_ASC || !PoE2_ASC->GetSkillSpec(SkillDA, LocalSkillSpec))
+    {
+        TArray<FPatch> Patches;
+        if (PoE2_ASC)
+        {
+            Patches = PoE2_ASC->GetPatchesForSkill(SkillDA);
+        }
+        BuildSkillSpec(SkillDA, Patches, LocalSkillSpec);
+    }
     
     // 验证 SkillSpec 构建结果
     if (LocalSkillSpec.SkillId == NAME_None)
@@ -105,12 +138,13 @@ void UGA_SkillBase::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
     
     // 5. 播放施法表现
     // 5.1 播放施法动画
-    if (SkillDA->CastMontage)
+    // Cosmetic bundle: absent on dedicated servers and possibly still streaming on clients
+    if (UAnimMontage* CastMontage = SkillDA->CastMontage.Get())
     {
         UAbilityTask_PlayMontageAndWait* MontageTask = UAbilityTask_PlayMontageAndWait::CreatePlayMontageAndWaitProxy(
             this, 
             NAME_None, 
-            SkillDA->CastMontage, 
+            CastMontage, 
             1.0f, // PlayRate
             NAME_None, // StartSection
             true, // bStopWhenAbilityEnds
@@ -162,7 +196,8 @@ void UGA_SkillBase::ExecuteSkillEffects(const FSkillSpec& LocalSkillSpec)
             continue;
         }
 
-        UMechanicHandlerBase* NewHandler = NewObject<UMechanicHandlerBase>(this, HandlerClass);
+        // Handlers only need to implement IMechanicHandler, not derive from UMechanicHandlerBase (e.g. UMechanic_Pierce)
+        UObject* NewHandler = NewObject<UObject>(this, HandlerClass);
         if (!NewHandler)
         {
             continue;
@@ -177,7 +212,11 @@ void UGA_SkillBase::ExecuteSkillEffects(const FSkillSpec& LocalSkillSpec)
             continue;
         }
 
-        IMechanicHandler::Execute_OnCast(NewHandler, CasterASC, LocalSkillSpec);
+        const FMechanicHandlerRef HandlerRef(NewHandler);
+        if (EnumHasAnyFlags(HandlerRef.Hooks, EMechanicHandlerHooks::Cast))
+        {
+            MechanicHandlerDispatch::OnCast(HandlerRef, CasterASC, LocalSkillSpec);
+        }
         HandlerInstances.Add(HandlerInterface);
     }
 
@@ -199,22 +238,25 @@ void UGA_SkillBase::ExecuteSkillEffects(const FSkillSpec& LocalSkillSpec)
         }
     }
 
-    // 生成召唤物
+    // 生成召唤物：阵型位置一次批量投影到导航网格，按每帧预算分帧生成
     if (LocalSkillSpec.SummonClass)
     {
         AActor* Avatar = GetAvatarActorFromActorInfo();
-        if (Avatar)
+        UWorld* World = Avatar ? Avatar->GetWorld() : nullptr;
+        if (UPoE2SummonSpawnSubsystem* Spawner = World ? World->GetSubsystem<UPoE2SummonSpawnSubsystem>() : nullptr)
         {
-            const FVector RightVector = Avatar->GetActorRightVector();
-
-            for (int32 Index = 0; Index < LocalSkillSpec.SummonCount; ++Index)
+            Spawner->QueueFormation(Avatar, LocalSkillSpec, CasterASC, HandlerInstances);
+        }
+        else if (Avatar)
+        {
+            // 没有生成子系统（如编辑器预览世界）：按阵型立即生成，不做投影
+            TArray<FTransform> Slots;
+            PoE2SummonFormation::ComputeSlots(Avatar->GetActorLocation(), Avatar->GetActorForwardVector(), LocalSkillSpec.SummonCount, FPoE2SummonFormationSettings(), Slots);
+            for (const FTransform& Slot : Slots)
             {
                 if (APoE2MinionBase* Summon = SpawnSummon(LocalSkillSpec))
                 {
-                    const float Spread = 100.f;
-                    const float OffsetIndex = static_cast<float>(Index) - (static_cast<float>(LocalSkillSpec.SummonCount - 1) * 0.5f);
-                    const FVector SpawnLocation = Avatar->GetActorLocation() + (RightVector * OffsetIndex * Spread);
-                    Summon->SetActorLocation(SpawnLocation);
+                    Summon->SetActorTransform(Slot);
                     Summon->InitFromSpec(LocalSkillSpec, CasterASC, HandlerInstances);
                 }
             }
@@ -257,57 +299,8 @@ void UGA_SkillBase::BuildSkillSpec(const USkillDataAsset* SkillDA,
     const TArray<FPatch>& Patches,
     FSkillSpec& OutSpec) const
 {
-    if (!SkillDA)
-    {
-        return;
-    }
-    
-    // 1. 从 SkillDA 读取基础数值
-    OutSpec = SkillDA->CreateBaseSkillSpec();
-    
-    // 2. 应用所有 Patch 修改
-    for (const FPatch& Patch : Patches)
-    {
-        UStruct* SkillSpecStruct = FSkillSpec::StaticStruct();
-
-        // 应用加法修改
-        for (const auto& Elem : Patch.AdditiveModifiers)
-        {
-            if (FFloatProperty* FloatProp = FindFProperty<FFloatProperty>(SkillSpecStruct, Elem.Key))
-            {
-                float& CurrentValue = *FloatProp->ContainerPtrToValuePtr<float>(&OutSpec);
-                CurrentValue += Elem.Value;
-            }
-        }
-
-        // 应用乘法修改 ("Increased/Reduced")
-        for (const auto& Elem : Patch.MultiplicativeModifiers)
-        {
-            if (FFloatProperty* FloatProp = FindFProperty<FFloatProperty>(SkillSpecStruct, Elem.Key))
-            {
-                float& CurrentValue = *FloatProp->ContainerPtrToValuePtr<float>(&OutSpec);
-                CurrentValue *= (1.0f + Elem.Value);
-            }
-        }
-        
-        // 应用标签修改
-        OutSpec.SkillTags.AppendTags(Patch.TagsToAdd);
-        OutSpec.SkillTags.RemoveTags(Patch.TagsToRemove);
-        
-        // 添加效果
-        OutSpec.AppliedEffects.Append(Patch.EffectsToAdd);
-        
-        // 添加机制处理器
-        OutSpec.MechanicHandlers.Append(Patch.HandlersToAdd);
-        
-        // 应用投掷物类覆盖
-        if (Patch.ProjectileClassOverride)
-        {
-            OutSpec.ProjectileClass = Patch.ProjectileClassOverride;
-        }
-    }
-    
-    // 3. OutSpec 现在包含了完整的合成结果
+    // 合成逻辑在 FSkillSpecBuilder 中，离线模拟与支援搜索共用同一套规则
+    FSkillSpecBuilder::Build(SkillDA, Patches, OutSpec);
 }
 
 APoE2ProjectileBase* UGA_SkillBase::SpawnProjectile(const FSkillSpec& SkillSpec)
@@ -0,0 +1,79 @@
+#include "AbilitySystem/Handlers/MechanicHandler.h"
+#include "UObject/Class.h"
+#include "UObject/ObjectKey.h"
+
+namespace MechanicHandlerHooks
+{
+    namespace
+    {
+        struct FClassHookInfo
+        {
+            EMechanicHandlerHooks Hooks = EMechanicHandlerHooks::None;
+            EMechanicHandlerHooks ScriptHooks = EMechanicHandlerHooks::None;
+        };
+
+        const FClassHookInfo& GetClassHookInfo(const UClass* HandlerClass)
+        {
+            check(IsInGameThread());
+            check(HandlerClass);
+
+            // Keyed by TObjectKey so recompiled Blueprint classes get a fresh entry instead of a stale one.
+            static TMap<TObjectKey<UClass>, FClassHookInfo> ClassHookCache;
+
+            const TObjectKey<UClass> Key(const_cast<UClass*>(HandlerClass));
+            if (const FClassHookInfo* Cached = ClassHookCache.Find(Key))
+            {
+                return *Cached;
+            }
+
+            FClassHookInfo Info;
+
+            // Native side: only classes that implement the interface in C++ can be asked directly.
+            if (const IMechanicHandler* NativeHandler = Cast<IMechanicHandler>(HandlerClass->GetDefaultObject()))
+            {
+                Info.Hooks |= NativeHandler->GetNativeHandlerHooks();
+            }
+
+            // Blueprint side: any event graph implementation of a hook enables it.
+            struct FHookName
+            {
+                FName Name;
+                EMechanicHandlerHooks Hook;
+            };
+            static const FHookName HookNames[] =
+            {
+                { GET_FUNCTION_NAME_CHECKED(IMechanicHandler, OnCast), EMechanicHandlerHooks::Cast },
+                { GET_FUNCTION_NAME_CHECKED(IMechanicHandler, OnSpawn), EMechanicHandlerHooks::Spawn },
+                { GET_FUNCTION_NAME_CHECKED(IMechanicHandler, OnHit), EMechanicHandlerHooks::Hit },
+                { GET_FUNCTION_NAME_CHECKED(IMechanicHandler, OnTick), EMechanicHandlerHooks::Tick },
+                { GET_FUNCTION_NAME_CHECKED(IMechanicHandler, OnEnd), EMechanicHandlerHooks::End },
+            };
+
+            for (const FHookName& HookName : HookNames)
+            {
+                if (HandlerClass->IsFunctionImplementedInScript(HookName.Name))
+                {
+                    Info.ScriptHooks |= HookName.Hook;
+                }
+            }
+            Info.Hooks |= Info.ScriptHooks;
+
+            return ClassHookCache.Add(Key, Info);
+        }
+    }
+
+    EMechanicHandlerHooks GetClassHooks(const UClass* HandlerClass)
+    {
+        return HandlerClass ? GetClassHookInfo(HandlerClass).Hooks : EMechanicHandlerHooks::None;
+    }
+
+    EMechanicHandlerHooks GetClassScriptHooks(const UClass* HandlerClass)
+    {
+        return HandlerClass ? GetClassHookInfo(HandlerClass).ScriptHooks : EMechanicHandlerHooks::None;
+    }
+
+    EMechanicHandlerHooks GetHooks(const UObject* Handler)
+    {
+        return Handler ? GetClassHooks(Handler->GetClass()) : EMechanicHandlerHooks::None;
+    }
+}
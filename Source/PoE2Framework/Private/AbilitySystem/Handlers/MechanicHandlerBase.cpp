@@ -44,8 +44,9 @@ EHitHandlerResult UMechanicHandlerBase::OnHit_Implementation(AActor* OwnerActor,
             *SkillSpec.SkillId.ToString());
     }
     
-    // Base implementation returns Stop (default projectile behavior)
-    return EHitHandlerResult::Stop;
+    // No opinion: lets a Filter accept the hit and leaves the decision to other handlers
+    // (a carrier with no decision falls back to its own default, e.g. a projectile is destroyed)
+    return EHitHandlerResult::Continue;
 }
 
 void UMechanicHandlerBase::OnTick_Implementation(AActor* OwnerActor, float DeltaTime, const FSkillSpec& SkillSpec)
@@ -65,4 +66,26 @@ void UMechanicHandlerBase::OnEnd_Implementation(AActor* OwnerActor, const FSkill
     }
     
     // Base implementation does nothing - override in derived classes
+}
+
+EMechanicHandlerHooks UMechanicHandlerBase::GetNativeHandlerHooks() const
+{
+    // A native subclass that doesn't declare its hooks may override any of them
+    return IsNearestNativeClass(StaticClass()) ? GetBaseHandlerHooks() : EMechanicHandlerHooks::All;
+}
+
+EMechanicHandlerHooks UMechanicHandlerBase::GetBaseHandlerHooks() const
+{
+    // Queried on the class defaults, so this follows the class's debug setting, not an instance's
+    return bDebugLogging ? EMechanicHandlerHooks::All : EMechanicHandlerHooks::None;
+}
+
+bool UMechanicHandlerBase::IsNearestNativeClass(const UClass* DeclaringClass) const
+{
+    const UClass* NativeClass = GetClass();
+    while (NativeClass && !NativeClass->HasAnyClassFlags(CLASS_Native))
+    {
+        NativeClass = NativeClass->GetSuperClass();
+    }
+    return NativeClass == DeclaringClass;
 }
\ No newline at end of file
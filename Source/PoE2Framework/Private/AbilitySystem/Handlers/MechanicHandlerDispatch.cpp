@@ -0,0 +1,12 @@
+#include "AbilitySystem/Handlers/MechanicHandlerDispatch.h"
+
+FMechanicHandlerRef::FMechanicHandlerRef(UObject* InObject)
+    : Object(InObject)
+{
+    if (Object)
+    {
+        NativeInterface = Cast<IMechanicHandler>(Object);
+        Hooks = MechanicHandlerHooks::GetClassHooks(Object->GetClass());
+        ScriptHooks = MechanicHandlerHooks::GetClassScriptHooks(Object->GetClass());
+    }
+}
@@ -0,0 +1,60 @@
+#include "AbilitySystem/Handlers/MechanicHandlerPipeline.h"
+#include "UObject/Class.h"
+#include "Algo/StableSort.h"
+
+TSharedRef<const FMechanicHandlerPipeline> FMechanicHandlerPipeline::Compile(TConstArrayView<TSubclassOf<UObject>> HandlerClasses)
+{
+    check(IsInGameThread());
+
+    TSharedRef<FMechanicHandlerPipeline> Pipeline = MakeShareable(new FMechanicHandlerPipeline());
+    Pipeline->Entries.Reserve(HandlerClasses.Num());
+
+    for (const TSubclassOf<UObject>& HandlerClass : HandlerClasses)
+    {
+        if (!HandlerClass || Pipeline->IndexOf(HandlerClass) != INDEX_NONE)
+        {
+            continue;
+        }
+
+        FMechanicHandlerPipelineEntry& Entry = Pipeline->Entries.AddDefaulted_GetRef();
+        Entry.HandlerClass = HandlerClass;
+        Entry.Hooks = MechanicHandlerHooks::GetClassHooks(HandlerClass);
+
+        // Blueprint-only interface implementations have no native interface and keep the defaults.
+        if (const IMechanicHandler* NativeHandler = Cast<IMechanicHandler>(HandlerClass->GetDefaultObject()))
+        {
+            Entry.Phase = NativeHandler->GetHitPhase();
+            Entry.Priority = NativeHandler->GetHandlerPriority();
+        }
+
+        Pipeline->CombinedHooks |= Entry.Hooks;
+    }
+
+    Algo::StableSort(Pipeline->Entries, [](const FMechanicHandlerPipelineEntry& A, const FMechanicHandlerPipelineEntry& B)
+    {
+        if (A.Phase != B.Phase)
+        {
+            return A.Phase < B.Phase;
+        }
+        return A.Priority > B.Priority;
+    });
+
+    return Pipeline;
+}
+
+int32 FMechanicHandlerPipeline::IndexOf(const UClass* HandlerClass) const
+{
+    return Entries.IndexOfByPredicate([HandlerClass](const FMechanicHandlerPipelineEntry& Entry)
+    {
+        return Entry.HandlerClass == HandlerClass;
+    });
+}
+
+void FMechanicHandlerPipeline::GetHandlerClasses(TArray<TSubclassOf<UObject>>& OutHandlerClasses) const
+{
+    OutHandlerClasses.Reset(Entries.Num());
+    for (const FMechanicHandlerPipelineEntry& Entry : Entries)
+    {
+        OutHandlerClasses.Add(Entry.HandlerClass);
+    }
+}
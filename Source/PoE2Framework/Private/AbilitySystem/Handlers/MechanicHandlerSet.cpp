@@ -0,0 +1,154 @@
+#include "AbilitySystem/Handlers/MechanicHandlerSet.h"
+#include "AbilitySystem/Handlers/MechanicHandlerPipeline.h"
+#include "Spec/SkillSpec.h"
+#include "GameFramework/Actor.h"
+#include "UObject/UObjectGlobals.h"
+
+void FMechanicHandlerSet::Initialize(AActor* OwnerActor, const FSkillSpec& SkillSpec, const TArray<TScriptInterface<IMechanicHandler>>& HandlerPrototypes)
+{
+    Reset();
+
+    Pipeline = SkillSpec.GetHandlerPipeline();
+
+    // Prototypes passed in from Blueprint may not come from the spec; fall back to compiling them directly
+    const bool bPipelineCoversPrototypes = Pipeline.IsValid() && !HandlerPrototypes.ContainsByPredicate([this](const TScriptInterface<IMechanicHandler>& Prototype)
+    {
+        return Prototype.GetObject() && Pipeline->IndexOf(Prototype.GetObject()->GetClass()) == INDEX_NONE;
+    });
+
+    if (!bPipelineCoversPrototypes)
+    {
+        // Specs assembled by hand (or received over the network) have no frozen pipeline yet
+        TArray<TSubclassOf<UObject>> PrototypeClasses;
+        PrototypeClasses.Reserve(HandlerPrototypes.Num());
+        for (const TScriptInterface<IMechanicHandler>& HandlerPrototype : HandlerPrototypes)
+        {
+            if (UObject* PrototypeObject = HandlerPrototype.GetObject())
+            {
+                PrototypeClasses.Add(PrototypeObject->GetClass());
+            }
+        }
+        Pipeline = FMechanicHandlerPipeline::Compile(PrototypeClasses);
+    }
+
+    for (const FMechanicHandlerPipelineEntry& Entry : Pipeline->GetEntries())
+    {
+        const TScriptInterface<IMechanicHandler>* HandlerPrototype = HandlerPrototypes.FindByPredicate([&Entry](const TScriptInterface<IMechanicHandler>& Prototype)
+        {
+            return Prototype.GetObject() && Prototype.GetObject()->GetClass() == Entry.HandlerClass;
+        });
+        if (!HandlerPrototype)
+        {
+            continue;
+        }
+
+        UObject* DuplicatedObject = DuplicateObject(HandlerPrototype->GetObject(), OwnerActor);
+        if (!DuplicatedObject)
+        {
+            continue;
+        }
+
+        TScriptInterface<IMechanicHandler> HandlerInstance;
+        HandlerInstance.SetObject(DuplicatedObject);
+        HandlerInstance.SetInterface(Cast<IMechanicHandler>(DuplicatedObject));
+
+        if (!HandlerInstance.GetInterface())
+        {
+            continue;
+        }
+
+        const FMechanicHandlerRef HandlerRef(DuplicatedObject);
+        CombinedHooks |= HandlerRef.Hooks;
+
+        Handlers.Add(HandlerInstance);
+        if (EnumHasAnyFlags(HandlerRef.Hooks, EMechanicHandlerHooks::Hit))
+        {
+            switch (Entry.Phase)
+            {
+            case EMechanicHandlerPhase::Filter:
+                FilterHitHandlers.Add(HandlerRef);
+                break;
+            case EMechanicHandlerPhase::Modify:
+                ModifyHitHandlers.Add(HandlerRef);
+                break;
+            default:
+                DecideHitHandlers.Add(HandlerRef);
+                break;
+            }
+        }
+        if (EnumHasAnyFlags(HandlerRef.Hooks, EMechanicHandlerHooks::Tick))
+        {
+            TickHandlers.Add(HandlerRef);
+        }
+        if (EnumHasAnyFlags(HandlerRef.Hooks, EMechanicHandlerHooks::End))
+        {
+            EndHandlers.Add(HandlerRef);
+        }
+
+        if (EnumHasAnyFlags(HandlerRef.Hooks, EMechanicHandlerHooks::Spawn))
+        {
+            MechanicHandlerDispatch::OnSpawn(HandlerRef, OwnerActor, SkillSpec);
+        }
+    }
+}
+
+void FMechanicHandlerSet::DispatchTick(AActor* OwnerActor, float DeltaTime, const FSkillSpec& SkillSpec) const
+{
+    for (const FMechanicHandlerRef& Handler : TickHandlers)
+    {
+        MechanicHandlerDispatch::OnTick(Handler, OwnerActor, DeltaTime, SkillSpec);
+    }
+}
+
+void FMechanicHandlerSet::DispatchEndAndReset(AActor* OwnerActor, const FSkillSpec& SkillSpec)
+{
+    for (const FMechanicHandlerRef& Handler : EndHandlers)
+    {
+        MechanicHandlerDispatch::OnEnd(Handler, OwnerActor, SkillSpec);
+    }
+
+    Reset();
+}
+
+bool FMechanicHandlerSet::RunHitFilters(AActor* OwnerActor, AActor* Target, const FHitResult& HitResult, const FSkillSpec& SkillSpec) const
+{
+    for (const FMechanicHandlerRef& Handler : FilterHitHandlers)
+    {
+        if (MechanicHandlerDispatch::OnHit(Handler, OwnerActor, Target, HitResult, SkillSpec) != EHitHandlerResult::Continue)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+EHitHandlerResult FMechanicHandlerSet::ResolveHit(AActor* OwnerActor, AActor* Target, const FHitResult& HitResult, const FSkillSpec& SkillSpec) const
+{
+    // Modify handlers run for their side effects; they cannot end the hit
+    for (const FMechanicHandlerRef& Handler : ModifyHitHandlers)
+    {
+        MechanicHandlerDispatch::OnHit(Handler, OwnerActor, Target, HitResult, SkillSpec);
+    }
+
+    for (const FMechanicHandlerRef& Handler : DecideHitHandlers)
+    {
+        const EHitHandlerResult Result = MechanicHandlerDispatch::OnHit(Handler, OwnerActor, Target, HitResult, SkillSpec);
+        if (Result != EHitHandlerResult::Continue)
+        {
+            return Result;
+        }
+    }
+    return EHitHandlerResult::Continue;
+}
+
+void FMechanicHandlerSet::Reset()
+{
+    Handlers.Reset();
+    FilterHitHandlers.Reset();
+    ModifyHitHandlers.Reset();
+    DecideHitHandlers.Reset();
+    TickHandlers.Reset();
+    EndHandlers.Reset();
+    Pipeline.Reset();
+    CombinedHooks = EMechanicHandlerHooks::None;
+}
@@ -0,0 +1,42 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "AbilitySystem/Handlers/Mechanic_DOT.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "AbilitySystemComponent.h"
+#include "Effects/PoE2DotSubsystem.h"
+#include "Effects/PoE2DamageTypes.h"
+#include "Spec/SkillSpec.h"
+#include "Core/PoE2Log.h"
+#include "Engine/World.h"
+
+const FName UMechanic_DOT::DamagePerSecondKey = FName(TEXT("Mechanic.DOT.DamagePerSecond"));
+const FName UMechanic_DOT::DurationKey = FName(TEXT("Mechanic.DOT.Duration"));
+const FName UMechanic_DOT::StrongestOnlyKey = FName(TEXT("Mechanic.DOT.StrongestOnly"));
+
+EHitHandlerResult UMechanic_DOT::OnHit_Implementation(AActor* OwnerActor, AActor* Target, const FHitResult& HitResult, const FSkillSpec& SkillSpec)
+{
+    UWorld* World = OwnerActor ? OwnerActor->GetWorld() : nullptr;
+    UPoE2DotSubsystem* DotSubsystem = World ? World->GetSubsystem<UPoE2DotSubsystem>() : nullptr;
+    if (!DotSubsystem)
+    {
+        return EHitHandlerResult::Continue;
+    }
+
+    FPoE2DotApplication Application;
+    Application.Target = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(Target);
+    Application.Source = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(OwnerActor->GetOwner());
+    Application.DamagePerSecond = SkillSpec.GetCustomParam(DamagePerSecondKey, 0.0f);
+    Application.Duration = SkillSpec.GetCustomParam(DurationKey, 0.0f);
+    Application.DamageType = PoE2DamageType::FindDamageTypeTag(SkillSpec.SkillTags);
+    Application.StackGroup = SkillSpec.SkillId;
+    Application.Stacking = SkillSpec.GetCustomParam(StrongestOnlyKey, 0.0f) > 0.0f ? EPoE2DotStacking::StrongestOnly : EPoE2DotStacking::Unlimited;
+
+    if (!DotSubsystem->ApplyDot(Application))
+    {
+        UE_LOG(LogPoE2Framework, Verbose, TEXT("Mechanic_DOT: Skipped DoT on %s (no ASC or no DPS/duration)"), Target ? *Target->GetName() : TEXT("NULL"));
+    }
+
+    return EHitHandlerResult::Continue;
+}
@@ -55,4 +55,9 @@ EHitHandlerResult UMechanic_Pierce::OnHit_Implementation(AActor* OwnerActor, AAc
     ProjectilePierceUsage.Remove(ProjectilePtr);
     UE_LOG(LogPoE2Framework, Log, TEXT("Mechanic_Pierce: No pierce remaining, stopping projectile"));
     return EHitHandlerResult::Stop;
+}
+
+EMechanicHandlerHooks UMechanic_Pierce::GetNativeHandlerHooks() const
+{
+    return MechanicHandlerHooks::DeriveNative<UMechanic_Pierce>();
 }
\ No newline at end of file
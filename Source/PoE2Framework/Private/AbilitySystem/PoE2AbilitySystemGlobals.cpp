@@ -0,0 +1,11 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "AbilitySystem/PoE2AbilitySystemGlobals.h"
+#include "Effects/PoE2GameplayEffectContext.h"
+
+FGameplayEffectContext* UPoE2AbilitySystemGlobals::AllocGameplayEffectContext() const
+{
+    return new FPoE2GameplayEffectContext();
+}
@@ -0,0 +1,103 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "AbilitySystem/PoE2SwarmAbilitySystemComponent.h"
+#include "Attributes/AttributeSet_SwarmCore.h"
+#include "Targeting/PoE2TargetingSubsystem.h"
+#include "Engine/World.h"
+#include "GameplayEffect.h"
+#include "GameplayEffectExecutionCalculation.h"
+
+UPoE2SwarmAbilitySystemComponent::UPoE2SwarmAbilitySystemComponent()
+{
+    SetIsReplicatedByDefault(true);
+    SetReplicationMode(EGameplayEffectReplicationMode::Minimal);
+
+    LazyAttributeSets.Add(UAttributeSet_SwarmCore::StaticClass());
+}
+
+FActiveGameplayEffectHandle UPoE2SwarmAbilitySystemComponent::ApplyGameplayEffectSpecToSelf(const FGameplayEffectSpec& GameplayEffect, FPredictionKey PredictionKey)
+{
+    // 属性集须在 GE 捕获与修改属性之前就位
+    if (const UGameplayEffect* Def = GameplayEffect.Def)
+    {
+        for (const FGameplayModifierInfo& Modifier : Def->Modifiers)
+        {
+            EnsureAttributeSetFor(Modifier.Attribute);
+        }
+
+        for (const FGameplayEffectExecutionDefinition& Execution : Def->Executions)
+        {
+            const UGameplayEffectExecutionCalculation* Calculation = Execution.CalculationClass ? Execution.CalculationClass->GetDefaultObject<UGameplayEffectExecutionCalculation>() : nullptr;
+            if (!Calculation)
+            {
+                continue;
+            }
+
+            // 从目标（即自己）捕获的属性：缺少属性集时捕获失败按 0 计，与属性集默认值不一定相同
+            for (const FGameplayEffectAttributeCaptureDefinition& Capture : Calculation->GetAttributeCaptureDefinitions())
+            {
+                if (Capture.AttributeSource == EGameplayEffectAttributeCaptureSource::Target)
+                {
+                    EnsureAttributeSetFor(Capture.AttributeToCapture);
+                }
+            }
+        }
+    }
+
+    return Super::ApplyGameplayEffectSpecToSelf(GameplayEffect, PredictionKey);
+}
+
+void UPoE2SwarmAbilitySystemComponent::InitAbilityActorInfo(AActor* InOwnerActor, AActor* InAvatarActor)
+{
+    AActor* PreviousAvatar = GetAvatarActor_Direct();
+
+    Super::InitAbilityActorInfo(InOwnerActor, InAvatarActor);
+
+    UPoE2TargetingSubsystem::UpdateAvatarTarget(GetWorld(), PreviousAvatar, InAvatarActor);
+}
+
+void UPoE2SwarmAbilitySystemComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    UPoE2TargetingSubsystem::UpdateAvatarTarget(GetWorld(), GetAvatarActor_Direct(), nullptr);
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void UPoE2SwarmAbilitySystemComponent::EnsureAttributeSetFor(const FGameplayAttribute& Attribute)
+{
+    // 客户端的属性集随复制到达，本地再建一份会重复
+    if (!Attribute.IsValid() || Attribute.IsSystemAttribute() || !IsOwnerActorAuthoritative() || HasAttributeSetForAttribute(Attribute))
+    {
+        return;
+    }
+
+    if (const TSubclassOf<UAttributeSet> SetClass = FindLazyAttributeSetClass(Attribute.GetAttributeSetClass()))
+    {
+        AddSpawnedAttribute(NewObject<UAttributeSet>(GetOwner(), SetClass));
+    }
+}
+
+const UAttributeSet* UPoE2SwarmAbilitySystemComponent::GetLazyAttributeSetDefaults(TSubclassOf<UAttributeSet> SetClass) const
+{
+    const TSubclassOf<UAttributeSet> LazyClass = FindLazyAttributeSetClass(SetClass);
+    return LazyClass ? LazyClass->GetDefaultObject<UAttributeSet>() : nullptr;
+}
+
+TSubclassOf<UAttributeSet> UPoE2SwarmAbilitySystemComponent::FindLazyAttributeSetClass(TSubclassOf<UAttributeSet> SetClass) const
+{
+    if (!SetClass)
+    {
+        return nullptr;
+    }
+
+    for (const TSubclassOf<UAttributeSet>& LazyClass : LazyAttributeSets)
+    {
+        if (LazyClass && LazyClass->IsChildOf(SetClass))
+        {
+            return LazyClass;
+        }
+    }
+    return nullptr;
+}
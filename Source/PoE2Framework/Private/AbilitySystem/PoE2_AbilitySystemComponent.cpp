@@ -3,6 +3,16 @@
 #include "AbilitySystem/PoE2_AbilitySystemComponent.h"
 #include "Data/SkillDataAsset.h"
 #include "Data/SupportDataAsset.h"
+#include "Spec/SkillSpecBuilder.h"
+#include "Data/PassiveTreeDataAsset.h"
+#include "Engine/AssetManager.h"
+#include "Core/PoE2Log.h"
+#include "Targeting/PoE2TargetingSubsystem.h"
+#include "Data/PoE2SkillRegistry.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/GameSession.h"
+#include "GameFramework/PlayerController.h"
 
 TArray<FPatch> UPoE2_AbilitySystemComponent::GetPatchesForSkill(const USkillDataAsset* SkillToFind) const
 {
@@ -54,28 +64,421 @@ void UPoE2_AbilitySystemComponent::EquipSkill(USkillDataAsset* NewSkill)
         {
             FActiveSkillLink NewLink;
             NewLink.Skill = NewSkill;
-            EquippedSkills.Add(NewLink);
-            
-            if (NewSkill->AbilityClass)
+            NewLink.StatConsumer = StatGraph.AddConsumer();
+            NewLink.SharedSpec = MakeShared<FPoE2SharedSkillSpec>();
+            NewLink.SharedSpec->StatConsumer = NewLink.StatConsumer;
+            const int32 LinkIndex = EquippedSkills.Add(NewLink);
+
+            // 能力类本身也在资源包里，所以授予必须等加载完成
+            TSharedPtr<FStreamableHandle> Handle = RequestSkillBundles(NewSkill,
+                FStreamableDelegate::CreateUObject(this, &UPoE2_AbilitySystemComponent::OnSkillAssetsLoaded, TWeakObjectPtr<USkillDataAsset>(NewSkill)));
+            EquippedSkills[LinkIndex].LoadHandle = Handle;
+
+            // 没有需要加载的内容时不会有回调，直接完成
+            if (!Handle.IsValid())
             {
-                FGameplayAbilitySpec Spec(NewSkill->AbilityClass, 1, -1, NewSkill);
-                GiveAbility(Spec);
+                OnSkillAssetsLoaded(NewSkill);
             }
         }
     }
 }
 
+bool UPoE2_AbilitySystemComponent::IsSkillReady(const USkillDataAsset* Skill) const
+{
+    if (!Skill)
+    {
+        return false;
+    }
+
+    if (const FActiveSkillLink* Link = EquippedSkills.FindByPredicate([Skill](const FActiveSkillLink& L) { return L.Skill == Skill; }))
+    {
+        return Link->bAssetsLoaded;
+    }
+
+    // 客户端没有装备记录，复制来的能力在 OnGiveAbility 中开始加载；无句柄表示没有需要加载的内容
+    if (const TSharedPtr<FStreamableHandle>* Handle = ReplicatedSkillLoadHandles.Find(Skill))
+    {
+        return !Handle->IsValid() || (*Handle)->HasLoadCompleted();
+    }
+    return false;
+}
+
+int64 UPoE2_AbilitySystemComponent::GetSkillResidentMemory(const USkillDataAsset* Skill) const
+{
+    return Skill ? Skill->GetResidentMemoryBytes() : 0;
+}
+
+TSharedPtr<FStreamableHandle> UPoE2_AbilitySystemComponent::RequestSkillBundles(USkillDataAsset* Skill, FStreamableDelegate OnLoaded) const
+{
+    const TArray<FName> Bundles = USkillDataAsset::GetRequiredBundles();
+
+    TSharedPtr<FStreamableHandle> Handle;
+    if (UAssetManager::IsInitialized())
+    {
+        Handle = UAssetManager::Get().LoadPrimaryAsset(Skill->GetPrimaryAssetId(), Bundles, OnLoaded);
+    }
+
+    // Asset Manager 不认识的资产（未扫描或临时创建的）直接按字段收集软引用加载
+    if (!Handle.IsValid())
+    {
+        TArray<FSoftObjectPath> Paths;
+        Skill->GatherBundleReferences(Bundles, Paths);
+        if (Paths.Num() > 0)
+        {
+            Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Paths, OnLoaded);
+        }
+    }
+
+    return Handle;
+}
+
+void UPoE2_AbilitySystemComponent::OnSkillAssetsLoaded(TWeakObjectPtr<USkillDataAsset> WeakSkill)
+{
+    USkillDataAsset* Skill = WeakSkill.Get();
+    if (!Skill)
+    {
+        return;
+    }
+
+    // 加载期间技能可能已被卸下；已完成的回调可能被重复触发
+    FActiveSkillLink* Link = EquippedSkills.FindByPredicate([Skill](const FActiveSkillLink& L) { return L.Skill == Skill; });
+    if (!Link || Link->bAssetsLoaded)
+    {
+        return;
+    }
+
+    Link->bAssetsLoaded = true;
+
+    // 加载前构建的缓存 Spec 缺少类引用
+    StatGraph.MarkConsumerDirty(Link->StatConsumer);
+
+    if (!IsOwnerActorAuthoritative())
+    {
+        return;
+    }
+
+    if (UClass* LoadedAbilityClass = Skill->AbilityClass.Get())
+    {
+        FGameplayAbilitySpec Spec(LoadedAbilityClass, 1, -1, Skill);
+        GiveAbility(Spec);
+    }
+    else if (!Skill->AbilityClass.IsNull())
+    {
+        UE_LOG(LogPoE2Framework, Error, TEXT("EquipSkill: Failed to load ability class %s for skill %s"),
+            *Skill->AbilityClass.ToString(), *Skill->SkillId.ToString());
+    }
+}
+
+void UPoE2_AbilitySystemComponent::InitAbilityActorInfo(AActor* InOwnerActor, AActor* InAvatarActor)
+{
+    AActor* PreviousAvatar = GetAvatarActor_Direct();
+
+    Super::InitAbilityActorInfo(InOwnerActor, InAvatarActor);
+
+    UPoE2TargetingSubsystem::UpdateAvatarTarget(GetWorld(), PreviousAvatar, InAvatarActor);
+
+    // 复制的技能 Spec 只带索引，索引在两端必须指向同一资产
+    const UPoE2SkillRegistry* Registry = UPoE2SkillRegistry::Get();
+    if (!bCatalogHashReported && Registry && !IsOwnerActorAuthoritative() && AbilityActorInfo.IsValid() && AbilityActorInfo->IsLocallyControlledPlayer())
+    {
+        bCatalogHashReported = true;
+        ServerVerifyCatalogHash(Registry->GetCatalogHash());
+    }
+}
+
+void UPoE2_AbilitySystemComponent::ServerVerifyCatalogHash_Implementation(int32 ClientCatalogHash)
+{
+    const UPoE2SkillRegistry* Registry = UPoE2SkillRegistry::Get();
+    const int32 ServerCatalogHash = Registry ? Registry->GetCatalogHash() : 0;
+    if (ClientCatalogHash == ServerCatalogHash)
+    {
+        return;
+    }
+
+    APlayerController* PlayerController = AbilityActorInfo.IsValid() ? AbilityActorInfo->PlayerController.Get() : nullptr;
+    UE_LOG(LogPoE2Framework, Error, TEXT("ServerVerifyCatalogHash: Client %s has skill catalog %08x, server has %08x; kicking"),
+        PlayerController ? *PlayerController->GetName() : TEXT("NULL"), ClientCatalogHash, ServerCatalogHash);
+
+    AGameModeBase* GameMode = GetWorld() ? GetWorld()->GetAuthGameMode() : nullptr;
+    if (PlayerController && GameMode && GameMode->GameSession)
+    {
+        GameMode->GameSession->KickPlayer(PlayerController, NSLOCTEXT("PoE2Framework", "SkillCatalogMismatch", "Your game content does not match the server's."));
+    }
+}
+
+void UPoE2_AbilitySystemComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    UPoE2TargetingSubsystem::UpdateAvatarTarget(GetWorld(), GetAvatarActor_Direct(), nullptr);
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void UPoE2_AbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+    Super::OnGiveAbility(AbilitySpec);
+
+    // 服务器在 EquipSkill 中已加载；客户端收到复制的能力后补齐本地资源包
+    if (IsOwnerActorAuthoritative())
+    {
+        return;
+    }
+
+    if (USkillDataAsset* Skill = Cast<USkillDataAsset>(AbilitySpec.SourceObject.Get()))
+    {
+        if (!ReplicatedSkillLoadHandles.Contains(Skill))
+        {
+            ReplicatedSkillLoadHandles.Add(Skill, RequestSkillBundles(Skill, FStreamableDelegate()));
+        }
+    }
+}
+
+void UPoE2_AbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+    if (const USkillDataAsset* Skill = Cast<USkillDataAsset>(AbilitySpec.SourceObject.Get()))
+    {
+        if (TSharedPtr<FStreamableHandle> Handle = ReplicatedSkillLoadHandles.FindRef(Skill))
+        {
+            Handle->ReleaseHandle();
+        }
+        ReplicatedSkillLoadHandles.Remove(Skill);
+    }
+
+    Super::OnRemoveAbility(AbilitySpec);
+}
+
 void UPoE2_AbilitySystemComponent::LinkSupportToSkill(USupportDataAsset* Support, USkillDataAsset* TargetSkill)
 {
     if(Support && TargetSkill)
     {
-        for (FActiveSkillLink& SkillLink : EquippedSkills)
+        FActiveSkillLink* SkillLink = EquippedSkills.FindByPredicate([TargetSkill](const FActiveSkillLink& L) { return L.Skill == TargetSkill; });
+        if (!SkillLink)
         {
-            if (SkillLink.Skill == TargetSkill)
-            {
-                SkillLink.LinkedSupports.AddUnique(Support);
-                break;
-            }
+            UE_LOG(LogPoE2Framework, Warning, TEXT("LinkSupportToSkill: %s is not equipped, %s not linked"), *TargetSkill->SkillId.ToString(), *Support->SupportId.ToString());
+            return;
         }
+
+        if (SkillLink->LinkedSupports.Contains(Support))
+        {
+            return;
+        }
+
+        // 与辅助宝石搜索同一规则：按已链接辅助合成后的 Spec 标签判断兼容性
+        FSkillSpec FoldedSpec;
+        FSkillSpecBuilder::Build(TargetSkill, GetPatchesForSkill(TargetSkill), FoldedSpec, false);
+        if (!Support->CanSupport(FoldedSpec))
+        {
+            UE_LOG(LogPoE2Framework, Warning, TEXT("LinkSupportToSkill: %s cannot support %s (tags %s)"),
+                *Support->SupportId.ToString(), *TargetSkill->SkillId.ToString(), *FoldedSpec.SkillTags.ToStringSimple());
+            return;
+        }
+
+        SkillLink->LinkedSupports.Add(Support);
+        StatGraph.MarkConsumerDirty(SkillLink->StatConsumer);
+    }
+}
+
+bool UPoE2_AbilitySystemComponent::GetSkillSpec(const USkillDataAsset* Skill, FSkillSpec& OutSpec)
+{
+    FActiveSkillLink* Link = Skill ? EquippedSkills.FindByPredicate([Skill](const FActiveSkillLink& L) { return L.Skill == Skill; }) : nullptr;
+    if (!Link)
+    {
+        return false;
     }
+
+    if (StatGraph.IsConsumerDirty(Link->StatConsumer))
+    {
+        RebuildSkillSpec(*Link);
+    }
+
+    OutSpec = Link->SharedSpec->Spec;
+    return true;
+}
+
+TSharedPtr<const FPoE2SharedSkillSpec> UPoE2_AbilitySystemComponent::FindSharedSkillSpec(const FSkillSpec& Spec)
+{
+    FActiveSkillLink* Link = EquippedSkills.FindByPredicate([&Spec](const FActiveSkillLink& L) { return L.SharedSpec.IsValid() && L.SharedSpec->Spec.SkillId == Spec.SkillId; });
+    if (!Link)
+    {
+        return nullptr;
+    }
+
+    if (StatGraph.IsConsumerDirty(Link->StatConsumer))
+    {
+        RebuildSkillSpec(*Link);
+    }
+
+    // 蓝图可能传入改过的 Spec，这种情况只能用快照；哈希只用于快速排除，相同时再逐字段确认
+    const FSkillSpec& LiveSpec = Link->SharedSpec->Spec;
+    if (LiveSpec.GetCacheHash() != Spec.GetCacheHash() || LiveSpec != Spec)
+    {
+        return nullptr;
+    }
+    return Link->SharedSpec;
+}
+
+void UPoE2_AbilitySystemComponent::UpdateSharedSkillSpec(const FPoE2SharedSkillSpec& Shared)
+{
+    if (Shared.StatConsumer == INDEX_NONE || !StatGraph.IsConsumerDirty(Shared.StatConsumer))
+    {
+        return;
+    }
+
+    FActiveSkillLink* Link = EquippedSkills.FindByPredicate([&Shared](const FActiveSkillLink& L) { return L.SharedSpec.Get() == &Shared; });
+    if (Link)
+    {
+        RebuildSkillSpec(*Link);
+    }
+}
+
+void UPoE2_AbilitySystemComponent::RebuildSkillSpec(FActiveSkillLink& Link)
+{
+    if (Link.StatConsumer == INDEX_NONE)
+    {
+        Link.StatConsumer = StatGraph.AddConsumer();
+    }
+    if (!Link.SharedSpec.IsValid())
+    {
+        Link.SharedSpec = MakeShared<FPoE2SharedSkillSpec>();
+    }
+    Link.SharedSpec->StatConsumer = Link.StatConsumer;
+
+    // 原地重建：持有共享 Spec 的承载体读到的始终是同一个对象
+    FSkillSpec& CachedSpec = Link.SharedSpec->Spec;
+
+    // 1. 辅助宝石 Patch 合成（先不冻结管线，属性只改数值）
+    FSkillSpecBuilder::Build(Link.Skill, GetPatchesForSkill(Link.Skill), CachedSpec, false);
+
+    // 2. 物品技能修正：按应用辅助后的标签匹配，并记下标签供物品增删时判断
+    Link.ModifierTarget = FPoE2SkillModifierTarget::FromSpec(CachedSpec);
+    if (SkillModifiers.Apply(CachedSpec) > 0)
+    {
+        CachedSpec.CompileHitConditions();
+    }
+
+    // 3. 依赖只包括技能拥有的数值字段；辅助或物品改变了字段集合时依赖随之更新
+    TArray<FName> SpecStats;
+    FPoE2StatGraph::GetSpecStats(CachedSpec, SpecStats);
+    StatGraph.SetConsumerStats(Link.StatConsumer, SpecStats);
+
+    // 4. 叠加角色属性并冻结处理器管线
+    StatGraph.ApplyToSpec(CachedSpec);
+    CachedSpec.FreezeHandlerPipeline();
+
+    StatGraph.ClearConsumerDirty(Link.StatConsumer);
+    ++Link.SharedSpec->Version;
+}
+
+FPoE2StatSourceHandle UPoE2_AbilitySystemComponent::AddStatSource(const TArray<FPoE2StatModifier>& Modifiers)
+{
+    return StatGraph.AddSource(Modifiers);
+}
+
+void UPoE2_AbilitySystemComponent::RemoveStatSource(FPoE2StatSourceHandle& Source)
+{
+    StatGraph.RemoveSource(Source);
+    Source.Reset();
+}
+
+float UPoE2_AbilitySystemComponent::GetStatValue(FName Stat) const
+{
+    return StatGraph.GetValue(Stat);
+}
+
+FPoE2SkillModifierSourceHandle UPoE2_AbilitySystemComponent::AddSkillModifierSource(const TArray<FPoE2SkillModifier>& Modifiers)
+{
+    const FPoE2SkillModifierSourceHandle Source = SkillModifiers.AddSource(Modifiers);
+    MarkSkillsAffectedBy(Source);
+    return Source;
+}
+
+void UPoE2_AbilitySystemComponent::RemoveSkillModifierSource(FPoE2SkillModifierSourceHandle& Source)
+{
+    // 移除前判断：之后已无从得知它影响了哪些技能
+    MarkSkillsAffectedBy(Source);
+    SkillModifiers.RemoveSource(Source);
+    Source.Reset();
+}
+
+void UPoE2_AbilitySystemComponent::MarkSkillsAffectedBy(FPoE2SkillModifierSourceHandle Source)
+{
+    for (const FActiveSkillLink& Link : EquippedSkills)
+    {
+        // 已脏的技能重建时自然会看到变化
+        if (Link.StatConsumer != INDEX_NONE && !StatGraph.IsConsumerDirty(Link.StatConsumer) && SkillModifiers.Affects(Source, Link.ModifierTarget))
+        {
+            StatGraph.MarkConsumerDirty(Link.StatConsumer);
+        }
+    }
+}
+
+void UPoE2_AbilitySystemComponent::SetPassiveClassStart(const UPassiveSkillDataAsset* ClassStart)
+{
+    if (!IsOwnerActorAuthoritative() || PassiveClassStart == ClassStart)
+    {
+        return;
+    }
+
+    // 旧职业的天赋无法连回新起点
+    PassiveClassStart = ClassStart;
+    PassiveTreeState.Reset(StatGraph);
+}
+
+void UPoE2_AbilitySystemComponent::SetPassivePoints(int32 Points)
+{
+    if (IsOwnerActorAuthoritative())
+    {
+        PassivePoints = FMath::Max(Points, 0);
+    }
+}
+
+int32 UPoE2_AbilitySystemComponent::GetUnspentPassivePoints() const
+{
+    return FMath::Max(PassivePoints - PassiveTreeState.GetSpentPoints(), 0);
+}
+
+bool UPoE2_AbilitySystemComponent::AllocatePassive(const UPassiveTreeDataAsset* Tree, const UPassiveSkillDataAsset* Node)
+{
+    if (!IsOwnerActorAuthoritative())
+    {
+        return false;
+    }
+
+    const TSharedPtr<const FPoE2PassiveTree> CompiledTree = Tree ? Tree->GetCompiledTree() : nullptr;
+    return CompiledTree.IsValid() && PassiveTreeState.AllocatePath(CompiledTree, CompiledTree->FindNode(PassiveClassStart), CompiledTree->FindNode(Node), StatGraph, PassivePoints);
+}
+
+bool UPoE2_AbilitySystemComponent::DeallocatePassive(const UPassiveSkillDataAsset* Node)
+{
+    if (!IsOwnerActorAuthoritative())
+    {
+        return false;
+    }
+
+    const TSharedPtr<const FPoE2PassiveTree>& CompiledTree = PassiveTreeState.GetTree();
+    return CompiledTree.IsValid() && PassiveTreeState.Deallocate(CompiledTree->FindNode(Node), StatGraph);
+}
+
+bool UPoE2_AbilitySystemComponent::IsPassiveAllocated(const UPassiveSkillDataAsset* Node) const
+{
+    const TSharedPtr<const FPoE2PassiveTree>& CompiledTree = PassiveTreeState.GetTree();
+    return CompiledTree.IsValid() && PassiveTreeState.GetAllocation().Contains(CompiledTree->FindNode(Node));
+}
+
+void UPoE2_AbilitySystemComponent::ResetPassives()
+{
+    if (IsOwnerActorAuthoritative())
+    {
+        PassiveTreeState.Reset(StatGraph);
+    }
+}
+
+bool UPoE2_AbilitySystemComponent::SetPassiveAllocation(const UPassiveTreeDataAsset* Tree, const FPoE2PassiveAllocation& Allocation)
+{
+    if (!IsOwnerActorAuthoritative())
+    {
+        return false;
+    }
+
+    const TSharedPtr<const FPoE2PassiveTree> CompiledTree = Tree ? Tree->GetCompiledTree() : nullptr;
+    return CompiledTree.IsValid() && PassiveTreeState.SetAllocation(CompiledTree, CompiledTree->FindNode(PassiveClassStart), Allocation, StatGraph, PassivePoints);
 }
@@ -0,0 +1,47 @@
+#include "Attributes/AttributeSet_Combat.h"
+#include "Net/UnrealNetwork.h"
+
+UAttributeSet_Combat::UAttributeSet_Combat()
+{
+    Armour = 0.0f;
+    FireResistance = 0.0f;
+    ColdResistance = 0.0f;
+    LightningResistance = 0.0f;
+    ChaosResistance = 0.0f;
+}
+
+void UAttributeSet_Combat::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME_CONDITION_NOTIFY(UAttributeSet_Combat, Armour, COND_None, REPNOTIFY_Always);
+    DOREPLIFETIME_CONDITION_NOTIFY(UAttributeSet_Combat, FireResistance, COND_None, REPNOTIFY_Always);
+    DOREPLIFETIME_CONDITION_NOTIFY(UAttributeSet_Combat, ColdResistance, COND_None, REPNOTIFY_Always);
+    DOREPLIFETIME_CONDITION_NOTIFY(UAttributeSet_Combat, LightningResistance, COND_None, REPNOTIFY_Always);
+    DOREPLIFETIME_CONDITION_NOTIFY(UAttributeSet_Combat, ChaosResistance, COND_None, REPNOTIFY_Always);
+}
+
+void UAttributeSet_Combat::OnRep_Armour(const FGameplayAttributeData& OldArmour)
+{
+    GAMEPLAYATTRIBUTE_REPNOTIFY(UAttributeSet_Combat, Armour, OldArmour);
+}
+
+void UAttributeSet_Combat::OnRep_FireResistance(const FGameplayAttributeData& OldFireResistance)
+{
+    GAMEPLAYATTRIBUTE_REPNOTIFY(UAttributeSet_Combat, FireResistance, OldFireResistance);
+}
+
+void UAttributeSet_Combat::OnRep_ColdResistance(const FGameplayAttributeData& OldColdResistance)
+{
+    GAMEPLAYATTRIBUTE_REPNOTIFY(UAttributeSet_Combat, ColdResistance, OldColdResistance);
+}
+
+void UAttributeSet_Combat::OnRep_LightningResistance(const FGameplayAttributeData& OldLightningResistance)
+{
+    GAMEPLAYATTRIBUTE_REPNOTIFY(UAttributeSet_Combat, LightningResistance, OldLightningResistance);
+}
+
+void UAttributeSet_Combat::OnRep_ChaosResistance(const FGameplayAttributeData& OldChaosResistance)
+{
+    GAMEPLAYATTRIBUTE_REPNOTIFY(UAttributeSet_Combat, ChaosResistance, OldChaosResistance);
+}
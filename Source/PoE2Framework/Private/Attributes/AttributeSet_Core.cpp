@@ -6,6 +6,7 @@
 #include "Net/UnrealNetwork.h"
 #include "GameplayEffectExtension.h"
 #include "Core/PoE2Log.h"
+#include "Attributes/PoE2LazyAttributeSetProvider.h"
 
 UAttributeSet_Core::UAttributeSet_Core()
 {
@@ -21,6 +22,33 @@ void UAttributeSet_Core::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& O
     DOREPLIFETIME_CONDITION_NOTIFY(UAttributeSet_Core, MaxHealth, COND_None, REPNOTIFY_Always);
 }
 
+bool UAttributeSet_Core::GetLife(const UAbilitySystemComponent* ASC, float& OutLife, float& OutMaxLife)
+{
+    if (!ASC)
+    {
+        return false;
+    }
+
+    if (ASC->HasAttributeSetForAttribute(GetHealthAttribute()))
+    {
+        OutLife = ASC->GetNumericAttribute(GetHealthAttribute());
+        OutMaxLife = ASC->GetNumericAttribute(GetMaxHealthAttribute());
+        return true;
+    }
+
+    // A lazy ASC gets its set on the first effect that needs it; until then it is untouched
+    const IPoE2LazyAttributeSetProvider* LazyProvider = Cast<const IPoE2LazyAttributeSetProvider>(ASC);
+    const UAttributeSet_Core* Defaults = LazyProvider ? Cast<UAttributeSet_Core>(LazyProvider->GetLazyAttributeSetDefaults(StaticClass())) : nullptr;
+    if (!Defaults)
+    {
+        return false;
+    }
+
+    OutLife = Defaults->GetHealth();
+    OutMaxLife = Defaults->GetMaxHealth();
+    return true;
+}
+
 void UAttributeSet_Core::PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue)
 {
     Super::PreAttributeChange(Attribute, NewValue);
@@ -51,7 +79,9 @@ void UAttributeSet_Core::OnRep_Health(const FGameplayAttributeData& OldHealth)
 {
     GAMEPLAYATTRIBUTE_REPNOTIFY(UAttributeSet_Core, Health, OldHealth);
 
+#if POE2_LOG_ATTRIBUTE_REPNOTIFY
     UE_LOG(LogPoE2Framework, Log, TEXT("Health changed from %.2f to %.2f"), OldHealth.GetCurrentValue(), GetHealth());
+#endif
 }
 
 void UAttributeSet_Core::OnRep_MaxHealth(const FGameplayAttributeData& OldMaxHealth)
@@ -64,5 +94,7 @@ void UAttributeSet_Core::OnRep_MaxHealth(const FGameplayAttributeData& OldMaxHea
         SetHealth(GetMaxHealth());
     }
 
+#if POE2_LOG_ATTRIBUTE_REPNOTIFY
     UE_LOG(LogPoE2Framework, Log, TEXT("MaxHealth changed from %.2f to %.2f"), OldMaxHealth.GetCurrentValue(), GetMaxHealth());
+#endif
 }
\ No newline at end of file
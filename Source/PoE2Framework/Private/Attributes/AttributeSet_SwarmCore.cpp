@@ -0,0 +1,70 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Attributes/AttributeSet_SwarmCore.h"
+#include "Net/UnrealNetwork.h"
+
+void UAttributeSet_SwarmCore::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    // Health travels as QuantizedHealth; MaxHealth barely changes, so only notify when it does
+    DISABLE_REPLICATED_PROPERTY(UAttributeSet_Core, Health);
+
+    FDoRepLifetimeParams MaxHealthParams;
+    MaxHealthParams.RepNotifyCondition = REPNOTIFY_OnChanged;
+    RESET_REPLIFETIME_WITH_PARAMS(UAttributeSet_Core, MaxHealth, MaxHealthParams);
+
+    DOREPLIFETIME(UAttributeSet_SwarmCore, QuantizedHealth);
+}
+
+void UAttributeSet_SwarmCore::PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue)
+{
+    Super::PostAttributeChange(Attribute, OldValue, NewValue);
+
+    if (Attribute == GetHealthAttribute() || Attribute == GetMaxHealthAttribute())
+    {
+        QuantizedHealth = QuantizeHealth(GetHealth(), GetMaxHealth());
+    }
+}
+
+uint8 UAttributeSet_SwarmCore::QuantizeHealth(float Health, float MaxHealth)
+{
+    if (Health <= 0.0f || MaxHealth <= 0.0f)
+    {
+        return 0;
+    }
+
+    // Round up so a sliver of life never replicates as dead
+    const float Fraction = FMath::Min(Health / MaxHealth, 1.0f);
+    return static_cast<uint8>(FMath::Clamp(FMath::CeilToInt32(Fraction * MAX_uint8), 1, static_cast<int32>(MAX_uint8)));
+}
+
+float UAttributeSet_SwarmCore::DequantizeHealth(uint8 Quantized, float MaxHealth)
+{
+    return MaxHealth * static_cast<float>(Quantized) / static_cast<float>(MAX_uint8);
+}
+
+void UAttributeSet_SwarmCore::OnRep_MaxHealth(const FGameplayAttributeData& OldMaxHealth)
+{
+    GAMEPLAYATTRIBUTE_REPNOTIFY(UAttributeSet_Core, MaxHealth, OldMaxHealth);
+
+    // Health is a fraction of MaxHealth, so it moves with it
+    ApplyQuantizedHealth();
+}
+
+void UAttributeSet_SwarmCore::OnRep_QuantizedHealth()
+{
+    ApplyQuantizedHealth();
+}
+
+void UAttributeSet_SwarmCore::ApplyQuantizedHealth()
+{
+    const FGameplayAttributeData OldHealth = Health;
+    const float NewHealth = DequantizeHealth(QuantizedHealth, GetMaxHealth());
+    Health.SetBaseValue(NewHealth);
+    Health.SetCurrentValue(NewHealth);
+
+    GAMEPLAYATTRIBUTE_REPNOTIFY(UAttributeSet_Core, Health, OldHealth);
+}
@@ -0,0 +1,171 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Core/PoE2TagBits.h"
+#include "Core/PoE2Tags.h"
+#include "Core/PoE2Log.h"
+#include "Spec/SkillSpec.h"
+#include "GameplayTagsManager.h"
+
+FPoE2TagBitTable FPoE2TagBitTable::Table;
+
+namespace
+{
+    void GatherSubtree(const TSharedPtr<FGameplayTagNode>& Node, TArray<FGameplayTag>& OutTags)
+    {
+        if (!Node.IsValid())
+        {
+            return;
+        }
+
+        OutTags.Add(Node->GetCompleteTag());
+        for (const TSharedPtr<FGameplayTagNode>& Child : Node->GetChildTagNodes())
+        {
+            GatherSubtree(Child, OutTags);
+        }
+    }
+}
+
+void FPoE2TagBitTable::Initialize()
+{
+    UGameplayTagsManager& Manager = UGameplayTagsManager::Get();
+    Manager.CallOrRegister_OnDoneAddingNativeTagsDelegate(FSimpleMulticastDelegate::FDelegate::CreateLambda([]()
+    {
+        Table.Rebuild();
+    }));
+
+#if WITH_EDITOR
+    // Tags added in the editor renumber the bits; specs built before that fall back to their containers
+    Manager.OnEditorRefreshGameplayTagTree.AddLambda([]()
+    {
+        Table.Rebuild();
+    });
+#endif
+}
+
+void FPoE2TagBitTable::Rebuild()
+{
+    static uint32 GenerationCounter = 0;
+
+    const FPoE2Tags& NativeTags = FPoE2Tags::Get();
+    const UGameplayTagsManager& Manager = UGameplayTagsManager::Get();
+
+    TArray<FGameplayTag> Tags;
+    for (const FGameplayTag& Root : { NativeTags.Ability, NativeTags.Damage, NativeTags.Mechanic, NativeTags.Status })
+    {
+        GatherSubtree(Manager.FindTagNode(Root), Tags);
+    }
+    Tags.Sort([](const FGameplayTag& A, const FGameplayTag& B) { return A.GetTagName().LexicalLess(B.GetTagName()); });
+
+    BitTags.Reset();
+    DescendantMasks.Reset();
+    TagToBit.Reset();
+
+    if (Tags.Num() > FPoE2TagBits::NumBits)
+    {
+        Generation = 0;
+        UE_LOG(LogPoE2Framework, Warning, TEXT("FPoE2TagBitTable: %d tags under the mapped roots exceed %d bits, tag checks use containers"),
+            Tags.Num(), FPoE2TagBits::NumBits);
+        return;
+    }
+
+    BitTags = MoveTemp(Tags);
+    DescendantMasks.SetNum(BitTags.Num());
+    for (int32 Bit = 0; Bit < BitTags.Num(); ++Bit)
+    {
+        TagToBit.Add(BitTags[Bit], Bit);
+        for (int32 Other = 0; Other < BitTags.Num(); ++Other)
+        {
+            if (BitTags[Other].MatchesTag(BitTags[Bit]))
+            {
+                DescendantMasks[Bit].SetBit(Other);
+            }
+        }
+    }
+
+    Generation = ++GenerationCounter;
+    UE_LOG(LogPoE2Framework, Log, TEXT("FPoE2TagBitTable: mapped %d tags"), BitTags.Num());
+}
+
+int32 FPoE2TagBitTable::FindBit(const FGameplayTag& Tag) const
+{
+    const int32* Bit = TagToBit.Find(Tag);
+    return Bit ? *Bit : INDEX_NONE;
+}
+
+FPoE2TagBits FPoE2TagBitTable::FromContainer(const FGameplayTagContainer& Tags, bool* bOutAllMapped) const
+{
+    FPoE2TagBits Bits;
+    bool bAllMapped = true;
+    for (const FGameplayTag& Tag : Tags)
+    {
+        const int32 Bit = FindBit(Tag);
+        if (Bit == INDEX_NONE)
+        {
+            bAllMapped = false;
+            continue;
+        }
+        Bits.SetBit(Bit);
+    }
+
+    if (bOutAllMapped)
+    {
+        *bOutAllMapped = bAllMapped;
+    }
+    return Bits;
+}
+
+FPoE2TagQuery FPoE2TagQuery::Compile(const FGameplayTagContainer& RequiredTags, const FGameplayTagContainer& ExcludedTags)
+{
+    const FPoE2TagBitTable& Table = FPoE2TagBitTable::Get();
+
+    FPoE2TagQuery Query;
+    Query.Required = RequiredTags;
+    Query.Excluded = ExcludedTags;
+
+    bool bAllMapped = Table.IsComplete();
+    for (const FGameplayTag& Tag : RequiredTags)
+    {
+        const int32 Bit = Table.FindBit(Tag);
+        bAllMapped &= Bit != INDEX_NONE;
+        if (Bit != INDEX_NONE)
+        {
+            Query.RequiredMasks.Add(Table.GetDescendantMask(Bit));
+        }
+    }
+    for (const FGameplayTag& Tag : ExcludedTags)
+    {
+        const int32 Bit = Table.FindBit(Tag);
+        bAllMapped &= Bit != INDEX_NONE;
+        if (Bit != INDEX_NONE)
+        {
+            Query.ExcludedMask.Append(Table.GetDescendantMask(Bit));
+        }
+    }
+
+    Query.Generation = bAllMapped ? Table.GetGeneration() : 0;
+    return Query;
+}
+
+bool FPoE2TagQuery::Matches(const FSkillSpec& Spec) const
+{
+    return Matches(Spec.SkillTags, Spec.TagBits, Spec.TagBitsGeneration);
+}
+
+bool FPoE2TagQuery::Matches(const FGameplayTagContainer& Tags, const FPoE2TagBits& Bits, uint32 BitsGeneration) const
+{
+    if (Generation == 0 || BitsGeneration != Generation)
+    {
+        return Tags.HasAll(Required) && !Tags.HasAny(Excluded);
+    }
+
+    for (const FPoE2TagBits& Mask : RequiredMasks)
+    {
+        if (!Bits.HasAny(Mask))
+        {
+            return false;
+        }
+    }
+    return !Bits.HasAny(ExcludedMask);
+}
@@ -0,0 +1,6 @@
+#include "Data/AffixDataAsset.h"
+
+FPrimaryAssetId UAffixDataAsset::GetPrimaryAssetId() const
+{
+    return FPrimaryAssetId(TEXT("Affix"), GetFName());
+}
@@ -0,0 +1,6 @@
+#include "Data/ItemBaseDataAsset.h"
+
+FPrimaryAssetId UItemBaseDataAsset::GetPrimaryAssetId() const
+{
+    return FPrimaryAssetId(TEXT("ItemBase"), GetFName());
+}
@@ -0,0 +1,12 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#include "Data/Mechanics/DotParameterDataAsset.h"
+#include "AbilitySystem/Handlers/Mechanic_DOT.h"
+
+void UDotParameterDataAsset::ContributeToParameterMap(TMap<FName, float>& InOutMap) const
+{
+    InOutMap.Add(UMechanic_DOT::DamagePerSecondKey, DamagePerSecond);
+    InOutMap.Add(UMechanic_DOT::DurationKey, Duration);
+    InOutMap.Add(UMechanic_DOT::StrongestOnlyKey, bStrongestOnly ? 1.0f : 0.0f);
+}
@@ -0,0 +1,6 @@
+#include "Data/PassiveSkillDataAsset.h"
+
+FPrimaryAssetId UPassiveSkillDataAsset::GetPrimaryAssetId() const
+{
+    return FPrimaryAssetId(TEXT("Passive"), GetFName());
+}
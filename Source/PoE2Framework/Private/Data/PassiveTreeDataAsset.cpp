@@ -0,0 +1,37 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Data/PassiveTreeDataAsset.h"
+#include "Data/PassiveSkillDataAsset.h"
+#include "Data/PoE2PassiveTree.h"
+
+FPrimaryAssetId UPassiveTreeDataAsset::GetPrimaryAssetId() const
+{
+    return FPrimaryAssetId(TEXT("PassiveTree"), GetFName());
+}
+
+#if WITH_EDITOR
+void UPassiveTreeDataAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    // Characters keep the tree they allocated on; new allocations pick up the edit
+    CompiledTree.Reset();
+}
+#endif
+
+TSharedPtr<const FPoE2PassiveTree> UPassiveTreeDataAsset::GetCompiledTree() const
+{
+    if (!CompiledTree.IsValid())
+    {
+        TArray<const UPassiveSkillDataAsset*> NodeList;
+        NodeList.Reserve(Nodes.Num());
+        for (const UPassiveSkillDataAsset* Node : Nodes)
+        {
+            NodeList.Add(Node);
+        }
+        CompiledTree = FPoE2PassiveTree::Compile(NodeList);
+    }
+    return CompiledTree;
+}
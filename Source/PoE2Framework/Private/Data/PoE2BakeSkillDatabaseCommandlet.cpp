@@ -0,0 +1,90 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Data/PoE2BakeSkillDatabaseCommandlet.h"
+#include "Data/PoE2SkillDatabase.h"
+#include "Data/SkillDataAsset.h"
+#include "Data/SupportDataAsset.h"
+#include "Spec/SkillSpec.h"
+#include "Engine/AssetManager.h"
+#include "Misc/FileHelper.h"
+#include "Core/PoE2Log.h"
+
+namespace
+{
+    template<typename AssetType>
+    void LoadPrimaryAssetsOfType(FPrimaryAssetType PrimaryAssetType, TArray<const AssetType*>& OutAssets)
+    {
+        TArray<FAssetData> AssetDatas;
+        UAssetManager::Get().GetPrimaryAssetDataList(PrimaryAssetType, AssetDatas);
+
+        for (const FAssetData& AssetData : AssetDatas)
+        {
+            if (const AssetType* Asset = Cast<AssetType>(AssetData.GetAsset()))
+            {
+                OutAssets.Add(Asset);
+            }
+        }
+    }
+}
+
+UPoE2BakeSkillDatabaseCommandlet::UPoE2BakeSkillDatabaseCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UPoE2BakeSkillDatabaseCommandlet::Main(const FString& Params)
+{
+    FString OutputPath = FPoE2SkillDatabase::GetDefaultPath();
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+    // Same primary asset lists the registry scans, so the baked indices match the clients'
+    TArray<const USkillDataAsset*> Skills;
+    TArray<const USupportDataAsset*> Supports;
+    LoadPrimaryAssetsOfType(FPrimaryAssetType(TEXT("Skill")), Skills);
+    LoadPrimaryAssetsOfType(FPrimaryAssetType(TEXT("Support")), Supports);
+
+    TArray64<uint8> Bytes;
+    FPoE2SkillDatabase::Bake(Skills, Supports, Bytes);
+
+    // Read it back and check every skill against the asset it came from
+    FPoE2SkillDatabase Database;
+    if (!Database.OpenFromMemory(TArray64<uint8>(Bytes)))
+    {
+        UE_LOG(LogPoE2Framework, Error, TEXT("PoE2BakeSkillDatabase: The baked image failed validation"));
+        return 1;
+    }
+
+    int32 Mismatches = 0;
+    for (const USkillDataAsset* Skill : Skills)
+    {
+        const FSkillSpec Expected = Skill->CreateBaseSkillSpec();
+        const FPoE2AssetIndex Index = Database.GetSkillCatalog().FindByAssetId(Skill->GetPrimaryAssetId());
+
+        FSkillSpec Baked;
+        if (!Database.BuildBaseSpec(Index, Baked) || Baked.FinalDamage != Expected.FinalDamage || Baked.SkillTags != Expected.SkillTags
+            || Baked.CustomParams.Num() != Expected.CustomParams.Num())
+        {
+            UE_LOG(LogPoE2Framework, Error, TEXT("PoE2BakeSkillDatabase: %s does not round-trip"), *Skill->GetPathName());
+            ++Mismatches;
+        }
+    }
+    if (Mismatches > 0)
+    {
+        return 1;
+    }
+
+    if (!FFileHelper::SaveArrayToFile(Bytes, *OutputPath))
+    {
+        UE_LOG(LogPoE2Framework, Error, TEXT("PoE2BakeSkillDatabase: Failed to write %s"), *OutputPath);
+        return 1;
+    }
+
+    UE_LOG(LogPoE2Framework, Display, TEXT("PoE2BakeSkillDatabase: %d skills, %d supports, %lld bytes -> %s"),
+        Skills.Num(), Supports.Num(), Bytes.Num(), *OutputPath);
+    return 0;
+}
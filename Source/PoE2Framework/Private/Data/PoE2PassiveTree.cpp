@@ -0,0 +1,297 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Data/PoE2PassiveTree.h"
+#include "Data/PassiveSkillDataAsset.h"
+#include "Stats/PoE2StatGraph.h"
+#include "Core/PoE2Log.h"
+#include "Algo/Reverse.h"
+
+TSharedPtr<const FPoE2PassiveTree> FPoE2PassiveTree::Compile(TConstArrayView<const UPassiveSkillDataAsset*> Nodes)
+{
+    TSharedRef<FPoE2PassiveTree> Tree = MakeShared<FPoE2PassiveTree>();
+
+    for (const UPassiveSkillDataAsset* Node : Nodes)
+    {
+        if (Node && !Tree->NodeIndices.Contains(Node))
+        {
+            Tree->NodeIndices.Add(Node, Tree->NodeAssets.Add(Node));
+        }
+    }
+
+    const int32 NumNodes = Tree->NodeAssets.Num();
+    if (NumNodes > FPoE2PassiveAllocation::MaxNodes)
+    {
+        UE_LOG(LogPoE2Framework, Error, TEXT("FPoE2PassiveTree: %d nodes exceed the limit of %d"), NumNodes, FPoE2PassiveAllocation::MaxNodes);
+        return nullptr;
+    }
+
+    // Symmetrize the edges, then lay each node's sorted neighbour list out contiguously
+    TArray<TArray<uint16>> Neighbours;
+    Neighbours.SetNum(NumNodes);
+    for (int32 Index = 0; Index < NumNodes; ++Index)
+    {
+        const UPassiveSkillDataAsset* Node = Tree->NodeAssets[Index].Get();
+        for (const UPassiveSkillDataAsset* Connected : Node->ConnectedNodes)
+        {
+            const int32 Other = Tree->FindNode(Connected);
+            if (Other == INDEX_NONE || Other == Index)
+            {
+                continue;
+            }
+            Neighbours[Index].AddUnique(static_cast<uint16>(Other));
+            Neighbours[Other].AddUnique(static_cast<uint16>(Index));
+        }
+
+        if (Node->bIsStartNode)
+        {
+            Tree->StartNodes.Add(Index);
+        }
+    }
+
+    Tree->AdjacencyOffsets.Reserve(NumNodes + 1);
+    Tree->ModifierOffsets.Reserve(NumNodes + 1);
+    for (int32 Index = 0; Index < NumNodes; ++Index)
+    {
+        Neighbours[Index].Sort();
+        Tree->AdjacencyOffsets.Add(Tree->Adjacency.Num());
+        Tree->Adjacency.Append(Neighbours[Index]);
+
+        Tree->ModifierOffsets.Add(Tree->Modifiers.Num());
+        Tree->Modifiers.Append(Tree->NodeAssets[Index]->StatModifiers);
+    }
+    Tree->AdjacencyOffsets.Add(Tree->Adjacency.Num());
+    Tree->ModifierOffsets.Add(Tree->Modifiers.Num());
+
+    return Tree;
+}
+
+int32 FPoE2PassiveTree::FindNode(const UPassiveSkillDataAsset* Node) const
+{
+    const int32* Index = NodeIndices.Find(Node);
+    return Index ? *Index : INDEX_NONE;
+}
+
+void FPoE2PassiveTree::Expand(const FPoE2PassiveAllocation& Frontier, FPoE2PassiveAllocation& OutNeighbours) const
+{
+    Frontier.ForEachNode([this, &OutNeighbours](int32 Node)
+    {
+        for (const uint16 Neighbour : GetNeighbours(Node))
+        {
+            OutNeighbours.Add(Neighbour);
+        }
+    });
+}
+
+bool FPoE2PassiveTree::IsConnected(const FPoE2PassiveAllocation& Allocated, int32 StartNode) const
+{
+    if (!StartNodes.Contains(StartNode) || !Allocated.Contains(StartNode))
+    {
+        return false;
+    }
+
+    // Other classes' starts are roots only for their own characters
+    FPoE2PassiveAllocation OtherStarts = StartNodes;
+    OtherStarts.Remove(StartNode);
+    OtherStarts.Intersect(Allocated);
+    if (!OtherStarts.IsEmpty())
+    {
+        return false;
+    }
+
+    FPoE2PassiveAllocation Reached;
+    Reached.Add(StartNode);
+    FPoE2PassiveAllocation Frontier = Reached;
+
+    while (!Frontier.IsEmpty())
+    {
+        FPoE2PassiveAllocation Next;
+        Expand(Frontier, Next);
+        Next.Intersect(Allocated);
+        Next.Subtract(Reached);
+        Reached.Union(Next);
+        Frontier = Next;
+    }
+
+    return Reached == Allocated;
+}
+
+bool FPoE2PassiveTree::CanDeallocate(const FPoE2PassiveAllocation& Allocated, int32 StartNode, int32 Node) const
+{
+    if (!Allocated.Contains(Node) || StartNodes.Contains(Node))
+    {
+        return false;
+    }
+
+    FPoE2PassiveAllocation Remaining = Allocated;
+    Remaining.Remove(Node);
+    return IsConnected(Remaining, StartNode);
+}
+
+bool FPoE2PassiveTree::FindPath(const FPoE2PassiveAllocation& Allocated, int32 StartNode, int32 Target, TArray<int32>& OutPath) const
+{
+    OutPath.Reset();
+    if (Target < 0 || Target >= Num() || !StartNodes.Contains(StartNode))
+    {
+        return false;
+    }
+    if (Allocated.Contains(Target))
+    {
+        return true;
+    }
+    if (Allocated.IsEmpty() && Target == StartNode)
+    {
+        OutPath.Add(Target);
+        return true;
+    }
+
+    // Multi-source BFS outwards from the allocation; Parent records the BFS tree for the walk back.
+    // Other class starts are pre-visited so no path runs through (or ends at) one.
+    FPoE2PassiveAllocation Frontier = Allocated;
+    if (Frontier.IsEmpty())
+    {
+        Frontier.Add(StartNode);
+    }
+    FPoE2PassiveAllocation Visited = StartNodes;
+    Visited.Union(Frontier);
+    if (StartNodes.Contains(Target) && !Frontier.Contains(Target))
+    {
+        return false;
+    }
+
+    TArray<int32> Parent;
+    Parent.Init(INDEX_NONE, Num());
+
+    while (!Frontier.IsEmpty() && !Visited.Contains(Target))
+    {
+        FPoE2PassiveAllocation Next;
+        Frontier.ForEachNode([this, &Visited, &Next, &Parent](int32 Node)
+        {
+            for (const uint16 Neighbour : GetNeighbours(Node))
+            {
+                if (!Visited.Contains(Neighbour))
+                {
+                    Visited.Add(Neighbour);
+                    Next.Add(Neighbour);
+                    Parent[Neighbour] = Node;
+                }
+            }
+        });
+        Frontier = Next;
+    }
+
+    if (!Visited.Contains(Target))
+    {
+        return false;
+    }
+
+    for (int32 Node = Target; Node != INDEX_NONE && !Allocated.Contains(Node); Node = Parent[Node])
+    {
+        OutPath.Add(Node);
+    }
+    Algo::Reverse(OutPath);
+    return true;
+}
+
+void FPoE2PassiveTree::Diff(const FPoE2PassiveAllocation& From, const FPoE2PassiveAllocation& To, FPoE2PassiveAllocation& OutAdded, FPoE2PassiveAllocation& OutRemoved)
+{
+    OutAdded = To;
+    OutAdded.Subtract(From);
+    OutRemoved = From;
+    OutRemoved.Subtract(To);
+}
+
+bool FPoE2PassiveTreeState::SetAllocation(const TSharedPtr<const FPoE2PassiveTree>& InTree, int32 InStartNode, const FPoE2PassiveAllocation& NewAllocation, FPoE2StatGraph& Graph, int32 MaxPoints)
+{
+    if (!InTree.IsValid() || !InTree->GetStartNodes().Contains(InStartNode))
+    {
+        return false;
+    }
+
+    FPoE2PassiveAllocation Target = NewAllocation;
+    Target.Add(InStartNode);
+    if (Target.Num() - 1 > MaxPoints || !InTree->IsConnected(Target, InStartNode))
+    {
+        return false;
+    }
+
+    if (Tree != InTree || StartNode != InStartNode)
+    {
+        Reset(Graph);
+        Tree = InTree;
+        StartNode = InStartNode;
+    }
+
+    FPoE2PassiveAllocation Added;
+    FPoE2PassiveAllocation Removed;
+    FPoE2PassiveTree::Diff(Allocation, Target, Added, Removed);
+
+    Removed.ForEachNode([this, &Graph](int32 Node)
+    {
+        FPoE2StatSourceHandle Source;
+        if (NodeSources.RemoveAndCopyValue(Node, Source))
+        {
+            Graph.RemoveSource(Source);
+        }
+    });
+
+    Added.ForEachNode([this, &Graph](int32 Node)
+    {
+        const TConstArrayView<FPoE2StatModifier> NodeModifiers = Tree->GetModifiers(Node);
+        if (NodeModifiers.Num() > 0)
+        {
+            NodeSources.Add(Node, Graph.AddSource(NodeModifiers));
+        }
+    });
+
+    Allocation = Target;
+    return true;
+}
+
+bool FPoE2PassiveTreeState::AllocatePath(const TSharedPtr<const FPoE2PassiveTree>& InTree, int32 InStartNode, int32 Node, FPoE2StatGraph& Graph, int32 MaxPoints)
+{
+    if (!InTree.IsValid() || !InTree->GetStartNodes().Contains(InStartNode))
+    {
+        return false;
+    }
+
+    FPoE2PassiveAllocation Current = (Tree == InTree && StartNode == InStartNode) ? Allocation : FPoE2PassiveAllocation();
+    Current.Add(InStartNode);
+
+    TArray<int32> Path;
+    if (!InTree->FindPath(Current, InStartNode, Node, Path))
+    {
+        return false;
+    }
+
+    for (const int32 PathNode : Path)
+    {
+        Current.Add(PathNode);
+    }
+    return SetAllocation(InTree, InStartNode, Current, Graph, MaxPoints);
+}
+
+bool FPoE2PassiveTreeState::Deallocate(int32 Node, FPoE2StatGraph& Graph)
+{
+    if (!Tree.IsValid() || !Tree->CanDeallocate(Allocation, StartNode, Node))
+    {
+        return false;
+    }
+
+    FPoE2PassiveAllocation Remaining = Allocation;
+    Remaining.Remove(Node);
+    return SetAllocation(Tree, StartNode, Remaining, Graph);
+}
+
+void FPoE2PassiveTreeState::Reset(FPoE2StatGraph& Graph)
+{
+    for (const TPair<int32, FPoE2StatSourceHandle>& Pair : NodeSources)
+    {
+        Graph.RemoveSource(Pair.Value);
+    }
+    NodeSources.Reset();
+    Allocation = FPoE2PassiveAllocation();
+    Tree.Reset();
+    StartNode = INDEX_NONE;
+}
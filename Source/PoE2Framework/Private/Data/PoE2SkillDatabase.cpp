@@ -0,0 +1,649 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Data/PoE2SkillDatabase.h"
+#include "Data/SkillDataAsset.h"
+#include "Data/SupportDataAsset.h"
+#include "Spec/SkillSpec.h"
+#include "Spec/Patch.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Core/PoE2Log.h"
+
+using namespace PoE2SkillDatabase;
+
+namespace
+{
+    const FPrimaryAssetType SkillAssetType(TEXT("Skill"));
+    const FPrimaryAssetType SupportAssetType(TEXT("Support"));
+
+    /** Accumulates records and interns strings while baking. */
+    struct FBakeWriter
+    {
+        TArray<FString> Strings;
+        TMap<FString, uint32> StringIndices;
+
+        TArray<FSkillRecord> Skills;
+        TArray<FSupportRecord> Supports;
+        TArray<FOpRecord> Ops;
+        TArray<uint32> Refs;
+        TArray<FParamRecord> Params;
+
+        FBakeWriter()
+        {
+            Strings.Add(FString());
+            StringIndices.Add(FString(), NoString);
+        }
+
+        uint32 AddString(const FString& String)
+        {
+            if (const uint32* Existing = StringIndices.Find(String))
+            {
+                return *Existing;
+            }
+            const uint32 Index = Strings.Add(String);
+            StringIndices.Add(String, Index);
+            return Index;
+        }
+
+        uint32 AddString(FName Name)
+        {
+            return Name.IsNone() ? NoString : AddString(Name.ToString());
+        }
+
+        uint32 AddPath(const FSoftObjectPath& Path)
+        {
+            return Path.IsNull() ? NoString : AddString(Path.ToString());
+        }
+
+        FRange AddTags(const FGameplayTagContainer& Container)
+        {
+            FRange Range{ static_cast<uint32>(Refs.Num()), 0 };
+            for (const FGameplayTag& Tag : Container)
+            {
+                Refs.Add(AddString(Tag.GetTagName()));
+                ++Range.Num;
+            }
+            return Range;
+        }
+
+        template<typename ClassType>
+        FRange AddClasses(const TArray<TSoftClassPtr<ClassType>>& Classes)
+        {
+            FRange Range{ static_cast<uint32>(Refs.Num()), 0 };
+            for (const TSoftClassPtr<ClassType>& Class : Classes)
+            {
+                Range.Num += AddClassRef(Class.ToSoftObjectPath());
+            }
+            return Range;
+        }
+
+        template<typename ClassType>
+        FRange AddClasses(const TArray<TSubclassOf<ClassType>>& Classes)
+        {
+            FRange Range{ static_cast<uint32>(Refs.Num()), 0 };
+            for (const TSubclassOf<ClassType>& Class : Classes)
+            {
+                Range.Num += AddClassRef(FSoftObjectPath(Class.Get()));
+            }
+            return Range;
+        }
+
+        uint32 AddClassRef(const FSoftObjectPath& Path)
+        {
+            const uint32 Index = AddPath(Path);
+            if (Index == NoString)
+            {
+                return 0;
+            }
+            Refs.Add(Index);
+            return 1;
+        }
+
+        FRange AddOps(TConstArrayView<FCompiledPatch::FOp> CompiledOps)
+        {
+            FRange Range{ static_cast<uint32>(Ops.Num()), static_cast<uint32>(CompiledOps.Num()) };
+            for (const FCompiledPatch::FOp& Op : CompiledOps)
+            {
+                FOpRecord& Record = Ops.AddZeroed_GetRef();
+                Record.Field = static_cast<uint8>(Op.Field);
+                Record.Value = Op.Value;
+            }
+            return Range;
+        }
+    };
+
+    /** Pairs each asset with its key, in the order UPoE2SkillRegistry indexes them. */
+    template<typename AssetType, typename KeyFuncType>
+    TArray<TPair<const AssetType*, FName>> SortLikeRegistry(TConstArrayView<const AssetType*> Assets, FPrimaryAssetType InAssetType, KeyFuncType GetKey, FPoE2AssetCatalog& OutCatalog)
+    {
+        TArray<FPoE2AssetCatalog::FEntry> Entries;
+        TMap<FPrimaryAssetId, const AssetType*> AssetsById;
+        for (const AssetType* Asset : Assets)
+        {
+            if (!Asset)
+            {
+                continue;
+            }
+            FPoE2AssetCatalog::FEntry& Entry = Entries.AddDefaulted_GetRef();
+            Entry.AssetId = FPrimaryAssetId(InAssetType, Asset->GetPrimaryAssetId().PrimaryAssetName);
+            Entry.Key = GetKey(Asset).IsNone() ? Entry.AssetId.PrimaryAssetName : GetKey(Asset);
+            AssetsById.Add(Entry.AssetId, Asset);
+        }
+        OutCatalog.Build(MoveTemp(Entries));
+
+        TArray<TPair<const AssetType*, FName>> Sorted;
+        Sorted.SetNum(OutCatalog.Num());
+        for (const TPair<FPrimaryAssetId, const AssetType*>& Pair : AssetsById)
+        {
+            const FPoE2AssetIndex Index = OutCatalog.FindByAssetId(Pair.Key);
+            if (Index.IsValid())
+            {
+                Sorted[Index.Value - 1] = TPair<const AssetType*, FName>(Pair.Value, OutCatalog.Get(Index)->Key);
+            }
+        }
+        return Sorted;
+    }
+
+    bool IsSectionValid(const FSection& Section, SIZE_T ElementSize, int64 ImageSize)
+    {
+        return Section.Offset % alignof(uint32) == 0
+            && static_cast<int64>(Section.Offset) + static_cast<int64>(Section.Count) * static_cast<int64>(ElementSize) <= ImageSize;
+    }
+
+    bool IsRangeValid(const FRange& Range, uint32 Limit)
+    {
+        return Range.First <= Limit && Range.Num <= Limit - Range.First;
+    }
+}
+
+FPoE2SkillDatabase::FPoE2SkillDatabase() = default;
+
+FPoE2SkillDatabase::~FPoE2SkillDatabase()
+{
+    Close();
+}
+
+FString FPoE2SkillDatabase::GetDefaultPath()
+{
+    return FPaths::ProjectContentDir() / TEXT("Baked/PoE2SkillDatabase.bin");
+}
+
+void FPoE2SkillDatabase::Bake(TConstArrayView<const USkillDataAsset*> Skills, TConstArrayView<const USupportDataAsset*> Supports, TArray64<uint8>& OutBytes)
+{
+    FPoE2AssetCatalog SkillCatalog;
+    FPoE2AssetCatalog SupportCatalog;
+
+    // Records are written in registry order so a registry index addresses a record directly
+    const auto SortedSkills = SortLikeRegistry<USkillDataAsset>(Skills, SkillAssetType, [](const USkillDataAsset* Skill) { return Skill->SkillId; }, SkillCatalog);
+    const auto SortedSupports = SortLikeRegistry<USupportDataAsset>(Supports, SupportAssetType, [](const USupportDataAsset* Support) { return Support->SupportId; }, SupportCatalog);
+
+    FBakeWriter Writer;
+
+    for (const TPair<const USkillDataAsset*, FName>& Pair : SortedSkills)
+    {
+        const USkillDataAsset* Skill = Pair.Key;
+
+        // The base spec is the reference: whatever CreateBaseSkillSpec derives, the bake stores
+        const FSkillSpec BaseSpec = Skill->CreateBaseSkillSpec();
+
+        FSkillRecord& Record = Writer.Skills.AddZeroed_GetRef();
+        Record.Key = Writer.AddString(Pair.Value);
+        Record.AssetName = Writer.AddString(Skill->GetPrimaryAssetId().PrimaryAssetName);
+        for (int32 Field = 0; Field < SkillSpecNumericField::Num; ++Field)
+        {
+            Record.Numerics[Field] = SkillSpecNumericField::Get(BaseSpec, static_cast<ESkillSpecNumericField>(Field));
+        }
+        Record.SummonCount = BaseSpec.SummonCount;
+
+        // Class references come from the soft paths, so nothing has to be loaded to bake them
+        Record.AbilityClass = Writer.AddPath(Skill->AbilityClass.ToSoftObjectPath());
+        Record.DamageEffectClass = Writer.AddPath(Skill->DamageEffectClass.ToSoftObjectPath());
+        Record.ProjectileClass = Writer.AddPath(Skill->ProjectileClass.ToSoftObjectPath());
+        Record.SummonClass = Writer.AddPath(Skill->SummonClass.ToSoftObjectPath());
+
+        Record.Tags = Writer.AddTags(BaseSpec.SkillTags);
+        Record.Effects = Writer.AddClasses(Skill->DefaultEffects);
+        Record.Handlers = Writer.AddClasses(Skill->DefaultHandlers);
+
+        Record.Params = FRange{ static_cast<uint32>(Writer.Params.Num()), static_cast<uint32>(BaseSpec.CustomParams.Num()) };
+        for (const FCustomParam& Param : BaseSpec.CustomParams)
+        {
+            Writer.Params.Add(FParamRecord{ Writer.AddString(Param.Key), Param.Value });
+        }
+    }
+
+    for (const TPair<const USupportDataAsset*, FName>& Pair : SortedSupports)
+    {
+        const USupportDataAsset* Support = Pair.Key;
+        const FPatch& Patch = Support->SkillPatch;
+        const FCompiledPatch Compiled = FCompiledPatch::Compile(Patch);
+
+        FSupportRecord& Record = Writer.Supports.AddZeroed_GetRef();
+        Record.Key = Writer.AddString(Pair.Value);
+        Record.AssetName = Writer.AddString(Support->GetPrimaryAssetId().PrimaryAssetName);
+        Record.Additive = Writer.AddOps(Compiled.Additive);
+        Record.Multiplicative = Writer.AddOps(Compiled.Multiplicative);
+        Record.TagsToAdd = Writer.AddTags(Patch.TagsToAdd);
+        Record.TagsToRemove = Writer.AddTags(Patch.TagsToRemove);
+        Record.RequiredSkillTags = Writer.AddTags(Support->RequiredSkillTags);
+        Record.ExcludedSkillTags = Writer.AddTags(Support->ExcludedSkillTags);
+        Record.Effects = Writer.AddClasses(Patch.EffectsToAdd);
+        Record.Handlers = Writer.AddClasses(Patch.HandlersToAdd);
+        Record.ProjectileClassOverride = Patch.ProjectileClassOverride ? Writer.AddPath(FSoftObjectPath(Patch.ProjectileClassOverride.Get())) : NoString;
+    }
+
+    // String blob
+    TArray<uint32> StringOffsets;
+    TArray<uint8> StringData;
+    StringOffsets.Reserve(Writer.Strings.Num());
+    for (const FString& String : Writer.Strings)
+    {
+        StringOffsets.Add(StringData.Num());
+        const FTCHARToUTF8 Utf8(*String);
+        StringData.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+        StringData.Add(0);
+    }
+
+    OutBytes.Reset();
+    OutBytes.AddZeroed(sizeof(FHeader));
+
+    auto AppendSection = [&OutBytes](const void* Data, int32 Count, SIZE_T ElementSize)
+    {
+        OutBytes.AddZeroed(Align(OutBytes.Num(), 8) - OutBytes.Num());
+        const FSection Section{ static_cast<uint32>(OutBytes.Num()), static_cast<uint32>(Count) };
+        OutBytes.Append(static_cast<const uint8*>(Data), Count * ElementSize);
+        return Section;
+    };
+
+    FHeader Header;
+    FMemory::Memzero(Header);
+    Header.Magic = Magic;
+    Header.FormatVersion = FormatVersion;
+    Header.NumericFieldCount = SkillSpecNumericField::Num;
+    Header.CatalogHash = HashCombine(SkillCatalog.GetHash(), SupportCatalog.GetHash());
+    Header.Strings = AppendSection(StringOffsets.GetData(), StringOffsets.Num(), sizeof(uint32));
+    Header.StringData = AppendSection(StringData.GetData(), StringData.Num(), sizeof(uint8));
+    Header.Skills = AppendSection(Writer.Skills.GetData(), Writer.Skills.Num(), sizeof(FSkillRecord));
+    Header.Supports = AppendSection(Writer.Supports.GetData(), Writer.Supports.Num(), sizeof(FSupportRecord));
+    Header.Ops = AppendSection(Writer.Ops.GetData(), Writer.Ops.Num(), sizeof(FOpRecord));
+    Header.Refs = AppendSection(Writer.Refs.GetData(), Writer.Refs.Num(), sizeof(uint32));
+    Header.Params = AppendSection(Writer.Params.GetData(), Writer.Params.Num(), sizeof(FParamRecord));
+    Header.TotalSize = static_cast<uint32>(OutBytes.Num());
+
+    FMemory::Memcpy(OutBytes.GetData(), &Header, sizeof(FHeader));
+}
+
+bool FPoE2SkillDatabase::Open(const FString& Path)
+{
+    Close();
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    TUniquePtr<IMappedFileHandle> File(PlatformFile.OpenMapped(*Path));
+    if (File.IsValid())
+    {
+        TUniquePtr<IMappedFileRegion> Region(File->MapRegion(0, File->GetFileSize()));
+        if (Region.IsValid())
+        {
+            MappedFile = MoveTemp(File);
+            MappedRegion = MoveTemp(Region);
+            if (Attach(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize()))
+            {
+                return true;
+            }
+            Close();
+            return false;
+        }
+    }
+
+    // Paks and some platforms cannot map; read the image instead
+    TArray64<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+    {
+        return false;
+    }
+    return OpenFromMemory(MoveTemp(Bytes));
+}
+
+bool FPoE2SkillDatabase::OpenFromMemory(TArray64<uint8>&& Bytes)
+{
+    Close();
+
+    OwnedBytes = MoveTemp(Bytes);
+    if (Attach(OwnedBytes.GetData(), OwnedBytes.Num()))
+    {
+        return true;
+    }
+    Close();
+    return false;
+}
+
+void FPoE2SkillDatabase::Close()
+{
+    Base = nullptr;
+    Header = nullptr;
+    Names.Reset();
+    Tags.Reset();
+    ClassPaths.Reset();
+    SkillCatalog.Reset();
+    SupportCatalog.Reset();
+
+    // The region must go before the file it maps
+    MappedRegion.Reset();
+    MappedFile.Reset();
+    OwnedBytes.Empty();
+}
+
+bool FPoE2SkillDatabase::Attach(const uint8* Data, int64 Size)
+{
+    if (!Data || Size < static_cast<int64>(sizeof(FHeader)))
+    {
+        return false;
+    }
+
+    const FHeader* CandidateHeader = reinterpret_cast<const FHeader*>(Data);
+    if (CandidateHeader->Magic != Magic || CandidateHeader->FormatVersion != FormatVersion)
+    {
+        UE_LOG(LogPoE2Framework, Warning, TEXT("FPoE2SkillDatabase: Unrecognized image (magic %08x, version %u)"), CandidateHeader->Magic, CandidateHeader->FormatVersion);
+        return false;
+    }
+    if (CandidateHeader->NumericFieldCount != SkillSpecNumericField::Num || CandidateHeader->TotalSize != Size)
+    {
+        UE_LOG(LogPoE2Framework, Warning, TEXT("FPoE2SkillDatabase: Image is stale or truncated, rebake it"));
+        return false;
+    }
+
+    // Validate every offset once so lookups can index without checks
+    const bool bSectionsValid = IsSectionValid(CandidateHeader->Strings, sizeof(uint32), Size)
+        && IsSectionValid(CandidateHeader->StringData, sizeof(uint8), Size)
+        && IsSectionValid(CandidateHeader->Skills, sizeof(FSkillRecord), Size)
+        && IsSectionValid(CandidateHeader->Supports, sizeof(FSupportRecord), Size)
+        && IsSectionValid(CandidateHeader->Ops, sizeof(FOpRecord), Size)
+        && IsSectionValid(CandidateHeader->Refs, sizeof(uint32), Size)
+        && IsSectionValid(CandidateHeader->Params, sizeof(FParamRecord), Size)
+        && CandidateHeader->Strings.Count > 0
+        && CandidateHeader->StringData.Count > 0;
+    if (!bSectionsValid)
+    {
+        UE_LOG(LogPoE2Framework, Warning, TEXT("FPoE2SkillDatabase: Section out of bounds"));
+        return false;
+    }
+
+    Base = Data;
+    Header = CandidateHeader;
+
+    const uint32 NumStrings = Header->Strings.Count;
+    const uint32* StringOffsets = GetSection<uint32>(Header->Strings);
+    const ANSICHAR* StringData = GetSection<ANSICHAR>(Header->StringData);
+    if (StringData[Header->StringData.Count - 1] != '\0')
+    {
+        Close();
+        return false;
+    }
+
+    Names.SetNum(NumStrings);
+    Tags.SetNum(NumStrings);
+    ClassPaths.SetNum(NumStrings);
+    for (uint32 Index = 0; Index < NumStrings; ++Index)
+    {
+        if (StringOffsets[Index] >= Header->StringData.Count)
+        {
+            Close();
+            return false;
+        }
+
+        const FString String = UTF8_TO_TCHAR(StringData + StringOffsets[Index]);
+        if (String.IsEmpty())
+        {
+            continue;
+        }
+
+        Names[Index] = FName(*String);
+        if (String.StartsWith(TEXT("/")))
+        {
+            ClassPaths[Index] = FSoftObjectPath(String);
+        }
+        else
+        {
+            Tags[Index] = FGameplayTag::RequestGameplayTag(Names[Index], false);
+        }
+    }
+
+    auto IsStringValid = [NumStrings](uint32 Index) { return Index < NumStrings; };
+    const uint32 NumRefs = Header->Refs.Count;
+    const uint32 NumOps = Header->Ops.Count;
+
+    const uint32* Refs = GetSection<uint32>(Header->Refs);
+    for (uint32 Index = 0; Index < NumRefs; ++Index)
+    {
+        if (!IsStringValid(Refs[Index]))
+        {
+            Close();
+            return false;
+        }
+    }
+
+    const FOpRecord* Ops = GetSection<FOpRecord>(Header->Ops);
+    for (uint32 Index = 0; Index < NumOps; ++Index)
+    {
+        if (Ops[Index].Field >= SkillSpecNumericField::Num)
+        {
+            Close();
+            return false;
+        }
+    }
+
+    TArray<FPoE2AssetCatalog::FEntry> Entries;
+
+    const FSkillRecord* SkillRecords = GetSection<FSkillRecord>(Header->Skills);
+    for (uint32 Index = 0; Index < Header->Skills.Count; ++Index)
+    {
+        const FSkillRecord& Record = SkillRecords[Index];
+        const bool bValid = IsStringValid(Record.Key) && IsStringValid(Record.AssetName)
+            && IsStringValid(Record.AbilityClass) && IsStringValid(Record.DamageEffectClass)
+            && IsStringValid(Record.ProjectileClass) && IsStringValid(Record.SummonClass)
+            && IsRangeValid(Record.Tags, NumRefs) && IsRangeValid(Record.Effects, NumRefs)
+            && IsRangeValid(Record.Handlers, NumRefs) && IsRangeValid(Record.Params, Header->Params.Count);
+        if (!bValid)
+        {
+            Close();
+            return false;
+        }
+        Entries.Add({ FPrimaryAssetId(SkillAssetType, Names[Record.AssetName]), Names[Record.Key] });
+    }
+    SkillCatalog.Build(MoveTemp(Entries));
+
+    Entries.Reset();
+    const FSupportRecord* SupportRecords = GetSection<FSupportRecord>(Header->Supports);
+    for (uint32 Index = 0; Index < Header->Supports.Count; ++Index)
+    {
+        const FSupportRecord& Record = SupportRecords[Index];
+        const bool bValid = IsStringValid(Record.Key) && IsStringValid(Record.AssetName)
+            && IsStringValid(Record.ProjectileClassOverride)
+            && IsRangeValid(Record.Additive, NumOps) && IsRangeValid(Record.Multiplicative, NumOps)
+            && IsRangeValid(Record.TagsToAdd, NumRefs) && IsRangeValid(Record.TagsToRemove, NumRefs)
+            && IsRangeValid(Record.RequiredSkillTags, NumRefs) && IsRangeValid(Record.ExcludedSkillTags, NumRefs)
+            && IsRangeValid(Record.Effects, NumRefs) && IsRangeValid(Record.Handlers, NumRefs);
+        if (!bValid)
+        {
+            Close();
+            return false;
+        }
+        Entries.Add({ FPrimaryAssetId(SupportAssetType, Names[Record.AssetName]), Names[Record.Key] });
+    }
+    SupportCatalog.Build(MoveTemp(Entries));
+
+    // Records are stored in catalog order, so index N is record N - 1
+    if (SkillCatalog.Num() != static_cast<int32>(Header->Skills.Count) || SupportCatalog.Num() != static_cast<int32>(Header->Supports.Count)
+        || HashCombine(SkillCatalog.GetHash(), SupportCatalog.GetHash()) != Header->CatalogHash)
+    {
+        UE_LOG(LogPoE2Framework, Warning, TEXT("FPoE2SkillDatabase: Catalog does not match the baked hash"));
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+const FSkillRecord* FPoE2SkillDatabase::GetSkillRecord(FPoE2AssetIndex Index) const
+{
+    if (!Header || !Index.IsValid() || Index.Value > Header->Skills.Count)
+    {
+        return nullptr;
+    }
+    return GetSection<FSkillRecord>(Header->Skills) + (Index.Value - 1);
+}
+
+const FSupportRecord* FPoE2SkillDatabase::GetSupportRecord(FPoE2AssetIndex Index) const
+{
+    if (!Header || !Index.IsValid() || Index.Value > Header->Supports.Count)
+    {
+        return nullptr;
+    }
+    return GetSection<FSupportRecord>(Header->Supports) + (Index.Value - 1);
+}
+
+void FPoE2SkillDatabase::AppendTags(const FRange& Range, FGameplayTagContainer& OutTags) const
+{
+    const uint32* Refs = GetSection<uint32>(Header->Refs);
+    for (uint32 Index = Range.First; Index < Range.First + Range.Num; ++Index)
+    {
+        const FGameplayTag& Tag = Tags[Refs[Index]];
+        if (Tag.IsValid())
+        {
+            OutTags.AddTag(Tag);
+        }
+    }
+}
+
+void FPoE2SkillDatabase::RemoveTags(const FRange& Range, FGameplayTagContainer& OutTags) const
+{
+    const uint32* Refs = GetSection<uint32>(Header->Refs);
+    for (uint32 Index = Range.First; Index < Range.First + Range.Num; ++Index)
+    {
+        OutTags.RemoveTag(Tags[Refs[Index]]);
+    }
+}
+
+UClass* FPoE2SkillDatabase::ResolveClass(uint32 StringIndex) const
+{
+    if (StringIndex == NoString)
+    {
+        return nullptr;
+    }
+    return Cast<UClass>(ClassPaths[StringIndex].ResolveObject());
+}
+
+bool FPoE2SkillDatabase::BuildBaseSpec(FPoE2AssetIndex Skill, FSkillSpec& OutSpec) const
+{
+    const FSkillRecord* Record = GetSkillRecord(Skill);
+    if (!Record)
+    {
+        return false;
+    }
+
+    OutSpec = FSkillSpec();
+    OutSpec.SkillId = Names[Record->Key];
+    OutSpec.SkillIndex = Skill;
+
+    for (int32 Field = 0; Field < SkillSpecNumericField::Num; ++Field)
+    {
+        SkillSpecNumericField::Get(OutSpec, static_cast<ESkillSpecNumericField>(Field)) = Record->Numerics[Field];
+    }
+    OutSpec.SummonCount = Record->SummonCount;
+
+    OutSpec.AbilityClass = ResolveClass(Record->AbilityClass);
+    OutSpec.DamageEffectClass = ResolveClass(Record->DamageEffectClass);
+    OutSpec.ProjectileClass = ResolveClass(Record->ProjectileClass);
+    OutSpec.SummonClass = ResolveClass(Record->SummonClass);
+
+    AppendTags(Record->Tags, OutSpec.SkillTags);
+    OutSpec.RefreshTagBits();
+    AppendClasses(Record->Effects, OutSpec.AppliedEffects);
+    AppendClasses(Record->Handlers, OutSpec.MechanicHandlers);
+
+    const FParamRecord* Params = GetSection<FParamRecord>(Header->Params) + Record->Params.First;
+    OutSpec.CustomParams.Reserve(Record->Params.Num);
+    for (uint32 Index = 0; Index < Record->Params.Num; ++Index)
+    {
+        OutSpec.CustomParams.Add(FCustomParam(Names[Params[Index].Key], Params[Index].Value));
+    }
+
+    return true;
+}
+
+bool FPoE2SkillDatabase::ApplySupport(FPoE2AssetIndex Support, FSkillSpec& Spec) const
+{
+    const FSupportRecord* Record = GetSupportRecord(Support);
+    if (!Record)
+    {
+        return false;
+    }
+
+    // Same order as FSkillSpecBuilder::ApplyPatch
+    const FOpRecord* Ops = GetSection<FOpRecord>(Header->Ops);
+    for (uint32 Index = Record->Additive.First; Index < Record->Additive.First + Record->Additive.Num; ++Index)
+    {
+        SkillSpecNumericField::Get(Spec, static_cast<ESkillSpecNumericField>(Ops[Index].Field)) += Ops[Index].Value;
+    }
+    for (uint32 Index = Record->Multiplicative.First; Index < Record->Multiplicative.First + Record->Multiplicative.Num; ++Index)
+    {
+        SkillSpecNumericField::Get(Spec, static_cast<ESkillSpecNumericField>(Ops[Index].Field)) *= (1.0f + Ops[Index].Value);
+    }
+
+    AppendTags(Record->TagsToAdd, Spec.SkillTags);
+    RemoveTags(Record->TagsToRemove, Spec.SkillTags);
+    Spec.RefreshTagBits();
+    AppendClasses(Record->Effects, Spec.AppliedEffects);
+    AppendClasses(Record->Handlers, Spec.MechanicHandlers);
+
+    if (UClass* ProjectileOverride = ResolveClass(Record->ProjectileClassOverride))
+    {
+        Spec.ProjectileClass = ProjectileOverride;
+    }
+
+    return true;
+}
+
+bool FPoE2SkillDatabase::IsSupportCompatible(FPoE2AssetIndex Support, const FGameplayTagContainer& SkillTags) const
+{
+    const FSupportRecord* Record = GetSupportRecord(Support);
+    if (!Record)
+    {
+        return false;
+    }
+
+    const uint32* Refs = GetSection<uint32>(Header->Refs);
+    for (uint32 Index = Record->RequiredSkillTags.First; Index < Record->RequiredSkillTags.First + Record->RequiredSkillTags.Num; ++Index)
+    {
+        if (!SkillTags.HasTag(Tags[Refs[Index]]))
+        {
+            return false;
+        }
+    }
+    for (uint32 Index = Record->ExcludedSkillTags.First; Index < Record->ExcludedSkillTags.First + Record->ExcludedSkillTags.Num; ++Index)
+    {
+        if (SkillTags.HasTag(Tags[Refs[Index]]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FPoE2SkillDatabase::BuildSpec(FPoE2AssetIndex Skill, TConstArrayView<FPoE2AssetIndex> Supports, FSkillSpec& OutSpec) const
+{
+    if (!BuildBaseSpec(Skill, OutSpec))
+    {
+        return false;
+    }
+
+    for (const FPoE2AssetIndex Support : Supports)
+    {
+        ApplySupport(Support, OutSpec);
+    }
+    return true;
+}
@@ -0,0 +1,239 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Data/PoE2SkillRegistry.h"
+#include "Data/SkillDataAsset.h"
+#include "Data/SupportDataAsset.h"
+#include "Data/PoE2SkillDatabase.h"
+#include "Misc/CommandLine.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Engine.h"
+#include "Core/PoE2Log.h"
+
+void FPoE2AssetCatalog::Build(TArray<FEntry> InEntries)
+{
+    Reset();
+
+    InEntries.Sort([](const FEntry& A, const FEntry& B)
+    {
+        if (A.Key != B.Key)
+        {
+            return A.Key.LexicalLess(B.Key);
+        }
+        return A.AssetId.PrimaryAssetName.LexicalLess(B.AssetId.PrimaryAssetName);
+    });
+
+    if (InEntries.Num() > MaxEntries - 1)
+    {
+        UE_LOG(LogPoE2Framework, Error, TEXT("FPoE2AssetCatalog: %d assets exceed the 16-bit index space, the tail is dropped"), InEntries.Num());
+        InEntries.SetNum(MaxEntries - 1);
+    }
+
+    Entries.Reserve(InEntries.Num() + 1);
+    Entries.AddDefaulted();
+    KeyToIndex.Reserve(InEntries.Num());
+    AssetIdToIndex.Reserve(InEntries.Num());
+
+    for (FEntry& Entry : InEntries)
+    {
+        if (KeyToIndex.Contains(Entry.Key))
+        {
+            // The first asset in sort order owns the key; the duplicate still gets its own index
+            UE_LOG(LogPoE2Framework, Warning, TEXT("FPoE2AssetCatalog: %s reuses id %s"), *Entry.AssetId.ToString(), *Entry.Key.ToString());
+        }
+
+        const uint16 Index = static_cast<uint16>(Entries.Num());
+        KeyToIndex.FindOrAdd(Entry.Key, Index);
+        AssetIdToIndex.Add(Entry.AssetId, Index);
+
+        // The asset behind each key too: two builds can share ids yet resolve an index to different assets
+        Hash = FCrc::StrCrc32(*Entry.Key.ToString(), Hash);
+        Hash = FCrc::StrCrc32(*Entry.AssetId.ToString(), Hash);
+
+        Entries.Add(MoveTemp(Entry));
+    }
+}
+
+void FPoE2AssetCatalog::Reset()
+{
+    Entries.Reset();
+    KeyToIndex.Reset();
+    AssetIdToIndex.Reset();
+    Hash = 0;
+}
+
+FPoE2AssetIndex FPoE2AssetCatalog::FindByKey(FName Key) const
+{
+    const uint16* Index = KeyToIndex.Find(Key);
+    return Index ? FPoE2AssetIndex(*Index) : FPoE2AssetIndex();
+}
+
+FPoE2AssetIndex FPoE2AssetCatalog::FindByAssetId(const FPrimaryAssetId& AssetId) const
+{
+    const uint16* Index = AssetIdToIndex.Find(AssetId);
+    return Index ? FPoE2AssetIndex(*Index) : FPoE2AssetIndex();
+}
+
+const FPoE2AssetCatalog::FEntry* FPoE2AssetCatalog::Get(FPoE2AssetIndex Index) const
+{
+    return (Index.IsValid() && Entries.IsValidIndex(Index.Value)) ? &Entries[Index.Value] : nullptr;
+}
+
+UPoE2SkillRegistry* UPoE2SkillRegistry::Get()
+{
+    return GEngine ? GEngine->GetEngineSubsystem<UPoE2SkillRegistry>() : nullptr;
+}
+
+void UPoE2SkillRegistry::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // The bake serves lookups straight away; the initial scan then checks it against the assets actually packaged
+    if (ShouldUseBakedDatabase())
+    {
+        OpenBakedDatabase();
+    }
+
+    UAssetManager::CallOrRegister_OnCompletedInitialScan(FSimpleMulticastDelegate::FDelegate::CreateUObject(this, &UPoE2SkillRegistry::Rebuild));
+}
+
+void UPoE2SkillRegistry::Deinitialize()
+{
+    Skills.Reset();
+    Supports.Reset();
+    BakedDatabase.Reset();
+
+    Super::Deinitialize();
+}
+
+bool UPoE2SkillRegistry::ShouldUseBakedDatabase()
+{
+    if (FParse::Param(FCommandLine::Get(), TEXT("NoBakedSkillDatabase")))
+    {
+        return false;
+    }
+    return IsRunningDedicatedServer() || FParse::Param(FCommandLine::Get(), TEXT("BakedSkillDatabase"));
+}
+
+bool UPoE2SkillRegistry::OpenBakedDatabase()
+{
+    TSharedPtr<FPoE2SkillDatabase> Database = MakeShared<FPoE2SkillDatabase>();
+    const FString Path = FPoE2SkillDatabase::GetDefaultPath();
+    if (!Database->Open(Path))
+    {
+        UE_LOG(LogPoE2Framework, Log, TEXT("UPoE2SkillRegistry: No usable baked skill database at %s, scanning assets"), *Path);
+        return false;
+    }
+
+    // Same sort as Rebuild, so indices and hash match clients that scanned the assets
+    Skills = Database->GetSkillCatalog();
+    Supports = Database->GetSupportCatalog();
+    BakedDatabase = MoveTemp(Database);
+
+    UE_LOG(LogPoE2Framework, Log, TEXT("UPoE2SkillRegistry: Baked database %s (%lld bytes, %s): %d skills, %d supports, hash %08x"),
+        *Path, BakedDatabase->GetImageSize(), BakedDatabase->IsMapped() ? TEXT("mapped") : TEXT("in memory"),
+        Skills.Num(), Supports.Num(), GetCatalogHash());
+    return true;
+}
+
+void UPoE2SkillRegistry::Rebuild()
+{
+    if (!UAssetManager::IsInitialized())
+    {
+        return;
+    }
+
+    TArray<FPoE2AssetCatalog::FEntry> Entries;
+
+    FPoE2AssetCatalog ScannedSkills;
+    GatherEntries(FPrimaryAssetType(TEXT("Skill")), GET_MEMBER_NAME_CHECKED(USkillDataAsset, SkillId), Entries);
+    ScannedSkills.Build(MoveTemp(Entries));
+
+    Entries.Reset();
+    FPoE2AssetCatalog ScannedSupports;
+    GatherEntries(FPrimaryAssetType(TEXT("Support")), GET_MEMBER_NAME_CHECKED(USupportDataAsset, SupportId), Entries);
+    ScannedSupports.Build(MoveTemp(Entries));
+
+    if (BakedDatabase.IsValid())
+    {
+        // A server cooked without the DataAssets has nothing to compare against and must trust the bake
+        const bool bNothingScanned = ScannedSkills.Num() == 0 && ScannedSupports.Num() == 0;
+        if (bNothingScanned || (ScannedSkills.GetHash() == Skills.GetHash() && ScannedSupports.GetHash() == Supports.GetHash()))
+        {
+            return;
+        }
+
+        // A stale bake would hand out indices the clients resolve to other assets
+        UE_LOG(LogPoE2Framework, Warning, TEXT("UPoE2SkillRegistry: Baked database (hash %08x) does not match the packaged assets (hash %08x); rebake it. Using the scanned assets"),
+            GetCatalogHash(), static_cast<int32>(HashCombine(ScannedSkills.GetHash(), ScannedSupports.GetHash())));
+        BakedDatabase.Reset();
+    }
+
+    Skills = MoveTemp(ScannedSkills);
+    Supports = MoveTemp(ScannedSupports);
+
+    UE_LOG(LogPoE2Framework, Log, TEXT("UPoE2SkillRegistry: %d skills, %d supports, hash %08x"), Skills.Num(), Supports.Num(), GetCatalogHash());
+}
+
+void UPoE2SkillRegistry::GatherEntries(FPrimaryAssetType AssetType, FName KeyTag, TArray<FPoE2AssetCatalog::FEntry>& OutEntries)
+{
+    UAssetManager& AssetManager = UAssetManager::Get();
+
+    TArray<FAssetData> AssetDatas;
+    AssetManager.GetPrimaryAssetDataList(AssetType, AssetDatas);
+
+    OutEntries.Reserve(OutEntries.Num() + AssetDatas.Num());
+    for (const FAssetData& AssetData : AssetDatas)
+    {
+        FPoE2AssetCatalog::FEntry& Entry = OutEntries.AddDefaulted_GetRef();
+        Entry.AssetId = AssetManager.GetPrimaryAssetIdForData(AssetData);
+
+        // The id fields are AssetRegistrySearchable, so this does not load the asset
+        if (!AssetData.GetTagValue(KeyTag, Entry.Key) || Entry.Key.IsNone())
+        {
+            Entry.Key = Entry.AssetId.PrimaryAssetName;
+        }
+    }
+}
+
+FPoE2AssetIndex UPoE2SkillRegistry::GetSkillIndex(const USkillDataAsset* Skill) const
+{
+    if (!Skill)
+    {
+        return FPoE2AssetIndex();
+    }
+    return Skills.FindByAssetId(Skill->GetPrimaryAssetId());
+}
+
+FName UPoE2SkillRegistry::GetSkillId(FPoE2AssetIndex Index) const
+{
+    const FPoE2AssetCatalog::FEntry* Entry = Skills.Get(Index);
+    return Entry ? Entry->Key : NAME_None;
+}
+
+USkillDataAsset* UPoE2SkillRegistry::GetSkill(FPoE2AssetIndex Index) const
+{
+    const FPoE2AssetCatalog::FEntry* Entry = Skills.Get(Index);
+    return Entry ? UAssetManager::Get().GetPrimaryAssetObject<USkillDataAsset>(Entry->AssetId) : nullptr;
+}
+
+FPoE2AssetIndex UPoE2SkillRegistry::GetSupportIndex(const USupportDataAsset* Support) const
+{
+    if (!Support)
+    {
+        return FPoE2AssetIndex();
+    }
+    return Supports.FindByAssetId(Support->GetPrimaryAssetId());
+}
+
+USupportDataAsset* UPoE2SkillRegistry::GetSupport(FPoE2AssetIndex Index) const
+{
+    const FPoE2AssetCatalog::FEntry* Entry = Supports.Get(Index);
+    return Entry ? UAssetManager::Get().GetPrimaryAssetObject<USupportDataAsset>(Entry->AssetId) : nullptr;
+}
+
+int32 UPoE2SkillRegistry::GetCatalogHash() const
+{
+    return static_cast<int32>(HashCombine(Skills.GetHash(), Supports.GetHash()));
+}
@@ -1,6 +1,14 @@
 #include "Data/SkillDataAsset.h"
 #include "Spec/SkillSpec.h"
+#include "Data/PoE2SkillRegistry.h"
 #include "Engine/AssetManager.h"
+#include "UObject/ObjectSaveContext.h"
+#include "Core/PoE2Log.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+const FName USkillDataAsset::GameplayBundle(TEXT("Gameplay"));
+const FName USkillDataAsset::CosmeticBundle(TEXT("Cosmetic"));
 
 USkillDataAsset::USkillDataAsset()
 {
@@ -25,24 +33,133 @@ FPrimaryAssetId USkillDataAsset::GetPrimaryAssetId() const
     return FPrimaryAssetId(TEXT("Skill"), GetFName());
 }
 
+TArray<FName> USkillDataAsset::GetRequiredBundles()
+{
+    TArray<FName> Bundles;
+    Bundles.Add(GameplayBundle);
+    if (!IsRunningDedicatedServer())
+    {
+        Bundles.Add(CosmeticBundle);
+    }
+    return Bundles;
+}
+
+void USkillDataAsset::GatherBundleReferences(TConstArrayView<FName> Bundles, TArray<FSoftObjectPath>& OutPaths) const
+{
+    // Mirrors the AssetBundles meta on the fields; kept explicit so unscanned or transient assets can still stream
+    auto AddPath = [&OutPaths](const FSoftObjectPath& Path)
+    {
+        if (!Path.IsNull())
+        {
+            OutPaths.AddUnique(Path);
+        }
+    };
+
+    if (Bundles.Contains(GameplayBundle))
+    {
+        AddPath(AbilityClass.ToSoftObjectPath());
+        AddPath(DamageEffectClass.ToSoftObjectPath());
+        AddPath(ProjectileClass.ToSoftObjectPath());
+        AddPath(SummonClass.ToSoftObjectPath());
+        for (const TSoftClassPtr<UGameplayEffect>& Effect : DefaultEffects)
+        {
+            AddPath(Effect.ToSoftObjectPath());
+        }
+        for (const TSoftClassPtr<UObject>& Handler : DefaultHandlers)
+        {
+            AddPath(Handler.ToSoftObjectPath());
+        }
+    }
+
+    if (Bundles.Contains(CosmeticBundle))
+    {
+        AddPath(CastMontage.ToSoftObjectPath());
+    }
+}
+
+bool USkillDataAsset::AreBundlesLoaded(TConstArrayView<FName> Bundles) const
+{
+    TArray<FSoftObjectPath> Paths;
+    GatherBundleReferences(Bundles, Paths);
+
+    for (const FSoftObjectPath& Path : Paths)
+    {
+        if (!Path.ResolveObject())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int64 USkillDataAsset::GetResidentMemoryBytes() const
+{
+    int64 TotalBytes = GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+
+    TArray<FSoftObjectPath> Paths;
+    GatherBundleReferences({ GameplayBundle, CosmeticBundle }, Paths);
+
+    for (const FSoftObjectPath& Path : Paths)
+    {
+        if (const UObject* Resident = Path.ResolveObject())
+        {
+            TotalBytes += Resident->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+        }
+    }
+    return TotalBytes;
+}
+
+static FAutoConsoleCommand GPoE2SkillMemReportCommand(
+    TEXT("PoE2.Skills.MemReport"),
+    TEXT("Logs the resident memory of every loaded skill asset and whether its bundles are streamed in."),
+    FConsoleCommandDelegate::CreateLambda([]()
+    {
+        int64 TotalBytes = 0;
+        int32 SkillCount = 0;
+        for (TObjectIterator<USkillDataAsset> It; It; ++It)
+        {
+            const USkillDataAsset* Skill = *It;
+            if (Skill->HasAnyFlags(RF_ClassDefaultObject))
+            {
+                continue;
+            }
+
+            const int64 Bytes = Skill->GetResidentMemoryBytes();
+            TotalBytes += Bytes;
+            ++SkillCount;
+
+            UE_LOG(LogPoE2Framework, Display, TEXT("%-32s %10.1f KB  Gameplay=%d Cosmetic=%d"),
+                *Skill->SkillId.ToString(), Bytes / 1024.0,
+                Skill->AreBundlesLoaded({ USkillDataAsset::GameplayBundle }),
+                Skill->AreBundlesLoaded({ USkillDataAsset::CosmeticBundle }));
+        }
+
+        UE_LOG(LogPoE2Framework, Display, TEXT("%d skills resident, %.1f KB total"), SkillCount, TotalBytes / 1024.0);
+    }));
+
 FSkillSpec USkillDataAsset::CreateBaseSkillSpec() const
 {
-    // Create a new SkillSpec and populate it with base data from this asset
+    // Create a new SkillSpec and populate it with base data from this asset.
+    // Soft references resolve to null until their bundle is loaded (see UPoE2_AbilitySystemComponent::EquipSkill).
     FSkillSpec NewSpec;
     
     // Identity & Basic Properties
     NewSpec.SkillId = this->SkillId;
-    NewSpec.AbilityClass = this->AbilityClass;
+    if (const UPoE2SkillRegistry* Registry = UPoE2SkillRegistry::Get())
+    {
+        NewSpec.SkillIndex = Registry->GetSkillIndex(this);
+    }
+    NewSpec.AbilityClass = this->AbilityClass.Get();
     
     // Actor Classes
-    NewSpec.ProjectileClass = this->ProjectileClass;
+    NewSpec.ProjectileClass = this->ProjectileClass.Get();
     NewSpec.AreaClass = nullptr; // Not defined in this DataAsset, would come from patches or other sources
-    NewSpec.SummonClass = this->SummonClass;
+    NewSpec.SummonClass = this->SummonClass.Get();
     NewSpec.SummonCount = this->SummonCount;
     
     // Numerical Stats - Map from DataAsset naming to SkillSpec naming
     NewSpec.FinalDamage = this->BaseDamage;
-    NewSpec.DamageEffectClass = this->DamageEffectClass;
+    NewSpec.DamageEffectClass = this->DamageEffectClass.Get();
     NewSpec.Cooldown = this->Cooldown;
     NewSpec.ResourceCost = this->Cost;  // Cost -> ResourceCost
     NewSpec.CastTime = this->CastTime;
@@ -53,17 +170,67 @@ FSkillSpec USkillDataAsset::CreateBaseSkillSpec() const
     
     // Tags
     NewSpec.SkillTags = this->SkillTags;
+    if (this->DamageType.IsValid())
+    {
+        // The damage kernel reads the skill's damage type from its tags
+        NewSpec.SkillTags.AddTag(this->DamageType);
+    }
+    NewSpec.RefreshTagBits();
     
     // Default Effects
-    NewSpec.AppliedEffects = this->DefaultEffects;
+    NewSpec.AppliedEffects.Reserve(this->DefaultEffects.Num());
+    for (const TSoftClassPtr<UGameplayEffect>& Effect : this->DefaultEffects)
+    {
+        if (UClass* EffectClass = Effect.Get())
+        {
+            NewSpec.AppliedEffects.Add(EffectClass);
+        }
+    }
     
     // Default Mechanic Handlers
-    NewSpec.MechanicHandlers = this->DefaultHandlers;
+    NewSpec.MechanicHandlers.Reserve(this->DefaultHandlers.Num());
+    for (const TSoftClassPtr<UObject>& Handler : this->DefaultHandlers)
+    {
+        if (UClass* HandlerClass = Handler.Get())
+        {
+            NewSpec.MechanicHandlers.Add(HandlerClass);
+        }
+    }
+
+    // Custom Parameters: baked in the editor, so this is a flat copy
+    NewSpec.CustomParams = this->BakedCustomParams;
+
+    return NewSpec;
+}
 
-    // Custom Parameters (empty by default, can be populated by patches)
-    NewSpec.CustomParams.Empty();
+void USkillDataAsset::PostLoad()
+{
+    Super::PostLoad();
+
+#if WITH_EDITOR
+    // Parameter classes may have changed since the asset was saved
+    BakeCustomParams();
+#endif
+}
+
+#if WITH_EDITOR
+void USkillDataAsset::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+    BakeCustomParams();
 
-    // Flatten the parameter data assets into the final TMap
+    Super::PreSave(ObjectSaveContext);
+}
+
+void USkillDataAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    // Edits inside the instanced parameter objects also propagate here through the outer
+    BakeCustomParams();
+}
+
+void USkillDataAsset::BakeCustomParams()
+{
     TMap<FName, float> FlattenedParams;
     for (const UParameterDataAsset* ParamDA : CustomMechanicParameters)
     {
@@ -73,11 +240,13 @@ FSkillSpec USkillDataAsset::CreateBaseSkillSpec() const
         }
     }
 
-    // Convert from TMap to TArray<FCustomParam> for network compatibility
-    for (const auto& ParamPair : FlattenedParams)
+    BakedCustomParams.Reset(FlattenedParams.Num());
+    for (const TPair<FName, float>& ParamPair : FlattenedParams)
     {
-        NewSpec.SetCustomParam(ParamPair.Key, ParamPair.Value);
+        BakedCustomParams.Add(FCustomParam(ParamPair.Key, ParamPair.Value));
     }
 
-    return NewSpec;
-}
\ No newline at end of file
+    // Lexical order so the saved table is deterministic across editor sessions
+    BakedCustomParams.Sort([](const FCustomParam& A, const FCustomParam& B) { return A.Key.LexicalLess(B.Key); });
+}
+#endif
\ No newline at end of file
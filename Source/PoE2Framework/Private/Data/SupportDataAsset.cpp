@@ -1,4 +1,5 @@
 #include "Data/SupportDataAsset.h"
+#include "Spec/SkillSpec.h"
 #include "Engine/AssetManager.h"
 
 USupportDataAsset::USupportDataAsset()
@@ -13,4 +14,19 @@ FPrimaryAssetId USupportDataAsset::GetPrimaryAssetId() const
     // Return a FPrimaryAssetId with a type of 'Support' and a name of this asset's FName
     // This is important for the Asset Manager to discover and manage support gems
     return FPrimaryAssetId(TEXT("Support"), GetFName());
-}
\ No newline at end of file
+}
+
+bool USupportDataAsset::IsCompatibleWith(const FGameplayTagContainer& SkillTags) const
+{
+    return SkillTags.HasAll(RequiredSkillTags) && !SkillTags.HasAny(ExcludedSkillTags);
+}
+
+bool USupportDataAsset::CanSupport(const FSkillSpec& Spec) const
+{
+    return IsCompatibleWith(Spec.SkillTags);
+}
+
+FPoE2TagQuery USupportDataAsset::CompileCompatibilityQuery() const
+{
+    return FPoE2TagQuery::Compile(RequiredSkillTags, ExcludedSkillTags);
+}
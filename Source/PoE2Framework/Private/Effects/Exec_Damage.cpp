@@ -1,8 +1,45 @@
 #include "Effects/Exec_Damage.h"
 #include "Attributes/AttributeSet_Core.h"
+#include "Attributes/AttributeSet_Combat.h"
 #include "AbilitySystemComponent.h"
 #include "Core/PoE2Log.h"
 #include "Core/PoE2Tags.h"
+#include "Effects/PoE2DamageKernel.h"
+#include "Effects/PoE2GameplayEffectContext.h"
+
+namespace
+{
+    struct FPoE2DamageStatics
+    {
+        DECLARE_ATTRIBUTE_CAPTUREDEF(Armour);
+        DECLARE_ATTRIBUTE_CAPTUREDEF(FireResistance);
+        DECLARE_ATTRIBUTE_CAPTUREDEF(ColdResistance);
+        DECLARE_ATTRIBUTE_CAPTUREDEF(LightningResistance);
+        DECLARE_ATTRIBUTE_CAPTUREDEF(ChaosResistance);
+
+        FPoE2DamageStatics()
+        {
+            DEFINE_ATTRIBUTE_CAPTUREDEF(UAttributeSet_Combat, Armour, Target, false);
+            DEFINE_ATTRIBUTE_CAPTUREDEF(UAttributeSet_Combat, FireResistance, Target, false);
+            DEFINE_ATTRIBUTE_CAPTUREDEF(UAttributeSet_Combat, ColdResistance, Target, false);
+            DEFINE_ATTRIBUTE_CAPTUREDEF(UAttributeSet_Combat, LightningResistance, Target, false);
+            DEFINE_ATTRIBUTE_CAPTUREDEF(UAttributeSet_Combat, ChaosResistance, Target, false);
+        }
+    };
+
+    const FPoE2DamageStatics& DamageStatics()
+    {
+        static FPoE2DamageStatics Statics;
+        return Statics;
+    }
+
+    float CaptureTargetValue(const FGameplayEffectCustomExecutionParameters& ExecutionParams, const FGameplayEffectAttributeCaptureDefinition& Definition, const FAggregatorEvaluateParameters& EvaluationParameters)
+    {
+        float Value = 0.0f;
+        ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(Definition, EvaluationParameters, Value);
+        return Value;
+    }
+}
 
 UExec_Damage::UExec_Damage()
 {
@@ -12,6 +49,13 @@ UExec_Damage::UExec_Damage()
         EGameplayEffectAttributeCaptureSource::Target,
         false
     ));
+
+    // Defences used by the damage kernel
+    RelevantAttributesToCapture.Add(DamageStatics().ArmourDef);
+    RelevantAttributesToCapture.Add(DamageStatics().FireResistanceDef);
+    RelevantAttributesToCapture.Add(DamageStatics().ColdResistanceDef);
+    RelevantAttributesToCapture.Add(DamageStatics().LightningResistanceDef);
+    RelevantAttributesToCapture.Add(DamageStatics().ChaosResistanceDef);
 }
 
 void UExec_Damage::Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams, FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const
@@ -26,17 +70,56 @@ void UExec_Damage::Execute_Implementation(const FGameplayEffectCustomExecutionPa
         return;
     }
 
-    // Read damage from SetByCaller using the Data.Damage tag
-    float DamageValue = Spec.GetSetByCallerMagnitude(FPoE2Tags::Get().Data_Damage, false, 0.0f);
+    // Prefer the per-type vector from the context; fall back to Data.Damage as a single-type hit
+    FPoE2DamageVector IncomingDamage;
+    const FPoE2GameplayEffectContext* Context = FPoE2GameplayEffectContext::Get(Spec.GetContext());
+    if (Context && Context->HasDamage())
+    {
+        IncomingDamage = Context->GetDamage();
+    }
+    else
+    {
+        const float DamageValue = Spec.GetSetByCallerMagnitude(FPoE2Tags::Get().Data_Damage, false, 0.0f);
+        const FGameplayTag DamageTypeTag = PoE2DamageType::FindDamageTypeTag(Spec.GetDynamicAssetTags());
+        IncomingDamage = FPoE2DamageVector::Single(PoE2DamageType::FromTag(DamageTypeTag), DamageValue);
+    }
 
-    if (DamageValue <= 0.0f)
+    if (IncomingDamage.Total() <= 0.0f)
     {
-        UE_LOG(LogPoE2Framework, Log, TEXT("Exec_Damage: No damage to apply (%.2f)"), DamageValue);
+        UE_LOG(LogPoE2Framework, Log, TEXT("Exec_Damage: No damage to apply (%.2f)"), IncomingDamage.Total());
         return;
     }
 
-    UE_LOG(LogPoE2Framework, Log, TEXT("Exec_Damage: Applying %.2f damage"), DamageValue);
+    FAggregatorEvaluateParameters EvaluationParameters;
+    EvaluationParameters.SourceTags = Spec.CapturedSourceTags.GetAggregatedTags();
+    EvaluationParameters.TargetTags = Spec.CapturedTargetTags.GetAggregatedTags();
+
+    const FPoE2DamageStatics& Statics = DamageStatics();
+    FPoE2DefenceProfile Defence;
+    if (!Spec.GetDynamicAssetTags().HasTagExact(FPoE2Tags::Get().Damage_OverTime))
+    {
+        // Armour only mitigates hits
+        Defence.Armour = CaptureTargetValue(ExecutionParams, Statics.ArmourDef, EvaluationParameters);
+    }
+    Defence.Resistances[static_cast<int32>(EPoE2DamageType::Fire)] = CaptureTargetValue(ExecutionParams, Statics.FireResistanceDef, EvaluationParameters);
+    Defence.Resistances[static_cast<int32>(EPoE2DamageType::Cold)] = CaptureTargetValue(ExecutionParams, Statics.ColdResistanceDef, EvaluationParameters);
+    Defence.Resistances[static_cast<int32>(EPoE2DamageType::Lightning)] = CaptureTargetValue(ExecutionParams, Statics.LightningResistanceDef, EvaluationParameters);
+    Defence.Resistances[static_cast<int32>(EPoE2DamageType::Chaos)] = CaptureTargetValue(ExecutionParams, Statics.ChaosResistanceDef, EvaluationParameters);
+
+    // Conversion already happened on the source side (PoE2DamageKernel::MakeHitDamage).
+    // An aggregated execution mitigates each of its hits, so batching never changes the result.
+    const TConstArrayView<FPoE2DamageVector> HitDamages = Context ? Context->GetHitDamages() : TConstArrayView<FPoE2DamageVector>();
+    const float FinalDamage = HitDamages.Num() > 0
+        ? PoE2DamageKernel::MitigateHits(HitDamages, Defence).Total()
+        : PoE2DamageKernel::Mitigate(IncomingDamage, Defence).Total();
+
+    UE_LOG(LogPoE2Framework, Log, TEXT("Exec_Damage: Applying %.2f damage (%.2f before mitigation)"), FinalDamage, IncomingDamage.Total());
+
+    if (FinalDamage <= 0.0f)
+    {
+        return;
+    }
 
     // Apply damage to Health attribute (negative modifier to reduce health)
-    OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(UAttributeSet_Core::GetHealthAttribute(), EGameplayModOp::Additive, -DamageValue));
-}
\ No newline at end of file
+    OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(UAttributeSet_Core::GetHealthAttribute(), EGameplayModOp::Additive, -FinalDamage));
+}
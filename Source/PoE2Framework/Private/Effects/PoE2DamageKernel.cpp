@@ -0,0 +1,208 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Effects/PoE2DamageKernel.h"
+#include "Spec/SkillSpec.h"
+#include "Effects/PoE2HitConditions.h"
+#include "Core/PoE2Tags.h"
+
+namespace PoE2DamageType
+{
+    EPoE2DamageType FromTag(const FGameplayTag& Tag)
+    {
+        const FPoE2Tags& Tags = FPoE2Tags::Get();
+        if (Tag == Tags.Damage_Type_Lightning) { return EPoE2DamageType::Lightning; }
+        if (Tag == Tags.Damage_Type_Cold) { return EPoE2DamageType::Cold; }
+        if (Tag == Tags.Damage_Type_Fire) { return EPoE2DamageType::Fire; }
+        if (Tag == Tags.Damage_Type_Chaos) { return EPoE2DamageType::Chaos; }
+        return EPoE2DamageType::Physical;
+    }
+
+    FGameplayTag ToTag(EPoE2DamageType Type)
+    {
+        const FPoE2Tags& Tags = FPoE2Tags::Get();
+        switch (Type)
+        {
+        case EPoE2DamageType::Lightning: return Tags.Damage_Type_Lightning;
+        case EPoE2DamageType::Cold: return Tags.Damage_Type_Cold;
+        case EPoE2DamageType::Fire: return Tags.Damage_Type_Fire;
+        case EPoE2DamageType::Chaos: return Tags.Damage_Type_Chaos;
+        default: return Tags.Damage_Type_Physical;
+        }
+    }
+
+    const TCHAR* ToString(EPoE2DamageType Type)
+    {
+        static const TCHAR* Names[Num] = { TEXT("Physical"), TEXT("Lightning"), TEXT("Cold"), TEXT("Fire"), TEXT("Chaos") };
+        const int32 Index = static_cast<int32>(Type);
+        return Index >= 0 && Index < Num ? Names[Index] : TEXT("Invalid");
+    }
+
+    FGameplayTag FindDamageTypeTag(const FGameplayTagContainer& Tags)
+    {
+        const FGameplayTag& DamageTypeParent = FPoE2Tags::Get().Damage_Type;
+        for (const FGameplayTag& Tag : Tags)
+        {
+            if (Tag != DamageTypeParent && Tag.MatchesTag(DamageTypeParent))
+            {
+                return Tag;
+            }
+        }
+        return FGameplayTag();
+    }
+}
+
+namespace
+{
+    struct FConversionParamKey
+    {
+        bool bGainAsExtra;
+        int32 From;
+        int32 To;
+    };
+
+    /** Every valid Damage.Conversion.* / Damage.GainAsExtra.* key, built once. */
+    const TMap<FName, FConversionParamKey>& GetConversionParamKeys()
+    {
+        static const TMap<FName, FConversionParamKey> Keys = []()
+        {
+            TMap<FName, FConversionParamKey> Result;
+            for (int32 From = 0; From < PoE2DamageType::Num; ++From)
+            {
+                for (int32 To = From + 1; To < PoE2DamageType::Num; ++To)
+                {
+                    const TCHAR* FromName = PoE2DamageType::ToString(static_cast<EPoE2DamageType>(From));
+                    const TCHAR* ToName = PoE2DamageType::ToString(static_cast<EPoE2DamageType>(To));
+                    Result.Add(FName(*FString::Printf(TEXT("Damage.Conversion.%sTo%s"), FromName, ToName)), { false, From, To });
+                    Result.Add(FName(*FString::Printf(TEXT("Damage.GainAsExtra.%sTo%s"), FromName, ToName)), { true, From, To });
+                }
+            }
+            return Result;
+        }();
+        return Keys;
+    }
+}
+
+FPoE2DamageConversion FPoE2DamageConversion::FromSkillSpec(const FSkillSpec& Spec)
+{
+    FPoE2DamageConversion Conversion;
+
+    const TMap<FName, FConversionParamKey>& Keys = GetConversionParamKeys();
+    for (const FCustomParam& Param : Spec.CustomParams)
+    {
+        if (const FConversionParamKey* Key = Keys.Find(Param.Key))
+        {
+            float(&Table)[PoE2DamageType::Num][PoE2DamageType::Num] = Key->bGainAsExtra ? Conversion.GainAsExtra : Conversion.Convert;
+            Table[Key->From][Key->To] += Param.Value;
+            Conversion.bIsIdentity &= Param.Value == 0.0f;
+        }
+    }
+
+    return Conversion;
+}
+
+namespace PoE2DamageKernel
+{
+    FPoE2DamageVector ApplyConversion(const FPoE2DamageVector& Damage, const FPoE2DamageConversion& Conversion)
+    {
+        if (Conversion.bIsIdentity)
+        {
+            return Damage;
+        }
+
+        FPoE2DamageVector Result = Damage;
+
+        // Forward pass: by the time a lane is processed it already holds everything converted into it,
+        // so chained conversion (physical -> cold -> fire) falls out naturally.
+        for (int32 From = 0; From < PoE2DamageType::Num; ++From)
+        {
+            const float Amount = Result.Values[From];
+            if (Amount <= 0.0f)
+            {
+                continue;
+            }
+
+            float TotalConverted = 0.0f;
+            for (int32 To = From + 1; To < PoE2DamageType::Num; ++To)
+            {
+                TotalConverted += FMath::Max(0.0f, Conversion.Convert[From][To]);
+            }
+
+            // Conversion above 100% is scaled down proportionally
+            const float ConversionScale = TotalConverted > 1.0f ? 1.0f / TotalConverted : 1.0f;
+
+            for (int32 To = From + 1; To < PoE2DamageType::Num; ++To)
+            {
+                const float Converted = FMath::Max(0.0f, Conversion.Convert[From][To]) * ConversionScale;
+                const float Extra = FMath::Max(0.0f, Conversion.GainAsExtra[From][To]);
+                Result.Values[To] += Amount * (Converted + Extra);
+            }
+
+            Result.Values[From] = Amount * (1.0f - FMath::Min(TotalConverted, 1.0f));
+        }
+
+        return Result;
+    }
+
+    float ArmourDamageReduction(float Armour, float PhysicalDamage)
+    {
+        if (Armour <= 0.0f || PhysicalDamage <= 0.0f)
+        {
+            return 0.0f;
+        }
+
+        return FMath::Min(Armour / (Armour + 10.0f * PhysicalDamage), MaxArmourReduction);
+    }
+
+    FPoE2DamageVector Mitigate(const FPoE2DamageVector& Damage, const FPoE2DefenceProfile& Defence)
+    {
+        FPoE2DamageVector Result = Damage;
+
+        Result[EPoE2DamageType::Physical] *= 1.0f - ArmourDamageReduction(Defence.Armour, Damage[EPoE2DamageType::Physical]);
+
+        for (int32 Index = 0; Index < PoE2DamageType::Num; ++Index)
+        {
+            // Negative resistance amplifies damage
+            const float Resistance = FMath::Min(Defence.Resistances[Index], MaxResistance);
+            Result.Values[Index] = FMath::Max(0.0f, Result.Values[Index] * (1.0f - Resistance));
+        }
+
+        return Result;
+    }
+
+    FPoE2DamageVector MitigateHits(TConstArrayView<FPoE2DamageVector> Hits, const FPoE2DefenceProfile& Defence)
+    {
+        FPoE2DamageVector Result;
+        for (const FPoE2DamageVector& Hit : Hits)
+        {
+            Result += Mitigate(Hit, Defence);
+        }
+        return Result;
+    }
+
+    FPoE2DamageVector MakeHitDamage(const FSkillSpec& Spec)
+    {
+        const EPoE2DamageType BaseType = PoE2DamageType::FromTag(PoE2DamageType::FindDamageTypeTag(Spec.SkillTags));
+        return ApplyConversion(FPoE2DamageVector::Single(BaseType, Spec.FinalDamage), FPoE2DamageConversion::FromSkillSpec(Spec));
+    }
+
+    FPoE2DamageVector ApplyHitConditions(const FPoE2DamageVector& Damage, const FPoE2HitConditionProgram& Conditions, const FPoE2HitConditionContext& Context)
+    {
+        FPoE2DamageVector Result = Damage;
+        Result *= Conditions.Evaluate(Context);
+        return Result;
+    }
+
+    void ResolveBatch(TConstArrayView<FPoE2DamageVector> In, const FPoE2DamageConversion& Conversion, TConstArrayView<FPoE2DefenceProfile> Defences, TArrayView<FPoE2DamageVector> Out)
+    {
+        check(Out.Num() >= In.Num());
+        check(Defences.Num() == 1 || Defences.Num() >= In.Num());
+
+        const bool bSharedDefence = Defences.Num() == 1;
+        for (int32 Index = 0; Index < In.Num(); ++Index)
+        {
+            Out[Index] = Mitigate(ApplyConversion(In[Index], Conversion), Defences[bSharedDefence ? 0 : Index]);
+        }
+    }
+}
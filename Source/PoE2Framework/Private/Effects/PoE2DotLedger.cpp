@@ -0,0 +1,246 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Effects/PoE2DotLedger.h"
+#include "AbilitySystemComponent.h"
+
+bool FPoE2DotLedger::Add(const FPoE2DotApplication& Application, double Now)
+{
+    if (!Application.Target || Application.DamagePerSecond <= 0.0f || Application.Duration <= 0.0f)
+    {
+        return false;
+    }
+
+    const int32 Slot = AcquireTargetSlot(Application.Target);
+    const EPoE2DamageType Type = PoE2DamageType::FromTag(Application.DamageType);
+    if (GetTypeCount(Slot, Type)++ == 0)
+    {
+        PendingTypeChanges.Add({ TargetTable[Slot], Type, true });
+    }
+
+    TargetSlots.Add(Slot);
+    Sources.Add(Application.Source.Get());
+    DamagePerSecond.Add(Application.DamagePerSecond);
+    StartTimes.Add(Now);
+    ExpiryTimes.Add(Now + Application.Duration);
+    StackGroups.Add(Application.StackGroup);
+    StackingRules.Add(Application.Stacking);
+    DamageTypes.Add(Type);
+    return true;
+}
+
+void FPoE2DotLedger::Tick(double Now, float DeltaTime, TArray<FPoE2DotTargetDamage>& OutDamage)
+{
+    OutDamage.Reset();
+
+    const int32 NumInstances = DamagePerSecond.Num();
+    if (NumInstances == 0)
+    {
+        return;
+    }
+
+    const double WindowStart = Now - DeltaTime;
+
+    ScratchTargetDamage.Reset();
+    ScratchTargetDamage.SetNum(TargetTable.Num());
+    ScratchTargetSource.Reset();
+    ScratchTargetSource.SetNumUninitialized(TargetTable.Num());
+    for (int32& SourceIndex : ScratchTargetSource)
+    {
+        SourceIndex = INDEX_NONE;
+    }
+    ScratchStrongest.Reset();
+
+    auto WindowDamage = [this, WindowStart, Now](int32 Index)
+    {
+        const double ActiveFrom = FMath::Max(WindowStart, StartTimes[Index]);
+        const double ActiveTo = FMath::Min(Now, ExpiryTimes[Index]);
+        return DamagePerSecond[Index] * static_cast<float>(FMath::Max(0.0, ActiveTo - ActiveFrom));
+    };
+
+    // Pass 1: integrate every row over the window. Unlimited stacks accumulate directly,
+    // strongest-only stacks keep the highest-DPS row per (target, group): a stronger instance that
+    // expires mid-window still beats a weaker one that ran the whole window.
+    for (int32 Index = 0; Index < NumInstances; ++Index)
+    {
+        const float Damage = WindowDamage(Index);
+        if (Damage <= 0.0f)
+        {
+            continue;
+        }
+
+        const int32 Slot = TargetSlots[Index];
+        if (StackingRules[Index] == EPoE2DotStacking::Unlimited)
+        {
+            ScratchTargetDamage[Slot][DamageTypes[Index]] += Damage;
+            ScratchTargetSource[Slot] = Index;
+        }
+        else
+        {
+            int32& Best = ScratchStrongest.FindOrAdd(TPair<int32, FName>(Slot, StackGroups[Index]), INDEX_NONE);
+            if (Best == INDEX_NONE || DamagePerSecond[Index] > DamagePerSecond[Best])
+            {
+                Best = Index;
+            }
+        }
+    }
+
+    for (const TPair<TPair<int32, FName>, int32>& Strongest : ScratchStrongest)
+    {
+        const int32 Slot = Strongest.Key.Key;
+        const int32 Index = Strongest.Value;
+        ScratchTargetDamage[Slot][DamageTypes[Index]] += WindowDamage(Index);
+        ScratchTargetSource[Slot] = Index;
+    }
+
+    // Pass 2: one aggregated entry per damaged target
+    for (int32 Slot = 0; Slot < ScratchTargetDamage.Num(); ++Slot)
+    {
+        if (ScratchTargetDamage[Slot].Total() > 0.0f && TargetTable[Slot].IsValid())
+        {
+            FPoE2DotTargetDamage& Entry = OutDamage.AddDefaulted_GetRef();
+            Entry.Target = TargetTable[Slot];
+            Entry.Source = Sources.IsValidIndex(ScratchTargetSource[Slot]) ? Sources[ScratchTargetSource[Slot]] : nullptr;
+            Entry.Damage = ScratchTargetDamage[Slot];
+        }
+    }
+
+    // Pass 3: drop expired rows and rows whose target is gone
+    for (int32 Index = DamagePerSecond.Num() - 1; Index >= 0; --Index)
+    {
+        if (ExpiryTimes[Index] <= Now || !TargetTable[TargetSlots[Index]].IsValid())
+        {
+            RemoveInstanceAtSwap(Index);
+        }
+    }
+}
+
+void FPoE2DotLedger::RemoveTarget(const UAbilitySystemComponent* Target)
+{
+    const int32* Slot = TargetSlotLookup.Find(TObjectKey<UAbilitySystemComponent>(const_cast<UAbilitySystemComponent*>(Target)));
+    if (!Slot)
+    {
+        return;
+    }
+
+    const int32 TargetSlot = *Slot;
+    for (int32 Index = TargetSlots.Num() - 1; Index >= 0; --Index)
+    {
+        if (TargetSlots[Index] == TargetSlot)
+        {
+            RemoveInstanceAtSwap(Index);
+        }
+    }
+}
+
+void FPoE2DotLedger::Reset()
+{
+    for (int32 Slot = 0; Slot < TargetTable.Num(); ++Slot)
+    {
+        for (int32 Type = 0; Type < PoE2DamageType::Num; ++Type)
+        {
+            if (GetTypeCount(Slot, static_cast<EPoE2DamageType>(Type)) > 0)
+            {
+                PendingTypeChanges.Add({ TargetTable[Slot], static_cast<EPoE2DamageType>(Type), false });
+            }
+        }
+    }
+
+    TargetSlots.Reset();
+    Sources.Reset();
+    DamagePerSecond.Reset();
+    StartTimes.Reset();
+    ExpiryTimes.Reset();
+    StackGroups.Reset();
+    StackingRules.Reset();
+    DamageTypes.Reset();
+
+    TargetTable.Reset();
+    TargetKeys.Reset();
+    TargetRefCounts.Reset();
+    TargetTypeCounts.Reset();
+    FreeTargetSlots.Reset();
+    TargetSlotLookup.Reset();
+}
+
+int32 FPoE2DotLedger::NumOnTarget(const UAbilitySystemComponent* Target) const
+{
+    const int32* Slot = TargetSlotLookup.Find(TObjectKey<UAbilitySystemComponent>(const_cast<UAbilitySystemComponent*>(Target)));
+    return Slot ? TargetRefCounts[*Slot] : 0;
+}
+
+bool FPoE2DotLedger::HasDamageType(const UAbilitySystemComponent* Target, EPoE2DamageType Type) const
+{
+    const int32* Slot = TargetSlotLookup.Find(TObjectKey<UAbilitySystemComponent>(const_cast<UAbilitySystemComponent*>(Target)));
+    return Slot && TargetTypeCounts[*Slot * PoE2DamageType::Num + static_cast<int32>(Type)] > 0;
+}
+
+void FPoE2DotLedger::ConsumeTypeChanges(TArray<FPoE2DotTypeChange>& OutChanges)
+{
+    OutChanges = MoveTemp(PendingTypeChanges);
+    PendingTypeChanges.Reset();
+}
+
+int32 FPoE2DotLedger::AcquireTargetSlot(UAbilitySystemComponent* Target)
+{
+    const TObjectKey<UAbilitySystemComponent> Key(Target);
+    if (const int32* Existing = TargetSlotLookup.Find(Key))
+    {
+        ++TargetRefCounts[*Existing];
+        return *Existing;
+    }
+
+    int32 Slot;
+    if (FreeTargetSlots.Num() > 0)
+    {
+        Slot = FreeTargetSlots.Pop(EAllowShrinking::No);
+        TargetTable[Slot] = Target;
+        TargetKeys[Slot] = Key;
+        TargetRefCounts[Slot] = 1;
+    }
+    else
+    {
+        Slot = TargetTable.Add(Target);
+        TargetKeys.Add(Key);
+        TargetRefCounts.Add(1);
+        TargetTypeCounts.AddZeroed(PoE2DamageType::Num);
+    }
+
+    TargetSlotLookup.Add(Key, Slot);
+    return Slot;
+}
+
+void FPoE2DotLedger::ReleaseTargetSlot(int32 Slot)
+{
+    if (--TargetRefCounts[Slot] > 0)
+    {
+        return;
+    }
+
+    // The slot keeps its own key: the weak pointer may already be stale
+    TargetSlotLookup.Remove(TargetKeys[Slot]);
+    TargetKeys[Slot] = TObjectKey<UAbilitySystemComponent>();
+    TargetTable[Slot].Reset();
+    FreeTargetSlots.Add(Slot);
+}
+
+void FPoE2DotLedger::RemoveInstanceAtSwap(int32 Index)
+{
+    // Recorded before the slot is released: the change must still name the target
+    const int32 Slot = TargetSlots[Index];
+    if (--GetTypeCount(Slot, DamageTypes[Index]) == 0)
+    {
+        PendingTypeChanges.Add({ TargetTable[Slot], DamageTypes[Index], false });
+    }
+    ReleaseTargetSlot(Slot);
+
+    TargetSlots.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Sources.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    DamagePerSecond.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    StartTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    ExpiryTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    StackGroups.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    StackingRules.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    DamageTypes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
@@ -0,0 +1,142 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Effects/PoE2DotSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "Core/PoE2Tags.h"
+#include "Effects/GE_Damage.h"
+#include "Effects/PoE2GameplayEffectContext.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("PoE2 DoT Ledger Tick"), STAT_PoE2DotLedgerTick, STATGROUP_Game);
+
+bool UPoE2DotSubsystem::ApplyDot(const FPoE2DotApplication& Application)
+{
+    if (!IsServerWorld())
+    {
+        return false;
+    }
+
+    if (!Ledger.Add(Application, GetWorld()->GetTimeSeconds()))
+    {
+        return false;
+    }
+
+    // The status goes on straight away so hits this frame already see it
+    ApplyStatusChanges();
+    return true;
+}
+
+void UPoE2DotSubsystem::RemoveDotsOnTarget(UAbilitySystemComponent* Target)
+{
+    Ledger.RemoveTarget(Target);
+    ApplyStatusChanges();
+}
+
+void UPoE2DotSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (Ledger.Num() == 0 || !IsServerWorld())
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_PoE2DotLedgerTick);
+
+    Ledger.Tick(GetWorld()->GetTimeSeconds(), DeltaTime, PendingDamage);
+
+    for (const FPoE2DotTargetDamage& Entry : PendingDamage)
+    {
+        ApplyDamage(Entry);
+    }
+
+    // Expired instances drop their status only after their last damage
+    ApplyStatusChanges();
+}
+
+void UPoE2DotSubsystem::ApplyDamage(const FPoE2DotTargetDamage& Entry)
+{
+    UAbilitySystemComponent* TargetASC = Entry.Target.Get();
+    if (!TargetASC)
+    {
+        return;
+    }
+
+    // A DoT outlives its source; once the source is gone the target applies the damage to itself
+    UAbilitySystemComponent* SourceASC = Entry.Source.IsValid() ? Entry.Source.Get() : TargetASC;
+
+    FGameplayEffectContextHandle ContextHandle = SourceASC->MakeEffectContext();
+    if (FPoE2GameplayEffectContext* PoE2Context = FPoE2GameplayEffectContext::Get(ContextHandle))
+    {
+        PoE2Context->SetDamage(Entry.Damage);
+    }
+
+    FGameplayEffectSpecHandle SpecHandle = SourceASC->MakeOutgoingSpec(UGE_Damage::StaticClass(), 1.0f, ContextHandle);
+    if (!SpecHandle.IsValid())
+    {
+        return;
+    }
+
+    const FPoE2Tags& Tags = FPoE2Tags::Get();
+    SpecHandle.Data->SetSetByCallerMagnitude(Tags.Data_Damage, Entry.Damage.Total());
+    SpecHandle.Data->AddDynamicAssetTag(Tags.Damage_OverTime);
+
+    SourceASC->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), TargetASC);
+}
+
+void UPoE2DotSubsystem::ApplyStatusChanges()
+{
+    Ledger.ConsumeTypeChanges(PendingTypeChanges);
+    for (const FPoE2DotTypeChange& Change : PendingTypeChanges)
+    {
+        UAbilitySystemComponent* TargetASC = Change.Target.Get();
+        const FGameplayTag StatusTag = GetStatusTag(Change.Type);
+        if (!TargetASC || !StatusTag.IsValid())
+        {
+            continue;
+        }
+
+        // Loose tags are counted, so statuses from other sources stack with ours instead of being overwritten
+        if (Change.bActive)
+        {
+            TargetASC->AddLooseGameplayTag(StatusTag);
+            TargetASC->AddReplicatedLooseGameplayTag(StatusTag);
+        }
+        else
+        {
+            TargetASC->RemoveLooseGameplayTag(StatusTag);
+            TargetASC->RemoveReplicatedLooseGameplayTag(StatusTag);
+        }
+    }
+    PendingTypeChanges.Reset();
+}
+
+FGameplayTag UPoE2DotSubsystem::GetStatusTag(EPoE2DamageType Type)
+{
+    const FPoE2Tags& Tags = FPoE2Tags::Get();
+    switch (Type)
+    {
+    case EPoE2DamageType::Physical: return Tags.Status_Bleeding;
+    case EPoE2DamageType::Fire:     return Tags.Status_Burning;
+    case EPoE2DamageType::Chaos:    return Tags.Status_Poisoned;
+    default:                        return FGameplayTag();
+    }
+}
+
+TStatId UPoE2DotSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UPoE2DotSubsystem, STATGROUP_Tickables);
+}
+
+bool UPoE2DotSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UPoE2DotSubsystem::IsServerWorld() const
+{
+    const UWorld* World = GetWorld();
+    return World && World->GetNetMode() != NM_Client;
+}
@@ -0,0 +1,64 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Effects/PoE2GameplayEffectContext.h"
+
+FPoE2GameplayEffectContext* FPoE2GameplayEffectContext::Get(FGameplayEffectContextHandle& Handle)
+{
+    FGameplayEffectContext* Context = Handle.Get();
+    if (Context && Context->GetScriptStruct()->IsChildOf(StaticStruct()))
+    {
+        return static_cast<FPoE2GameplayEffectContext*>(Context);
+    }
+    return nullptr;
+}
+
+const FPoE2GameplayEffectContext* FPoE2GameplayEffectContext::Get(const FGameplayEffectContextHandle& Handle)
+{
+    const FGameplayEffectContext* Context = Handle.Get();
+    if (Context && Context->GetScriptStruct()->IsChildOf(StaticStruct()))
+    {
+        return static_cast<const FPoE2GameplayEffectContext*>(Context);
+    }
+    return nullptr;
+}
+
+FGameplayEffectContext* FPoE2GameplayEffectContext::Duplicate() const
+{
+    FPoE2GameplayEffectContext* NewContext = new FPoE2GameplayEffectContext();
+    *NewContext = *this;
+    if (GetHitResult())
+    {
+        // Deep copy the hit result, the base copy only shares the pointer
+        NewContext->AddHitResult(*GetHitResult(), true);
+    }
+    return NewContext;
+}
+
+bool FPoE2GameplayEffectContext::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    if (!Super::NetSerialize(Ar, Map, bOutSuccess))
+    {
+        return false;
+    }
+
+    // One bit when there is no damage (most cue-only contexts)
+    uint8 bHasDamage = Ar.IsSaving() ? (HasDamage() ? 1 : 0) : 0;
+    Ar.SerializeBits(&bHasDamage, 1);
+
+    if (bHasDamage)
+    {
+        for (float& Value : Damage.Values)
+        {
+            Ar << Value;
+        }
+    }
+    else if (Ar.IsLoading())
+    {
+        Damage = FPoE2DamageVector();
+    }
+
+    bOutSuccess = true;
+    return true;
+}
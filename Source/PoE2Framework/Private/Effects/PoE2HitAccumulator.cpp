@@ -0,0 +1,185 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Effects/PoE2HitAccumulator.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "Spec/SkillSpec.h"
+#include "Core/PoE2Log.h"
+#include "Core/PoE2Tags.h"
+#include "Effects/PoE2GameplayEffectContext.h"
+#include "Effects/PoE2DamageKernel.h"
+#include "Effects/PoE2HitConditions.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("PoE2 Hit Accumulator Flush"), STAT_PoE2HitAccumulatorFlush, STATGROUP_Game);
+
+void UPoE2HitAccumulatorSubsystem::SubmitHit(UObject* SourceObject, UAbilitySystemComponent* SourceASC, UAbilitySystemComponent* TargetASC, const FSkillSpec& Spec, const FPoE2DamageVector& HitDamage, const FHitResult& HitResult)
+{
+    if (!SourceASC || !TargetASC || !Spec.DamageEffectClass)
+    {
+        return;
+    }
+
+    // Damage is server-authoritative; a client that simulates the carrier must not queue or apply it
+    UWorld* World = SourceObject ? SourceObject->GetWorld() : nullptr;
+    if (World && World->GetNetMode() == NM_Client)
+    {
+        return;
+    }
+
+    FPoE2HitRecord Hit;
+    Hit.SourceASC = SourceASC;
+    Hit.TargetASC = TargetASC;
+    Hit.SourceObject = SourceObject;
+    Hit.EffectClass = Spec.DamageEffectClass;
+    Hit.DamageType = PoE2DamageType::FindDamageTypeTag(Spec.SkillTags);
+    Hit.Damage = HitDamage;
+
+    // Conditions read the target as it is now, not at flush time; the carrier's cached damage stays unconditional
+    if (const FPoE2HitConditionProgram* Conditions = Spec.GetHitConditions().Get())
+    {
+        Hit.Damage = PoE2DamageKernel::ApplyHitConditions(HitDamage, *Conditions, FPoE2HitConditionContext::Gather(SourceASC, TargetASC));
+    }
+    Hit.HitResult = HitResult;
+
+    if (UPoE2HitAccumulatorSubsystem* Accumulator = World ? World->GetSubsystem<UPoE2HitAccumulatorSubsystem>() : nullptr)
+    {
+        Accumulator->QueueHit(MoveTemp(Hit));
+        return;
+    }
+
+    // No accumulator (e.g. editor preview worlds): apply as a batch of one
+    FPoE2HitBatch Batch;
+    Batch.SourceASC = Hit.SourceASC;
+    Batch.TargetASC = Hit.TargetASC;
+    Batch.EffectClass = Hit.EffectClass;
+    Batch.DamageType = Hit.DamageType;
+    Batch.TotalDamage = Hit.Damage;
+    Batch.Hits.Add(MoveTemp(Hit));
+    ApplyBatch(Batch);
+}
+
+void UPoE2HitAccumulatorSubsystem::QueueHit(FPoE2HitRecord&& Hit)
+{
+    const FBatchKey Key{ Hit.SourceASC.Get(), Hit.TargetASC.Get(), Hit.EffectClass.Get(), Hit.DamageType };
+
+    int32 BatchIndex;
+    if (const int32* Existing = BatchLookup.Find(Key))
+    {
+        BatchIndex = *Existing;
+    }
+    else
+    {
+        BatchIndex = Batches.AddDefaulted();
+        FPoE2HitBatch& NewBatch = Batches[BatchIndex];
+        NewBatch.SourceASC = Hit.SourceASC;
+        NewBatch.TargetASC = Hit.TargetASC;
+        NewBatch.EffectClass = Hit.EffectClass;
+        NewBatch.DamageType = Hit.DamageType;
+        BatchLookup.Add(Key, BatchIndex);
+    }
+
+    FPoE2HitBatch& Batch = Batches[BatchIndex];
+    Batch.TotalDamage += Hit.Damage;
+    Batch.Hits.Add(MoveTemp(Hit));
+    ++NumPendingHits;
+}
+
+void UPoE2HitAccumulatorSubsystem::Flush()
+{
+    if (Batches.Num() == 0)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_PoE2HitAccumulatorFlush);
+
+    // Swap out first so hits submitted from inside an execution (reflect, on-hit triggers) land in the next flush
+    Swap(Batches, FlushingBatches);
+    Batches.Reset();
+    BatchLookup.Reset();
+
+    UE_LOG(LogPoE2Framework, Verbose, TEXT("HitAccumulator: Flushing %d hits as %d executions"), NumPendingHits, FlushingBatches.Num());
+    NumPendingHits = 0;
+
+    for (const FPoE2HitBatch& Batch : FlushingBatches)
+    {
+        ApplyBatch(Batch);
+        OnHitBatchApplied.Broadcast(Batch);
+    }
+    FlushingBatches.Reset();
+}
+
+void UPoE2HitAccumulatorSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    // Tickable objects run after all actor tick groups, so every hit of this frame is already queued
+    Flush();
+}
+
+TStatId UPoE2HitAccumulatorSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UPoE2HitAccumulatorSubsystem, STATGROUP_Tickables);
+}
+
+void UPoE2HitAccumulatorSubsystem::Deinitialize()
+{
+    Flush();
+
+    Super::Deinitialize();
+}
+
+bool UPoE2HitAccumulatorSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UPoE2HitAccumulatorSubsystem::ApplyBatch(const FPoE2HitBatch& Batch)
+{
+    UAbilitySystemComponent* SourceASC = Batch.SourceASC.Get();
+    UAbilitySystemComponent* TargetASC = Batch.TargetASC.Get();
+    if (!SourceASC || !TargetASC || Batch.Hits.Num() == 0)
+    {
+        return;
+    }
+
+    // The context carries the summed damage vector and the most recent hit; the full list is available through OnHitBatchApplied.
+    // Each hit's own damage rides along so UExec_Damage can apply armour per hit.
+    const FPoE2HitRecord& LastHit = Batch.Hits.Last();
+    FGameplayEffectContextHandle ContextHandle = SourceASC->MakeEffectContext();
+    ContextHandle.AddSourceObject(LastHit.SourceObject.Get());
+    ContextHandle.AddHitResult(LastHit.HitResult);
+    if (FPoE2GameplayEffectContext* PoE2Context = FPoE2GameplayEffectContext::Get(ContextHandle))
+    {
+        PoE2Context->SetDamage(Batch.TotalDamage);
+        if (Batch.Hits.Num() > 1)
+        {
+            TArray<FPoE2DamageVector> HitDamages;
+            HitDamages.Reserve(Batch.Hits.Num());
+            for (const FPoE2HitRecord& Hit : Batch.Hits)
+            {
+                HitDamages.Add(Hit.Damage);
+            }
+            PoE2Context->SetHitDamages(MoveTemp(HitDamages));
+        }
+    }
+
+    FGameplayEffectSpecHandle SpecHandle = SourceASC->MakeOutgoingSpec(Batch.EffectClass, 1.0f, ContextHandle);
+    if (!SpecHandle.IsValid())
+    {
+        return;
+    }
+
+    const FPoE2Tags& Tags = FPoE2Tags::Get();
+    SpecHandle.Data->SetSetByCallerMagnitude(Tags.Data_Damage, Batch.TotalDamage.Total());
+    SpecHandle.Data->SetSetByCallerMagnitude(Tags.Data_HitCount, static_cast<float>(Batch.Hits.Num()));
+    if (Batch.DamageType.IsValid())
+    {
+        SpecHandle.Data->AddDynamicAssetTag(Batch.DamageType);
+    }
+
+    SourceASC->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), TargetASC);
+}
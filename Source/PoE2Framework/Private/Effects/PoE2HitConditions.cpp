@@ -0,0 +1,167 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Effects/PoE2HitConditions.h"
+#include "AbilitySystemComponent.h"
+#include "Attributes/AttributeSet_Core.h"
+
+namespace
+{
+    void FillSide(const FGameplayTagContainer& Tags, float Life, float MaxLife, const FPoE2TagBitTable& Table, FPoE2TagBits& OutBits, const FGameplayTagContainer*& OutTags, float& OutLife, float& OutLifeFraction)
+    {
+        OutTags = &Tags;
+        if (Table.IsComplete())
+        {
+            OutBits = Table.FromContainer(Tags);
+        }
+
+        OutLife = Life;
+        OutLifeFraction = MaxLife > 0.0f ? Life / MaxLife : 1.0f;
+    }
+
+    void GatherSide(const UAbilitySystemComponent* ASC, const FPoE2TagBitTable& Table, FPoE2TagBits& OutBits, const FGameplayTagContainer*& OutTags, float& OutLife, float& OutLifeFraction)
+    {
+        static const FGameplayTagContainer NoTags;
+        OutTags = &NoTags;
+        OutLife = 0.0f;
+        OutLifeFraction = 1.0f;
+        if (!ASC)
+        {
+            return;
+        }
+
+        float Life = 0.0f;
+        float MaxLife = 0.0f;
+        UAttributeSet_Core::GetLife(ASC, Life, MaxLife);
+        FillSide(ASC->GetOwnedGameplayTags(), Life, MaxLife, Table, OutBits, OutTags, OutLife, OutLifeFraction);
+    }
+}
+
+FPoE2HitConditionContext FPoE2HitConditionContext::Gather(const UAbilitySystemComponent* Source, const UAbilitySystemComponent* Target)
+{
+    const FPoE2TagBitTable& Table = FPoE2TagBitTable::Get();
+
+    FPoE2HitConditionContext Context;
+    Context.BitsGeneration = Table.GetGeneration();
+    GatherSide(Source, Table, Context.SourceBits, Context.SourceTags,
+        Context.Values[static_cast<int32>(EPoE2HitValue::SourceLife)], Context.Values[static_cast<int32>(EPoE2HitValue::SourceLifeFraction)]);
+    GatherSide(Target, Table, Context.TargetBits, Context.TargetTags,
+        Context.Values[static_cast<int32>(EPoE2HitValue::TargetLife)], Context.Values[static_cast<int32>(EPoE2HitValue::TargetLifeFraction)]);
+    return Context;
+}
+
+FPoE2HitConditionContext FPoE2HitConditionContext::Make(const FGameplayTagContainer& SourceTags, float SourceLife, float SourceMaxLife, const FGameplayTagContainer& TargetTags, float TargetLife, float TargetMaxLife)
+{
+    const FPoE2TagBitTable& Table = FPoE2TagBitTable::Get();
+
+    FPoE2HitConditionContext Context;
+    Context.BitsGeneration = Table.GetGeneration();
+    FillSide(SourceTags, SourceLife, SourceMaxLife, Table, Context.SourceBits, Context.SourceTags,
+        Context.Values[static_cast<int32>(EPoE2HitValue::SourceLife)], Context.Values[static_cast<int32>(EPoE2HitValue::SourceLifeFraction)]);
+    FillSide(TargetTags, TargetLife, TargetMaxLife, Table, Context.TargetBits, Context.TargetTags,
+        Context.Values[static_cast<int32>(EPoE2HitValue::TargetLife)], Context.Values[static_cast<int32>(EPoE2HitValue::TargetLifeFraction)]);
+    return Context;
+}
+
+TSharedPtr<const FPoE2HitConditionProgram> FPoE2HitConditionProgram::Compile(TConstArrayView<FPoE2ConditionalModifier> InModifiers)
+{
+    const FPoE2TagBitTable& Table = FPoE2TagBitTable::Get();
+
+    TSharedRef<FPoE2HitConditionProgram> Program = MakeShared<FPoE2HitConditionProgram>();
+    bool bAllMapped = Table.IsComplete();
+
+    for (const FPoE2ConditionalModifier& Modifier : InModifiers)
+    {
+        if (Modifier.Value == 0.0f)
+        {
+            continue;
+        }
+
+        FModifier& Compiled = Program->Modifiers.AddDefaulted_GetRef();
+        Compiled.FirstTerm = Program->Terms.Num();
+        Compiled.Increased = Modifier.Op == EPoE2HitModifierOp::Increased ? Modifier.Value : 0.0f;
+        Compiled.More = Modifier.Op == EPoE2HitModifierOp::More ? Modifier.Value : 0.0f;
+
+        for (const FPoE2HitCondition& Condition : Modifier.Conditions)
+        {
+            FTerm& Term = Program->Terms.AddDefaulted_GetRef();
+            Term.bNegate = Condition.bNegate ? 1 : 0;
+
+            if (Condition.Type == EPoE2HitConditionType::ValueAtLeast)
+            {
+                Term.Operand = EOperand::Value;
+                Term.ValueIndex = static_cast<uint8>(FMath::Min(static_cast<int32>(Condition.Value), static_cast<int32>(EPoE2HitValue::Count) - 1));
+                Term.Threshold = Condition.Threshold;
+                continue;
+            }
+
+            Term.Operand = Condition.Type == EPoE2HitConditionType::SourceHasTag ? EOperand::SourceTags : EOperand::TargetTags;
+            Term.Tag = Condition.Tag;
+            const int32 Bit = Table.FindBit(Condition.Tag);
+            bAllMapped &= Bit != INDEX_NONE;
+            if (Bit != INDEX_NONE)
+            {
+                Term.Mask = Table.GetDescendantMask(Bit);
+            }
+        }
+
+        Compiled.NumTerms = Program->Terms.Num() - Compiled.FirstTerm;
+    }
+
+    if (Program->Modifiers.Num() == 0)
+    {
+        return nullptr;
+    }
+
+    Program->Generation = bAllMapped ? Table.GetGeneration() : 0;
+    return Program;
+}
+
+uint32 FPoE2HitConditionProgram::TermsPassed(const FModifier& Modifier, const FPoE2HitConditionContext& Context, bool bUseBits) const
+{
+    uint32 Passed = 1;
+    for (int32 Index = Modifier.FirstTerm; Index < Modifier.FirstTerm + Modifier.NumTerms; ++Index)
+    {
+        const FTerm& Term = Terms[Index];
+
+        // Both tests are computed and one is selected, so the term costs the same whatever its kind or outcome
+        uint32 TagPassed;
+        if (bUseBits)
+        {
+            const FPoE2TagBits& Bits = Term.Operand == EOperand::SourceTags ? Context.SourceBits : Context.TargetBits;
+            uint64 Common = 0;
+            for (int32 Word = 0; Word < FPoE2TagBits::NumWords; ++Word)
+            {
+                Common |= Bits.Words[Word] & Term.Mask.Words[Word];
+            }
+            TagPassed = Common != 0;
+        }
+        else
+        {
+            const FGameplayTagContainer* Tags = Term.Operand == EOperand::SourceTags ? Context.SourceTags : Context.TargetTags;
+            TagPassed = Term.Operand != EOperand::Value && Tags && Tags->HasTag(Term.Tag);
+        }
+
+        const uint32 ValuePassed = Context.Values[Term.ValueIndex] >= Term.Threshold;
+        const uint32 IsValue = Term.Operand == EOperand::Value;
+        Passed &= ((ValuePassed & IsValue) | (TagPassed & (IsValue ^ 1))) ^ Term.bNegate;
+    }
+    return Passed;
+}
+
+float FPoE2HitConditionProgram::Evaluate(const FPoE2HitConditionContext& Context) const
+{
+    // The bits are usable only if both the program and the context were built against the current table
+    const bool bUseBits = Generation != 0 && Context.BitsGeneration == Generation;
+
+    float Increased = 0.0f;
+    float More = 1.0f;
+    for (const FModifier& Modifier : Modifiers)
+    {
+        const float Passed = static_cast<float>(TermsPassed(Modifier, Context, bUseBits));
+        Increased += Passed * Modifier.Increased;
+        More *= 1.0f + Passed * Modifier.More;
+    }
+    return (1.0f + Increased) * More;
+}
@@ -0,0 +1,115 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Items/PoE2AffixRollBenchmarkCommandlet.h"
+#include "Items/PoE2AffixRoller.h"
+#include "Data/AffixDataAsset.h"
+#include "Data/ItemBaseDataAsset.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Core/PoE2Log.h"
+
+namespace
+{
+    template<typename AssetType>
+    void LoadAllAssetsOfClass(TArray<const AssetType*>& OutAssets)
+    {
+        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+        AssetRegistry.SearchAllAssets(true);
+
+        TArray<FAssetData> AssetDatas;
+        AssetRegistry.GetAssetsByClass(AssetType::StaticClass()->GetClassPathName(), AssetDatas, true);
+
+        for (const FAssetData& AssetData : AssetDatas)
+        {
+            if (const AssetType* Asset = Cast<AssetType>(AssetData.GetAsset()))
+            {
+                OutAssets.Add(Asset);
+            }
+        }
+    }
+}
+
+UPoE2AffixRollBenchmarkCommandlet::UPoE2AffixRollBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UPoE2AffixRollBenchmarkCommandlet::Main(const FString& Params)
+{
+    int32 Count = 1000000;
+    FParse::Value(*Params, TEXT("Count="), Count);
+    Count = FMath::Max(1, Count);
+
+    int32 ItemLevel = 100;
+    FParse::Value(*Params, TEXT("ItemLevel="), ItemLevel);
+
+    int32 Seed = 1;
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+
+    FString BaseId;
+    FParse::Value(*Params, TEXT("Base="), BaseId);
+
+    TArray<const UItemBaseDataAsset*> Bases;
+    TArray<const UAffixDataAsset*> Affixes;
+    LoadAllAssetsOfClass(Bases);
+    LoadAllAssetsOfClass(Affixes);
+
+    const double CompileStart = FPlatformTime::Seconds();
+    const TSharedPtr<const FPoE2AffixRoller> Roller = FPoE2AffixRoller::Compile(Bases, Affixes);
+    const double CompileTime = FPlatformTime::Seconds() - CompileStart;
+    if (!Roller.IsValid() || Roller->NumBases() == 0)
+    {
+        UE_LOG(LogPoE2Framework, Error, TEXT("PoE2AffixRollBenchmark: No item bases to roll"));
+        return 1;
+    }
+
+    const UItemBaseDataAsset* const* Selected = Bases.FindByPredicate([&BaseId](const UItemBaseDataAsset* Base)
+    {
+        return Base->BaseId.ToString() == BaseId;
+    });
+    const int32 Base = Selected ? Roller->FindBase(*Selected) : 0;
+    if (!BaseId.IsEmpty() && !Selected)
+    {
+        UE_LOG(LogPoE2Framework, Warning, TEXT("PoE2AffixRollBenchmark: Unknown base %s, rolling base 0"), *BaseId);
+    }
+
+    UE_LOG(LogPoE2Framework, Display, TEXT("PoE2AffixRollBenchmark: %d bases, %d affixes, %d pools compiled in %.2fms"),
+        Roller->NumBases(), Roller->NumAffixes(), Roller->NumPools(), CompileTime * 1000.0);
+
+    const FPoE2AffixRollSettings Settings;
+
+    // Single thread: one stream, one reused item, so this is the sampler alone
+    FRandomStream Random(Seed);
+    FPoE2RolledItem Item;
+    int64 NumAffixesRolled = 0;
+    const double SerialStart = FPlatformTime::Seconds();
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        if (!Roller->Roll(Base, ItemLevel, Settings, Random, Item))
+        {
+            UE_LOG(LogPoE2Framework, Error, TEXT("PoE2AffixRollBenchmark: Nothing rolls at item level %d"), ItemLevel);
+            return 1;
+        }
+        NumAffixesRolled += Item.Affixes.Num();
+    }
+    const double SerialTime = FMath::Max(FPlatformTime::Seconds() - SerialStart, UE_DOUBLE_SMALL_NUMBER);
+
+    TArray<FPoE2RolledItem> Items;
+    const double BatchStart = FPlatformTime::Seconds();
+    Roller->RollBatch(Base, ItemLevel, Settings, Count, Seed, Items);
+    const double BatchTime = FMath::Max(FPlatformTime::Seconds() - BatchStart, UE_DOUBLE_SMALL_NUMBER);
+
+    // Workers plus the calling thread, which ParallelFor also uses
+    const int32 NumCores = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+
+    UE_LOG(LogPoE2Framework, Display, TEXT("PoE2AffixRollBenchmark: Single thread: %d items in %.2fms, %.0f items/s (%.2f affixes/item)"),
+        Count, SerialTime * 1000.0, Count / SerialTime, static_cast<double>(NumAffixesRolled) / Count);
+    UE_LOG(LogPoE2Framework, Display, TEXT("PoE2AffixRollBenchmark: Batch on %d cores: %d items in %.2fms, %.0f items/s, %.0f items/s per core"),
+        NumCores, Count, BatchTime * 1000.0, Count / BatchTime, Count / BatchTime / NumCores);
+    return 0;
+}
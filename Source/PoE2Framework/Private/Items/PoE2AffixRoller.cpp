@@ -0,0 +1,423 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Items/PoE2AffixRoller.h"
+#include "Data/AffixDataAsset.h"
+#include "Data/ItemBaseDataAsset.h"
+#include "Core/PoE2Log.h"
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+
+namespace PoE2AffixRoller
+{
+    /** Redraws before an exact pass over the remaining weights; only hit when most of a side is excluded. */
+    constexpr int32 MaxRejections = 8;
+
+    constexpr int32 ItemsPerBatchTask = 1024;
+
+    template<typename AssetType, typename KeyFunc>
+    void SortById(TArray<const AssetType*>& Assets, KeyFunc GetKey)
+    {
+        Assets.Sort([&GetKey](const AssetType& A, const AssetType& B)
+        {
+            const FName KeyA = GetKey(A);
+            const FName KeyB = GetKey(B);
+            if (KeyA != KeyB)
+            {
+                return KeyA.LexicalLess(KeyB);
+            }
+            return A.GetFName().LexicalLess(B.GetFName());
+        });
+    }
+}
+
+void FPoE2AffixRoller::FAliasTable::Build()
+{
+    const int32 Num = Affixes.Num();
+    Probability.SetNumUninitialized(Num);
+    Alias.SetNumUninitialized(Num);
+
+    TotalWeight = 0.0f;
+    for (const float Weight : Weights)
+    {
+        TotalWeight += Weight;
+    }
+    if (Num == 0 || TotalWeight <= 0.0f)
+    {
+        return;
+    }
+
+    // Vose: pair every under-full column with an over-full one until all columns hold exactly 1
+    TArray<float> Scaled;
+    Scaled.SetNumUninitialized(Num);
+    TArray<int32> Small;
+    TArray<int32> Large;
+    for (int32 Index = 0; Index < Num; ++Index)
+    {
+        Scaled[Index] = Weights[Index] * Num / TotalWeight;
+        (Scaled[Index] < 1.0f ? Small : Large).Add(Index);
+    }
+
+    while (Small.Num() > 0 && Large.Num() > 0)
+    {
+        const int32 Under = Small.Pop(EAllowShrinking::No);
+        const int32 Over = Large.Pop(EAllowShrinking::No);
+        Probability[Under] = Scaled[Under];
+        Alias[Under] = static_cast<uint16>(Over);
+        Scaled[Over] = (Scaled[Over] + Scaled[Under]) - 1.0f;
+        (Scaled[Over] < 1.0f ? Small : Large).Add(Over);
+    }
+
+    // Leftovers are 1 up to rounding
+    for (const int32 Index : Large)
+    {
+        Probability[Index] = 1.0f;
+        Alias[Index] = static_cast<uint16>(Index);
+    }
+    for (const int32 Index : Small)
+    {
+        Probability[Index] = 1.0f;
+        Alias[Index] = static_cast<uint16>(Index);
+    }
+}
+
+int32 FPoE2AffixRoller::FAliasTable::Sample(FRandomStream& Random, const FGroupMask& Excluded) const
+{
+    const int32 Num = Affixes.Num();
+    if (Num == 0 || TotalWeight <= 0.0f)
+    {
+        return INDEX_NONE;
+    }
+
+    for (int32 Attempt = 0; Attempt < PoE2AffixRoller::MaxRejections; ++Attempt)
+    {
+        const float Draw = Random.GetFraction() * Num;
+        const int32 Column = FMath::Min(static_cast<int32>(Draw), Num - 1);
+        const int32 Entry = (Draw - Column) < Probability[Column] ? Column : Alias[Column];
+        if (!Excluded.Contains(LocalGroups[Entry]))
+        {
+            return Entry;
+        }
+    }
+
+    float Remaining = 0.0f;
+    int32 LastAllowed = INDEX_NONE;
+    for (int32 Entry = 0; Entry < Num; ++Entry)
+    {
+        if (!Excluded.Contains(LocalGroups[Entry]))
+        {
+            Remaining += Weights[Entry];
+            LastAllowed = Entry;
+        }
+    }
+    if (LastAllowed == INDEX_NONE)
+    {
+        return INDEX_NONE;
+    }
+
+    float Pick = Random.GetFraction() * Remaining;
+    for (int32 Entry = 0; Entry < Num; ++Entry)
+    {
+        if (!Excluded.Contains(LocalGroups[Entry]))
+        {
+            Pick -= Weights[Entry];
+            if (Pick < 0.0f)
+            {
+                return Entry;
+            }
+        }
+    }
+    return LastAllowed;
+}
+
+TSharedPtr<const FPoE2AffixRoller> FPoE2AffixRoller::Compile(TConstArrayView<const UItemBaseDataAsset*> InBases, TConstArrayView<const UAffixDataAsset*> InAffixes)
+{
+    using namespace PoE2AffixRoller;
+
+    TSharedRef<FPoE2AffixRoller> Roller = MakeShared<FPoE2AffixRoller>();
+
+    // Stable dense order, independent of load order
+    TArray<const UItemBaseDataAsset*> Bases;
+    for (const UItemBaseDataAsset* Base : InBases)
+    {
+        if (Base)
+        {
+            Bases.AddUnique(Base);
+        }
+    }
+    TArray<const UAffixDataAsset*> Affixes;
+    for (const UAffixDataAsset* Affix : InAffixes)
+    {
+        if (Affix && Affix->SpawnWeight > 0)
+        {
+            Affixes.AddUnique(Affix);
+        }
+    }
+    SortById(Bases, [](const UItemBaseDataAsset& Base) { return Base.BaseId; });
+    SortById(Affixes, [](const UAffixDataAsset& Affix) { return Affix.AffixId; });
+
+    if (Affixes.Num() > MAX_uint16)
+    {
+        UE_LOG(LogPoE2Framework, Error, TEXT("FPoE2AffixRoller: %d affixes exceed the limit of %d"), Affixes.Num(), MAX_uint16);
+        return nullptr;
+    }
+
+    // Affixes: flat stat ranges and global groups (ungrouped affixes only exclude themselves)
+    TMap<FName, int32> GroupIndices;
+    int32 NumGroups = 0;
+    for (const UAffixDataAsset* Affix : Affixes)
+    {
+        FAffixInfo& Info = Roller->AffixInfos.AddDefaulted_GetRef();
+        Info.FirstRange = Roller->StatRanges.Num();
+        Info.Side = static_cast<uint8>(Affix->Type);
+        Info.RequiredItemLevel = Affix->RequiredItemLevel;
+        Info.Weight = Affix->SpawnWeight;
+        if (Affix->ModGroup.IsNone())
+        {
+            Info.Group = NumGroups++;
+        }
+        else if (const int32* Group = GroupIndices.Find(Affix->ModGroup))
+        {
+            Info.Group = *Group;
+        }
+        else
+        {
+            Info.Group = GroupIndices.Add(Affix->ModGroup, NumGroups++);
+        }
+
+        if (Affix->Stats.Num() > FPoE2RolledAffix::MaxValues)
+        {
+            UE_LOG(LogPoE2Framework, Warning, TEXT("FPoE2AffixRoller: %s has more than %d stats, the rest are ignored"), *Affix->GetName(), FPoE2RolledAffix::MaxValues);
+        }
+        for (int32 Index = 0; Index < FMath::Min(Affix->Stats.Num(), FPoE2RolledAffix::MaxValues); ++Index)
+        {
+            const FPoE2AffixStatRange& Range = Affix->Stats[Index];
+            Roller->StatRanges.Add({ Range.Stat, Range.Op, FMath::Min(Range.Min, Range.Max), FMath::Max(Range.Min, Range.Max) });
+        }
+        Info.NumRanges = static_cast<uint8>(Roller->StatRanges.Num() - Info.FirstRange);
+
+        Info.FirstSkillModifier = Roller->SkillModifiers.Num();
+        Info.NumSkillModifiers = Affix->SkillModifiers.Num();
+        Roller->SkillModifiers.Append(Affix->SkillModifiers);
+
+        Roller->BandLevels.AddUnique(Affix->RequiredItemLevel);
+        Roller->AffixIndices.Add(Affix, Roller->AffixAssets.Add(Affix));
+    }
+    Roller->BandLevels.Sort();
+
+    // Bases: pools are shared by every base that can spawn exactly the same affixes
+    TMap<TBitArray<>, int32> PoolsBySpawnSet;
+    for (const UItemBaseDataAsset* Base : Bases)
+    {
+        FBaseInfo& BaseInfo = Roller->BaseInfos.AddDefaulted_GetRef();
+        BaseInfo.MaxPerSide[static_cast<int32>(EPoE2AffixType::Prefix)] = FMath::Max(0, Base->MaxPrefixes);
+        BaseInfo.MaxPerSide[static_cast<int32>(EPoE2AffixType::Suffix)] = FMath::Max(0, Base->MaxSuffixes);
+        BaseInfo.FirstImplicit = Roller->Implicits.Num();
+        BaseInfo.NumImplicits = Base->ImplicitModifiers.Num();
+        Roller->Implicits.Append(Base->ImplicitModifiers);
+        BaseInfo.FirstSkillModifier = Roller->SkillModifiers.Num();
+        BaseInfo.NumSkillModifiers = Base->ImplicitSkillModifiers.Num();
+        Roller->SkillModifiers.Append(Base->ImplicitSkillModifiers);
+        Roller->BaseIndices.Add(Base, Roller->BaseAssets.Add(Base));
+
+        TBitArray<> SpawnSet(false, Affixes.Num());
+        for (int32 Affix = 0; Affix < Affixes.Num(); ++Affix)
+        {
+            SpawnSet[Affix] = Affixes[Affix]->SpawnTags.IsEmpty() || Base->ItemTags.HasAny(Affixes[Affix]->SpawnTags);
+        }
+
+        if (const int32* Existing = PoolsBySpawnSet.Find(SpawnSet))
+        {
+            BaseInfo.FirstPool = *Existing;
+            continue;
+        }
+
+        BaseInfo.FirstPool = Roller->Pools.Num();
+        PoolsBySpawnSet.Add(SpawnSet, BaseInfo.FirstPool);
+
+        for (const int32 BandLevel : Roller->BandLevels)
+        {
+            FPool& Pool = Roller->Pools.AddDefaulted_GetRef();
+            TMap<int32, uint8> LocalGroups;
+            for (int32 Affix = 0; Affix < Affixes.Num(); ++Affix)
+            {
+                const FAffixInfo& Info = Roller->AffixInfos[Affix];
+                if (!SpawnSet[Affix] || Info.RequiredItemLevel > BandLevel)
+                {
+                    continue;
+                }
+
+                const uint8* LocalGroup = LocalGroups.Find(Info.Group);
+                if (!LocalGroup)
+                {
+                    if (LocalGroups.Num() >= FGroupMask::MaxGroups)
+                    {
+                        UE_LOG(LogPoE2Framework, Warning, TEXT("FPoE2AffixRoller: %s exceeds %d mod groups for %s, dropped"),
+                            *Affixes[Affix]->GetName(), FGroupMask::MaxGroups, *Base->GetName());
+                        continue;
+                    }
+                    LocalGroup = &LocalGroups.Add(Info.Group, static_cast<uint8>(LocalGroups.Num()));
+                }
+
+                FAliasTable& Table = Pool.Sides[Info.Side];
+                Table.Affixes.Add(static_cast<uint16>(Affix));
+                Table.LocalGroups.Add(*LocalGroup);
+                Table.Weights.Add(static_cast<float>(Info.Weight));
+            }
+
+            Pool.Sides[0].Build();
+            Pool.Sides[1].Build();
+        }
+    }
+
+    UE_LOG(LogPoE2Framework, Log, TEXT("FPoE2AffixRoller: %d bases, %d affixes, %d bands, %d pools"),
+        Roller->BaseAssets.Num(), Roller->AffixAssets.Num(), Roller->BandLevels.Num(), Roller->Pools.Num());
+    return Roller;
+}
+
+int32 FPoE2AffixRoller::FindBase(const UItemBaseDataAsset* Base) const
+{
+    const int32* Index = BaseIndices.Find(Base);
+    return Index ? *Index : INDEX_NONE;
+}
+
+int32 FPoE2AffixRoller::FindAffix(const UAffixDataAsset* Affix) const
+{
+    const int32* Index = AffixIndices.Find(Affix);
+    return Index ? *Index : INDEX_NONE;
+}
+
+bool FPoE2AffixRoller::Roll(int32 Base, int32 ItemLevel, const FPoE2AffixRollSettings& Settings, FRandomStream& Random, FPoE2RolledItem& OutItem) const
+{
+    OutItem.Base = Base;
+    OutItem.ItemLevel = ItemLevel;
+    OutItem.Affixes.Reset();
+
+    if (!BaseInfos.IsValidIndex(Base))
+    {
+        return false;
+    }
+
+    const int32 Band = Algo::UpperBound(BandLevels, ItemLevel) - 1;
+    if (Band < 0)
+    {
+        return false;
+    }
+
+    const FBaseInfo& BaseInfo = BaseInfos[Base];
+    const FPool& Pool = Pools[BaseInfo.FirstPool + Band];
+
+    const int32 Capacity = BaseInfo.MaxPerSide[0] + BaseInfo.MaxPerSide[1];
+    const int32 MinAffixes = FMath::Clamp(Settings.MinAffixes, 0, Capacity);
+    const int32 Count = Random.RandRange(MinAffixes, FMath::Clamp(Settings.MaxAffixes, MinAffixes, Capacity));
+
+    FGroupMask Taken;
+    int32 Used[2] = { 0, 0 };
+    bool bExhausted[2] = { false, false };
+
+    while (OutItem.Affixes.Num() < Count)
+    {
+        bool bOpen[2];
+        for (int32 Side = 0; Side < 2; ++Side)
+        {
+            bOpen[Side] = !bExhausted[Side] && Used[Side] < BaseInfo.MaxPerSide[Side] && Pool.Sides[Side].Num() > 0;
+        }
+        if (!bOpen[0] && !bOpen[1])
+        {
+            break;
+        }
+
+        int32 Side = bOpen[0] ? 0 : 1;
+        if (bOpen[0] && bOpen[1])
+        {
+            const float PrefixWeight = Pool.Sides[0].TotalWeight;
+            Side = Random.GetFraction() * (PrefixWeight + Pool.Sides[1].TotalWeight) < PrefixWeight ? 0 : 1;
+        }
+
+        const FAliasTable& Table = Pool.Sides[Side];
+        const int32 Entry = Table.Sample(Random, Taken);
+        if (Entry == INDEX_NONE)
+        {
+            bExhausted[Side] = true;
+            continue;
+        }
+
+        Taken.Add(Table.LocalGroups[Entry]);
+        ++Used[Side];
+        RollAffixValues(Table.Affixes[Entry], Random, OutItem.Affixes.AddDefaulted_GetRef());
+    }
+
+    return true;
+}
+
+void FPoE2AffixRoller::RollAffixValues(int32 Affix, FRandomStream& Random, FPoE2RolledAffix& OutAffix) const
+{
+    const FAffixInfo& Info = AffixInfos[Affix];
+    OutAffix.Affix = static_cast<uint16>(Affix);
+    OutAffix.NumValues = Info.NumRanges;
+    for (int32 Index = 0; Index < Info.NumRanges; ++Index)
+    {
+        const FStatRange& Range = StatRanges[Info.FirstRange + Index];
+        OutAffix.Values[Index] = Random.FRandRange(Range.Min, Range.Max);
+    }
+}
+
+void FPoE2AffixRoller::RollBatch(int32 Base, int32 ItemLevel, const FPoE2AffixRollSettings& Settings, int32 Count, int32 Seed, TArray<FPoE2RolledItem>& OutItems) const
+{
+    using namespace PoE2AffixRoller;
+
+    OutItems.SetNum(FMath::Max(0, Count));
+    const int32 NumTasks = FMath::DivideAndRoundUp(OutItems.Num(), ItemsPerBatchTask);
+
+    ParallelFor(NumTasks, [this, Base, ItemLevel, &Settings, Seed, &OutItems](int32 Task)
+    {
+        const int32 First = Task * ItemsPerBatchTask;
+        const int32 Last = FMath::Min(First + ItemsPerBatchTask, OutItems.Num());
+        for (int32 Index = First; Index < Last; ++Index)
+        {
+            FRandomStream Random(static_cast<int32>(HashCombineFast(static_cast<uint32>(Seed), static_cast<uint32>(Index))));
+            Roll(Base, ItemLevel, Settings, Random, OutItems[Index]);
+        }
+    });
+}
+
+void FPoE2AffixRoller::GetModifiers(const FPoE2RolledItem& Item, TArray<FPoE2StatModifier>& OutModifiers) const
+{
+    OutModifiers.Reset();
+    if (!BaseInfos.IsValidIndex(Item.Base))
+    {
+        return;
+    }
+
+    const FBaseInfo& BaseInfo = BaseInfos[Item.Base];
+    OutModifiers.Append(Implicits.GetData() + BaseInfo.FirstImplicit, BaseInfo.NumImplicits);
+
+    for (const FPoE2RolledAffix& Affix : Item.Affixes)
+    {
+        const FAffixInfo& Info = AffixInfos[Affix.Affix];
+        for (int32 Index = 0; Index < Affix.NumValues; ++Index)
+        {
+            const FStatRange& Range = StatRanges[Info.FirstRange + Index];
+            OutModifiers.Add(FPoE2StatModifier(Range.Stat, Range.Op, Affix.Values[Index]));
+        }
+    }
+}
+
+void FPoE2AffixRoller::GetSkillModifiers(const FPoE2RolledItem& Item, TArray<FPoE2SkillModifier>& OutModifiers) const
+{
+    OutModifiers.Reset();
+    if (!BaseInfos.IsValidIndex(Item.Base))
+    {
+        return;
+    }
+
+    const FBaseInfo& BaseInfo = BaseInfos[Item.Base];
+    OutModifiers.Append(SkillModifiers.GetData() + BaseInfo.FirstSkillModifier, BaseInfo.NumSkillModifiers);
+
+    for (const FPoE2RolledAffix& Affix : Item.Affixes)
+    {
+        const FAffixInfo& Info = AffixInfos[Affix.Affix];
+        OutModifiers.Append(SkillModifiers.GetData() + Info.FirstSkillModifier, Info.NumSkillModifiers);
+    }
+}
@@ -0,0 +1,117 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Minions/PoE2MinionCrowd.h"
+
+void FPoE2MinionCrowd::SetPath(TArray<FVector>&& Points, TArrayView<FPoE2CrowdAgent> Agents)
+{
+    Path = MoveTemp(Points);
+
+    // Point 0 is where the query started (the crowd's centre), which every agent is already around
+    const int32 FirstWaypoint = FMath::Min(1, Path.Num() - 1);
+    for (FPoE2CrowdAgent& Agent : Agents)
+    {
+        Agent.PathIndex = FMath::Max(FirstWaypoint, 0);
+    }
+}
+
+FVector FPoE2MinionCrowd::GetSlotLocation(const FVector& Goal, float SlotRadius, int32 Index, int32 Num)
+{
+    if (Num <= 1)
+    {
+        return Goal + FVector(SlotRadius, 0.0f, 0.0f);
+    }
+
+    // Evenly spaced on the ring, so slots never coincide however many minions there are
+    const float Angle = UE_TWO_PI * static_cast<float>(Index) / static_cast<float>(Num);
+    return Goal + FVector(FMath::Cos(Angle) * SlotRadius, FMath::Sin(Angle) * SlotRadius, 0.0f);
+}
+
+void FPoE2MinionCrowd::Steer(TArrayView<FPoE2CrowdAgent> Agents, float SlotRadius, const FPoE2MinionCrowdSettings& Settings) const
+{
+    if (Path.Num() == 0)
+    {
+        for (FPoE2CrowdAgent& Agent : Agents)
+        {
+            Agent.Velocity = FVector::ZeroVector;
+        }
+        return;
+    }
+
+    const int32 LastWaypoint = Path.Num() - 1;
+    const FVector& Goal = Path[LastWaypoint];
+    const float WaypointRadiusSq = FMath::Square(Settings.WaypointRadius);
+
+    for (int32 Index = 0; Index < Agents.Num(); ++Index)
+    {
+        FPoE2CrowdAgent& Agent = Agents[Index];
+
+        // Advance along the shared path; the final stretch heads for the agent's own slot instead of the goal
+        while (Agent.PathIndex < LastWaypoint && FVector::DistSquared2D(Agent.Location, Path[Agent.PathIndex]) <= WaypointRadiusSq)
+        {
+            ++Agent.PathIndex;
+        }
+
+        const bool bFinalLeg = Agent.PathIndex >= LastWaypoint;
+        const FVector Destination = bFinalLeg ? GetSlotLocation(Goal, SlotRadius, Index, Agents.Num()) : Path[Agent.PathIndex];
+
+        // Path points lie on the floor and agents stand above it, so only the horizontal offset counts
+        FVector ToDestination = Destination - Agent.Location;
+        ToDestination.Z = 0.0f;
+        const float Distance = ToDestination.Size();
+        float Speed = Agent.MaxSpeed;
+        if (bFinalLeg && Settings.SlowdownRadius > 0.0f)
+        {
+            Speed *= FMath::Min(Distance / Settings.SlowdownRadius, 1.0f);
+        }
+        Agent.Velocity = Distance > UE_KINDA_SMALL_NUMBER ? ToDestination * (Speed / Distance) : FVector::ZeroVector;
+    }
+
+    // Separation on the ground plane; crowds are a few dozen agents, so the pairwise pass beats any grid
+    TArray<FVector, TInlineAllocator<64>> Push;
+    Push.SetNumZeroed(Agents.Num());
+    for (int32 A = 0; A < Agents.Num(); ++A)
+    {
+        for (int32 B = A + 1; B < Agents.Num(); ++B)
+        {
+            const float MinDistance = Agents[A].Radius + Agents[B].Radius + Settings.SeparationPadding;
+            FVector Offset = Agents[A].Location - Agents[B].Location;
+            Offset.Z = 0.0f;
+            const float DistanceSq = Offset.SizeSquared();
+            if (DistanceSq >= FMath::Square(MinDistance))
+            {
+                continue;
+            }
+
+            const float Distance = FMath::Sqrt(DistanceSq);
+            // Agents on the same spot are split along an arbitrary but stable axis
+            const FVector Direction = Distance > UE_KINDA_SMALL_NUMBER ? Offset / Distance : FVector(1.0f, 0.0f, 0.0f);
+            const FVector Strength = Direction * ((MinDistance - Distance) / MinDistance);
+            Push[A] += Strength;
+            Push[B] -= Strength;
+        }
+    }
+
+    for (int32 Index = 0; Index < Agents.Num(); ++Index)
+    {
+        FPoE2CrowdAgent& Agent = Agents[Index];
+        Agent.Velocity += Push[Index] * (Settings.SeparationWeight * Agent.MaxSpeed);
+        Agent.Velocity = Agent.Velocity.GetClampedToMaxSize(Agent.MaxSpeed);
+    }
+}
+
+FVector FPoE2MinionCrowd::GetCentroid(TConstArrayView<FPoE2CrowdAgent> Agents)
+{
+    if (Agents.Num() == 0)
+    {
+        return FVector::ZeroVector;
+    }
+
+    FVector Sum = FVector::ZeroVector;
+    for (const FPoE2CrowdAgent& Agent : Agents)
+    {
+        Sum += Agent.Location;
+    }
+    return Sum / static_cast<float>(Agents.Num());
+}
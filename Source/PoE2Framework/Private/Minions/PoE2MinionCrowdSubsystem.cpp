@@ -0,0 +1,283 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Minions/PoE2MinionCrowdSubsystem.h"
+#include "AbilitySystem/Actors/PoE2MinionBase.h"
+#include "Targeting/PoE2TargetingSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("PoE2 Minion Crowd Tick"), STAT_PoE2MinionCrowdTick, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("PoE2 Minion Crowd Repath"), STAT_PoE2MinionCrowdRepath, STATGROUP_Game);
+
+void UPoE2MinionCrowdSubsystem::RegisterMinion(APoE2MinionBase* Minion, UAbilitySystemComponent* OwnerASC)
+{
+    if (!Minion || !OwnerASC || !IsServerWorld())
+    {
+        return;
+    }
+
+    FCrowdState& State = Crowds.FindOrAdd(OwnerASC);
+    State.OwnerASC = OwnerASC;
+    State.Minions.AddUnique(Minion);
+}
+
+void UPoE2MinionCrowdSubsystem::UnregisterMinion(APoE2MinionBase* Minion)
+{
+    if (!Minion)
+    {
+        return;
+    }
+
+    if (FCrowdState* State = Crowds.Find(Minion->GetOwnerASC()))
+    {
+        State->Minions.Remove(Minion);
+    }
+}
+
+void UPoE2MinionCrowdSubsystem::SetCrowdTarget(UAbilitySystemComponent* OwnerASC, AActor* Target)
+{
+    if (FCrowdState* State = Crowds.Find(OwnerASC))
+    {
+        State->Target = Target;
+        State->bTargetOrdered = Target != nullptr;
+        State->Crowd.ResetPath();
+    }
+}
+
+AActor* UPoE2MinionCrowdSubsystem::GetCrowdTarget(const UAbilitySystemComponent* OwnerASC) const
+{
+    const FCrowdState* State = Crowds.Find(OwnerASC);
+    return State ? State->Target.Get() : nullptr;
+}
+
+int32 UPoE2MinionCrowdSubsystem::GetNumMinions(const UAbilitySystemComponent* OwnerASC) const
+{
+    const FCrowdState* State = Crowds.Find(OwnerASC);
+    return State ? State->Minions.Num() : 0;
+}
+
+void UPoE2MinionCrowdSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (Crowds.Num() == 0 || !IsServerWorld())
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_PoE2MinionCrowdTick);
+
+    const float Now = GetWorld()->GetTimeSeconds();
+    for (auto It = Crowds.CreateIterator(); It; ++It)
+    {
+        FCrowdState& State = It.Value();
+        const UAbilitySystemComponent* OwnerASC = State.OwnerASC.Get();
+        const AActor* OwnerActor = OwnerASC ? OwnerASC->GetAvatarActor() : nullptr;
+        if (!OwnerActor || !GatherAgents(State))
+        {
+            It.RemoveCurrent();
+            continue;
+        }
+
+        const FVector Centroid = FPoE2MinionCrowd::GetCentroid(State.Agents);
+
+        AActor* Target = State.Target.Get();
+        if (State.bAcquireAnswered)
+        {
+            // An order given while the request was in flight wins over its answer
+            State.bAcquireAnswered = false;
+            Target = State.bTargetOrdered ? Target : State.AcquiredTarget.Get();
+        }
+        if (Target && !IsValidTarget(OwnerActor, Target))
+        {
+            Target = nullptr;
+            State.bTargetOrdered = false;
+        }
+        if (!State.bTargetOrdered && !State.bAcquirePending && Now >= State.NextAcquireTime)
+        {
+            RequestTarget(State, OwnerActor, Centroid);
+            State.NextAcquireTime = Now + Settings.AcquireInterval;
+        }
+        if (Target != State.Target.Get())
+        {
+            State.Target = Target;
+            State.Crowd.ResetPath();
+        }
+
+        const FVector Goal = Target ? Target->GetActorLocation() : OwnerActor->GetActorLocation();
+        UpdatePath(State, Centroid, Goal, Now);
+
+        State.Crowd.Steer(State.Agents, Target ? Settings.EngageRadius : Settings.FollowRadius, Settings);
+        MoveMinions(State, DeltaTime);
+    }
+}
+
+bool UPoE2MinionCrowdSubsystem::GatherAgents(FCrowdState& State) const
+{
+    State.Minions.RemoveAll([](const TWeakObjectPtr<APoE2MinionBase>& Minion) { return !Minion.IsValid(); });
+
+    // Agents keep their path progress across frames; a change in membership repaths the whole crowd
+    const int32 NumMinions = State.Minions.Num();
+    if (State.Agents.Num() != NumMinions)
+    {
+        State.Agents.SetNum(NumMinions);
+        State.Crowd.ResetPath();
+    }
+
+    for (int32 Index = 0; Index < NumMinions; ++Index)
+    {
+        const APoE2MinionBase* Minion = State.Minions[Index].Get();
+        FPoE2CrowdAgent& Agent = State.Agents[Index];
+        Agent.Location = Minion->GetActorLocation();
+        Agent.MaxSpeed = Minion->GetMoveSpeed();
+        Agent.Radius = Minion->GetCrowdRadius();
+    }
+    return NumMinions > 0;
+}
+
+void UPoE2MinionCrowdSubsystem::RequestTarget(FCrowdState& State, const AActor* OwnerActor, const FVector& Centroid)
+{
+    UPoE2TargetingSubsystem* Targeting = GetWorld()->GetSubsystem<UPoE2TargetingSubsystem>();
+    if (!Targeting)
+    {
+        return;
+    }
+
+    FPoE2TargetRequest Request;
+    Request.Origin = Centroid;
+    Request.Radius = Settings.AcquireRadius;
+    Request.Instigator = OwnerActor;
+
+    // The crowd may be gone by the time the answer arrives, so find it again by its owner
+    State.bAcquirePending = true;
+    Targeting->RequestTarget(MoveTemp(Request), [WeakThis = TWeakObjectPtr<UPoE2MinionCrowdSubsystem>(this), OwnerKey = TObjectKey<UAbilitySystemComponent>(State.OwnerASC.Get())](AActor* Target)
+    {
+        FCrowdState* Answered = WeakThis.IsValid() ? WeakThis->Crowds.Find(OwnerKey) : nullptr;
+        if (Answered)
+        {
+            Answered->AcquiredTarget = Target;
+            Answered->bAcquirePending = false;
+            Answered->bAcquireAnswered = true;
+        }
+    });
+}
+
+bool UPoE2MinionCrowdSubsystem::IsValidTarget(const AActor* OwnerActor, const AActor* Candidate) const
+{
+    if (!IsValid(Candidate) || FVector::DistSquared(Candidate->GetActorLocation(), OwnerActor->GetActorLocation()) > FMath::Square(Settings.LeashRadius))
+    {
+        return false;
+    }
+
+    // Own minions, allies and the dead are ruled out the same way the targeting service rules them out
+    return UPoE2TargetingSubsystem::IsHostileTarget(OwnerActor, Candidate);
+}
+
+void UPoE2MinionCrowdSubsystem::UpdatePath(FCrowdState& State, const FVector& Centroid, const FVector& Goal, float Now) const
+{
+    if (State.Crowd.HasPath() && Now < State.NextRepathTime
+        && FVector::DistSquared(Goal, State.PathGoal) < FMath::Square(Settings.RepathDistance))
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_PoE2MinionCrowdRepath);
+
+    TArray<FVector> Points;
+    UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+    const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+    if (NavData)
+    {
+        // One query from the crowd's centre serves every minion
+        const FPathFindingQuery Query(this, *NavData, Centroid, Goal);
+        const FPathFindingResult Result = NavSys->FindPathSync(Query);
+        if (Result.IsSuccessful() && Result.Path.IsValid())
+        {
+            for (const FNavPathPoint& Point : Result.Path->GetPathPoints())
+            {
+                Points.Add(Point.Location);
+            }
+        }
+    }
+
+    // No navmesh or no path: walk straight, which is still better than standing still
+    if (Points.Num() < 2)
+    {
+        Points.Reset();
+        Points.Add(Centroid);
+        Points.Add(Goal);
+    }
+
+    State.Crowd.SetPath(MoveTemp(Points), State.Agents);
+    State.PathGoal = Goal;
+    State.NextRepathTime = Now + Settings.RepathInterval;
+}
+
+void UPoE2MinionCrowdSubsystem::MoveMinions(FCrowdState& State, float DeltaTime) const
+{
+    TArray<int32, TInlineAllocator<64>> Moving;
+    TArray<FNavigationProjectionWork> Workload;
+    for (int32 Index = 0; Index < State.Minions.Num(); ++Index)
+    {
+        const FPoE2CrowdAgent& Agent = State.Agents[Index];
+        if (!Agent.Velocity.IsNearlyZero())
+        {
+            Moving.Add(Index);
+            Workload.Emplace(Agent.Location + Agent.Velocity * DeltaTime);
+        }
+    }
+    if (Moving.Num() == 0)
+    {
+        return;
+    }
+
+    // One batched projection stands every moving minion on the floor under its next position
+    const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+    const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+    if (NavData)
+    {
+        NavData->BatchProjectPoints(Workload, Settings.ProjectionExtent, nullptr, this);
+    }
+
+    for (int32 Move = 0; Move < Moving.Num(); ++Move)
+    {
+        const int32 Index = Moving[Move];
+        APoE2MinionBase* Minion = State.Minions[Index].Get();
+        const FPoE2CrowdAgent& Agent = State.Agents[Index];
+
+        // Off the navmesh (or without one) the minion keeps its height rather than sinking to a path point
+        FVector NewLocation = Workload[Move].Point;
+        if (NavData && Workload[Move].bResult)
+        {
+            NewLocation.Z = Workload[Move].OutLocation.Location.Z + Minion->GetSimpleCollisionHalfHeight();
+        }
+        else
+        {
+            NewLocation.Z = Agent.Location.Z;
+        }
+
+        // Swept, so minions stop at walls and other actors instead of passing through them
+        const FRotator Facing(0.0f, Agent.Velocity.Rotation().Yaw, 0.0f);
+        Minion->SetActorLocationAndRotation(NewLocation, Facing, true);
+    }
+}
+
+TStatId UPoE2MinionCrowdSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UPoE2MinionCrowdSubsystem, STATGROUP_Tickables);
+}
+
+bool UPoE2MinionCrowdSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UPoE2MinionCrowdSubsystem::IsServerWorld() const
+{
+    const UWorld* World = GetWorld();
+    return World && World->GetNetMode() != NM_Client;
+}
@@ -0,0 +1,28 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Minions/PoE2MinionSignificance.h"
+
+namespace PoE2MinionSignificance
+{
+    float Score(float DistanceToNearestPlayer, bool bInCombat, const FPoE2MinionSignificanceSettings& Settings)
+    {
+        return bInCombat ? DistanceToNearestPlayer * Settings.CombatDistanceScale : DistanceToNearestPlayer;
+    }
+
+    EPoE2MinionTier SelectTier(float Score, EPoE2MinionTier Current, const FPoE2MinionSignificanceSettings& Settings)
+    {
+        const float Boundaries[] = { Settings.MediumDistance, Settings.LowDistance };
+
+        // Boundary B separates tier B from tier B + 1; the side the minion is on now decides which way it is widened
+        int32 Tier = 0;
+        for (int32 Boundary = 0; Boundary < UE_ARRAY_COUNT(Boundaries); ++Boundary)
+        {
+            const bool bCurrentlyInside = static_cast<int32>(Current) <= Boundary;
+            const float Threshold = Boundaries[Boundary] * (bCurrentlyInside ? 1.0f + Settings.Hysteresis : 1.0f - Settings.Hysteresis);
+            Tier += Score > Threshold ? 1 : 0;
+        }
+        return static_cast<EPoE2MinionTier>(Tier);
+    }
+}
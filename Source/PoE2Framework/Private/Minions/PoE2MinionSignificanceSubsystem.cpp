@@ -0,0 +1,160 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Minions/PoE2MinionSignificanceSubsystem.h"
+#include "Minions/PoE2MinionCrowdSubsystem.h"
+#include "AbilitySystem/Actors/PoE2MinionBase.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+DECLARE_STATS_GROUP(TEXT("PoE2 Minions"), STATGROUP_PoE2Minions, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Significance Update"), STAT_PoE2MinionSignificanceUpdate, STATGROUP_PoE2Minions);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Minions High"), STAT_PoE2MinionsHigh, STATGROUP_PoE2Minions);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Minions Medium"), STAT_PoE2MinionsMedium, STATGROUP_PoE2Minions);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Minions Low"), STAT_PoE2MinionsLow, STATGROUP_PoE2Minions);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Saved Tick (ms)"), STAT_PoE2MinionsSavedMs, STATGROUP_PoE2Minions);
+
+void UPoE2MinionSignificanceSubsystem::RegisterMinion(APoE2MinionBase* Minion)
+{
+    if (!Minion || Minions.Contains(Minion))
+    {
+        return;
+    }
+
+    Minions.Add(Minion);
+    Minion->ApplySignificance(EPoE2MinionTier::High, Settings.High);
+    ++TierCounts[static_cast<int32>(EPoE2MinionTier::High)];
+    TickingCounts[static_cast<int32>(EPoE2MinionTier::High)] += Minion->IsActorTickEnabled() ? 1 : 0;
+}
+
+void UPoE2MinionSignificanceSubsystem::UnregisterMinion(APoE2MinionBase* Minion)
+{
+    if (Minion && Minions.RemoveSwap(Minion) > 0)
+    {
+        const int32 Tier = static_cast<int32>(Minion->GetSignificanceTier());
+        --TierCounts[Tier];
+
+        // Its tick may have been switched on since it was last counted; never count below zero
+        if (Minion->IsActorTickEnabled())
+        {
+            TickingCounts[Tier] = FMath::Max(TickingCounts[Tier] - 1, 0);
+        }
+    }
+}
+
+int32 UPoE2MinionSignificanceSubsystem::GetNumTickingInTier(EPoE2MinionTier Tier) const
+{
+    return Tier < EPoE2MinionTier::Count ? TickingCounts[static_cast<int32>(Tier)] : 0;
+}
+
+void UPoE2MinionSignificanceSubsystem::RecordTickCost(uint32 Cycles)
+{
+    // Exponential average; a single hitch should not swing the estimate
+    const double Ms = FPlatformTime::ToMilliseconds(Cycles);
+    AverageTickMs = AverageTickMs > 0.0 ? FMath::Lerp(AverageTickMs, Ms, 0.05) : Ms;
+}
+
+int32 UPoE2MinionSignificanceSubsystem::GetNumInTier(EPoE2MinionTier Tier) const
+{
+    return Tier < EPoE2MinionTier::Count ? TierCounts[static_cast<int32>(Tier)] : 0;
+}
+
+void UPoE2MinionSignificanceSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (Minions.Num() == 0)
+    {
+        SavedMs = 0.0f;
+        return;
+    }
+
+    TimeUntilUpdate -= DeltaTime;
+    if (TimeUntilUpdate <= 0.0f)
+    {
+        TimeUntilUpdate = Settings.UpdateInterval;
+        UpdateTiers();
+    }
+
+    // A minion ticking every Interval seconds skips 1 - DeltaTime / Interval of the frames it would otherwise tick
+    float SkippedTicks = 0.0f;
+    for (int32 Tier = 0; Tier < static_cast<int32>(EPoE2MinionTier::Count); ++Tier)
+    {
+        const float Interval = Settings.GetTier(static_cast<EPoE2MinionTier>(Tier)).TickInterval;
+        if (Interval > DeltaTime)
+        {
+            SkippedTicks += TickingCounts[Tier] * (1.0f - DeltaTime / Interval);
+        }
+    }
+    SavedMs = static_cast<float>(AverageTickMs * SkippedTicks);
+
+    SET_DWORD_STAT(STAT_PoE2MinionsHigh, TierCounts[static_cast<int32>(EPoE2MinionTier::High)]);
+    SET_DWORD_STAT(STAT_PoE2MinionsMedium, TierCounts[static_cast<int32>(EPoE2MinionTier::Medium)]);
+    SET_DWORD_STAT(STAT_PoE2MinionsLow, TierCounts[static_cast<int32>(EPoE2MinionTier::Low)]);
+    SET_FLOAT_STAT(STAT_PoE2MinionsSavedMs, SavedMs);
+}
+
+void UPoE2MinionSignificanceSubsystem::UpdateTiers()
+{
+    SCOPE_CYCLE_COUNTER(STAT_PoE2MinionSignificanceUpdate);
+
+    UWorld* World = GetWorld();
+    PlayerLocations.Reset();
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        if (const APlayerController* PC = It->Get())
+        {
+            FVector Location;
+            FRotator Rotation;
+            PC->GetPlayerViewPoint(Location, Rotation);
+            PlayerLocations.Add(Location);
+        }
+    }
+
+    // Without any player to measure against, keep every minion where it is
+    if (PlayerLocations.Num() == 0)
+    {
+        return;
+    }
+
+    // Combat state comes from the owner's crowd, which only exists on the server
+    const UPoE2MinionCrowdSubsystem* Crowds = World->GetSubsystem<UPoE2MinionCrowdSubsystem>();
+
+    FMemory::Memzero(TierCounts);
+    FMemory::Memzero(TickingCounts);
+    Minions.RemoveAllSwap([](const TWeakObjectPtr<APoE2MinionBase>& Minion) { return !Minion.IsValid(); });
+
+    for (const TWeakObjectPtr<APoE2MinionBase>& WeakMinion : Minions)
+    {
+        APoE2MinionBase* Minion = WeakMinion.Get();
+        const FVector MinionLocation = Minion->GetActorLocation();
+
+        float NearestSq = TNumericLimits<float>::Max();
+        for (const FVector& PlayerLocation : PlayerLocations)
+        {
+            NearestSq = FMath::Min(NearestSq, static_cast<float>(FVector::DistSquared(MinionLocation, PlayerLocation)));
+        }
+
+        const bool bInCombat = Crowds && Crowds->GetCrowdTarget(Minion->GetOwnerASC()) != nullptr;
+        const float Score = PoE2MinionSignificance::Score(FMath::Sqrt(NearestSq), bInCombat, Settings);
+        const EPoE2MinionTier Tier = PoE2MinionSignificance::SelectTier(Score, Minion->GetSignificanceTier(), Settings);
+        if (Tier != Minion->GetSignificanceTier())
+        {
+            Minion->ApplySignificance(Tier, Settings.GetTier(Tier));
+        }
+
+        ++TierCounts[static_cast<int32>(Tier)];
+        TickingCounts[static_cast<int32>(Tier)] += Minion->IsActorTickEnabled() ? 1 : 0;
+    }
+}
+
+TStatId UPoE2MinionSignificanceSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UPoE2MinionSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+bool UPoE2MinionSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,175 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Minions/PoE2SummonSpawnSubsystem.h"
+#include "AbilitySystem/Actors/PoE2MinionBase.h"
+#include "AbilitySystemComponent.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("PoE2 Summon Projection"), STAT_PoE2SummonProjection, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("PoE2 Summon Spawn"), STAT_PoE2SummonSpawn, STATGROUP_Game);
+
+namespace PoE2SummonFormation
+{
+    void ComputeSlots(const FVector& Origin, const FVector& Forward, int32 Count, const FPoE2SummonFormationSettings& Settings, TArray<FTransform>& OutSlots)
+    {
+        OutSlots.Reset(Count);
+
+        const FVector Ahead = Forward.GetSafeNormal2D(UE_SMALL_NUMBER, FVector::ForwardVector);
+        const FVector Right(-Ahead.Y, Ahead.X, 0.0f);
+        const FQuat Facing = Ahead.ToOrientationQuat();
+        const int32 PerRow = FMath::Max(Settings.MaxPerRow, 1);
+
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            const int32 Row = Index / PerRow;
+            const int32 Column = Index % PerRow;
+
+            // The last row may be short; centre it like the others
+            const int32 InRow = FMath::Min(PerRow, Count - Row * PerRow);
+            const float Across = (static_cast<float>(Column) - static_cast<float>(InRow - 1) * 0.5f) * Settings.Spacing;
+            const float Along = (1.0f - static_cast<float>(Row)) * Settings.Spacing;
+
+            OutSlots.Emplace(Facing, Origin + Ahead * Along + Right * Across);
+        }
+    }
+
+    void PlaceProjectedSlots(TConstArrayView<FNavigationProjectionWork> Projections, const FVector& Fallback, float HalfHeight, TArray<FTransform>& Slots)
+    {
+        check(Projections.Num() == Slots.Num());
+
+        const FVector Lift(0.0f, 0.0f, HalfHeight);
+        for (int32 Index = 0; Index < Slots.Num(); ++Index)
+        {
+            Slots[Index].SetLocation(Projections[Index].bResult ? FVector(Projections[Index].OutLocation.Location) + Lift : Fallback);
+        }
+    }
+}
+
+void UPoE2SummonSpawnSubsystem::QueueFormation(AActor* Summoner, const FSkillSpec& Spec, UAbilitySystemComponent* OwnerASC, const TArray<TScriptInterface<IMechanicHandler>>& HandlerPrototypes)
+{
+    if (!Summoner || !Spec.SummonClass || Spec.SummonCount <= 0)
+    {
+        return;
+    }
+
+    FPoE2PendingSummons& Summons = Pending.AddDefaulted_GetRef();
+    Summons.Summoner = Summoner;
+    Summons.OwnerASC = OwnerASC;
+    Summons.Spec = Spec;
+    Summons.HandlerPrototypes = HandlerPrototypes;
+
+    PoE2SummonFormation::ComputeSlots(Summoner->GetActorLocation(), Summoner->GetActorForwardVector(), Spec.SummonCount, Formation, Summons.Slots);
+    const APoE2MinionBase* DefaultMinion = Spec.SummonClass->GetDefaultObject<APoE2MinionBase>();
+    ProjectSlots(Summoner, DefaultMinion ? DefaultMinion->GetSimpleCollisionHalfHeight() : 0.0f, Summons.Slots);
+
+    SpawnPending();
+}
+
+int32 UPoE2SummonSpawnSubsystem::GetNumPendingSpawns() const
+{
+    int32 Num = 0;
+    for (const FPoE2PendingSummons& Summons : Pending)
+    {
+        Num += Summons.Slots.Num() - Summons.NextSlot;
+    }
+    return Num;
+}
+
+void UPoE2SummonSpawnSubsystem::ProjectSlots(const AActor* Summoner, float HalfHeight, TArray<FTransform>& Slots) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_PoE2SummonProjection);
+
+    const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+    const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+    if (!NavData)
+    {
+        // Nothing to project onto (e.g. arenas without navmesh): keep the raw formation
+        return;
+    }
+
+    TArray<FNavigationProjectionWork> Workload;
+    Workload.Reserve(Slots.Num());
+    for (const FTransform& Slot : Slots)
+    {
+        Workload.Emplace(Slot.GetLocation());
+    }
+
+    NavData->BatchProjectPoints(Workload, Formation.ProjectionExtent, nullptr, this);
+
+    // A slot inside a wall or over a ledge has no navmesh nearby; stand that summon where the summoner is
+    PoE2SummonFormation::PlaceProjectedSlots(Workload, Summoner->GetActorLocation(), HalfHeight, Slots);
+}
+
+void UPoE2SummonSpawnSubsystem::SpawnPending()
+{
+    if (BudgetFrame != GFrameCounter)
+    {
+        BudgetFrame = GFrameCounter;
+        SpawnsThisFrame = 0;
+    }
+
+    if (Pending.Num() == 0 || SpawnsThisFrame >= MaxSpawnsPerFrame)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_PoE2SummonSpawn);
+
+    UWorld* World = GetWorld();
+    int32 Finished = 0;
+    for (FPoE2PendingSummons& Summons : Pending)
+    {
+        AActor* Summoner = Summons.Summoner.Get();
+        if (Summoner)
+        {
+            FActorSpawnParameters SpawnParams;
+            SpawnParams.Owner = Summoner;
+            SpawnParams.Instigator = Cast<APawn>(Summoner);
+            SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+            while (Summons.NextSlot < Summons.Slots.Num() && SpawnsThisFrame < MaxSpawnsPerFrame)
+            {
+                const FTransform SpawnTransform = Summons.Slots[Summons.NextSlot++];
+                ++SpawnsThisFrame;
+
+                if (APoE2MinionBase* Summon = World->SpawnActor<APoE2MinionBase>(Summons.Spec.SummonClass, SpawnTransform, SpawnParams))
+                {
+                    Summon->InitFromSpec(Summons.Spec, Summons.OwnerASC, Summons.HandlerPrototypes);
+                }
+            }
+        }
+
+        // A summoner that died or left drops the rest of its formation
+        if (!Summoner || Summons.NextSlot >= Summons.Slots.Num())
+        {
+            ++Finished;
+            continue;
+        }
+        break;
+    }
+
+    // Formations complete strictly in queue order, so the finished ones are always a prefix
+    Pending.RemoveAt(0, Finished);
+}
+
+void UPoE2SummonSpawnSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    SpawnPending();
+}
+
+TStatId UPoE2SummonSpawnSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UPoE2SummonSpawnSubsystem, STATGROUP_Tickables);
+}
+
+bool UPoE2SummonSpawnSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
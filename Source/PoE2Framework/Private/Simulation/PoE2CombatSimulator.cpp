@@ -0,0 +1,183 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Simulation/PoE2CombatSimulator.h"
+#include "Spec/SkillSpecBuilder.h"
+#include "Data/SkillDataAsset.h"
+#include "Data/SupportDataAsset.h"
+#include "AbilitySystem/Handlers/Mechanic_DOT.h"
+#include "Effects/PoE2HitConditions.h"
+#include "Async/ParallelFor.h"
+
+FString FPoE2SimBuild::GetLabel() const
+{
+    FString Label = Skill ? Skill->SkillId.ToString() : TEXT("None");
+    for (const USupportDataAsset* Support : Supports)
+    {
+        if (Support)
+        {
+            Label += TEXT("+") + Support->SupportId.ToString();
+        }
+    }
+    return Label;
+}
+
+void FPoE2CombatSimulator::GatherPatches(const FPoE2SimBuild& Build, TArray<FPatch>& OutPatches)
+{
+    OutPatches.Reset(Build.Supports.Num() + Build.ExtraPatches.Num());
+    for (const USupportDataAsset* Support : Build.Supports)
+    {
+        if (Support)
+        {
+            OutPatches.Add(Support->SkillPatch);
+        }
+    }
+    OutPatches.Append(Build.ExtraPatches);
+}
+
+FPoE2SimResult FPoE2CombatSimulator::SimulateBuild(const FPoE2SimBuild& Build, const FPoE2SimTarget& Target, const FPoE2SimSettings& Settings)
+{
+    TArray<FPatch> Patches;
+    GatherPatches(Build, Patches);
+
+    // The handler pipeline is not needed here and may only be compiled on the game thread
+    FSkillSpec Spec;
+    FSkillSpecBuilder::Build(Build.Skill, Patches, Spec, false);
+
+    FPoE2SimResult Result = SimulateSpec(Spec, Target, Settings);
+    Result.Label = Build.GetLabel();
+    return Result;
+}
+
+FPoE2SimResult FPoE2CombatSimulator::SimulateSpec(const FSkillSpec& Spec, const FPoE2SimTarget& Target, const FPoE2SimSettings& Settings)
+{
+    FPoE2SimResult Result;
+    Result.Spec = Spec;
+    Result.Label = Spec.SkillId.ToString();
+
+    const float Duration = FMath::Max(Settings.Duration, 0.0f);
+    const float TimeStep = FMath::Max(Settings.TimeStep, KINDA_SMALL_NUMBER);
+    const float UseInterval = FMath::Max3(Spec.CastTime, Spec.Cooldown, Settings.MinUseInterval);
+    Result.UsesPerSecond = UseInterval > 0.0f ? 1.0f / UseInterval : 0.0f;
+
+    // Same order as an in-game hit: conditional modifiers on the outgoing damage, then the target's mitigation
+    FPoE2DamageVector HitDamage = PoE2DamageKernel::MakeHitDamage(Spec);
+    if (const FPoE2HitConditionProgram* Conditions = Spec.GetHitConditions().Get())
+    {
+        // The simulated attacker has no tags and full life, like a hit whose source is gone
+        static const FGameplayTagContainer NoTags;
+        const FPoE2HitConditionContext Context = FPoE2HitConditionContext::Make(NoTags, 0.0f, 0.0f, Target.Tags, Target.Life * Target.LifeFraction, Target.Life);
+        HitDamage = PoE2DamageKernel::ApplyHitConditions(HitDamage, *Conditions, Context);
+    }
+    Result.MitigatedHitDamage = PoE2DamageKernel::Mitigate(HitDamage, Target.Defence).Total();
+
+    // DoT applied per use, same params and stacking as UMechanic_DOT
+    const float DotDps = Spec.GetCustomParam(UMechanic_DOT::DamagePerSecondKey, 0.0f);
+    const float DotDuration = Spec.GetCustomParam(UMechanic_DOT::DurationKey, 0.0f);
+    const bool bDotStrongestOnly = Spec.GetCustomParam(UMechanic_DOT::StrongestOnlyKey, 0.0f) > 0.0f;
+    const bool bHasDot = Spec.MechanicHandlers.ContainsByPredicate([](const TSubclassOf<UObject>& HandlerClass) { return HandlerClass.Get() == UMechanic_DOT::StaticClass(); }) && DotDps > 0.0f && DotDuration > 0.0f;
+
+    if (bHasDot)
+    {
+        // UExec_Damage gives Damage.OverTime executions the target's resistance but no armour
+        FPoE2DefenceProfile DotDefence = Target.Defence;
+        DotDefence.Armour = 0.0f;
+        const EPoE2DamageType DotType = PoE2DamageType::FromTag(PoE2DamageType::FindDamageTypeTag(Spec.SkillTags));
+        Result.MitigatedDotDps = PoE2DamageKernel::Mitigate(FPoE2DamageVector::Single(DotType, DotDps), DotDefence).Total();
+    }
+
+    TArray<float> DotExpiries;
+    int32 NumUses = 0;
+    float RemainingLife = Target.Life;
+
+    // Step times are derived from the step index, so long encounters don't accumulate rounding
+    const int32 NumSteps = FMath::CeilToInt32(Duration / TimeStep - KINDA_SMALL_NUMBER);
+    for (int32 Step = 0; Step < NumSteps; ++Step)
+    {
+        const float Time = Step * TimeStep;
+        const float StepEnd = FMath::Min((Step + 1) * TimeStep, Duration);
+        float StepDamage = 0.0f;
+
+        while (Result.UsesPerSecond > 0.0f && NumUses * UseInterval < StepEnd)
+        {
+            StepDamage += Result.MitigatedHitDamage;
+            Result.HitDamageDealt += Result.MitigatedHitDamage;
+            if (bHasDot)
+            {
+                DotExpiries.Add(NumUses * UseInterval + DotDuration);
+            }
+            ++NumUses;
+        }
+
+        if (DotExpiries.Num() > 0)
+        {
+            float ActiveSeconds = 0.0f;
+            for (const float Expiry : DotExpiries)
+            {
+                const float Active = FMath::Clamp(Expiry - Time, 0.0f, StepEnd - Time);
+                ActiveSeconds = bDotStrongestOnly ? FMath::Max(ActiveSeconds, Active) : ActiveSeconds + Active;
+            }
+
+            const float DotDamage = Result.MitigatedDotDps * ActiveSeconds;
+            StepDamage += DotDamage;
+            Result.DotDamageDealt += DotDamage;
+
+            DotExpiries.RemoveAllSwap([StepEnd](float Expiry) { return Expiry <= StepEnd; }, EAllowShrinking::No);
+        }
+
+        if (Result.TimeToKill < 0.0f && StepDamage > 0.0f)
+        {
+            RemainingLife -= StepDamage;
+            if (RemainingLife <= 0.0f)
+            {
+                Result.TimeToKill = StepEnd;
+            }
+        }
+    }
+
+    Result.TotalDamage = Result.HitDamageDealt + Result.DotDamageDealt;
+    Result.DPS = Duration > 0.0f ? Result.TotalDamage / Duration : 0.0f;
+    return Result;
+}
+
+void FPoE2CombatSimulator::SimulateBuilds(TConstArrayView<FPoE2SimBuild> Builds, const FPoE2SimTarget& Target, const FPoE2SimSettings& Settings, TArray<FPoE2SimResult>& OutResults)
+{
+    OutResults.Reset();
+    OutResults.SetNum(Builds.Num());
+
+    // Composing reads the skill and support assets, so it stays on this thread; only the simulation is spread out
+    TArray<FSkillSpec> Specs;
+    Specs.SetNum(Builds.Num());
+    TArray<FPatch> Patches;
+    for (int32 Index = 0; Index < Builds.Num(); ++Index)
+    {
+        GatherPatches(Builds[Index], Patches);
+        FSkillSpecBuilder::Build(Builds[Index].Skill, Patches, Specs[Index], false);
+    }
+
+    ParallelFor(Builds.Num(), [&Builds, &Specs, &Target, &Settings, &OutResults](int32 Index)
+    {
+        OutResults[Index] = SimulateSpec(Specs[Index], Target, Settings);
+        OutResults[Index].Label = Builds[Index].GetLabel();
+    });
+}
+
+FString FPoE2CombatSimulator::ToCSV(TConstArrayView<FPoE2SimResult> Results)
+{
+    FString CSV = TEXT("Build,FinalDamage,MitigatedHitDamage,UsesPerSecond,HitDamage,DotDamage,TotalDamage,DPS,TimeToKill\n");
+    for (const FPoE2SimResult& Result : Results)
+    {
+        CSV += FString::Printf(TEXT("%s,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n"),
+            *Result.Label,
+            Result.Spec.FinalDamage,
+            Result.MitigatedHitDamage,
+            Result.UsesPerSecond,
+            Result.HitDamageDealt,
+            Result.DotDamageDealt,
+            Result.TotalDamage,
+            Result.DPS,
+            Result.TimeToKill);
+    }
+    return CSV;
+}
@@ -0,0 +1,156 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Simulation/PoE2SimulateBuildsCommandlet.h"
+#include "Simulation/PoE2CombatSimulator.h"
+#include "Data/SkillDataAsset.h"
+#include "Data/SupportDataAsset.h"
+#include "Spec/SkillSpecBuilder.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/AssetManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Core/PoE2Log.h"
+
+namespace
+{
+    template<typename AssetType>
+    void LoadAllAssetsOfClass(TArray<const AssetType*>& OutAssets)
+    {
+        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+        AssetRegistry.SearchAllAssets(true);
+
+        TArray<FAssetData> AssetDatas;
+        AssetRegistry.GetAssetsByClass(AssetType::StaticClass()->GetClassPathName(), AssetDatas, true);
+
+        for (const FAssetData& AssetData : AssetDatas)
+        {
+            if (const AssetType* Asset = Cast<AssetType>(AssetData.GetAsset()))
+            {
+                OutAssets.Add(Asset);
+            }
+        }
+    }
+
+    /**
+     * Appends every combination of up to MaxCount supports (no repeats, order-independent) that could be linked in game:
+     * each support must be compatible with the spec folded so far, as in FPoE2SupportSearch.
+     */
+    void AppendSupportCombinations(const USkillDataAsset* Skill, const FSkillSpec& Spec, TConstArrayView<const USupportDataAsset*> Supports, int32 MaxCount, int32 StartIndex, TArray<const USupportDataAsset*>& Current, TArray<FPoE2SimBuild>& OutBuilds)
+    {
+        FPoE2SimBuild& Build = OutBuilds.AddDefaulted_GetRef();
+        Build.Skill = Skill;
+        Build.Supports = Current;
+
+        if (Current.Num() >= MaxCount)
+        {
+            return;
+        }
+
+        for (int32 Index = StartIndex; Index < Supports.Num(); ++Index)
+        {
+            const USupportDataAsset* Support = Supports[Index];
+            if (!Support || !Support->CanSupport(Spec))
+            {
+                continue;
+            }
+
+            FSkillSpec Child = Spec;
+            FSkillSpecBuilder::ApplyPatch(Child, Support->SkillPatch);
+
+            Current.Push(Support);
+            AppendSupportCombinations(Skill, Child, Supports, MaxCount, Index + 1, Current, OutBuilds);
+            Current.Pop(EAllowShrinking::No);
+        }
+    }
+}
+
+UPoE2SimulateBuildsCommandlet::UPoE2SimulateBuildsCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UPoE2SimulateBuildsCommandlet::Main(const FString& Params)
+{
+    int32 MaxSupports = 2;
+    FParse::Value(*Params, TEXT("MaxSupports="), MaxSupports);
+    MaxSupports = FMath::Clamp(MaxSupports, 0, 5);
+
+    FPoE2SimSettings Settings;
+    FParse::Value(*Params, TEXT("Duration="), Settings.Duration);
+
+    FPoE2SimTarget Target;
+    FParse::Value(*Params, TEXT("Armour="), Target.Defence.Armour);
+    FParse::Value(*Params, TEXT("Life="), Target.Life);
+    float Resistance = 0.0f;
+    if (FParse::Value(*Params, TEXT("Resist="), Resistance))
+    {
+        for (int32 Index = static_cast<int32>(EPoE2DamageType::Lightning); Index < PoE2DamageType::Num; ++Index)
+        {
+            Target.Defence.Resistances[Index] = Resistance;
+        }
+    }
+
+    FString OutputPath = FPaths::ProjectSavedDir() / TEXT("Simulation/BuildDPS.csv");
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+    FString SkillFilter;
+    TArray<FString> SkillFilterIds;
+    if (FParse::Value(*Params, TEXT("Skills="), SkillFilter, false))
+    {
+        SkillFilter.ParseIntoArray(SkillFilterIds, TEXT(","));
+    }
+
+    TArray<const USkillDataAsset*> Skills;
+    TArray<const USupportDataAsset*> Supports;
+    LoadAllAssetsOfClass(Skills);
+    LoadAllAssetsOfClass(Supports);
+
+    // Handler and effect classes are soft references in the Gameplay bundle; the held handle keeps them resident
+    TArray<FSoftObjectPath> GameplayPaths;
+    for (const USkillDataAsset* Skill : Skills)
+    {
+        Skill->GatherBundleReferences({ USkillDataAsset::GameplayBundle }, GameplayPaths);
+    }
+    const TSharedPtr<FStreamableHandle> GameplayBundleHandle = GameplayPaths.Num() > 0
+        ? UAssetManager::GetStreamableManager().RequestSyncLoad(GameplayPaths)
+        : nullptr;
+
+    TArray<FPoE2SimBuild> Builds;
+    for (const USkillDataAsset* Skill : Skills)
+    {
+        if (SkillFilterIds.Num() > 0 && !SkillFilterIds.Contains(Skill->SkillId.ToString()))
+        {
+            continue;
+        }
+
+        FSkillSpec BaseSpec;
+        FSkillSpecBuilder::Build(Skill, {}, BaseSpec, false);
+
+        TArray<const USupportDataAsset*> Current;
+        AppendSupportCombinations(Skill, BaseSpec, Supports, MaxSupports, 0, Current, Builds);
+    }
+
+    UE_LOG(LogPoE2Framework, Display, TEXT("PoE2SimulateBuilds: %d skills, %d supports, %d builds (up to %d supports)"),
+        Skills.Num(), Supports.Num(), Builds.Num(), MaxSupports);
+
+    const double StartTime = FPlatformTime::Seconds();
+    TArray<FPoE2SimResult> Results;
+    FPoE2CombatSimulator::SimulateBuilds(Builds, Target, Settings, Results);
+    const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+    Results.Sort([](const FPoE2SimResult& A, const FPoE2SimResult& B) { return A.DPS > B.DPS; });
+
+    if (!FFileHelper::SaveStringToFile(FPoE2CombatSimulator::ToCSV(Results), *OutputPath))
+    {
+        UE_LOG(LogPoE2Framework, Error, TEXT("PoE2SimulateBuilds: Failed to write %s"), *OutputPath);
+        return 1;
+    }
+
+    UE_LOG(LogPoE2Framework, Display, TEXT("PoE2SimulateBuilds: Simulated %d builds in %.2fs, wrote %s"), Results.Num(), Elapsed, *OutputPath);
+    return 0;
+}
@@ -0,0 +1,344 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Simulation/PoE2SupportSearch.h"
+#include "Spec/SkillSpecBuilder.h"
+#include "Data/SkillDataAsset.h"
+#include "Data/SupportDataAsset.h"
+#include "Async/ParallelFor.h"
+#include "Algo/Sort.h"
+#include <atomic>
+
+namespace PoE2SupportSearch
+{
+    /** What one support can do to the fields DefaultScore reads, for the default bound. */
+    struct FSupportGain
+    {
+        float DamageAdd = 0.0f;
+        float DamageScale = 1.0f;
+        bool bCanShortenUse = false;
+    };
+
+    FSupportGain ComputeGain(const FCompiledPatch& Compiled)
+    {
+        FSupportGain Gain;
+        for (const FCompiledPatch::FOp& Op : Compiled.Additive)
+        {
+            if (Op.Field == ESkillSpecNumericField::FinalDamage)
+            {
+                Gain.DamageAdd += FMath::Max(0.0f, Op.Value);
+            }
+            else if ((Op.Field == ESkillSpecNumericField::CastTime || Op.Field == ESkillSpecNumericField::Cooldown) && Op.Value < 0.0f)
+            {
+                Gain.bCanShortenUse = true;
+            }
+        }
+        for (const FCompiledPatch::FOp& Op : Compiled.Multiplicative)
+        {
+            if (Op.Field == ESkillSpecNumericField::FinalDamage)
+            {
+                Gain.DamageScale *= FMath::Max(1.0f, 1.0f + Op.Value);
+            }
+            else if ((Op.Field == ESkillSpecNumericField::CastTime || Op.Field == ESkillSpecNumericField::Cooldown) && Op.Value < 0.0f)
+            {
+                Gain.bCanShortenUse = true;
+            }
+        }
+        return Gain;
+    }
+
+    /**
+     * For every suffix [Start, N) of the pool, the best damage adds and scales of up to MaxSlots supports.
+     * ((D + a1)(1 + m1) + a2)(1 + m2) <= (D + a1 + a2)(1 + m1)(1 + m2) for non-negative gains, so picking
+     * adds and scales independently bounds any real combination.
+     */
+    struct FSuffixBounds
+    {
+        int32 MaxSlots = 0;
+        TArray<float> TopAdds;     // [Start * MaxSlots + Rank], descending
+        TArray<float> TopScales;   // [Start * MaxSlots + Rank], descending
+        TArray<bool> CanShortenUse;
+
+        void Build(TConstArrayView<FSupportGain> Gains, int32 InMaxSlots)
+        {
+            MaxSlots = InMaxSlots;
+            const int32 Num = Gains.Num();
+            TopAdds.Init(0.0f, (Num + 1) * MaxSlots);
+            TopScales.Init(1.0f, (Num + 1) * MaxSlots);
+            CanShortenUse.Init(false, Num + 1);
+
+            for (int32 Start = Num - 1; Start >= 0; --Start)
+            {
+                InsertSorted(&TopAdds[Start * MaxSlots], &TopAdds[(Start + 1) * MaxSlots], Gains[Start].DamageAdd);
+                InsertSorted(&TopScales[Start * MaxSlots], &TopScales[(Start + 1) * MaxSlots], Gains[Start].DamageScale);
+                CanShortenUse[Start] = CanShortenUse[Start + 1] || Gains[Start].bCanShortenUse;
+            }
+        }
+
+        void InsertSorted(float* Out, const float* Next, float Value) const
+        {
+            int32 NextIndex = 0;
+            bool bInserted = false;
+            for (int32 Rank = 0; Rank < MaxSlots; ++Rank)
+            {
+                if (!bInserted && Value > Next[NextIndex])
+                {
+                    Out[Rank] = Value;
+                    bInserted = true;
+                }
+                else
+                {
+                    Out[Rank] = Next[NextIndex++];
+                }
+            }
+        }
+
+        float Bound(const FSkillSpec& Spec, int32 Start, int32 Slots, float MinUseInterval) const
+        {
+            float Damage = FMath::Max(0.0f, Spec.FinalDamage);
+            float Scale = 1.0f;
+            for (int32 Rank = 0; Rank < FMath::Min(Slots, MaxSlots); ++Rank)
+            {
+                Damage += TopAdds[Start * MaxSlots + Rank];
+                Scale *= TopScales[Start * MaxSlots + Rank];
+            }
+
+            const float UseInterval = CanShortenUse[Start] ? MinUseInterval : FMath::Max3(Spec.CastTime, Spec.Cooldown, MinUseInterval);
+            return UseInterval > 0.0f ? Damage * Scale / UseInterval : TNumericLimits<float>::Max();
+        }
+    };
+
+    /** Bounded min-heap of the best results seen by one worker. */
+    struct FTopK
+    {
+        int32 Capacity = 0;
+        TArray<FPoE2SupportSearchResult> Heap;
+
+        static bool Less(const FPoE2SupportSearchResult& A, const FPoE2SupportSearchResult& B) { return A.Score < B.Score; }
+
+        bool IsFull() const { return Heap.Num() >= Capacity; }
+        float Worst() const { return Heap.Num() > 0 ? Heap.HeapTop().Score : -TNumericLimits<float>::Max(); }
+
+        bool WouldAccept(float Score) const { return !IsFull() || Score > Worst(); }
+
+        void Add(FPoE2SupportSearchResult&& Result)
+        {
+            if (IsFull())
+            {
+                FPoE2SupportSearchResult Discarded;
+                Heap.HeapPop(Discarded, &FTopK::Less, EAllowShrinking::No);
+            }
+            Heap.HeapPush(MoveTemp(Result), &FTopK::Less);
+        }
+    };
+
+    struct FSearchContext
+    {
+        TConstArrayView<const USupportDataAsset*> Pool;
+        TConstArrayView<FCompiledPatch> CompiledPatches;
+        TConstArrayView<FPoE2TagQuery> Compatibility;
+        const FPoE2SupportSearchSettings* Settings = nullptr;
+        const FPoE2SupportScoreFunction* Score = nullptr;
+        const FPoE2SupportBoundFunction* CustomBound = nullptr;
+        const FSuffixBounds* DefaultBound = nullptr;
+
+        /** Best known K-th score across all workers; only ever raised. */
+        std::atomic<float> GlobalThreshold { -TNumericLimits<float>::Max() };
+        std::atomic<int64> CombinationsScored { 0 };
+        std::atomic<int64> SubtreesPruned { 0 };
+
+        void RaiseThreshold(float Value)
+        {
+            float Current = GlobalThreshold.load(std::memory_order_relaxed);
+            while (Value > Current && !GlobalThreshold.compare_exchange_weak(Current, Value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        bool ShouldPrune(const FSkillSpec& Spec, int32 Start, int32 Slots, const FTopK& Local) const
+        {
+            const float Threshold = FMath::Max(GlobalThreshold.load(std::memory_order_relaxed), Local.IsFull() ? Local.Worst() : -TNumericLimits<float>::Max());
+            if (Threshold <= -TNumericLimits<float>::Max())
+            {
+                return false;
+            }
+
+            if (CustomBound && *CustomBound)
+            {
+                return (*CustomBound)(Spec, Pool.RightChop(Start), Slots) <= Threshold;
+            }
+            if (DefaultBound)
+            {
+                return DefaultBound->Bound(Spec, Start, Slots, Settings->MinUseInterval) <= Threshold;
+            }
+            return false;
+        }
+    };
+
+    /** Scores the combination held in SpecStack[Depth], then extends it with every later support. */
+    void Search(FSearchContext& Context, TArray<FSkillSpec>& SpecStack, TArray<int32>& Chosen, int32 Depth, int32 Start, FTopK& Local)
+    {
+        const FSkillSpec& Spec = SpecStack[Depth];
+
+        const float Score = (*Context.Score)(Spec);
+        Context.CombinationsScored.fetch_add(1, std::memory_order_relaxed);
+        if (Local.WouldAccept(Score))
+        {
+            FPoE2SupportSearchResult Result;
+            Result.Score = Score;
+            Result.Spec = Spec;
+            for (const int32 Index : Chosen)
+            {
+                Result.Supports.Add(Context.Pool[Index]);
+            }
+            Local.Add(MoveTemp(Result));
+            if (Local.IsFull())
+            {
+                Context.RaiseThreshold(Local.Worst());
+            }
+        }
+
+        const int32 Slots = Context.Settings->MaxSupports - Depth;
+        if (Slots <= 0 || Start >= Context.Pool.Num())
+        {
+            return;
+        }
+
+        if (Context.ShouldPrune(Spec, Start, Slots, Local))
+        {
+            Context.SubtreesPruned.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        for (int32 Index = Start; Index < Context.Pool.Num(); ++Index)
+        {
+            const USupportDataAsset* Support = Context.Pool[Index];
+            if (!Support || !Context.Compatibility[Index].Matches(Spec))
+            {
+                continue;
+            }
+
+            // Memoized prefix: the child starts from this depth's fold and applies one more patch
+            FSkillSpec& Child = SpecStack[Depth + 1];
+            Child = Spec;
+            FSkillSpecBuilder::ApplyPatch(Child, Support->SkillPatch, Context.CompiledPatches[Index]);
+
+            Chosen.Push(Index);
+            Search(Context, SpecStack, Chosen, Depth + 1, Index + 1, Local);
+            Chosen.Pop(EAllowShrinking::No);
+        }
+    }
+}
+
+float FPoE2SupportSearch::DefaultScore(const FSkillSpec& Spec, float MinUseInterval)
+{
+    const float UseInterval = FMath::Max3(Spec.CastTime, Spec.Cooldown, MinUseInterval);
+    return UseInterval > 0.0f ? Spec.FinalDamage / UseInterval : Spec.FinalDamage;
+}
+
+void FPoE2SupportSearch::FindTopCombinations(const USkillDataAsset* Skill, TConstArrayView<const USupportDataAsset*> SupportPool, const FPoE2SupportSearchSettings& Settings, TArray<FPoE2SupportSearchResult>& OutResults, FPoE2SupportSearchStats* OutStats)
+{
+    using namespace PoE2SupportSearch;
+
+    OutResults.Reset();
+    if (!Skill || Settings.TopK <= 0)
+    {
+        return;
+    }
+
+    const int32 MaxSupports = FMath::Max(0, Settings.MaxSupports);
+
+    FSkillSpec BaseSpec;
+    FSkillSpecBuilder::Build(Skill, {}, BaseSpec, false);
+
+    // Compile every support's patch and compatibility test (USupportDataAsset::CanSupport) once for the whole search
+    TArray<FCompiledPatch> CompiledPatches;
+    TArray<FPoE2TagQuery> Compatibility;
+    TArray<FSupportGain> Gains;
+    CompiledPatches.Reserve(SupportPool.Num());
+    Compatibility.Reserve(SupportPool.Num());
+    Gains.Reserve(SupportPool.Num());
+    for (const USupportDataAsset* Support : SupportPool)
+    {
+        CompiledPatches.Add(Support ? FCompiledPatch::Compile(Support->SkillPatch) : FCompiledPatch());
+        Compatibility.Add(Support ? Support->CompileCompatibilityQuery() : FPoE2TagQuery());
+        Gains.Add(ComputeGain(CompiledPatches.Last()));
+    }
+
+    const float MinUseInterval = Settings.MinUseInterval;
+    const FPoE2SupportScoreFunction Score = Settings.Score ? Settings.Score : FPoE2SupportScoreFunction([MinUseInterval](const FSkillSpec& Spec) { return DefaultScore(Spec, MinUseInterval); });
+
+    FSuffixBounds DefaultBound;
+    const bool bUseDefaultBound = !Settings.Score && !Settings.UpperBound && MaxSupports > 0;
+    if (bUseDefaultBound)
+    {
+        DefaultBound.Build(Gains, MaxSupports);
+    }
+
+    FSearchContext Context;
+    Context.Pool = SupportPool;
+    Context.CompiledPatches = CompiledPatches;
+    Context.Compatibility = Compatibility;
+    Context.Settings = &Settings;
+    Context.Score = &Score;
+    Context.CustomBound = Settings.UpperBound ? &Settings.UpperBound : nullptr;
+    Context.DefaultBound = bUseDefaultBound ? &DefaultBound : nullptr;
+
+    // Root (no supports) plus one task per first support; each task owns its spec stack and top-K
+    const int32 NumTasks = SupportPool.Num() + 1;
+    TArray<FTopK> LocalResults;
+    LocalResults.SetNum(NumTasks);
+
+    ParallelFor(NumTasks, [&](int32 TaskIndex)
+    {
+        FTopK& Local = LocalResults[TaskIndex];
+        Local.Capacity = Settings.TopK;
+
+        TArray<FSkillSpec> SpecStack;
+        SpecStack.SetNum(MaxSupports + 1);
+        SpecStack[0] = BaseSpec;
+        TArray<int32> Chosen;
+        Chosen.Reserve(MaxSupports);
+
+        if (TaskIndex == 0)
+        {
+            // Root combination only; its children are the other tasks
+            FPoE2SupportSearchResult Result;
+            Result.Spec = BaseSpec;
+            Result.Score = Score(BaseSpec);
+            Local.Add(MoveTemp(Result));
+            Context.CombinationsScored.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        const int32 FirstIndex = TaskIndex - 1;
+        const USupportDataAsset* First = SupportPool[FirstIndex];
+        if (MaxSupports == 0 || !First || !Compatibility[FirstIndex].Matches(BaseSpec))
+        {
+            return;
+        }
+
+        SpecStack[1] = BaseSpec;
+        FSkillSpecBuilder::ApplyPatch(SpecStack[1], First->SkillPatch, CompiledPatches[FirstIndex]);
+        Chosen.Push(FirstIndex);
+        Search(Context, SpecStack, Chosen, 1, FirstIndex + 1, Local);
+    });
+
+    for (FTopK& Local : LocalResults)
+    {
+        OutResults.Append(MoveTemp(Local.Heap));
+    }
+
+    Algo::StableSortBy(OutResults, [](const FPoE2SupportSearchResult& Result) { return -Result.Score; });
+    if (OutResults.Num() > Settings.TopK)
+    {
+        OutResults.SetNum(Settings.TopK);
+    }
+
+    if (OutStats)
+    {
+        OutStats->CombinationsScored = Context.CombinationsScored.load();
+        OutStats->SubtreesPruned = Context.SubtreesPruned.load();
+    }
+}
@@ -0,0 +1,159 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Spec/SkillModifierIndex.h"
+#include "Spec/SkillSpec.h"
+
+FPoE2SkillModifierTarget FPoE2SkillModifierTarget::FromSpec(const FSkillSpec& Spec)
+{
+    FPoE2SkillModifierTarget Target;
+    Target.Tags = Spec.SkillTags;
+    Target.Bits = Spec.TagBits;
+    Target.BitsGeneration = Spec.TagBitsGeneration;
+    return Target;
+}
+
+FPoE2SkillModifierSourceHandle FPoE2SkillModifierIndex::AddSource(TConstArrayView<FPoE2SkillModifier> Modifiers)
+{
+    FPoE2SkillModifierSourceHandle Handle;
+    Handle.Id = NextSourceId++;
+
+    TArray<int32>& SourceEntries = Sources.Add(Handle.Id);
+    for (const FPoE2SkillModifier& Modifier : Modifiers)
+    {
+        FEntry Entry;
+        Entry.Modifier = Modifier;
+        Entry.Query = FPoE2TagQuery::Compile(Modifier.RequiredSkillTags, Modifier.ExcludedSkillTags);
+        Entry.Compiled = FCompiledPatch::Compile(Modifier.Patch);
+        Entry.Order = NextOrder++;
+
+        // Any required tag is a valid key; the first is as selective as any other
+        const FGameplayTag Key = Modifier.RequiredSkillTags.IsEmpty() ? FGameplayTag() : Modifier.RequiredSkillTags.First();
+        Entry.Bucket = Key.IsValid() ? FindOrAddBucket(Key) : INDEX_NONE;
+
+        const int32 EntryIndex = Entries.Add(MoveTemp(Entry));
+        SourceEntries.Add(EntryIndex);
+        (Entries[EntryIndex].Bucket != INDEX_NONE ? Buckets[Entries[EntryIndex].Bucket].Entries : Unbucketed).Add(EntryIndex);
+    }
+
+    return Handle;
+}
+
+void FPoE2SkillModifierIndex::RemoveSource(FPoE2SkillModifierSourceHandle Source)
+{
+    TArray<int32> SourceEntries;
+    if (!Sources.RemoveAndCopyValue(Source.Id, SourceEntries))
+    {
+        return;
+    }
+
+    for (const int32 EntryIndex : SourceEntries)
+    {
+        const int32 Bucket = Entries[EntryIndex].Bucket;
+        (Bucket != INDEX_NONE ? Buckets[Bucket].Entries : Unbucketed).RemoveSingle(EntryIndex);
+        Entries.RemoveAt(EntryIndex);
+    }
+}
+
+int32 FPoE2SkillModifierIndex::FindOrAddBucket(const FGameplayTag& Tag)
+{
+    const int32 Existing = Buckets.IndexOfByPredicate([&Tag](const FBucket& Bucket) { return Bucket.Tag == Tag; });
+    if (Existing != INDEX_NONE)
+    {
+        return Existing;
+    }
+
+    FBucket& Bucket = Buckets.AddDefaulted_GetRef();
+    Bucket.Tag = Tag;
+
+    const FPoE2TagBitTable& Table = FPoE2TagBitTable::Get();
+    const int32 Bit = Table.FindBit(Tag);
+    if (Bit != INDEX_NONE)
+    {
+        Bucket.Mask = Table.GetDescendantMask(Bit);
+        Bucket.MaskGeneration = Table.GetGeneration();
+    }
+    return Buckets.Num() - 1;
+}
+
+bool FPoE2SkillModifierIndex::BucketMatches(const FBucket& Bucket, const FPoE2SkillModifierTarget& Target) const
+{
+    if (Bucket.MaskGeneration != 0 && Bucket.MaskGeneration == Target.BitsGeneration)
+    {
+        return Target.Bits.HasAny(Bucket.Mask);
+    }
+    return Target.Tags.HasTag(Bucket.Tag);
+}
+
+bool FPoE2SkillModifierIndex::Affects(FPoE2SkillModifierSourceHandle Source, const FPoE2SkillModifierTarget& Target) const
+{
+    const TArray<int32>* SourceEntries = Sources.Find(Source.Id);
+    if (!SourceEntries)
+    {
+        return false;
+    }
+
+    for (const int32 EntryIndex : *SourceEntries)
+    {
+        if (Entries[EntryIndex].Query.Matches(Target.Tags, Target.Bits, Target.BitsGeneration))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FPoE2SkillModifierIndex::GatherEntries(const FPoE2SkillModifierTarget& Target, TArray<int32, TInlineAllocator<16>>& OutEntries) const
+{
+    auto TestEntries = [this, &Target, &OutEntries](const TArray<int32>& Candidates)
+    {
+        for (const int32 EntryIndex : Candidates)
+        {
+            if (Entries[EntryIndex].Query.Matches(Target.Tags, Target.Bits, Target.BitsGeneration))
+            {
+                OutEntries.Add(EntryIndex);
+            }
+        }
+    };
+
+    TestEntries(Unbucketed);
+    for (const FBucket& Bucket : Buckets)
+    {
+        if (Bucket.Entries.Num() > 0 && BucketMatches(Bucket, Target))
+        {
+            TestEntries(Bucket.Entries);
+        }
+    }
+
+    OutEntries.Sort([this](int32 A, int32 B) { return Entries[A].Order < Entries[B].Order; });
+}
+
+void FPoE2SkillModifierIndex::GatherModifiers(const FPoE2SkillModifierTarget& Target, TArray<const FPoE2SkillModifier*>& OutModifiers) const
+{
+    TArray<int32, TInlineAllocator<16>> Matched;
+    GatherEntries(Target, Matched);
+    for (const int32 EntryIndex : Matched)
+    {
+        OutModifiers.Add(&Entries[EntryIndex].Modifier);
+    }
+}
+
+int32 FPoE2SkillModifierIndex::Apply(FSkillSpec& Spec) const
+{
+    if (Entries.Num() == 0)
+    {
+        return 0;
+    }
+
+    // Matched against the tags before any modifier applies, so modifiers never enable each other
+    TArray<int32, TInlineAllocator<16>> Matched;
+    GatherEntries(FPoE2SkillModifierTarget::FromSpec(Spec), Matched);
+
+    for (const int32 EntryIndex : Matched)
+    {
+        const FEntry& Entry = Entries[EntryIndex];
+        FSkillSpecBuilder::ApplyPatch(Spec, Entry.Modifier.Patch, Entry.Compiled);
+    }
+    return Matched.Num();
+}
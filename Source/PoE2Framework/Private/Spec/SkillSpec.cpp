@@ -6,6 +6,106 @@
 #include "AbilitySystem/Actors/PoE2AreaEffectBase.h"
 #include "AbilitySystem/Actors/PoE2MinionBase.h"
 #include "AbilitySystem/Handlers/MechanicHandler.h"
+#include "AbilitySystem/Handlers/MechanicHandlerPipeline.h"
+#include "Data/PoE2SkillRegistry.h"
+
+void FSkillSpec::FreezeHandlerPipeline()
+{
+    HandlerPipeline = FMechanicHandlerPipeline::Compile(MechanicHandlers);
+    HandlerPipeline->GetHandlerClasses(MechanicHandlers);
+}
+
+void FSkillSpec::RefreshTagBits()
+{
+    const FPoE2TagBitTable& Table = FPoE2TagBitTable::Get();
+    TagBits = Table.IsComplete() ? Table.FromContainer(SkillTags) : FPoE2TagBits();
+    TagBitsGeneration = Table.GetGeneration();
+}
+
+void FSkillSpec::CompileHitConditions()
+{
+    HitConditions = FPoE2HitConditionProgram::Compile(ConditionalModifiers);
+}
+
+uint32 FSkillSpec::GetCacheHash() const
+{
+    uint32 Hash = SkillIndex.IsValid() ? GetTypeHash(SkillIndex) : GetTypeHash(SkillId);
+
+    const float Numbers[] = { FinalDamage, Cooldown, ResourceCost, CastTime, AreaRadius, ProjectileSpeed, MaxRange, Lifetime };
+    Hash = FCrc::MemCrc32(Numbers, sizeof(Numbers), Hash);
+    Hash = HashCombineFast(Hash, GetTypeHash(SummonCount));
+
+    // 位集无效时（表未完成或已重建）退回到容器
+    if (TagBitsGeneration != 0 && TagBitsGeneration == FPoE2TagBitTable::Get().GetGeneration())
+    {
+        Hash = HashCombineFast(Hash, GetTypeHash(TagBits));
+    }
+    else
+    {
+        for (const FGameplayTag& Tag : SkillTags)
+        {
+            Hash = HashCombineFast(Hash, GetTypeHash(Tag));
+        }
+    }
+
+    Hash = HashCombineFast(Hash, GetTypeHash(AbilityClass.Get()));
+    Hash = HashCombineFast(Hash, GetTypeHash(ProjectileClass.Get()));
+    Hash = HashCombineFast(Hash, GetTypeHash(AreaClass.Get()));
+    Hash = HashCombineFast(Hash, GetTypeHash(SummonClass.Get()));
+    Hash = HashCombineFast(Hash, GetTypeHash(DamageEffectClass.Get()));
+    for (const TSubclassOf<UGameplayEffect>& Effect : AppliedEffects)
+    {
+        Hash = HashCombineFast(Hash, GetTypeHash(Effect.Get()));
+    }
+    for (const TSubclassOf<UObject>& Handler : MechanicHandlers)
+    {
+        Hash = HashCombineFast(Hash, GetTypeHash(Handler.Get()));
+    }
+    for (const FCustomParam& Param : CustomParams)
+    {
+        Hash = HashCombineFast(Hash, HashCombineFast(GetTypeHash(Param.Key), GetTypeHash(Param.Value)));
+    }
+    for (const FPoE2ConditionalModifier& Modifier : ConditionalModifiers)
+    {
+        Hash = HashCombineFast(Hash, HashCombineFast(GetTypeHash(Modifier.Op), GetTypeHash(Modifier.Value)));
+        Hash = HashCombineFast(Hash, GetTypeHash(Modifier.Conditions.Num()));
+        for (const FPoE2HitCondition& Condition : Modifier.Conditions)
+        {
+            Hash = HashCombineFast(Hash, HashCombineFast(GetTypeHash(Condition.Type), GetTypeHash(Condition.Tag)));
+            Hash = HashCombineFast(Hash, HashCombineFast(GetTypeHash(Condition.Value), GetTypeHash(Condition.Threshold)));
+            Hash = HashCombineFast(Hash, GetTypeHash(Condition.bNegate));
+        }
+    }
+    return Hash;
+}
+
+bool FSkillSpec::operator==(const FSkillSpec& Other) const
+{
+    // FCustomParam::operator== 只比较键，这里键值都要相同
+    auto SameParams = [](const TArray<FCustomParam>& A, const TArray<FCustomParam>& B)
+    {
+        if (A.Num() != B.Num())
+        {
+            return false;
+        }
+        for (int32 Index = 0; Index < A.Num(); ++Index)
+        {
+            if (A[Index].Key != B[Index].Key || A[Index].Value != B[Index].Value)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    return SkillId == Other.SkillId && SkillIndex == Other.SkillIndex
+        && AbilityClass == Other.AbilityClass && ProjectileClass == Other.ProjectileClass && AreaClass == Other.AreaClass
+        && SummonClass == Other.SummonClass && SummonCount == Other.SummonCount && DamageEffectClass == Other.DamageEffectClass
+        && FinalDamage == Other.FinalDamage && Cooldown == Other.Cooldown && ResourceCost == Other.ResourceCost && CastTime == Other.CastTime
+        && AreaRadius == Other.AreaRadius && ProjectileSpeed == Other.ProjectileSpeed && MaxRange == Other.MaxRange && Lifetime == Other.Lifetime
+        && SkillTags == Other.SkillTags && AppliedEffects == Other.AppliedEffects && MechanicHandlers == Other.MechanicHandlers
+        && ConditionalModifiers == Other.ConditionalModifiers && SameParams(CustomParams, Other.CustomParams);
+}
 
 bool FSkillSpec::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
 {
@@ -24,8 +124,29 @@ bool FSkillSpec::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
         return false;
     }
 
-    // 序列化基础数据
-    Ar << SkillId;
+    // 序列化基础数据：已注册的技能只发送索引，接收端从注册表还原 SkillId
+    uint8 bHasSkillIndex = SkillIndex.IsValid() ? 1 : 0;
+    Ar.SerializeBits(&bHasSkillIndex, 1);
+    if (bHasSkillIndex)
+    {
+        Ar << SkillIndex.Value;
+        if (Ar.IsLoading())
+        {
+            const UPoE2SkillRegistry* Registry = UPoE2SkillRegistry::Get();
+            SkillId = Registry ? Registry->GetSkillId(SkillIndex) : NAME_None;
+            if (SkillId.IsNone())
+            {
+                // 两端内容不一致
+                bOutSuccess = false;
+                return false;
+            }
+        }
+    }
+    else
+    {
+        SkillIndex = FPoE2AssetIndex();
+        Ar << SkillId;
+    }
     
     // 使用 UObject* 临时变量序列化类引用
     UObject* TempAbilityClass = AbilityClass;
@@ -150,6 +271,10 @@ bool FSkillSpec::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
         bOutSuccess = false;
         return false;
     }
+    if (Ar.IsLoading())
+    {
+        RefreshTagBits();
+    }
 
     // 序列化效果数组
     uint32 EffectsNum = AppliedEffects.Num();
@@ -221,6 +346,9 @@ bool FSkillSpec::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
     if (Ar.IsLoading())
     {
         MechanicHandlers.SetNum(HandlersNum);
+
+        // 管线只在服务器端构建，接收到的列表不再对应旧管线
+        HandlerPipeline.Reset();
     }
     
     for (uint32 i = 0; i < HandlersNum; i++)
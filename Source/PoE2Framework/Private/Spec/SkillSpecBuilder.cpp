@@ -0,0 +1,189 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Spec/SkillSpecBuilder.h"
+#include "Spec/SkillSpec.h"
+#include "Spec/Patch.h"
+#include "Data/SkillDataAsset.h"
+#include "Core/PoE2Log.h"
+
+namespace SkillSpecNumericField
+{
+    namespace
+    {
+        float FSkillSpec::* const Members[Num] =
+        {
+            &FSkillSpec::FinalDamage,
+            &FSkillSpec::Cooldown,
+            &FSkillSpec::ResourceCost,
+            &FSkillSpec::CastTime,
+            &FSkillSpec::AreaRadius,
+            &FSkillSpec::ProjectileSpeed,
+            &FSkillSpec::MaxRange,
+            &FSkillSpec::Lifetime,
+        };
+
+        const FName Names[Num] =
+        {
+            GET_MEMBER_NAME_CHECKED(FSkillSpec, FinalDamage),
+            GET_MEMBER_NAME_CHECKED(FSkillSpec, Cooldown),
+            GET_MEMBER_NAME_CHECKED(FSkillSpec, ResourceCost),
+            GET_MEMBER_NAME_CHECKED(FSkillSpec, CastTime),
+            GET_MEMBER_NAME_CHECKED(FSkillSpec, AreaRadius),
+            GET_MEMBER_NAME_CHECKED(FSkillSpec, ProjectileSpeed),
+            GET_MEMBER_NAME_CHECKED(FSkillSpec, MaxRange),
+            GET_MEMBER_NAME_CHECKED(FSkillSpec, Lifetime),
+        };
+    }
+
+    ESkillSpecNumericField FromName(FName Name)
+    {
+        for (int32 Index = 0; Index < Num; ++Index)
+        {
+            if (Names[Index] == Name)
+            {
+                return static_cast<ESkillSpecNumericField>(Index);
+            }
+        }
+        return ESkillSpecNumericField::Count;
+    }
+
+    FName ToName(ESkillSpecNumericField Field)
+    {
+        return Field < ESkillSpecNumericField::Count ? Names[static_cast<int32>(Field)] : NAME_None;
+    }
+
+    bool IsLowerBetter(ESkillSpecNumericField Field)
+    {
+        return Field == ESkillSpecNumericField::Cooldown || Field == ESkillSpecNumericField::ResourceCost || Field == ESkillSpecNumericField::CastTime;
+    }
+
+    float& Get(FSkillSpec& Spec, ESkillSpecNumericField Field)
+    {
+        check(Field < ESkillSpecNumericField::Count);
+        return Spec.*Members[static_cast<int32>(Field)];
+    }
+
+    float Get(const FSkillSpec& Spec, ESkillSpecNumericField Field)
+    {
+        check(Field < ESkillSpecNumericField::Count);
+        return Spec.*Members[static_cast<int32>(Field)];
+    }
+}
+
+FCompiledPatch FCompiledPatch::Compile(const FPatch& Patch)
+{
+    FCompiledPatch Compiled;
+
+    auto CompileOps = [](const TMap<FName, float>& Modifiers, TArray<FOp, TInlineAllocator<4>>& OutOps)
+    {
+        for (const TPair<FName, float>& Elem : Modifiers)
+        {
+            const ESkillSpecNumericField Field = SkillSpecNumericField::FromName(Elem.Key);
+            if (Field == ESkillSpecNumericField::Count)
+            {
+                UE_LOG(LogPoE2Framework, Verbose, TEXT("FCompiledPatch: '%s' is not a numeric SkillSpec field, ignored"), *Elem.Key.ToString());
+                continue;
+            }
+            OutOps.Add({ Field, Elem.Value });
+        }
+    };
+
+    CompileOps(Patch.AdditiveModifiers, Compiled.Additive);
+    CompileOps(Patch.MultiplicativeModifiers, Compiled.Multiplicative);
+
+    // Tags outside the mapped roots never reach a query mask, so only completeness of the table matters
+    const FPoE2TagBitTable& Table = FPoE2TagBitTable::Get();
+    if (Table.IsComplete())
+    {
+        Compiled.TagsToAdd = Table.FromContainer(Patch.TagsToAdd);
+        Compiled.TagsToRemove = Table.FromContainer(Patch.TagsToRemove);
+        Compiled.TagBitsGeneration = Table.GetGeneration();
+    }
+    return Compiled;
+}
+
+void FCompiledPatch::ApplyNumerics(FSkillSpec& Spec) const
+{
+    for (const FOp& Op : Additive)
+    {
+        SkillSpecNumericField::Get(Spec, Op.Field) += Op.Value;
+    }
+
+    for (const FOp& Op : Multiplicative)
+    {
+        SkillSpecNumericField::Get(Spec, Op.Field) *= (1.0f + Op.Value);
+    }
+}
+
+void FCompiledPatch::ApplyTags(FSkillSpec& Spec, const FPatch& Patch) const
+{
+    Spec.SkillTags.AppendTags(Patch.TagsToAdd);
+    Spec.SkillTags.RemoveTags(Patch.TagsToRemove);
+
+    if (TagBitsGeneration != 0 && Spec.TagBitsGeneration == TagBitsGeneration)
+    {
+        Spec.TagBits.Append(TagsToAdd);
+        Spec.TagBits.Remove(TagsToRemove);
+    }
+    else
+    {
+        Spec.RefreshTagBits();
+    }
+}
+
+void FSkillSpecBuilder::Build(const USkillDataAsset* SkillDA, TConstArrayView<FPatch> Patches, FSkillSpec& OutSpec, bool bFreezeHandlerPipeline)
+{
+    if (!SkillDA)
+    {
+        return;
+    }
+
+    // 1. 从 SkillDA 读取基础数值
+    OutSpec = SkillDA->CreateBaseSkillSpec();
+
+    // 2. 按顺序应用所有 Patch 修改
+    for (const FPatch& Patch : Patches)
+    {
+        ApplyPatch(OutSpec, Patch);
+    }
+
+    // 3. 条件修正编译为命中时求值的谓词程序
+    OutSpec.CompileHitConditions();
+
+    // 4. 去重并排序机制处理器，冻结为所有承载体共享的管线
+    if (bFreezeHandlerPipeline)
+    {
+        OutSpec.FreezeHandlerPipeline();
+    }
+}
+
+void FSkillSpecBuilder::ApplyPatch(FSkillSpec& Spec, const FPatch& Patch)
+{
+    ApplyPatch(Spec, Patch, FCompiledPatch::Compile(Patch));
+}
+
+void FSkillSpecBuilder::ApplyPatch(FSkillSpec& Spec, const FPatch& Patch, const FCompiledPatch& Compiled)
+{
+    // 数值修改（先加法，后乘法 "Increased/Reduced"）
+    Compiled.ApplyNumerics(Spec);
+
+    // 应用标签修改（容器与位集同步）
+    Compiled.ApplyTags(Spec, Patch);
+
+    // 添加效果
+    Spec.AppliedEffects.Append(Patch.EffectsToAdd);
+
+    // 添加机制处理器
+    Spec.MechanicHandlers.Append(Patch.HandlersToAdd);
+
+    // 添加条件修正（由 Build 统一编译）
+    Spec.ConditionalModifiers.Append(Patch.ConditionalModifiersToAdd);
+
+    // 应用投掷物类覆盖
+    if (Patch.ProjectileClassOverride)
+    {
+        Spec.ProjectileClass = Patch.ProjectileClassOverride;
+    }
+}
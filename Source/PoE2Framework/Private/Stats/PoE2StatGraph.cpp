@@ -0,0 +1,305 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Stats/PoE2StatGraph.h"
+#include "Spec/SkillSpec.h"
+#include "Spec/SkillSpecBuilder.h"
+#include "Core/PoE2Log.h"
+
+FPoE2StatSourceHandle FPoE2StatGraph::AddSource(TConstArrayView<FPoE2StatModifier> Modifiers)
+{
+    FPoE2StatSourceHandle Handle;
+    Handle.Id = NextSourceId++;
+    AddModifiers(Handle.Id, Modifiers);
+    ++Revision;
+    return Handle;
+}
+
+void FPoE2StatGraph::UpdateSource(FPoE2StatSourceHandle Source, TConstArrayView<FPoE2StatModifier> Modifiers)
+{
+    if (!HasSource(Source))
+    {
+        return;
+    }
+
+    RemoveModifiers(Source.Id);
+    AddModifiers(Source.Id, Modifiers);
+    ++Revision;
+}
+
+void FPoE2StatGraph::RemoveSource(FPoE2StatSourceHandle Source)
+{
+    if (!HasSource(Source))
+    {
+        return;
+    }
+
+    RemoveModifiers(Source.Id);
+    ++Revision;
+}
+
+void FPoE2StatGraph::AddModifiers(uint32 SourceId, TConstArrayView<FPoE2StatModifier> Modifiers)
+{
+    TArray<int32>& Touched = SourceStats.Add(SourceId);
+    for (const FPoE2StatModifier& Modifier : Modifiers)
+    {
+        if (Modifier.Stat.IsNone())
+        {
+            continue;
+        }
+
+        const int32 StatIndex = FindOrAddStat(Modifier.Stat);
+        Stats[StatIndex].Contributions.Add({ SourceId, Modifier.Op, Modifier.Value });
+        Touched.AddUnique(StatIndex);
+    }
+
+    for (const int32 StatIndex : Touched)
+    {
+        MarkStatDirty(StatIndex);
+    }
+}
+
+void FPoE2StatGraph::RemoveModifiers(uint32 SourceId)
+{
+    TArray<int32> Touched;
+    SourceStats.RemoveAndCopyValue(SourceId, Touched);
+    for (const int32 StatIndex : Touched)
+    {
+        Stats[StatIndex].Contributions.RemoveAllSwap([SourceId](const FContribution& Contribution) { return Contribution.Source == SourceId; });
+        MarkStatDirty(StatIndex);
+    }
+}
+
+void FPoE2StatGraph::SetBaseValue(FName Stat, float Value)
+{
+    const int32 StatIndex = FindOrAddStat(Stat);
+    if (Stats[StatIndex].BaseValue != Value)
+    {
+        Stats[StatIndex].BaseValue = Value;
+        MarkStatDirty(StatIndex);
+        ++Revision;
+    }
+}
+
+bool FPoE2StatGraph::AddDerivation(FName From, FName To, EPoE2StatModOp Op, float PerPoint)
+{
+    const int32 FromIndex = FindOrAddStat(From);
+    const int32 ToIndex = FindOrAddStat(To);
+    if (FromIndex == ToIndex || IsReachable(ToIndex, FromIndex))
+    {
+        UE_LOG(LogPoE2Framework, Warning, TEXT("FPoE2StatGraph: deriving %s from %s would close a cycle, ignored"), *To.ToString(), *From.ToString());
+        return false;
+    }
+
+    Stats[ToIndex].Inputs.Add({ FromIndex, Op, PerPoint });
+    Stats[FromIndex].DerivedStats.AddUnique(ToIndex);
+    MarkStatDirty(ToIndex);
+    ++Revision;
+    return true;
+}
+
+float FPoE2StatGraph::GetValue(FName Stat) const
+{
+    return GetAggregate(Stat).GetValue();
+}
+
+FPoE2StatAggregate FPoE2StatGraph::GetAggregate(FName Stat) const
+{
+    const int32* StatIndex = StatIndices.Find(Stat);
+    return StatIndex ? Evaluate(*StatIndex) : FPoE2StatAggregate();
+}
+
+int32 FPoE2StatGraph::FindOrAddStat(FName Stat)
+{
+    if (const int32* Existing = StatIndices.Find(Stat))
+    {
+        return *Existing;
+    }
+
+    const int32 StatIndex = Stats.AddDefaulted();
+    Stats[StatIndex].Name = Stat;
+    StatIndices.Add(Stat, StatIndex);
+    return StatIndex;
+}
+
+void FPoE2StatGraph::MarkStatDirty(int32 StatIndex)
+{
+    FStatNode& Node = Stats[StatIndex];
+    for (const int32 Consumer : Node.Consumers)
+    {
+        Consumers[Consumer].bDirty = true;
+    }
+
+    // A dirty stat's derived stats are already dirty: evaluating one evaluates its inputs first
+    if (Node.bDirty)
+    {
+        return;
+    }
+
+    Node.bDirty = true;
+    for (const int32 Derived : Node.DerivedStats)
+    {
+        MarkStatDirty(Derived);
+    }
+}
+
+const FPoE2StatAggregate& FPoE2StatGraph::Evaluate(int32 StatIndex) const
+{
+    const FStatNode& Node = Stats[StatIndex];
+    if (!Node.bDirty)
+    {
+        return Node.Cached;
+    }
+
+    FPoE2StatAggregate Aggregate;
+    Aggregate.Base = Node.BaseValue;
+    for (const FContribution& Contribution : Node.Contributions)
+    {
+        Aggregate.Add(Contribution.Op, Contribution.Value);
+    }
+    for (const FDerivation& Input : Node.Inputs)
+    {
+        Aggregate.Add(Input.Op, Evaluate(Input.From).GetValue() * Input.PerPoint);
+    }
+
+    Node.Cached = Aggregate;
+    Node.bDirty = false;
+    ++RecomputeCount;
+    return Node.Cached;
+}
+
+bool FPoE2StatGraph::IsReachable(int32 From, int32 To) const
+{
+    TArray<int32, TInlineAllocator<16>> Stack = { From };
+    TSet<int32> Visited;
+    while (Stack.Num() > 0)
+    {
+        const int32 Current = Stack.Pop(EAllowShrinking::No);
+        if (Current == To)
+        {
+            return true;
+        }
+        if (!Visited.Contains(Current))
+        {
+            Visited.Add(Current);
+            Stack.Append(Stats[Current].DerivedStats);
+        }
+    }
+    return false;
+}
+
+int32 FPoE2StatGraph::AddConsumer()
+{
+    const int32 Consumer = FreeConsumers.Num() > 0 ? FreeConsumers.Pop(EAllowShrinking::No) : Consumers.AddDefaulted();
+    Consumers[Consumer] = FConsumer();
+    Consumers[Consumer].bAlive = true;
+    return Consumer;
+}
+
+void FPoE2StatGraph::RemoveConsumer(int32 Consumer)
+{
+    if (!Consumers.IsValidIndex(Consumer) || !Consumers[Consumer].bAlive)
+    {
+        return;
+    }
+
+    SetConsumerStats(Consumer, {});
+    Consumers[Consumer].bAlive = false;
+    FreeConsumers.Add(Consumer);
+}
+
+void FPoE2StatGraph::SetConsumerStats(int32 Consumer, TConstArrayView<FName> InStats)
+{
+    if (!Consumers.IsValidIndex(Consumer) || !Consumers[Consumer].bAlive)
+    {
+        return;
+    }
+
+    for (const int32 StatIndex : Consumers[Consumer].Stats)
+    {
+        Stats[StatIndex].Consumers.RemoveSingleSwap(Consumer);
+    }
+
+    TArray<int32> NewStats;
+    NewStats.Reserve(InStats.Num());
+    for (const FName Stat : InStats)
+    {
+        const int32 StatIndex = FindOrAddStat(Stat);
+        if (!NewStats.Contains(StatIndex))
+        {
+            NewStats.Add(StatIndex);
+            Stats[StatIndex].Consumers.Add(Consumer);
+        }
+    }
+
+    Consumers[Consumer].Stats = MoveTemp(NewStats);
+    Consumers[Consumer].bDirty = true;
+}
+
+bool FPoE2StatGraph::IsConsumerDirty(int32 Consumer) const
+{
+    return !Consumers.IsValidIndex(Consumer) || !Consumers[Consumer].bAlive || Consumers[Consumer].bDirty;
+}
+
+void FPoE2StatGraph::MarkConsumerDirty(int32 Consumer)
+{
+    if (Consumers.IsValidIndex(Consumer))
+    {
+        Consumers[Consumer].bDirty = true;
+    }
+}
+
+void FPoE2StatGraph::ClearConsumerDirty(int32 Consumer)
+{
+    if (!Consumers.IsValidIndex(Consumer) || !Consumers[Consumer].bAlive)
+    {
+        return;
+    }
+
+    // Evaluating keeps "dirty stat => dirty consumers" true once the flag is cleared
+    for (const int32 StatIndex : Consumers[Consumer].Stats)
+    {
+        Evaluate(StatIndex);
+    }
+    Consumers[Consumer].bDirty = false;
+}
+
+void FPoE2StatGraph::GetSpecStats(const FSkillSpec& Spec, TArray<FName>& OutStats)
+{
+    OutStats.Reset();
+    for (int32 Field = 0; Field < SkillSpecNumericField::Num; ++Field)
+    {
+        const ESkillSpecNumericField NumericField = static_cast<ESkillSpecNumericField>(Field);
+        if (SkillSpecNumericField::Get(Spec, NumericField) != 0.0f)
+        {
+            OutStats.Add(SkillSpecNumericField::ToName(NumericField));
+        }
+    }
+}
+
+void FPoE2StatGraph::ApplyToSpec(FSkillSpec& Spec) const
+{
+    // Character stats scale what a skill has; they never give a skill a property it lacks
+    for (int32 Field = 0; Field < SkillSpecNumericField::Num; ++Field)
+    {
+        const ESkillSpecNumericField NumericField = static_cast<ESkillSpecNumericField>(Field);
+        float& Value = SkillSpecNumericField::Get(Spec, NumericField);
+        if (Value == 0.0f)
+        {
+            continue;
+        }
+
+        const FPoE2StatAggregate Aggregate = GetAggregate(SkillSpecNumericField::ToName(NumericField));
+        if (SkillSpecNumericField::IsLowerBetter(NumericField))
+        {
+            // "Increased cooldown recovery / cast speed / cost efficiency" shortens the field instead of lengthening it
+            const float Speed = FMath::Max((1.0f + Aggregate.Increased) * Aggregate.More, UE_KINDA_SMALL_NUMBER);
+            Value = FMath::Max(Value + Aggregate.Flat, 0.0f) / Speed;
+        }
+        else
+        {
+            Value = Aggregate.Apply(Value);
+        }
+    }
+}
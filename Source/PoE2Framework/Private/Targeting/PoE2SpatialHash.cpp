@@ -0,0 +1,86 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Targeting/PoE2SpatialHash.h"
+
+FPoE2SpatialHash::FPoE2SpatialHash(float InCellSize, int32 InNumBuckets)
+    : CellSize(FMath::Max(InCellSize, 1.0f))
+    , NumBuckets(FMath::Max(InNumBuckets, 1))
+{
+}
+
+FIntPoint FPoE2SpatialHash::GetCell(const FVector& Location) const
+{
+    return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+int32 FPoE2SpatialHash::GetBucket(const FIntPoint& Cell) const
+{
+    return static_cast<int32>(GetTypeHash(Cell) % static_cast<uint32>(NumBuckets));
+}
+
+void FPoE2SpatialHash::Build(TConstArrayView<FVector> Points)
+{
+    // Counting sort by bucket: count, prefix-sum into starts, then scatter
+    BucketStarts.SetNumZeroed(NumBuckets + 1);
+    Entries.SetNumUninitialized(Points.Num());
+
+    TArray<int32, TInlineAllocator<256>> Buckets;
+    Buckets.SetNumUninitialized(Points.Num());
+    for (int32 Index = 0; Index < Points.Num(); ++Index)
+    {
+        Buckets[Index] = GetBucket(GetCell(Points[Index]));
+        ++BucketStarts[Buckets[Index] + 1];
+    }
+
+    for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+    {
+        BucketStarts[Bucket + 1] += BucketStarts[Bucket];
+    }
+
+    TArray<int32, TInlineAllocator<256>> Cursors(BucketStarts.GetData(), NumBuckets);
+    for (int32 Index = 0; Index < Points.Num(); ++Index)
+    {
+        Entries[Cursors[Buckets[Index]]++] = { Points[Index], GetCell(Points[Index]), Index };
+    }
+}
+
+void FPoE2SpatialHash::ForEachInRadius(const FVector& Origin, float Radius, TFunctionRef<void(int32 Index)> Visitor) const
+{
+    const float RadiusSq = FMath::Square(Radius);
+    const FIntPoint Min = GetCell(Origin - FVector(Radius, Radius, 0.0f));
+    const FIntPoint Max = GetCell(Origin + FVector(Radius, Radius, 0.0f));
+
+    // A radius spanning more cells than there are buckets would scan buckets repeatedly; walk everything once instead
+    const int64 NumCells = static_cast<int64>(Max.X - Min.X + 1) * static_cast<int64>(Max.Y - Min.Y + 1);
+    if (NumCells >= NumBuckets)
+    {
+        for (const FEntry& Entry : Entries)
+        {
+            if (FVector::DistSquared(Entry.Location, Origin) <= RadiusSq)
+            {
+                Visitor(Entry.Index);
+            }
+        }
+        return;
+    }
+
+    for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+    {
+        for (int32 X = Min.X; X <= Max.X; ++X)
+        {
+            const FIntPoint Cell(X, Y);
+            const int32 Bucket = GetBucket(Cell);
+            for (int32 Entry = BucketStarts[Bucket]; Entry < BucketStarts[Bucket + 1]; ++Entry)
+            {
+                // Other cells hashing into the same bucket are visited when their own cell is scanned
+                const FEntry& Candidate = Entries[Entry];
+                if (Candidate.Cell == Cell && FVector::DistSquared(Candidate.Location, Origin) <= RadiusSq)
+                {
+                    Visitor(Candidate.Index);
+                }
+            }
+        }
+    }
+}
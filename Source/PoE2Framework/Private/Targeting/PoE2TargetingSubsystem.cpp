@@ -0,0 +1,273 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "Targeting/PoE2TargetingSubsystem.h"
+#include "AbilitySystem/Actors/PoE2MinionBase.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "Attributes/AttributeSet_Core.h"
+#include "GenericTeamAgentInterface.h"
+#include "Engine/World.h"
+
+DECLARE_STATS_GROUP(TEXT("PoE2 Targeting"), STATGROUP_PoE2Targeting, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Targeting Batch"), STAT_PoE2TargetingBatch, STATGROUP_PoE2Targeting);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Registered Targets"), STAT_PoE2TargetingTargets, STATGROUP_PoE2Targeting);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Requests"), STAT_PoE2TargetingRequests, STATGROUP_PoE2Targeting);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Request Groups"), STAT_PoE2TargetingGroups, STATGROUP_PoE2Targeting);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Candidate Checks"), STAT_PoE2TargetingChecks, STATGROUP_PoE2Targeting);
+
+namespace
+{
+    /** Requests sharing a key see the same hostile candidates, so they share one gather. */
+    struct FTargetGroupKey
+    {
+        /** The team owner's team, or NoTeam when the owner has none and is then its own team. */
+        uint8 TeamId = FGenericTeamId::NoTeam.GetId();
+        const AActor* TeamOwner = nullptr;
+        FIntPoint Cell = FIntPoint::ZeroValue;
+
+        bool operator==(const FTargetGroupKey& Other) const
+        {
+            return TeamId == Other.TeamId && TeamOwner == Other.TeamOwner && Cell == Other.Cell;
+        }
+
+        friend uint32 GetTypeHash(const FTargetGroupKey& Key)
+        {
+            return HashCombineFast(HashCombineFast(::GetTypeHash(Key.TeamId), ::GetTypeHash(Key.TeamOwner)), ::GetTypeHash(Key.Cell));
+        }
+    };
+
+    struct FTargetGroup
+    {
+        const AActor* Instigator = nullptr;
+        FBox Origins = FBox(ForceInit);
+        float MaxRadius = 0.0f;
+        TArray<int32, TInlineAllocator<8>> Requests;
+    };
+
+    FTargetGroupKey MakeGroupKey(const FPoE2TargetRequest& Request, const FPoE2SpatialHash& Hash)
+    {
+        FTargetGroupKey Key;
+        Key.Cell = Hash.GetCell(Request.Origin);
+
+        const AActor* TeamOwner = UPoE2TargetingSubsystem::GetTeamOwner(Request.Instigator.Get());
+        const IGenericTeamAgentInterface* TeamAgent = Cast<const IGenericTeamAgentInterface>(TeamOwner);
+        if (TeamAgent && TeamAgent->GetGenericTeamId() != FGenericTeamId::NoTeam)
+        {
+            Key.TeamId = TeamAgent->GetGenericTeamId().GetId();
+        }
+        else
+        {
+            Key.TeamOwner = TeamOwner;
+        }
+        return Key;
+    }
+}
+
+void UPoE2TargetingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    Hash = FPoE2SpatialHash(CellSize);
+}
+
+void UPoE2TargetingSubsystem::RegisterTarget(AActor* Target)
+{
+    if (Target && !Targets.Contains(Target))
+    {
+        Targets.Add(Target);
+    }
+}
+
+void UPoE2TargetingSubsystem::UnregisterTarget(AActor* Target)
+{
+    if (Target)
+    {
+        Targets.RemoveSwap(Target);
+    }
+}
+
+void UPoE2TargetingSubsystem::UpdateAvatarTarget(const UWorld* World, AActor* PreviousAvatar, AActor* NewAvatar)
+{
+    UPoE2TargetingSubsystem* Targeting = UWorld::GetSubsystem<UPoE2TargetingSubsystem>(World);
+    if (!Targeting)
+    {
+        return;
+    }
+
+    if (PreviousAvatar != NewAvatar)
+    {
+        Targeting->UnregisterTarget(PreviousAvatar);
+    }
+    Targeting->RegisterTarget(NewAvatar);
+}
+
+void UPoE2TargetingSubsystem::RequestTarget(FPoE2TargetRequest&& Request, FPoE2TargetCallback&& OnResult)
+{
+    if (OnResult)
+    {
+        Pending.Add({ MoveTemp(Request), MoveTemp(OnResult) });
+    }
+}
+
+const AActor* UPoE2TargetingSubsystem::GetTeamOwner(const AActor* Actor)
+{
+    if (const APoE2MinionBase* Minion = Cast<APoE2MinionBase>(Actor))
+    {
+        const UAbilitySystemComponent* OwnerASC = Minion->GetOwnerASC();
+        if (const AActor* Owner = OwnerASC ? OwnerASC->GetAvatarActor() : nullptr)
+        {
+            return Owner;
+        }
+    }
+    return Actor;
+}
+
+bool UPoE2TargetingSubsystem::IsHostileTarget(const AActor* Instigator, const AActor* Candidate)
+{
+    if (!IsValid(Candidate) || Candidate == Instigator)
+    {
+        return false;
+    }
+
+    if (Instigator)
+    {
+        const AActor* InstigatorTeam = GetTeamOwner(Instigator);
+        const AActor* CandidateTeam = GetTeamOwner(Candidate);
+        if (Cast<const IGenericTeamAgentInterface>(InstigatorTeam) && Cast<const IGenericTeamAgentInterface>(CandidateTeam))
+        {
+            if (FGenericTeamId::GetAttitude(InstigatorTeam, CandidateTeam) != ETeamAttitude::Hostile)
+            {
+                return false;
+            }
+        }
+        else if (InstigatorTeam == CandidateTeam)
+        {
+            return false;
+        }
+    }
+
+    float Life = 0.0f;
+    float MaxLife = 0.0f;
+    return UAttributeSet_Core::GetLife(UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(const_cast<AActor*>(Candidate)), Life, MaxLife) && Life > 0.0f;
+}
+
+void UPoE2TargetingSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    SET_DWORD_STAT(STAT_PoE2TargetingTargets, Targets.Num());
+    if (Pending.Num() == 0)
+    {
+        return;
+    }
+
+    // Callbacks may ask again straight away; those requests wait for the next batch
+    TArray<FPendingRequest> Batch = MoveTemp(Pending);
+    Pending.Reset();
+
+    SCOPE_CYCLE_COUNTER(STAT_PoE2TargetingBatch);
+    SET_DWORD_STAT(STAT_PoE2TargetingRequests, Batch.Num());
+
+    BuildHash();
+    ProcessBatch(Batch);
+}
+
+void UPoE2TargetingSubsystem::BuildHash()
+{
+    Targets.RemoveAllSwap([](const TWeakObjectPtr<AActor>& Target) { return !Target.IsValid(); });
+
+    LiveTargets.Reset(Targets.Num());
+    TargetLocations.Reset(Targets.Num());
+    for (const TWeakObjectPtr<AActor>& Target : Targets)
+    {
+        AActor* Actor = Target.Get();
+        if (!Actor->IsActorBeingDestroyed())
+        {
+            LiveTargets.Add(Actor);
+            TargetLocations.Add(Actor->GetActorLocation());
+        }
+    }
+
+    Hash.Build(TargetLocations);
+}
+
+void UPoE2TargetingSubsystem::ProcessBatch(TArray<FPendingRequest>& Batch)
+{
+    TMap<FTargetGroupKey, FTargetGroup> Groups;
+    for (int32 Index = 0; Index < Batch.Num(); ++Index)
+    {
+        const FPoE2TargetRequest& Request = Batch[Index].Request;
+        if (Request.Instigator.IsStale())
+        {
+            // The asker is gone; without its team there is nobody to be hostile to
+            continue;
+        }
+
+        FTargetGroup& Group = Groups.FindOrAdd(MakeGroupKey(Request, Hash));
+        Group.Instigator = Group.Instigator ? Group.Instigator : Request.Instigator.Get();
+        Group.Origins += Request.Origin;
+        Group.MaxRadius = FMath::Max(Group.MaxRadius, Request.Radius);
+        Group.Requests.Add(Index);
+    }
+    LastBatchGroups = Groups.Num();
+    SET_DWORD_STAT(STAT_PoE2TargetingGroups, LastBatchGroups);
+
+    TArray<AActor*> Results;
+    Results.SetNumZeroed(Batch.Num());
+
+    TArray<int32> Candidates;
+    int32 NumChecks = 0;
+    for (const TPair<FTargetGroupKey, FTargetGroup>& Pair : Groups)
+    {
+        const FTargetGroup& Group = Pair.Value;
+
+        // One gather covering every request of the group; each then narrows it to its own origin and radius
+        Candidates.Reset();
+        const FVector Center = Group.Origins.GetCenter();
+        const float GatherRadius = Group.MaxRadius + Group.Origins.GetExtent().Size();
+        Hash.ForEachInRadius(Center, GatherRadius, [&](int32 Target)
+        {
+            ++NumChecks;
+            if (IsHostileTarget(Group.Instigator, LiveTargets[Target]))
+            {
+                Candidates.Add(Target);
+            }
+        });
+
+        for (const int32 RequestIndex : Group.Requests)
+        {
+            const FPoE2TargetRequest& Request = Batch[RequestIndex].Request;
+            float BestDistanceSq = FMath::Square(Request.Radius);
+            for (const int32 Target : Candidates)
+            {
+                AActor* Actor = LiveTargets[Target];
+                const float DistanceSq = FVector::DistSquared(TargetLocations[Target], Request.Origin);
+                if (DistanceSq <= BestDistanceSq && Actor != Request.Instigator.Get() && !Request.Exclude.Contains(Actor))
+                {
+                    Results[RequestIndex] = Actor;
+                    BestDistanceSq = DistanceSq;
+                }
+            }
+        }
+    }
+    LastBatchChecks = NumChecks;
+    SET_DWORD_STAT(STAT_PoE2TargetingChecks, LastBatchChecks);
+
+    // Handed out last: a callback may register, unregister or destroy actors the groups above still refer to
+    for (int32 Index = 0; Index < Batch.Num(); ++Index)
+    {
+        Batch[Index].OnResult(IsValid(Results[Index]) ? Results[Index] : nullptr);
+    }
+}
+
+TStatId UPoE2TargetingSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UPoE2TargetingSubsystem, STATGROUP_Tickables);
+}
+
+bool UPoE2TargetingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
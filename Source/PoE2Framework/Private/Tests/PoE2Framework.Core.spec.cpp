@@ -0,0 +1,235 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "GameplayTagsManager.h"
+#include "Core/PoE2Tags.h"
+#include "Core/PoE2TagBits.h"
+#include "Spec/SkillSpec.h"
+#include "Spec/SkillSpecBuilder.h"
+#include "Spec/Patch.h"
+
+BEGIN_DEFINE_SPEC(FPoE2Core_NativeTagsSpec, "PoE2.Core.NativeTags",
+                  EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+    /**
+     * Runtime sources allowed to resolve tags from strings. Everything else must use FPoE2Tags.
+     * PoE2SkillDatabase.cpp: resolves the baked string table once when the database is opened.
+     */
+    const TArray<FString> StringLookupAllowList = { TEXT("PoE2SkillDatabase.cpp") };
+
+END_DEFINE_SPEC(FPoE2Core_NativeTagsSpec)
+
+void FPoE2Core_NativeTagsSpec::Define()
+{
+    Describe("Native tag table", [this]()
+    {
+        It("should register every declared tag under its declared name", [this]()
+        {
+            int32 NumTags = 0;
+            FPoE2Tags::ForEachNativeTag([this, &NumTags](const FGameplayTag& Tag, const TCHAR* TagName)
+            {
+                ++NumTags;
+                TestTrue(*FString::Printf(TEXT("%s is registered"), TagName), Tag.IsValid());
+                TestEqual(*FString::Printf(TEXT("%s handle matches its name"), TagName), Tag.GetTagName(), FName(TagName));
+
+                const TSharedPtr<FGameplayTagNode> Node = UGameplayTagsManager::Get().FindTagNode(Tag);
+                TestTrue(*FString::Printf(TEXT("%s is native"), TagName), Node.IsValid() && Node->IsExplicitTag());
+            });
+
+            TestTrue(TEXT("Table is not empty"), NumTags > 0);
+        });
+
+        It("should not resolve tags from strings outside the allow list", [this]()
+        {
+            const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("PoE2Framework"));
+            const FString SourceDir = Plugin.IsValid() ? FPaths::Combine(Plugin->GetBaseDir(), TEXT("Source/PoE2Framework")) : FString();
+            if (SourceDir.IsEmpty() || !IFileManager::Get().DirectoryExists(*SourceDir))
+            {
+                AddWarning(TEXT("Plugin sources are not available in this build, skipping the scan"));
+                return;
+            }
+
+            TArray<FString> SourceFiles;
+            IFileManager::Get().FindFilesRecursive(SourceFiles, *SourceDir, TEXT("*.cpp"), true, false);
+            IFileManager::Get().FindFilesRecursive(SourceFiles, *SourceDir, TEXT("*.h"), true, false, false);
+
+            int32 NumScanned = 0;
+            for (const FString& File : SourceFiles)
+            {
+                const FString Normalized = File.Replace(TEXT("\\"), TEXT("/"));
+                if (Normalized.Contains(TEXT("/Private/Tests/")) || StringLookupAllowList.Contains(FPaths::GetCleanFilename(Normalized)))
+                {
+                    continue;
+                }
+
+                TArray<FString> Lines;
+                FFileHelper::LoadFileToStringArray(Lines, *File);
+                ++NumScanned;
+
+                for (int32 LineIndex = 0; LineIndex < Lines.Num(); ++LineIndex)
+                {
+                    if (Lines[LineIndex].Contains(TEXT("RequestGameplayTag")))
+                    {
+                        AddError(FString::Printf(TEXT("%s:%d resolves a tag from a string; add it to PoE2NativeTags.inl and use FPoE2Tags"),
+                            *FPaths::GetCleanFilename(Normalized), LineIndex + 1));
+                    }
+                }
+            }
+
+            TestTrue(TEXT("Sources were scanned"), NumScanned > 0);
+        });
+    });
+}
+
+BEGIN_DEFINE_SPEC(FPoE2Core_TagBitsSpec, "PoE2.Core.TagBits",
+                  EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+    static FGameplayTagContainer MakeContainer(std::initializer_list<FGameplayTag> Tags)
+    {
+        FGameplayTagContainer Container;
+        for (const FGameplayTag& Tag : Tags)
+        {
+            Container.AddTag(Tag);
+        }
+        return Container;
+    }
+
+    static FSkillSpec MakeSpec(const FGameplayTagContainer& Tags)
+    {
+        FSkillSpec Spec;
+        Spec.SkillTags = Tags;
+        Spec.RefreshTagBits();
+        return Spec;
+    }
+
+END_DEFINE_SPEC(FPoE2Core_TagBitsSpec)
+
+void FPoE2Core_TagBitsSpec::Define()
+{
+    Describe("Tag bit table", [this]()
+    {
+        It("should map the ability, mechanic and damage subtrees only", [this]()
+        {
+            const FPoE2TagBitTable& Table = FPoE2TagBitTable::Get();
+            const FPoE2Tags& Tags = FPoE2Tags::Get();
+            if (!TestTrue(TEXT("Table is complete"), Table.IsComplete()))
+            {
+                return;
+            }
+
+            TestNotEqual(TEXT("Ability.Skill has a bit"), Table.FindBit(Tags.Ability_Skill), static_cast<int32>(INDEX_NONE));
+            TestNotEqual(TEXT("Mechanic.Pierce has a bit"), Table.FindBit(Tags.Mechanic_Pierce), static_cast<int32>(INDEX_NONE));
+            TestNotEqual(TEXT("Damage.Type.Fire has a bit"), Table.FindBit(Tags.Damage_Type_Fire), static_cast<int32>(INDEX_NONE));
+            TestEqual(TEXT("Attributes are not mapped"), Table.FindBit(Tags.Attributes_Core_Health), static_cast<int32>(INDEX_NONE));
+
+            const int32 DamageType = Table.FindBit(Tags.Damage_Type);
+            TestTrue(TEXT("A parent's mask covers its children"), Table.GetDescendantMask(DamageType).HasBit(Table.FindBit(Tags.Damage_Type_Fire)));
+            TestFalse(TEXT("A child's mask does not cover its parent"), Table.GetDescendantMask(Table.FindBit(Tags.Damage_Type_Fire)).HasBit(DamageType));
+        });
+
+        It("should agree with container compatibility checks", [this]()
+        {
+            const FPoE2Tags& Tags = FPoE2Tags::Get();
+
+            const TArray<FGameplayTagContainer> SkillTagSets =
+            {
+                FGameplayTagContainer(),
+                MakeContainer({ Tags.Ability_Skill }),
+                MakeContainer({ Tags.Ability_Skill, Tags.Damage_Type_Fire }),
+                MakeContainer({ Tags.Ability_Skill, Tags.Mechanic_Pierce, Tags.Damage_Type_Cold }),
+                MakeContainer({ Tags.Mechanic_Chain, Tags.Mechanic_DOT, Tags.Attributes_Core_Health }),
+            };
+
+            const TArray<TPair<FGameplayTagContainer, FGameplayTagContainer>> Queries =
+            {
+                { FGameplayTagContainer(), FGameplayTagContainer() },
+                { MakeContainer({ Tags.Ability_Skill }), FGameplayTagContainer() },
+                { MakeContainer({ Tags.Damage_Type }), FGameplayTagContainer() },
+                { MakeContainer({ Tags.Ability_Skill, Tags.Damage }), MakeContainer({ Tags.Mechanic_Pierce }) },
+                { FGameplayTagContainer(), MakeContainer({ Tags.Damage_Type }) },
+                { MakeContainer({ Tags.Mechanic }), MakeContainer({ Tags.Attributes_Core_Health }) },
+            };
+
+            for (const TPair<FGameplayTagContainer, FGameplayTagContainer>& Query : Queries)
+            {
+                const FPoE2TagQuery Compiled = FPoE2TagQuery::Compile(Query.Key, Query.Value);
+                for (const FGameplayTagContainer& SkillTags : SkillTagSets)
+                {
+                    const bool bExpected = SkillTags.HasAll(Query.Key) && !SkillTags.HasAny(Query.Value);
+                    TestEqual(*FString::Printf(TEXT("[%s] vs +[%s] -[%s]"), *SkillTags.ToStringSimple(), *Query.Key.ToStringSimple(), *Query.Value.ToStringSimple()),
+                        Compiled.Matches(MakeSpec(SkillTags)), bExpected);
+                }
+            }
+
+            TestTrue(TEXT("Mapped queries run on bits"), FPoE2TagQuery::Compile(MakeContainer({ Tags.Damage_Type }), MakeContainer({ Tags.Mechanic_Pierce })).IsExact());
+            TestFalse(TEXT("Queries on unmapped tags fall back"), FPoE2TagQuery::Compile(FGameplayTagContainer(), MakeContainer({ Tags.Attributes_Core_Health })).IsExact());
+        });
+
+        It("should keep spec bits in step with patched tags", [this]()
+        {
+            const FPoE2Tags& Tags = FPoE2Tags::Get();
+            FSkillSpec Spec = MakeSpec(MakeContainer({ Tags.Ability_Skill, Tags.Mechanic_Pierce }));
+            const uint32 BaseHash = Spec.GetCacheHash();
+
+            FPatch Patch;
+            Patch.TagsToAdd = MakeContainer({ Tags.Mechanic_Chain, Tags.Damage_Type_Lightning });
+            Patch.TagsToRemove = MakeContainer({ Tags.Mechanic_Pierce });
+            FSkillSpecBuilder::ApplyPatch(Spec, Patch);
+
+            TestTrue(TEXT("Bits equal the container's bits"), Spec.TagBits == FPoE2TagBitTable::Get().FromContainer(Spec.SkillTags));
+            TestNotEqual(TEXT("Tag edits change the cache hash"), Spec.GetCacheHash(), BaseHash);
+
+            TestEqual(TEXT("A spec built with the same tags hashes equal"), MakeSpec(Spec.SkillTags).GetCacheHash(), Spec.GetCacheHash());
+        });
+
+        It("should compare specs field by field", [this]()
+        {
+            const FPoE2Tags& Tags = FPoE2Tags::Get();
+            FSkillSpec Spec = MakeSpec(MakeContainer({ Tags.Ability_Skill }));
+            Spec.SetCustomParam(TEXT("ChainCount"), 2.0f);
+            Spec.ConditionalModifiers.AddDefaulted_GetRef().Value = 0.4f;
+
+            FSkillSpec Copy = Spec;
+            Copy.TagBitsGeneration = 0;
+            TestTrue(TEXT("Derived tag bits do not count"), Copy == Spec);
+
+            Copy.SetCustomParam(TEXT("ChainCount"), 3.0f);
+            TestTrue(TEXT("Custom param values count, not just their keys"), Copy != Spec);
+
+            Copy = Spec;
+            Copy.ConditionalModifiers[0].Op = EPoE2HitModifierOp::More;
+            TestTrue(TEXT("Conditional modifiers count"), Copy != Spec);
+        });
+
+        It("should hash every part of a conditional modifier", [this]()
+        {
+            const FPoE2Tags& Tags = FPoE2Tags::Get();
+            FSkillSpec Spec = MakeSpec(MakeContainer({ Tags.Ability_Skill }));
+            FPoE2ConditionalModifier& Modifier = Spec.ConditionalModifiers.AddDefaulted_GetRef();
+            Modifier.Value = 0.4f;
+            FPoE2HitCondition& Condition = Modifier.Conditions.AddDefaulted_GetRef();
+            Condition.Tag = Tags.Status_Burning;
+            const uint32 BaseHash = Spec.GetCacheHash();
+
+            auto HashWith = [&Spec](TFunctionRef<void(FPoE2ConditionalModifier&)> Edit)
+            {
+                FSkillSpec Edited = Spec;
+                Edit(Edited.ConditionalModifiers[0]);
+                return Edited.GetCacheHash();
+            };
+
+            TestNotEqual(TEXT("Op"), HashWith([](FPoE2ConditionalModifier& M) { M.Op = EPoE2HitModifierOp::More; }), BaseHash);
+            TestNotEqual(TEXT("Condition tag"), HashWith([&Tags](FPoE2ConditionalModifier& M) { M.Conditions[0].Tag = Tags.Status_Poisoned; }), BaseHash);
+            TestNotEqual(TEXT("Condition type"), HashWith([](FPoE2ConditionalModifier& M) { M.Conditions[0].Type = EPoE2HitConditionType::SourceHasTag; }), BaseHash);
+            TestNotEqual(TEXT("Threshold"), HashWith([](FPoE2ConditionalModifier& M) { M.Conditions[0].Threshold = 0.5f; }), BaseHash);
+            TestNotEqual(TEXT("Negation"), HashWith([](FPoE2ConditionalModifier& M) { M.Conditions[0].bNegate = true; }), BaseHash);
+        });
+    });
+}
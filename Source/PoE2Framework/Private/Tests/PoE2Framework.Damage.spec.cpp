@@ -4,8 +4,16 @@
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemGlobals.h"
 #include "Attributes/AttributeSet_Core.h"
+#include "Attributes/AttributeSet_SwarmCore.h"
+#include "AbilitySystem/PoE2SwarmAbilitySystemComponent.h"
+#include "AbilitySystem/PoE2_AbilitySystemComponent.h"
 #include "Effects/Exec_Damage.h"
 #include "Core/PoE2Tags.h"
+#include "Effects/PoE2DotLedger.h"
+#include "Effects/PoE2HitAccumulator.h"
+#include "Effects/PoE2DamageKernel.h"
+#include "Effects/PoE2HitConditions.h"
+#include "Spec/SkillSpec.h"
 
 // We no longer need the test actor for this simplified test.
 
@@ -69,4 +77,473 @@ void FPoE2SkillSystem_DamageExecutionSpec::Define()
             DamageExecution = nullptr;
         });
     });
-}
\ No newline at end of file
+}
+
+BEGIN_DEFINE_SPEC(FPoE2DotLedgerSpec, "PoE2.SkillSystem.Execution.DotLedger",
+                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+    UAbilitySystemComponent* TargetA;
+    UAbilitySystemComponent* TargetB;
+    FPoE2DotLedger Ledger;
+    TArray<FPoE2DotTargetDamage> Damage;
+
+    FPoE2DotApplication MakeDot(UAbilitySystemComponent* Target, float Dps, float Duration, FName Group, EPoE2DotStacking Stacking)
+    {
+        FPoE2DotApplication Application;
+        Application.Target = Target;
+        Application.DamagePerSecond = Dps;
+        Application.Duration = Duration;
+        Application.StackGroup = Group;
+        Application.Stacking = Stacking;
+        return Application;
+    }
+
+    float DamageFor(const UAbilitySystemComponent* Target) const
+    {
+        const FPoE2DotTargetDamage* Entry = Damage.FindByPredicate([Target](const FPoE2DotTargetDamage& E) { return E.Target.Get() == Target; });
+        return Entry ? Entry->Damage.Total() : 0.0f;
+    }
+END_DEFINE_SPEC(FPoE2DotLedgerSpec)
+
+void FPoE2DotLedgerSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        TargetA = NewObject<UAbilitySystemComponent>();
+        TargetB = NewObject<UAbilitySystemComponent>();
+        Ledger.Reset();
+        Damage.Reset();
+    });
+
+    It("should sum unlimited stacks into one entry per target", [this]()
+    {
+        Ledger.Add(MakeDot(TargetA, 10.0f, 5.0f, TEXT("Poison"), EPoE2DotStacking::Unlimited), 0.0);
+        Ledger.Add(MakeDot(TargetA, 20.0f, 5.0f, TEXT("Poison"), EPoE2DotStacking::Unlimited), 0.0);
+        Ledger.Add(MakeDot(TargetB, 5.0f, 5.0f, TEXT("Poison"), EPoE2DotStacking::Unlimited), 0.0);
+
+        Ledger.Tick(1.0, 1.0f, Damage);
+
+        TestEqual(TEXT("One entry per target"), Damage.Num(), 2);
+        TestEqual(TEXT("Target A takes both stacks"), DamageFor(TargetA), 30.0f);
+        TestEqual(TEXT("Target B takes its stack"), DamageFor(TargetB), 5.0f);
+    });
+
+    It("should apply only the strongest instance of a strongest-only group", [this]()
+    {
+        Ledger.Add(MakeDot(TargetA, 10.0f, 5.0f, TEXT("Ignite"), EPoE2DotStacking::StrongestOnly), 0.0);
+        Ledger.Add(MakeDot(TargetA, 40.0f, 5.0f, TEXT("Ignite"), EPoE2DotStacking::StrongestOnly), 0.0);
+        Ledger.Add(MakeDot(TargetA, 5.0f, 5.0f, TEXT("Poison"), EPoE2DotStacking::Unlimited), 0.0);
+
+        Ledger.Tick(1.0, 1.0f, Damage);
+
+        TestEqual(TEXT("Strongest ignite plus poison"), DamageFor(TargetA), 45.0f);
+        TestEqual(TEXT("Weaker ignite is kept until it expires"), Ledger.NumOnTarget(TargetA), 3);
+    });
+
+    It("should pick the strongest-only instance by damage per second, not by damage this tick", [this]()
+    {
+        Ledger.Add(MakeDot(TargetA, 30.0f, 5.0f, TEXT("Ignite"), EPoE2DotStacking::StrongestOnly), 0.0);
+        Ledger.Add(MakeDot(TargetA, 40.0f, 0.5f, TEXT("Ignite"), EPoE2DotStacking::StrongestOnly), 0.0);
+
+        Ledger.Tick(1.0, 1.0f, Damage);
+
+        TestEqual(TEXT("Half a second of the 40 DPS ignite"), DamageFor(TargetA), 20.0f);
+    });
+
+    It("should keep each instance's damage type in its own lane", [this]()
+    {
+        FPoE2DotApplication Ignite = MakeDot(TargetA, 10.0f, 5.0f, TEXT("Ignite"), EPoE2DotStacking::StrongestOnly);
+        Ignite.DamageType = FPoE2Tags::Get().Damage_Type_Fire;
+        FPoE2DotApplication Poison = MakeDot(TargetA, 5.0f, 5.0f, TEXT("Poison"), EPoE2DotStacking::Unlimited);
+        Poison.DamageType = FPoE2Tags::Get().Damage_Type_Chaos;
+        Ledger.Add(Ignite, 0.0);
+        Ledger.Add(Poison, 0.0);
+
+        Ledger.Tick(1.0, 1.0f, Damage);
+
+        TestEqual(TEXT("One entry"), Damage.Num(), 1);
+        TestEqual(TEXT("Fire lane"), Damage[0].Damage[EPoE2DamageType::Fire], 10.0f);
+        TestEqual(TEXT("Chaos lane"), Damage[0].Damage[EPoE2DamageType::Chaos], 5.0f);
+    });
+
+    It("should report when a target gains and loses a damage type", [this]()
+    {
+        FPoE2DotApplication Ignite = MakeDot(TargetA, 10.0f, 0.5f, TEXT("Ignite"), EPoE2DotStacking::StrongestOnly);
+        Ignite.DamageType = FPoE2Tags::Get().Damage_Type_Fire;
+        Ledger.Add(Ignite, 0.0);
+        Ledger.Add(Ignite, 0.0);
+
+        TArray<FPoE2DotTypeChange> Changes;
+        Ledger.ConsumeTypeChanges(Changes);
+        TestEqual(TEXT("Only the first ignite starts burning"), Changes.Num(), 1);
+        TestTrue(TEXT("Fire became active on A"), Changes.Num() == 1 && Changes[0].Type == EPoE2DamageType::Fire && Changes[0].bActive && Changes[0].Target.Get() == TargetA);
+        TestTrue(TEXT("A has fire"), Ledger.HasDamageType(TargetA, EPoE2DamageType::Fire));
+        TestFalse(TEXT("A has no chaos"), Ledger.HasDamageType(TargetA, EPoE2DamageType::Chaos));
+
+        Ledger.Tick(1.0, 1.0f, Damage);
+        Ledger.ConsumeTypeChanges(Changes);
+        TestTrue(TEXT("Fire ended on A with the last ignite"), Changes.Num() == 1 && Changes[0].Type == EPoE2DamageType::Fire && !Changes[0].bActive && Changes[0].Target.Get() == TargetA);
+        TestFalse(TEXT("A no longer has fire"), Ledger.HasDamageType(TargetA, EPoE2DamageType::Fire));
+
+        Ledger.ConsumeTypeChanges(Changes);
+        TestEqual(TEXT("Changes are consumed once"), Changes.Num(), 0);
+    });
+
+    It("should reuse a released target slot for a new target", [this]()
+    {
+        Ledger.Add(MakeDot(TargetA, 10.0f, 0.5f, TEXT("Bleed"), EPoE2DotStacking::Unlimited), 0.0);
+        Ledger.Tick(1.0, 1.0f, Damage);
+        TestEqual(TEXT("Target A released"), Ledger.NumOnTarget(TargetA), 0);
+
+        Ledger.Add(MakeDot(TargetB, 10.0f, 5.0f, TEXT("Bleed"), EPoE2DotStacking::Unlimited), 1.0);
+        Ledger.Tick(2.0, 1.0f, Damage);
+        TestEqual(TEXT("Target B tracked"), Ledger.NumOnTarget(TargetB), 1);
+        TestEqual(TEXT("Target B damaged"), DamageFor(TargetB), 10.0f);
+        TestEqual(TEXT("Target A not resurrected"), DamageFor(TargetA), 0.0f);
+    });
+
+    It("should prorate the final tick and drop expired instances", [this]()
+    {
+        Ledger.Add(MakeDot(TargetA, 10.0f, 1.5f, TEXT("Bleed"), EPoE2DotStacking::Unlimited), 0.0);
+
+        Ledger.Tick(1.0, 1.0f, Damage);
+        TestEqual(TEXT("Full first second"), DamageFor(TargetA), 10.0f);
+
+        Ledger.Tick(2.0, 1.0f, Damage);
+        TestEqual(TEXT("Half of the second second"), DamageFor(TargetA), 5.0f);
+        TestEqual(TEXT("Expired instance removed"), Ledger.Num(), 0);
+        TestEqual(TEXT("Target slot released"), Ledger.NumOnTarget(TargetA), 0);
+    });
+
+    It("should reject instances without target, damage or duration", [this]()
+    {
+        TestFalse(TEXT("No target"), Ledger.Add(MakeDot(nullptr, 10.0f, 1.0f, NAME_None, EPoE2DotStacking::Unlimited), 0.0));
+        TestFalse(TEXT("No damage"), Ledger.Add(MakeDot(TargetA, 0.0f, 1.0f, NAME_None, EPoE2DotStacking::Unlimited), 0.0));
+        TestFalse(TEXT("No duration"), Ledger.Add(MakeDot(TargetA, 10.0f, 0.0f, NAME_None, EPoE2DotStacking::Unlimited), 0.0));
+        TestEqual(TEXT("Ledger stays empty"), Ledger.Num(), 0);
+    });
+
+    AfterEach([this]()
+    {
+        Ledger.Reset();
+        TargetA = nullptr;
+        TargetB = nullptr;
+    });
+}
+
+BEGIN_DEFINE_SPEC(FPoE2HitAccumulatorSpec, "PoE2.SkillSystem.Execution.HitAccumulator",
+                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+    UPoE2HitAccumulatorSubsystem* Accumulator;
+    UAbilitySystemComponent* Source;
+    UAbilitySystemComponent* TargetA;
+    UAbilitySystemComponent* TargetB;
+
+    void Queue(UAbilitySystemComponent* Target, float Damage, FGameplayTag DamageType = FGameplayTag())
+    {
+        FPoE2HitRecord Hit;
+        Hit.SourceASC = Source;
+        Hit.TargetASC = Target;
+        Hit.DamageType = DamageType;
+        Hit.Damage = FPoE2DamageVector::Single(EPoE2DamageType::Physical, Damage);
+        Accumulator->QueueHit(MoveTemp(Hit));
+    }
+END_DEFINE_SPEC(FPoE2HitAccumulatorSpec)
+
+void FPoE2HitAccumulatorSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        Accumulator = NewObject<UPoE2HitAccumulatorSubsystem>();
+        Source = NewObject<UAbilitySystemComponent>();
+        TargetA = NewObject<UAbilitySystemComponent>();
+        TargetB = NewObject<UAbilitySystemComponent>();
+    });
+
+    It("should group hits per target and damage type", [this]()
+    {
+        Queue(TargetA, 10.0f);
+        Queue(TargetA, 15.0f);
+        Queue(TargetA, 5.0f);
+        Queue(TargetB, 7.0f);
+        Queue(TargetA, 3.0f, FPoE2Tags::Get().Damage_Type_Fire);
+
+        TestEqual(TEXT("All hits pending"), Accumulator->GetNumPendingHits(), 5);
+        TestEqual(TEXT("Three batches"), Accumulator->GetNumPendingBatches(), 3);
+    });
+
+    It("should report each batch with its summed damage and hits on flush", [this]()
+    {
+        Queue(TargetA, 10.0f);
+        Queue(TargetA, 15.0f);
+        Queue(TargetB, 7.0f);
+
+        TMap<const UAbilitySystemComponent*, TPair<float, int32>> Flushed;
+        Accumulator->OnHitBatchApplied.AddLambda([&Flushed](const FPoE2HitBatch& Batch)
+        {
+            Flushed.Add(Batch.TargetASC.Get(), TPair<float, int32>(Batch.TotalDamage.Total(), Batch.Hits.Num()));
+        });
+
+        Accumulator->Flush();
+
+        TestEqual(TEXT("Two batches flushed"), Flushed.Num(), 2);
+        TestEqual(TEXT("Target A damage summed"), Flushed.FindRef(TargetA).Key, 25.0f);
+        TestEqual(TEXT("Target A keeps per-hit records"), Flushed.FindRef(TargetA).Value, 2);
+        TestEqual(TEXT("Target B damage"), Flushed.FindRef(TargetB).Key, 7.0f);
+        TestEqual(TEXT("Nothing pending after flush"), Accumulator->GetNumPendingHits(), 0);
+        TestEqual(TEXT("No batches after flush"), Accumulator->GetNumPendingBatches(), 0);
+    });
+
+    AfterEach([this]()
+    {
+        Accumulator = nullptr;
+        Source = nullptr;
+        TargetA = nullptr;
+        TargetB = nullptr;
+    });
+}
+
+BEGIN_DEFINE_SPEC(FPoE2DamageKernelSpec, "PoE2.SkillSystem.Execution.DamageKernel",
+                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FPoE2DamageKernelSpec)
+
+void FPoE2DamageKernelSpec::Define()
+{
+    It("should convert forward along the damage type chain", [this]()
+    {
+        FPoE2DamageConversion Conversion;
+        Conversion.Convert[(int32)EPoE2DamageType::Physical][(int32)EPoE2DamageType::Cold] = 0.5f;
+        Conversion.Convert[(int32)EPoE2DamageType::Cold][(int32)EPoE2DamageType::Fire] = 1.0f;
+        Conversion.bIsIdentity = false;
+
+        const FPoE2DamageVector Result = PoE2DamageKernel::ApplyConversion(FPoE2DamageVector::Single(EPoE2DamageType::Physical, 100.0f), Conversion);
+
+        TestEqual(TEXT("Half stays physical"), Result[EPoE2DamageType::Physical], 50.0f);
+        TestEqual(TEXT("Converted cold is converted on to fire"), Result[EPoE2DamageType::Cold], 0.0f);
+        TestEqual(TEXT("Fire receives the chained conversion"), Result[EPoE2DamageType::Fire], 50.0f);
+    });
+
+    It("should scale conversion above 100% and add gained-as-extra on top", [this]()
+    {
+        FPoE2DamageConversion Conversion;
+        Conversion.Convert[(int32)EPoE2DamageType::Physical][(int32)EPoE2DamageType::Fire] = 1.0f;
+        Conversion.Convert[(int32)EPoE2DamageType::Physical][(int32)EPoE2DamageType::Lightning] = 1.0f;
+        Conversion.GainAsExtra[(int32)EPoE2DamageType::Physical][(int32)EPoE2DamageType::Chaos] = 0.2f;
+        Conversion.bIsIdentity = false;
+
+        const FPoE2DamageVector Result = PoE2DamageKernel::ApplyConversion(FPoE2DamageVector::Single(EPoE2DamageType::Physical, 100.0f), Conversion);
+
+        TestEqual(TEXT("No physical left"), Result[EPoE2DamageType::Physical], 0.0f);
+        TestEqual(TEXT("Lightning gets half"), Result[EPoE2DamageType::Lightning], 50.0f);
+        TestEqual(TEXT("Fire gets half"), Result[EPoE2DamageType::Fire], 50.0f);
+        TestEqual(TEXT("Chaos gained as extra"), Result[EPoE2DamageType::Chaos], 20.0f);
+    });
+
+    It("should read conversion from skill spec custom params", [this]()
+    {
+        FSkillSpec Spec;
+        Spec.FinalDamage = 100.0f;
+        Spec.SetCustomParam(TEXT("Damage.Conversion.PhysicalToFire"), 0.25f);
+
+        const FPoE2DamageVector Result = PoE2DamageKernel::MakeHitDamage(Spec);
+
+        TestEqual(TEXT("Physical remainder"), Result[EPoE2DamageType::Physical], 75.0f);
+        TestEqual(TEXT("Converted fire"), Result[EPoE2DamageType::Fire], 25.0f);
+    });
+
+    It("should mitigate physical with armour and every type with resistances", [this]()
+    {
+        FPoE2DamageVector Damage;
+        Damage[EPoE2DamageType::Physical] = 100.0f;
+        Damage[EPoE2DamageType::Fire] = 100.0f;
+        Damage[EPoE2DamageType::Cold] = 100.0f;
+
+        FPoE2DefenceProfile Defence;
+        Defence.Armour = 1000.0f;
+        Defence.Resistances[(int32)EPoE2DamageType::Fire] = 0.75f;
+        Defence.Resistances[(int32)EPoE2DamageType::Cold] = -0.5f;
+
+        const FPoE2DamageVector Result = PoE2DamageKernel::Mitigate(Damage, Defence);
+
+        // 1000 / (1000 + 10 * 100) = 50% reduction
+        TestEqual(TEXT("Armour halves physical"), Result[EPoE2DamageType::Physical], 50.0f);
+        TestEqual(TEXT("Fire resisted"), Result[EPoE2DamageType::Fire], 25.0f);
+        TestEqual(TEXT("Negative cold resistance amplifies"), Result[EPoE2DamageType::Cold], 150.0f);
+    });
+
+    It("should cap armour and resistance reduction", [this]()
+    {
+        FPoE2DefenceProfile Defence;
+        Defence.Armour = 1.0e9f;
+        Defence.Resistances[(int32)EPoE2DamageType::Fire] = 5.0f;
+
+        FPoE2DamageVector Damage;
+        Damage[EPoE2DamageType::Physical] = 100.0f;
+        Damage[EPoE2DamageType::Fire] = 100.0f;
+
+        const FPoE2DamageVector Result = PoE2DamageKernel::Mitigate(Damage, Defence);
+
+        TestEqual(TEXT("Armour reduction capped"), Result[EPoE2DamageType::Physical], 10.0f, KINDA_SMALL_NUMBER * 100.0f);
+        TestEqual(TEXT("Resistance capped"), Result[EPoE2DamageType::Fire], 10.0f, KINDA_SMALL_NUMBER * 100.0f);
+    });
+
+    It("should resolve a batch with a shared defence profile", [this]()
+    {
+        TArray<FPoE2DamageVector> In;
+        In.Add(FPoE2DamageVector::Single(EPoE2DamageType::Fire, 100.0f));
+        In.Add(FPoE2DamageVector::Single(EPoE2DamageType::Fire, 40.0f));
+
+        FPoE2DefenceProfile Defence;
+        Defence.Resistances[(int32)EPoE2DamageType::Fire] = 0.5f;
+
+        TArray<FPoE2DamageVector> Out;
+        Out.SetNum(In.Num());
+        PoE2DamageKernel::ResolveBatch(In, FPoE2DamageConversion(), MakeArrayView(&Defence, 1), Out);
+
+        TestEqual(TEXT("First hit"), Out[0].Total(), 50.0f);
+        TestEqual(TEXT("Second hit"), Out[1].Total(), 20.0f);
+    });
+
+    It("should mitigate batched hits exactly like the same hits applied one by one", [this]()
+    {
+        TArray<FPoE2DamageVector> Hits;
+        Hits.Add(FPoE2DamageVector::Single(EPoE2DamageType::Physical, 100.0f));
+        Hits.Add(FPoE2DamageVector::Single(EPoE2DamageType::Physical, 20.0f));
+        Hits.Add(FPoE2DamageVector::Single(EPoE2DamageType::Fire, 30.0f));
+
+        FPoE2DefenceProfile Defence;
+        Defence.Armour = 1000.0f;
+        Defence.Resistances[(int32)EPoE2DamageType::Fire] = 0.5f;
+
+        float Unbatched = 0.0f;
+        FPoE2DamageVector Summed;
+        for (const FPoE2DamageVector& Hit : Hits)
+        {
+            Unbatched += PoE2DamageKernel::Mitigate(Hit, Defence).Total();
+            Summed += Hit;
+        }
+
+        const float Batched = PoE2DamageKernel::MitigateHits(Hits, Defence).Total();
+
+        TestEqual(TEXT("Batched equals unbatched"), Batched, Unbatched, KINDA_SMALL_NUMBER * 100.0f);
+        TestTrue(TEXT("Armour on the summed hit would differ"), !FMath::IsNearlyEqual(PoE2DamageKernel::Mitigate(Summed, Defence).Total(), Unbatched, 1.0f));
+    });
+}
+
+BEGIN_DEFINE_SPEC(FPoE2HitConditionSpec, "PoE2.SkillSystem.Execution.HitConditions",
+                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+    static FPoE2ConditionalModifier MakeModifier(EPoE2HitModifierOp Op, float Value, const FPoE2HitCondition& Condition)
+    {
+        FPoE2ConditionalModifier Modifier;
+        Modifier.Op = Op;
+        Modifier.Value = Value;
+        Modifier.Conditions.Add(Condition);
+        return Modifier;
+    }
+
+    static FPoE2HitCondition TargetHas(const FGameplayTag& Tag)
+    {
+        FPoE2HitCondition Condition;
+        Condition.Type = EPoE2HitConditionType::TargetHasTag;
+        Condition.Tag = Tag;
+        return Condition;
+    }
+
+END_DEFINE_SPEC(FPoE2HitConditionSpec)
+
+void FPoE2HitConditionSpec::Define()
+{
+    It("should scale only by the modifiers whose conditions hold", [this]()
+    {
+        const FPoE2Tags& Tags = FPoE2Tags::Get();
+
+        FPoE2HitCondition NotFullLife;
+        NotFullLife.Type = EPoE2HitConditionType::ValueAtLeast;
+        NotFullLife.Value = EPoE2HitValue::TargetLifeFraction;
+        NotFullLife.Threshold = 1.0f;
+        NotFullLife.bNegate = true;
+
+        const TSharedPtr<const FPoE2HitConditionProgram> Program = FPoE2HitConditionProgram::Compile({
+            MakeModifier(EPoE2HitModifierOp::Increased, 0.5f, TargetHas(Tags.Status_Burning)),
+            MakeModifier(EPoE2HitModifierOp::More, 0.4f, TargetHas(Tags.Status_Burning)),
+            MakeModifier(EPoE2HitModifierOp::More, 1.0f, NotFullLife) });
+        if (!TestTrue(TEXT("Compiled"), Program.IsValid()))
+        {
+            return;
+        }
+
+        const FGameplayTagContainer Burning(Tags.Status_Burning);
+        FPoE2HitConditionContext Context;
+        Context.TargetBits = FPoE2TagBitTable::Get().FromContainer(Burning);
+        Context.BitsGeneration = FPoE2TagBitTable::Get().GetGeneration();
+        Context.Values[(int32)EPoE2HitValue::TargetLifeFraction] = 1.0f;
+        TestEqual(TEXT("Burning at full life"), Program->Evaluate(Context), 1.5f * 1.4f, 1.e-4f);
+
+        Context.Values[(int32)EPoE2HitValue::TargetLifeFraction] = 0.5f;
+        TestEqual(TEXT("Burning and damaged"), Program->Evaluate(Context), 1.5f * 1.4f * 2.0f, 1.e-4f);
+
+        Context.TargetBits = FPoE2TagBits();
+        TestEqual(TEXT("Damaged only"), Program->Evaluate(Context), 2.0f, 1.e-4f);
+
+        const FPoE2DamageVector Scaled = PoE2DamageKernel::ApplyHitConditions(FPoE2DamageVector::Single(EPoE2DamageType::Fire, 10.0f), *Program, Context);
+        TestEqual(TEXT("Kernel scales the damage vector"), Scaled[EPoE2DamageType::Fire], 20.0f, 1.e-4f);
+    });
+
+    It("should fall back to the tag containers when the bits are stale", [this]()
+    {
+        const FPoE2Tags& Tags = FPoE2Tags::Get();
+        const TSharedPtr<const FPoE2HitConditionProgram> Program = FPoE2HitConditionProgram::Compile({
+            MakeModifier(EPoE2HitModifierOp::More, 0.4f, TargetHas(Tags.Status_Chilled)) });
+        if (!TestTrue(TEXT("Compiled"), Program.IsValid()))
+        {
+            return;
+        }
+
+        const FGameplayTagContainer Chilled(Tags.Status_Chilled);
+        const FGameplayTagContainer None;
+        FPoE2HitConditionContext Context;
+        Context.BitsGeneration = 0;
+        Context.SourceTags = &None;
+        Context.TargetTags = &Chilled;
+        TestEqual(TEXT("Container says chilled"), Program->Evaluate(Context), 1.4f, 1.e-4f);
+    });
+
+    It("should compile nothing from an empty modifier list", [this]()
+    {
+        TestFalse(TEXT("No program"), FPoE2HitConditionProgram::Compile({}).IsValid());
+    });
+}
+
+BEGIN_DEFINE_SPEC(FPoE2SwarmAttributesSpec, "PoE2.SkillSystem.Attributes.Swarm",
+                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FPoE2SwarmAttributesSpec)
+
+void FPoE2SwarmAttributesSpec::Define()
+{
+    It("should quantize health without losing death, full health or the last sliver of life", [this]()
+    {
+        TestEqual(TEXT("Dead stays dead"), UAttributeSet_SwarmCore::QuantizeHealth(0.0f, 500.0f), static_cast<uint8>(0));
+        TestEqual(TEXT("A sliver stays alive"), UAttributeSet_SwarmCore::QuantizeHealth(0.01f, 500.0f), static_cast<uint8>(1));
+        TestEqual(TEXT("Full health is exact"), UAttributeSet_SwarmCore::DequantizeHealth(UAttributeSet_SwarmCore::QuantizeHealth(500.0f, 500.0f), 500.0f), 500.0f);
+
+        // Rounding up, a value can only come back higher, and by less than one step
+        const float Restored = UAttributeSet_SwarmCore::DequantizeHealth(UAttributeSet_SwarmCore::QuantizeHealth(123.0f, 500.0f), 500.0f);
+        TestTrue(TEXT("Within one step"), Restored >= 123.0f && Restored - 123.0f < 500.0f / 255.0f);
+    });
+
+    It("should report default life until an attribute set is needed, then create it", [this]()
+    {
+        UPoE2SwarmAbilitySystemComponent* ASC = NewObject<UPoE2SwarmAbilitySystemComponent>();
+        TestNull(TEXT("Carries no player ASC state"), Cast<UPoE2_AbilitySystemComponent>(ASC));
+        const FGameplayAttribute HealthAttribute = UAttributeSet_Core::GetHealthAttribute();
+        TestFalse(TEXT("No set up front"), ASC->HasAttributeSetForAttribute(HealthAttribute));
+
+        float Life = 0.0f;
+        float MaxLife = 0.0f;
+        TestTrue(TEXT("Life reads from the lazy set's defaults"), UAttributeSet_Core::GetLife(ASC, Life, MaxLife));
+        TestEqual(TEXT("Untouched means full"), Life, MaxLife);
+
+        ASC->EnsureAttributeSetFor(HealthAttribute);
+        TestTrue(TEXT("Set created on demand"), ASC->HasAttributeSetForAttribute(HealthAttribute));
+        TestNotNull(TEXT("As the swarm set"), ASC->GetSet<UAttributeSet_SwarmCore>());
+    });
+}
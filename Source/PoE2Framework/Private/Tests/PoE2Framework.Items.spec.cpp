@@ -0,0 +1,257 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+#include "Items/PoE2AffixRoller.h"
+#include "Data/AffixDataAsset.h"
+#include "Data/ItemBaseDataAsset.h"
+#include "Spec/SkillModifierIndex.h"
+#include "Spec/SkillSpec.h"
+#include "Core/PoE2Tags.h"
+
+BEGIN_DEFINE_SPEC(FPoE2Items_AffixRollerSpec, "PoE2.Items.AffixRoller",
+                  EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+    TArray<UItemBaseDataAsset*> Bases;
+    TArray<UAffixDataAsset*> Affixes;
+
+    const FName Life = TEXT("MaxLife");
+
+    UItemBaseDataAsset* MakeBase(FName Id, int32 MaxPrefixes, int32 MaxSuffixes)
+    {
+        UItemBaseDataAsset* Base = NewObject<UItemBaseDataAsset>();
+        Base->BaseId = Id;
+        Base->MaxPrefixes = MaxPrefixes;
+        Base->MaxSuffixes = MaxSuffixes;
+        Bases.Add(Base);
+        return Base;
+    }
+
+    UAffixDataAsset* MakeAffix(FName Id, EPoE2AffixType Type, int32 Weight, FName Group = NAME_None, int32 ItemLevel = 1)
+    {
+        UAffixDataAsset* Affix = NewObject<UAffixDataAsset>();
+        Affix->AffixId = Id;
+        Affix->Type = Type;
+        Affix->SpawnWeight = Weight;
+        Affix->ModGroup = Group;
+        Affix->RequiredItemLevel = ItemLevel;
+        Affix->Stats.Add({ Life, EPoE2StatModOp::Flat, 10.0f, 20.0f });
+        Affixes.Add(Affix);
+        return Affix;
+    }
+
+    TSharedPtr<const FPoE2AffixRoller> Compile() const
+    {
+        return FPoE2AffixRoller::Compile(TArray<const UItemBaseDataAsset*>(Bases), TArray<const UAffixDataAsset*>(Affixes));
+    }
+
+END_DEFINE_SPEC(FPoE2Items_AffixRollerSpec)
+
+void FPoE2Items_AffixRollerSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        Bases.Reset();
+        Affixes.Reset();
+    });
+
+    Describe("Affix roller", [this]()
+    {
+        It("should draw affixes in proportion to their weights", [this]()
+        {
+            MakeBase(TEXT("Ring"), 1, 0);
+            MakeAffix(TEXT("Light"), EPoE2AffixType::Prefix, 1000);
+            const UAffixDataAsset* Heavy = MakeAffix(TEXT("Heavy"), EPoE2AffixType::Prefix, 3000);
+            const TSharedPtr<const FPoE2AffixRoller> Roller = Compile();
+            if (!TestTrue(TEXT("Roller compiled"), Roller.IsValid()))
+            {
+                return;
+            }
+
+            FPoE2AffixRollSettings Settings;
+            Settings.MinAffixes = 1;
+            FRandomStream Random(7);
+            FPoE2RolledItem Item;
+            const int32 NumRolls = 20000;
+            int32 NumHeavy = 0;
+            for (int32 Index = 0; Index < NumRolls; ++Index)
+            {
+                Roller->Roll(0, 10, Settings, Random, Item);
+                NumHeavy += (Item.Affixes.Num() == 1 && Roller->GetAffix(Item.Affixes[0].Affix) == Heavy) ? 1 : 0;
+            }
+            TestEqual(TEXT("Heavy rolls three times in four"), static_cast<float>(NumHeavy) / NumRolls, 0.75f, 0.02f);
+
+            TArray<FPoE2StatModifier> Modifiers;
+            Roller->GetModifiers(Item, Modifiers);
+            TestTrue(TEXT("Rolled value lies in the stat range"), Modifiers.Num() == 1 && Modifiers[0].Value >= 10.0f && Modifiers[0].Value <= 20.0f);
+        });
+
+        It("should respect prefix and suffix limits and mod groups", [this]()
+        {
+            MakeBase(TEXT("Amulet"), 3, 3);
+            const FName LifeGroup = TEXT("IncreasedLife");
+            TSet<const UAffixDataAsset*> LifeTiers;
+            LifeTiers.Add(MakeAffix(TEXT("Life1"), EPoE2AffixType::Prefix, 1000, LifeGroup));
+            LifeTiers.Add(MakeAffix(TEXT("Life2"), EPoE2AffixType::Prefix, 1000, LifeGroup));
+            LifeTiers.Add(MakeAffix(TEXT("Life3"), EPoE2AffixType::Prefix, 1000, LifeGroup));
+            MakeAffix(TEXT("Mana"), EPoE2AffixType::Prefix, 100);
+            MakeAffix(TEXT("Armour"), EPoE2AffixType::Prefix, 100);
+            for (int32 Index = 0; Index < 4; ++Index)
+            {
+                MakeAffix(*FString::Printf(TEXT("Resist%d"), Index), EPoE2AffixType::Suffix, 1000);
+            }
+            const TSharedPtr<const FPoE2AffixRoller> Roller = Compile();
+
+            FPoE2AffixRollSettings Settings;
+            Settings.MinAffixes = 6;
+            Settings.MaxAffixes = 6;
+            FRandomStream Random(11);
+            FPoE2RolledItem Item;
+            for (int32 Roll = 0; Roll < 500; ++Roll)
+            {
+                Roller->Roll(0, 10, Settings, Random, Item);
+
+                int32 NumPrefixes = 0;
+                int32 NumLifeTiers = 0;
+                for (const FPoE2RolledAffix& Rolled : Item.Affixes)
+                {
+                    const UAffixDataAsset* Affix = Roller->GetAffix(Rolled.Affix);
+                    NumPrefixes += Affix->Type == EPoE2AffixType::Prefix ? 1 : 0;
+                    NumLifeTiers += LifeTiers.Contains(Affix) ? 1 : 0;
+                }
+
+                if (!TestEqual(TEXT("Every slot fills"), Item.Affixes.Num(), 6)
+                    || !TestEqual(TEXT("Three prefixes"), NumPrefixes, 3)
+                    || !TestEqual(TEXT("One life tier"), NumLifeTiers, 1))
+                {
+                    return;
+                }
+            }
+        });
+
+        It("should gate affixes by item level", [this]()
+        {
+            MakeBase(TEXT("Ring"), 1, 1);
+            MakeAffix(TEXT("Low"), EPoE2AffixType::Prefix, 1000, NAME_None, 5);
+            const UAffixDataAsset* High = MakeAffix(TEXT("High"), EPoE2AffixType::Suffix, 1000, NAME_None, 50);
+            const TSharedPtr<const FPoE2AffixRoller> Roller = Compile();
+
+            FPoE2AffixRollSettings Settings;
+            Settings.MinAffixes = 2;
+            FRandomStream Random(3);
+            FPoE2RolledItem Item;
+            TestFalse(TEXT("Nothing rolls below the lowest band"), Roller->Roll(0, 1, Settings, Random, Item));
+
+            TestTrue(TEXT("Low band rolls"), Roller->Roll(0, 20, Settings, Random, Item));
+            TestTrue(TEXT("Only the low affix"), Item.Affixes.Num() == 1 && Roller->GetAffix(Item.Affixes[0].Affix) != High);
+
+            TestTrue(TEXT("High band rolls"), Roller->Roll(0, 60, Settings, Random, Item));
+            TestEqual(TEXT("Both affixes"), Item.Affixes.Num(), 2);
+        });
+
+        It("should roll batches deterministically", [this]()
+        {
+            UItemBaseDataAsset* Ring = MakeBase(TEXT("Ring"), 3, 3);
+            UItemBaseDataAsset* Belt = MakeBase(TEXT("Belt"), 3, 3);
+            for (int32 Index = 0; Index < 8; ++Index)
+            {
+                MakeAffix(*FString::Printf(TEXT("Affix%d"), Index), Index % 2 ? EPoE2AffixType::Suffix : EPoE2AffixType::Prefix, 100 * (Index + 1));
+            }
+            const TSharedPtr<const FPoE2AffixRoller> Roller = Compile();
+            TestEqual(TEXT("Bases with the same affixes share pools"), Roller->NumPools(), 1);
+
+            const FPoE2AffixRollSettings Settings;
+            TArray<FPoE2RolledItem> First;
+            TArray<FPoE2RolledItem> Second;
+            Roller->RollBatch(Roller->FindBase(Ring), 10, Settings, 5000, 42, First);
+            Roller->RollBatch(Roller->FindBase(Ring), 10, Settings, 5000, 42, Second);
+
+            bool bIdentical = First.Num() == Second.Num();
+            for (int32 Index = 0; bIdentical && Index < First.Num(); ++Index)
+            {
+                bIdentical = First[Index].Affixes.Num() == Second[Index].Affixes.Num();
+                for (int32 Affix = 0; bIdentical && Affix < First[Index].Affixes.Num(); ++Affix)
+                {
+                    bIdentical = First[Index].Affixes[Affix].Affix == Second[Index].Affixes[Affix].Affix
+                        && First[Index].Affixes[Affix].Values[0] == Second[Index].Affixes[Affix].Values[0];
+                }
+            }
+            TestTrue(TEXT("Same seed, same items"), bIdentical);
+            TestNotEqual(TEXT("Belt is a separate base"), Roller->FindBase(Belt), Roller->FindBase(Ring));
+        });
+    });
+}
+
+BEGIN_DEFINE_SPEC(FPoE2Items_SkillModifierSpec, "PoE2.Items.SkillModifiers",
+                  EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+    const FName FinalDamage = GET_MEMBER_NAME_CHECKED(FSkillSpec, FinalDamage);
+    const FName AreaRadius = GET_MEMBER_NAME_CHECKED(FSkillSpec, AreaRadius);
+
+    static FPoE2SkillModifier MakeModifier(const FGameplayTag& RequiredTag, FName Field, float Increased)
+    {
+        FPoE2SkillModifier Modifier;
+        if (RequiredTag.IsValid())
+        {
+            Modifier.RequiredSkillTags.AddTag(RequiredTag);
+        }
+        Modifier.Patch.MultiplicativeModifiers.Add(Field, Increased);
+        return Modifier;
+    }
+
+    static FSkillSpec MakeSpec(std::initializer_list<FGameplayTag> Tags)
+    {
+        FSkillSpec Spec;
+        for (const FGameplayTag& Tag : Tags)
+        {
+            Spec.SkillTags.AddTag(Tag);
+        }
+        Spec.RefreshTagBits();
+        Spec.FinalDamage = 100.0f;
+        Spec.AreaRadius = 100.0f;
+        return Spec;
+    }
+
+END_DEFINE_SPEC(FPoE2Items_SkillModifierSpec)
+
+void FPoE2Items_SkillModifierSpec::Define()
+{
+    Describe("Skill modifier index", [this]()
+    {
+        It("should apply only the modifiers whose tags a skill has", [this]()
+        {
+            const FPoE2Tags& Tags = FPoE2Tags::Get();
+            FPoE2SkillModifierIndex Index;
+            Index.AddSource({ MakeModifier(Tags.Mechanic_Pierce, FinalDamage, 0.5f), MakeModifier(Tags.Damage_Type, AreaRadius, 0.2f) });
+            Index.AddSource({ MakeModifier(FGameplayTag(), FinalDamage, 1.0f) });
+
+            FSkillSpec FireSkill = MakeSpec({ Tags.Ability_Skill, Tags.Damage_Type_Fire });
+            TestEqual(TEXT("Fire skill gets the damage-type and global modifiers"), Index.Apply(FireSkill), 2);
+            TestEqual(TEXT("Area from the parent tag"), FireSkill.AreaRadius, 120.0f, 1.e-3f);
+            TestEqual(TEXT("Global damage"), FireSkill.FinalDamage, 200.0f, 1.e-3f);
+
+            FSkillSpec PierceSkill = MakeSpec({ Tags.Ability_Skill, Tags.Mechanic_Pierce });
+            TestEqual(TEXT("Pierce skill gets the pierce and global modifiers"), Index.Apply(PierceSkill), 2);
+            TestEqual(TEXT("Pierce damage applies first"), PierceSkill.FinalDamage, 300.0f, 1.e-3f);
+            TestEqual(TEXT("Area untouched"), PierceSkill.AreaRadius, 100.0f);
+        });
+
+        It("should report which skills a source affects", [this]()
+        {
+            const FPoE2Tags& Tags = FPoE2Tags::Get();
+            FPoE2SkillModifierIndex Index;
+            FPoE2SkillModifierSourceHandle Ring = Index.AddSource({ MakeModifier(Tags.Mechanic_Chain, FinalDamage, 0.3f) });
+
+            const FPoE2SkillModifierTarget ChainSkill = FPoE2SkillModifierTarget::FromSpec(MakeSpec({ Tags.Ability_Skill, Tags.Mechanic_Chain }));
+            const FPoE2SkillModifierTarget ColdSkill = FPoE2SkillModifierTarget::FromSpec(MakeSpec({ Tags.Ability_Skill, Tags.Damage_Type_Cold }));
+            TestTrue(TEXT("Chain skill is affected"), Index.Affects(Ring, ChainSkill));
+            TestFalse(TEXT("Cold skill is not"), Index.Affects(Ring, ColdSkill));
+
+            Index.RemoveSource(Ring);
+            TestFalse(TEXT("Removed"), Index.HasSource(Ring));
+            TestEqual(TEXT("No modifiers left"), Index.NumModifiers(), 0);
+        });
+    });
+}
@@ -0,0 +1,330 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+#include "Minions/PoE2MinionCrowd.h"
+#include "Minions/PoE2MinionSignificance.h"
+#include "Minions/PoE2SummonSpawnSubsystem.h"
+#include "Minions/PoE2MinionSignificanceSubsystem.h"
+#include "AbilitySystem/Actors/PoE2MinionBase.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/StaticMeshActor.h"
+#include "EngineUtils.h"
+#include "NavigationData.h"
+
+BEGIN_DEFINE_SPEC(FPoE2Minions_CrowdSpec, "PoE2.Minions.Crowd",
+                  EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+    FPoE2MinionCrowdSettings Settings;
+
+    static FPoE2CrowdAgent MakeAgent(const FVector& Location)
+    {
+        FPoE2CrowdAgent Agent;
+        Agent.Location = Location;
+        Agent.MaxSpeed = 400.0f;
+        Agent.Radius = 40.0f;
+        return Agent;
+    }
+
+    /** Moves every agent by its velocity for Steps frames. */
+    void Simulate(FPoE2MinionCrowd& Crowd, TArray<FPoE2CrowdAgent>& Agents, float SlotRadius, int32 Steps) const
+    {
+        for (int32 Step = 0; Step < Steps; ++Step)
+        {
+            Crowd.Steer(Agents, SlotRadius, Settings);
+            for (FPoE2CrowdAgent& Agent : Agents)
+            {
+                Agent.Location += Agent.Velocity * (1.0f / 30.0f);
+            }
+        }
+    }
+
+END_DEFINE_SPEC(FPoE2Minions_CrowdSpec)
+
+void FPoE2Minions_CrowdSpec::Define()
+{
+    Describe("Minion crowd", [this]()
+    {
+        It("should walk every agent along the shared path onto its own slot", [this]()
+        {
+            TArray<FPoE2CrowdAgent> Agents = { MakeAgent(FVector(0, 0, 0)), MakeAgent(FVector(0, 60, 0)), MakeAgent(FVector(60, 0, 0)) };
+            const FVector Corner(1000, 0, 0);
+            const FVector Goal(1000, 1000, 0);
+
+            FPoE2MinionCrowd Crowd;
+            Crowd.SetPath({ FVector::ZeroVector, Corner, Goal }, Agents);
+            TestEqual(TEXT("Agents start at the first waypoint"), Agents[0].PathIndex, 1);
+
+            Simulate(Crowd, Agents, Settings.FollowRadius, 300);
+
+            for (int32 Index = 0; Index < Agents.Num(); ++Index)
+            {
+                const FVector Slot = FPoE2MinionCrowd::GetSlotLocation(Goal, Settings.FollowRadius, Index, Agents.Num());
+                TestTrue(FString::Printf(TEXT("Agent %d reached its slot"), Index), FVector::Dist2D(Agents[Index].Location, Slot) < 30.0f);
+                TestEqual(FString::Printf(TEXT("Agent %d finished the path"), Index), Agents[Index].PathIndex, 2);
+            }
+        });
+
+        It("should push overlapping agents apart and stop without a path", [this]()
+        {
+            TArray<FPoE2CrowdAgent> Agents = { MakeAgent(FVector(0, 0, 0)), MakeAgent(FVector(10, 0, 0)) };
+
+            FPoE2MinionCrowd Crowd;
+            Crowd.Steer(Agents, Settings.FollowRadius, Settings);
+            TestTrue(TEXT("No path, no movement"), Agents[0].Velocity.IsZero() && Agents[1].Velocity.IsZero());
+
+            // Both agents already stand on the goal, so only separation moves them
+            Crowd.SetPath({ FVector(5, 0, 0) }, Agents);
+            Crowd.Steer(Agents, 0.0f, Settings);
+            TestTrue(TEXT("Left agent pushed left"), Agents[0].Velocity.X < 0.0f);
+            TestTrue(TEXT("Right agent pushed right"), Agents[1].Velocity.X > 0.0f);
+            TestTrue(TEXT("Speed clamped"), Agents[0].Velocity.Size() <= Agents[0].MaxSpeed + KINDA_SMALL_NUMBER);
+        });
+
+        It("should steer on the ground plane whatever the height of the path", [this]()
+        {
+            // Agents stand half a capsule above the navmesh the path was found on
+            TArray<FPoE2CrowdAgent> Agents = { MakeAgent(FVector(0, 0, 90)) };
+
+            FPoE2MinionCrowd Crowd;
+            Crowd.SetPath({ FVector(0, 0, 0), FVector(1000, 0, 0) }, Agents);
+            Crowd.Steer(Agents, 0.0f, Settings);
+            TestEqual(TEXT("No vertical velocity"), Agents[0].Velocity.Z, 0.0f);
+            TestEqual(TEXT("Full speed along the path"), Agents[0].Velocity.X, Agents[0].MaxSpeed, 1.e-3f);
+        });
+
+        It("should not separate agents of different crowds", [this]()
+        {
+            TArray<FPoE2CrowdAgent> Mine = { MakeAgent(FVector(0, 0, 0)) };
+            TArray<FPoE2CrowdAgent> Theirs = { MakeAgent(FVector(10, 0, 0)) };
+
+            FPoE2MinionCrowd MyCrowd;
+            FPoE2MinionCrowd TheirCrowd;
+            MyCrowd.SetPath({ FVector(0, 0, 0) }, Mine);
+            TheirCrowd.SetPath({ FVector(10, 0, 0) }, Theirs);
+            MyCrowd.Steer(Mine, 0.0f, Settings);
+            TheirCrowd.Steer(Theirs, 0.0f, Settings);
+            TestTrue(TEXT("My agent stays on its goal"), Mine[0].Velocity.IsNearlyZero());
+            TestTrue(TEXT("Their agent stays on its goal"), Theirs[0].Velocity.IsNearlyZero());
+        });
+    });
+}
+
+BEGIN_DEFINE_SPEC(FPoE2Minions_SignificanceSpec, "PoE2.Minions.Significance",
+                  EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+    FPoE2MinionSignificanceSettings Settings;
+
+END_DEFINE_SPEC(FPoE2Minions_SignificanceSpec)
+
+void FPoE2Minions_SignificanceSpec::Define()
+{
+    Describe("Minion significance", [this]()
+    {
+        It("should only change tier once past the hysteresis band", [this]()
+        {
+            using namespace PoE2MinionSignificance;
+            const float JustOutside = Settings.MediumDistance * 1.05f;
+            const float WellOutside = Settings.MediumDistance * (1.0f + Settings.Hysteresis) + 1.0f;
+            const float JustInside = Settings.MediumDistance * 0.95f;
+
+            TestTrue(TEXT("High holds just past the boundary"), SelectTier(JustOutside, EPoE2MinionTier::High, Settings) == EPoE2MinionTier::High);
+            TestTrue(TEXT("High drops past the band"), SelectTier(WellOutside, EPoE2MinionTier::High, Settings) == EPoE2MinionTier::Medium);
+            TestTrue(TEXT("Medium holds just inside the boundary"), SelectTier(JustInside, EPoE2MinionTier::Medium, Settings) == EPoE2MinionTier::Medium);
+            TestTrue(TEXT("Far minions go straight to Low"), SelectTier(Settings.LowDistance * 2.0f, EPoE2MinionTier::High, Settings) == EPoE2MinionTier::Low);
+            TestTrue(TEXT("Close minions go straight to High"), SelectTier(0.0f, EPoE2MinionTier::Low, Settings) == EPoE2MinionTier::High);
+        });
+
+        It("should keep fighting minions more significant", [this]()
+        {
+            using namespace PoE2MinionSignificance;
+            const float Distance = Settings.MediumDistance * 1.5f;
+            TestTrue(TEXT("Idle minion drops"), SelectTier(Score(Distance, false, Settings), EPoE2MinionTier::High, Settings) == EPoE2MinionTier::Medium);
+            TestTrue(TEXT("Fighting minion stays"), SelectTier(Score(Distance, true, Settings), EPoE2MinionTier::High, Settings) == EPoE2MinionTier::High);
+        });
+
+        It("should stop counting a ticking minion once it is unregistered", [this]()
+        {
+            UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+            GEngine->CreateNewWorldContext(EWorldType::Game).SetCurrentWorld(World);
+
+            UPoE2MinionSignificanceSubsystem* Significance = World->GetSubsystem<UPoE2MinionSignificanceSubsystem>();
+            if (TestNotNull(TEXT("Significance subsystem"), Significance))
+            {
+                APoE2MinionBase* Ticking = World->SpawnActor<APoE2MinionBase>();
+                Ticking->SetActorTickEnabled(true);
+                APoE2MinionBase* Idle = World->SpawnActor<APoE2MinionBase>();
+
+                Significance->RegisterMinion(Ticking);
+                Significance->RegisterMinion(Idle);
+                TestEqual(TEXT("Both start High"), Significance->GetNumInTier(EPoE2MinionTier::High), 2);
+                TestEqual(TEXT("One of them ticks"), Significance->GetNumTickingInTier(EPoE2MinionTier::High), 1);
+
+                Significance->UnregisterMinion(Ticking);
+                TestEqual(TEXT("One left"), Significance->GetNumInTier(EPoE2MinionTier::High), 1);
+                TestEqual(TEXT("None left ticking"), Significance->GetNumTickingInTier(EPoE2MinionTier::High), 0);
+
+                Significance->UnregisterMinion(Idle);
+                TestEqual(TEXT("Idle minions never counted as ticking"), Significance->GetNumTickingInTier(EPoE2MinionTier::High), 0);
+            }
+
+            GEngine->DestroyWorldContext(World);
+            World->DestroyWorld(false);
+        });
+    });
+}
+
+BEGIN_DEFINE_SPEC(FPoE2Minions_FormationSpec, "PoE2.Minions.Formation",
+                  EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FPoE2Minions_FormationSpec)
+
+void FPoE2Minions_FormationSpec::Define()
+{
+    It("should lay out summons in centred rows in front of the summoner", [this]()
+    {
+        FPoE2SummonFormationSettings Settings;
+        Settings.Spacing = 100.0f;
+        Settings.MaxPerRow = 3;
+
+        TArray<FTransform> Slots;
+        PoE2SummonFormation::ComputeSlots(FVector::ZeroVector, FVector(1, 0, 0), 5, Settings, Slots);
+        if (!TestEqual(TEXT("One slot per summon"), Slots.Num(), 5))
+        {
+            return;
+        }
+
+        TestTrue(TEXT("First row in front, centred"), Slots[1].GetLocation().Equals(FVector(100, 0, 0)));
+        TestTrue(TEXT("First row spaced across"), Slots[0].GetLocation().Equals(FVector(100, -100, 0)) && Slots[2].GetLocation().Equals(FVector(100, 100, 0)));
+        TestTrue(TEXT("Short second row at the summoner, centred"), Slots[3].GetLocation().Equals(FVector(0, -50, 0)) && Slots[4].GetLocation().Equals(FVector(0, 50, 0)));
+        TestTrue(TEXT("Slots face forward"), Slots[4].GetRotation().GetForwardVector().Equals(FVector(1, 0, 0), 1.e-4f));
+    });
+}
+
+BEGIN_DEFINE_SPEC(FPoE2Minions_SummonSpawnSpec, "PoE2.Minions.SummonSpawn",
+                  EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+    UWorld* World;
+    UPoE2SummonSpawnSubsystem* Spawner;
+    AActor* Summoner;
+
+    FSkillSpec MakeSummonSpec(int32 Count) const
+    {
+        FSkillSpec Spec;
+        Spec.SkillId = TEXT("SummonSkill");
+        Spec.SummonClass = APoE2MinionBase::StaticClass();
+        Spec.SummonCount = Count;
+        return Spec;
+    }
+
+    int32 CountSummons() const
+    {
+        int32 Num = 0;
+        for (TActorIterator<APoE2MinionBase> It(World); It; ++It)
+        {
+            ++Num;
+        }
+        return Num;
+    }
+
+    /** The spawn budget is per engine frame; tests have no engine loop, so they move the frame on themselves. */
+    void NextFrame()
+    {
+        ++GFrameCounter;
+        Spawner->Tick(0.0f);
+    }
+END_DEFINE_SPEC(FPoE2Minions_SummonSpawnSpec)
+
+void FPoE2Minions_SummonSpawnSpec::Define()
+{
+    Describe("Summon spawn queue", [this]()
+    {
+        BeforeEach([this]()
+        {
+            // The spawn queue only runs in game worlds
+            World = UWorld::CreateWorld(EWorldType::Game, false);
+            GEngine->CreateNewWorldContext(EWorldType::Game).SetCurrentWorld(World);
+            Spawner = World->GetSubsystem<UPoE2SummonSpawnSubsystem>();
+            Summoner = World->SpawnActor<AStaticMeshActor>(FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator);
+        });
+
+        It("should spawn within the per-frame budget and finish the formation on later frames", [this]()
+        {
+            if (!TestNotNull(TEXT("Spawn subsystem"), Spawner))
+            {
+                return;
+            }
+            Spawner->MaxSpawnsPerFrame = 4;
+
+            ++GFrameCounter;
+            Spawner->QueueFormation(Summoner, MakeSummonSpec(6), nullptr, {});
+            TestEqual(TEXT("Budget spent on queueing"), CountSummons(), 4);
+            TestEqual(TEXT("Rest waits"), Spawner->GetNumPendingSpawns(), 2);
+
+            Spawner->Tick(0.0f);
+            TestEqual(TEXT("Nothing more the same frame"), CountSummons(), 4);
+
+            NextFrame();
+            TestEqual(TEXT("Rest spawned the next frame"), CountSummons(), 6);
+            TestEqual(TEXT("No spawns left"), Spawner->GetNumPendingSpawns(), 0);
+            TestEqual(TEXT("Finished formation removed"), Spawner->GetNumPendingFormations(), 0);
+        });
+
+        It("should share the budget between formations in queue order and drop those of a departed summoner", [this]()
+        {
+            if (!TestNotNull(TEXT("Spawn subsystem"), Spawner))
+            {
+                return;
+            }
+            Spawner->MaxSpawnsPerFrame = 2;
+
+            AActor* Departing = World->SpawnActor<AStaticMeshActor>(FVector(500.0f, 0.0f, 100.0f), FRotator::ZeroRotator);
+
+            ++GFrameCounter;
+            Spawner->QueueFormation(Summoner, MakeSummonSpec(3), nullptr, {});
+            Spawner->QueueFormation(Departing, MakeSummonSpec(3), nullptr, {});
+            TestEqual(TEXT("Both formations queued"), Spawner->GetNumPendingFormations(), 2);
+            TestEqual(TEXT("First formation spawns first"), CountSummons(), 2);
+
+            Departing->Destroy();
+            NextFrame();
+            TestEqual(TEXT("First formation completed"), CountSummons(), 3);
+            TestEqual(TEXT("Departed summoner's formation dropped, unspawned"), Spawner->GetNumPendingFormations(), 0);
+
+            NextFrame();
+            TestEqual(TEXT("Nothing spawned for it later"), CountSummons(), 3);
+        });
+
+        It("should stand summons without navmesh nearby where the summoner is", [this]()
+        {
+            TArray<FTransform> Slots;
+            PoE2SummonFormation::ComputeSlots(FVector::ZeroVector, FVector(1, 0, 0), 2, FPoE2SummonFormationSettings(), Slots);
+
+            TArray<FNavigationProjectionWork> Projections;
+            Projections.Emplace(Slots[0].GetLocation());
+            Projections.Emplace(Slots[1].GetLocation());
+            Projections[0].bResult = true;
+            Projections[0].OutLocation.Location = FVector(100.0f, -50.0f, -20.0f);
+            Projections[1].bResult = false;
+
+            const FVector SummonerLocation(0.0f, 0.0f, 90.0f);
+            PoE2SummonFormation::PlaceProjectedSlots(Projections, SummonerLocation, 90.0f, Slots);
+
+            TestTrue(TEXT("Projected slot lifted off the floor"), Slots[0].GetLocation().Equals(FVector(100.0f, -50.0f, 70.0f)));
+            TestTrue(TEXT("Unprojected slot at the summoner, not lifted again"), Slots[1].GetLocation().Equals(SummonerLocation));
+        });
+
+        AfterEach([this]()
+        {
+            if (World)
+            {
+                GEngine->DestroyWorldContext(World);
+                World->DestroyWorld(false);
+            }
+            World = nullptr;
+            Spawner = nullptr;
+            Summoner = nullptr;
+        });
+    });
+}
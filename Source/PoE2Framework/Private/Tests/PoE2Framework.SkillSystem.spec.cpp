@@ -17,9 +17,26 @@
 #include "AbilitySystem/Actors/PoE2ProjectileBase.h"
 #include "AbilitySystem/Handlers/Mechanic_Pierce.h"
 #include "AbilitySystem/Handlers/MechanicHandlerBase.h"
+#include "AbilitySystem/Handlers/MechanicHandlerDispatch.h"
+#include "AbilitySystem/Handlers/MechanicHandlerPipeline.h"
 #include "AbilitySystem/GA_SkillBase.h"
 #include "GameplayEffect.h"
 #include "Components/SphereComponent.h"
+#include "HAL/PlatformTime.h"
+#include "Spec/SkillSpecBuilder.h"
+#include "Simulation/PoE2CombatSimulator.h"
+#include "AbilitySystem/Handlers/Mechanic_DOT.h"
+#include "Effects/PoE2HitConditions.h"
+#include "Simulation/PoE2SupportSearch.h"
+#include "Data/SupportDataAsset.h"
+#include "Data/PoE2SkillRegistry.h"
+#include "Data/PoE2SkillDatabase.h"
+#include "Algo/Reverse.h"
+#include "Core/PoE2Tags.h"
+#include "AbilitySystem/PoE2SwarmAbilitySystemComponent.h"
+#include "Targeting/PoE2TargetingSubsystem.h"
+#include "Engine/Engine.h"
+#include "GameFramework/ProjectileMovementComponent.h"
 
 UCLASS()
 class UMechanic_TestLifecycle : public UMechanicHandlerBase
@@ -46,6 +63,67 @@ public:
     static TWeakObjectPtr<AActor> LastHitOwner;
 };
 
+/** Overrides a single hook, to check that the base's other no-op hooks are skipped. */
+UCLASS()
+class UMechanic_TestTickOnly : public UMechanicHandlerBase
+{
+    GENERATED_BODY()
+
+public:
+    POE2_MECHANIC_HANDLER_HOOKS()
+
+    virtual void OnTick_Implementation(AActor* OwnerActor, float DeltaTime, const FSkillSpec& SkillSpec) override {}
+};
+
+/** Filter-phase handler that does not override OnHit. */
+UCLASS()
+class UMechanic_TestPassiveFilter : public UMechanicHandlerBase
+{
+    GENERATED_BODY()
+
+public:
+    UMechanic_TestPassiveFilter() { HitPhase = EMechanicHandlerPhase::Filter; }
+};
+
+/** Filter-phase handler that rejects every hit. */
+UCLASS()
+class UMechanic_TestRejectFilter : public UMechanicHandlerBase
+{
+    GENERATED_BODY()
+
+public:
+    UMechanic_TestRejectFilter() { HitPhase = EMechanicHandlerPhase::Filter; }
+
+    POE2_MECHANIC_HANDLER_HOOKS()
+
+    virtual EHitHandlerResult OnHit_Implementation(AActor* OwnerActor, AActor* Target, const FHitResult& HitResult, const FSkillSpec& SkillSpec) override { return EHitHandlerResult::Stop; }
+};
+
+/** Decide-phase handler returning a fixed result, ahead of default-priority deciders. */
+UCLASS()
+class UMechanic_TestChain : public UMechanicHandlerBase
+{
+    GENERATED_BODY()
+
+public:
+    UMechanic_TestChain() { HandlerPriority = 1; }
+
+    POE2_MECHANIC_HANDLER_HOOKS()
+
+    virtual EHitHandlerResult OnHit_Implementation(AActor* OwnerActor, AActor* Target, const FHitResult& HitResult, const FSkillSpec& SkillSpec) override { return EHitHandlerResult::Chain; }
+};
+
+UCLASS()
+class UMechanic_TestAlwaysPierce : public UMechanicHandlerBase
+{
+    GENERATED_BODY()
+
+public:
+    POE2_MECHANIC_HANDLER_HOOKS()
+
+    virtual EHitHandlerResult OnHit_Implementation(AActor* OwnerActor, AActor* Target, const FHitResult& HitResult, const FSkillSpec& SkillSpec) override { return EHitHandlerResult::Pierce; }
+};
+
 int32 UMechanic_TestLifecycle::CastCount = 0;
 int32 UMechanic_TestLifecycle::SpawnCount = 0;
 int32 UMechanic_TestLifecycle::HitCount = 0;
@@ -120,6 +198,74 @@ void FPoE2SkillSystem_SkillSpecBuilderSpec::Define()
             TestTrue(TEXT("Mechanic handler appended"), OutSpec.MechanicHandlers.Contains(UMechanic_TestLifecycle::StaticClass()));
         });
 
+#if WITH_EDITOR
+        It("should copy baked mechanic parameters into the base spec", [this]()
+        {
+            UPierceParameterDataAsset* PierceParams = NewObject<UPierceParameterDataAsset>(SkillAsset);
+            PierceParams->PierceCount = 3;
+            SkillAsset->CustomMechanicParameters.Add(PierceParams);
+
+            TestEqual(TEXT("Nothing baked before the asset is baked"), SkillAsset->CreateBaseSkillSpec().CustomParams.Num(), 0);
+
+            SkillAsset->BakeCustomParams();
+            const FSkillSpec BaseSpec = SkillAsset->CreateBaseSkillSpec();
+
+            TestEqual(TEXT("Baked table copied"), BaseSpec.CustomParams.Num(), 1);
+            TestEqual(TEXT("Pierce count baked"), BaseSpec.GetCustomParam(UMechanic_Pierce::PierceCountKey), 3.f);
+            TestTrue(TEXT("Parameter objects are editor only"), PierceParams->IsEditorOnly());
+        });
+
+#endif
+        It("should deduplicate handlers and freeze a shared pipeline", [this]()
+        {
+            SkillAsset->DefaultHandlers.Add(UMechanic_Pierce::StaticClass());
+
+            FPatch Patch;
+            Patch.HandlersToAdd.Add(UMechanic_TestLifecycle::StaticClass());
+            Patch.HandlersToAdd.Add(UMechanic_Pierce::StaticClass());
+
+            TArray<FPatch> Patches;
+            Patches.Add(Patch);
+            Patches.Add(Patch);
+
+            FSkillSpec OutSpec;
+            Ability->BuildSkillSpec(SkillAsset, Patches, OutSpec);
+
+            TestEqual(TEXT("Duplicate handlers removed"), OutSpec.MechanicHandlers.Num(), 2);
+            TestTrue(TEXT("Pipeline frozen"), OutSpec.GetHandlerPipeline().IsValid());
+            if (OutSpec.GetHandlerPipeline().IsValid())
+            {
+                const FMechanicHandlerPipeline& Pipeline = *OutSpec.GetHandlerPipeline();
+                TestEqual(TEXT("Pipeline matches handler list"), Pipeline.Num(), OutSpec.MechanicHandlers.Num());
+                TestEqual(TEXT("Equal phase and priority keep contribution order"), Pipeline.IndexOf(UMechanic_Pierce::StaticClass()), 0);
+
+                FSkillSpec CarrierCopy = OutSpec;
+                TestTrue(TEXT("Copies share the same pipeline"), CarrierCopy.GetHandlerPipeline() == OutSpec.GetHandlerPipeline());
+            }
+        });
+
+        It("should resolve soft references by bundle", [this]()
+        {
+            SkillAsset->ProjectileClass = APoE2ProjectileBase::StaticClass();
+            SkillAsset->DefaultEffects.Add(UGameplayEffect::StaticClass());
+            SkillAsset->DefaultHandlers.Add(UMechanic_Pierce::StaticClass());
+
+            TArray<FSoftObjectPath> GameplayPaths;
+            SkillAsset->GatherBundleReferences({ USkillDataAsset::GameplayBundle }, GameplayPaths);
+            TArray<FSoftObjectPath> CosmeticPaths;
+            SkillAsset->GatherBundleReferences({ USkillDataAsset::CosmeticBundle }, CosmeticPaths);
+
+            TestEqual(TEXT("Null references are skipped"), GameplayPaths.Num(), 3);
+            TestEqual(TEXT("Montage is the only cosmetic reference"), CosmeticPaths.Num(), 0);
+            TestTrue(TEXT("Native classes are always resident"), SkillAsset->AreBundlesLoaded({ USkillDataAsset::GameplayBundle }));
+
+            const FSkillSpec BaseSpec = SkillAsset->CreateBaseSkillSpec();
+            TestEqual(TEXT("Loaded projectile class resolved"), BaseSpec.ProjectileClass.Get(), APoE2ProjectileBase::StaticClass());
+            TestTrue(TEXT("Loaded effect resolved"), BaseSpec.AppliedEffects.Contains(UGameplayEffect::StaticClass()));
+            TestTrue(TEXT("Loaded handler resolved"), BaseSpec.MechanicHandlers.Contains(UMechanic_Pierce::StaticClass()));
+            TestTrue(TEXT("Resident memory reported"), SkillAsset->GetResidentMemoryBytes() > 0);
+        });
+
         AfterEach([this]()
         {
             Ability = nullptr;
@@ -476,6 +622,164 @@ void FPoE2SkillSystem_HandlerLifecycleSpec::Define()
     });
 }
 
+BEGIN_DEFINE_SPEC(FPoE2SkillSystem_HitPhasesSpec, "PoE2.SkillSystem.Mechanics.HitPhases",
+                  EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+    UWorld* World;
+    ATestProjectile* Projectile;
+    AActor* Target;
+
+    void InitProjectile(TArrayView<UClass* const> HandlerClasses)
+    {
+        TArray<TScriptInterface<IMechanicHandler>> Prototypes;
+        for (UClass* HandlerClass : HandlerClasses)
+        {
+            UObject* Prototype = NewObject<UObject>(GetTransientPackage(), HandlerClass);
+            TScriptInterface<IMechanicHandler> PrototypeInterface;
+            PrototypeInterface.SetObject(Prototype);
+            PrototypeInterface.SetInterface(Cast<IMechanicHandler>(Prototype));
+            Prototypes.Add(PrototypeInterface);
+        }
+
+        FSkillSpec Spec;
+        Spec.SkillId = TEXT("HitPhasesSkill");
+        Projectile->InitFromSpec(Spec, nullptr, Prototypes);
+    }
+END_DEFINE_SPEC(FPoE2SkillSystem_HitPhasesSpec)
+
+void FPoE2SkillSystem_HitPhasesSpec::Define()
+{
+    Describe("Hit phases on a projectile", [this]()
+    {
+        BeforeEach([this]()
+        {
+            World = FAutomationEditorCommonUtils::CreateNewMap();
+            Projectile = World->SpawnActor<ATestProjectile>();
+            Target = World->SpawnActor<AActor>();
+            UMechanic_TestLifecycle::Reset();
+        });
+
+        It("should let a filter that does not override OnHit accept every hit", [this]()
+        {
+            FSkillSpec Spec;
+            TestTrue(TEXT("Base OnHit has no opinion"),
+                NewObject<UMechanic_TestPassiveFilter>()->OnHit_Implementation(nullptr, Target, FHitResult(), Spec) == EHitHandlerResult::Continue);
+
+            InitProjectile({ UMechanic_TestPassiveFilter::StaticClass(), UMechanic_TestLifecycle::StaticClass() });
+            Projectile->SimulateHit(Target);
+            TestEqual(TEXT("Hit reached the decide phase"), UMechanic_TestLifecycle::HitCount, 1);
+        });
+
+        It("should ignore a rejected hit before damage and decisions, and keep flying", [this]()
+        {
+            InitProjectile({ UMechanic_TestRejectFilter::StaticClass(), UMechanic_TestLifecycle::StaticClass() });
+            Projectile->SimulateHit(Target);
+            TestEqual(TEXT("Decide phase never ran"), UMechanic_TestLifecycle::HitCount, 0);
+            TestTrue(TEXT("Projectile still alive"), IsValid(Projectile));
+        });
+
+        It("should end the projectile on Chain without a targeting service, short-circuiting later deciders", [this]()
+        {
+            // An editor world has no targeting service, so there is nothing to chain to
+            InitProjectile({ UMechanic_TestAlwaysPierce::StaticClass(), UMechanic_TestChain::StaticClass() });
+            Projectile->SimulateHit(Target);
+            TestFalse(TEXT("Projectile destroyed despite the pierce handler"), IsValid(Projectile));
+        });
+
+        AfterEach([this]()
+        {
+            if (World)
+            {
+                World->DestroyWorld(false);
+            }
+            World = nullptr;
+            Projectile = nullptr;
+            Target = nullptr;
+        });
+    });
+}
+
+BEGIN_DEFINE_SPEC(FPoE2SkillSystem_ChainSpec, "PoE2.SkillSystem.Mechanics.Chain",
+                  EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+    UWorld* World;
+    UPoE2TargetingSubsystem* Targeting;
+    ATestProjectile* Projectile;
+
+    AActor* SpawnLivingTarget(const FVector& Location)
+    {
+        // Untouched swarm life reads as full, which is all the targeting service asks of a target
+        AActor* Actor = World->SpawnActor<ATestOverlapActor>(Location, FRotator::ZeroRotator);
+        UPoE2SwarmAbilitySystemComponent* ASC = NewObject<UPoE2SwarmAbilitySystemComponent>(Actor);
+        ASC->RegisterComponent();
+        Targeting->RegisterTarget(Actor);
+        return Actor;
+    }
+END_DEFINE_SPEC(FPoE2SkillSystem_ChainSpec)
+
+void FPoE2SkillSystem_ChainSpec::Define()
+{
+    Describe("Chaining projectile", [this]()
+    {
+        BeforeEach([this]()
+        {
+            // The targeting service only runs in game worlds
+            World = UWorld::CreateWorld(EWorldType::Game, false);
+            GEngine->CreateNewWorldContext(EWorldType::Game).SetCurrentWorld(World);
+            Targeting = World->GetSubsystem<UPoE2TargetingSubsystem>();
+
+            Projectile = World->SpawnActor<ATestProjectile>(FVector::ZeroVector, FRotator::ZeroRotator);
+
+            TArray<TScriptInterface<IMechanicHandler>> Prototypes;
+            UObject* Prototype = NewObject<UMechanic_TestChain>();
+            TScriptInterface<IMechanicHandler> PrototypeInterface;
+            PrototypeInterface.SetObject(Prototype);
+            PrototypeInterface.SetInterface(Cast<IMechanicHandler>(Prototype));
+            Prototypes.Add(PrototypeInterface);
+
+            FSkillSpec Spec;
+            Spec.SkillId = TEXT("ChainSkill");
+            Projectile->InitFromSpec(Spec, nullptr, Prototypes);
+        });
+
+        It("should fly on to the nearest target it has not hit, then end when none is left", [this]()
+        {
+            if (!TestNotNull(TEXT("Targeting service"), Targeting))
+            {
+                return;
+            }
+
+            AActor* First = SpawnLivingTarget(FVector(100.0f, 0.0f, 0.0f));
+            AActor* Second = SpawnLivingTarget(FVector(100.0f, 400.0f, 0.0f));
+            SpawnLivingTarget(FVector(5000.0f, 0.0f, 0.0f));
+
+            Projectile->SimulateHit(First);
+            TestTrue(TEXT("Alive while the next target is looked up"), IsValid(Projectile));
+            TestEqual(TEXT("One chain request"), Targeting->GetNumPendingRequests(), 1);
+
+            Targeting->Tick(0.0f);
+            TestTrue(TEXT("Still flying"), IsValid(Projectile));
+            const FVector ToSecond = (Second->GetActorLocation() - Projectile->GetActorLocation()).GetSafeNormal();
+            TestTrue(TEXT("Heading for the second target"), FVector::DotProduct(Projectile->MovementComponent->Velocity.GetSafeNormal(), ToSecond) > 0.99f);
+
+            // The first target is excluded and the last is out of range
+            Projectile->SimulateHit(Second);
+            Targeting->Tick(0.0f);
+            TestFalse(TEXT("Destroyed with nothing left to chain to"), IsValid(Projectile));
+        });
+
+        AfterEach([this]()
+        {
+            if (World)
+            {
+                GEngine->DestroyWorldContext(World);
+                World->DestroyWorld(false);
+            }
+            World = nullptr;
+            Targeting = nullptr;
+            Projectile = nullptr;
+        });
+    });
+}
+
 BEGIN_DEFINE_SPEC(FPoE2SkillSystem_AreaEffectSpec, "PoE2.SkillSystem.AreaEffect",
                   EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
     UWorld* World;
@@ -545,3 +849,619 @@ void FPoE2SkillSystem_AreaEffectSpec::Define()
         });
     });
 }
+
+BEGIN_DEFINE_SPEC(FPoE2SkillSystem_HandlerHooksSpec, "PoE2.SkillSystem.Mechanics.Hooks",
+                  EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FPoE2SkillSystem_HandlerHooksSpec)
+
+void FPoE2SkillSystem_HandlerHooksSpec::Define()
+{
+    Describe("Handler hook masks", [this]()
+    {
+        It("should only report OnHit for the pierce handler", [this]()
+        {
+            const EMechanicHandlerHooks Hooks = MechanicHandlerHooks::GetClassHooks(UMechanic_Pierce::StaticClass());
+            TestEqual(TEXT("Pierce implements only OnHit"), Hooks, EMechanicHandlerHooks::Hit);
+        });
+
+        It("should report every overridden hook for native subclasses", [this]()
+        {
+            const EMechanicHandlerHooks Hooks = MechanicHandlerHooks::GetClassHooks(UMechanic_TestLifecycle::StaticClass());
+            TestEqual(TEXT("Lifecycle handler implements every hook"), Hooks, EMechanicHandlerHooks::All);
+        });
+
+        It("should give native subclasses that don't declare their hooks every hook", [this]()
+        {
+            const EMechanicHandlerHooks Hooks = MechanicHandlerHooks::GetClassHooks(UMechanic_TestPassiveFilter::StaticClass());
+            TestEqual(TEXT("Undeclared handler keeps every hook"), Hooks, EMechanicHandlerHooks::All);
+        });
+
+        It("should only report the hooks a handler base subclass overrides", [this]()
+        {
+            const EMechanicHandlerHooks Hooks = MechanicHandlerHooks::GetClassHooks(UMechanic_TestTickOnly::StaticClass());
+            TestTrue(TEXT("Only OnTick, none of the base's no-ops"), Hooks == EMechanicHandlerHooks::Tick);
+        });
+
+        It("should derive native overrides at compile time", [this]()
+        {
+            TestEqual(TEXT("Derived pierce hooks"), MechanicHandlerHooks::DeriveNative<UMechanic_Pierce>(), EMechanicHandlerHooks::Hit);
+            TestEqual(TEXT("Handler base subclass without overrides"),
+                MechanicHandlerHooks::DeriveNative<UMechanicHandlerBase, UMechanicHandlerBase>(), EMechanicHandlerHooks::None);
+        });
+    });
+}
+
+
+// Measures per-hit handler dispatch cost through reflection (Execute_OnHit) versus the native fast path
+BEGIN_DEFINE_SPEC(FPoE2SkillSystem_HandlerDispatchBenchmarkSpec, "PoE2.SkillSystem.Mechanics.DispatchBenchmark",
+                  EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+    TArray<FMechanicHandlerRef> Handlers;
+    FSkillSpec SkillSpec;
+    double MeasurePerHitNanoseconds(int32 HandlerCount, bool bNativeFastPath);
+END_DEFINE_SPEC(FPoE2SkillSystem_HandlerDispatchBenchmarkSpec)
+
+double FPoE2SkillSystem_HandlerDispatchBenchmarkSpec::MeasurePerHitNanoseconds(int32 HandlerCount, bool bNativeFastPath)
+{
+    static constexpr int32 NumHits = 100000;
+    const FHitResult Hit;
+
+    const double StartSeconds = FPlatformTime::Seconds();
+    for (int32 HitIndex = 0; HitIndex < NumHits; ++HitIndex)
+    {
+        for (int32 HandlerIndex = 0; HandlerIndex < HandlerCount; ++HandlerIndex)
+        {
+            const FMechanicHandlerRef& Handler = Handlers[HandlerIndex];
+            if (bNativeFastPath)
+            {
+                MechanicHandlerDispatch::OnHit(Handler, nullptr, nullptr, Hit, SkillSpec);
+            }
+            else
+            {
+                IMechanicHandler::Execute_OnHit(Handler.Object, nullptr, nullptr, Hit, SkillSpec);
+            }
+        }
+    }
+    const double ElapsedSeconds = FPlatformTime::Seconds() - StartSeconds;
+
+    return (ElapsedSeconds * 1.0e9) / NumHits;
+}
+
+void FPoE2SkillSystem_HandlerDispatchBenchmarkSpec::Define()
+{
+    Describe("Per-hit handler dispatch cost", [this]()
+    {
+        BeforeEach([this]()
+        {
+            SkillSpec = FSkillSpec();
+            SkillSpec.SkillId = TEXT("DispatchBenchmarkSkill");
+
+            Handlers.Reset();
+            for (int32 Index = 0; Index < 8; ++Index)
+            {
+                Handlers.Add(FMechanicHandlerRef(NewObject<UMechanic_TestLifecycle>()));
+            }
+            UMechanic_TestLifecycle::Reset();
+        });
+
+        It("should report per-hit cost for 1, 4 and 8 handlers", [this]()
+        {
+            TestTrue(TEXT("Benchmark handlers resolve to the native path"), Handlers[0].IsNative(EMechanicHandlerHooks::Hit));
+
+            for (const int32 HandlerCount : { 1, 4, 8 })
+            {
+                const double ReflectiveNs = MeasurePerHitNanoseconds(HandlerCount, false);
+                const double NativeNs = MeasurePerHitNanoseconds(HandlerCount, true);
+
+                AddInfo(FString::Printf(TEXT("%d handler(s): reflective %.1f ns/hit, native %.1f ns/hit (%.1fx)"),
+                    HandlerCount, ReflectiveNs, NativeNs, NativeNs > 0.0 ? ReflectiveNs / NativeNs : 0.0));
+            }
+
+            TestTrue(TEXT("Native path reached the handler implementation"), UMechanic_TestLifecycle::HitCount > 0);
+        });
+
+        AfterEach([this]()
+        {
+            Handlers.Reset();
+        });
+    });
+}
+
+BEGIN_DEFINE_SPEC(FPoE2SkillSystem_CombatSimulatorSpec, "PoE2.SkillSystem.Simulation",
+                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+    USkillDataAsset* SkillAsset;
+    USupportDataAsset* SupportAsset;
+    UTestSkillAbility* Ability;
+END_DEFINE_SPEC(FPoE2SkillSystem_CombatSimulatorSpec)
+
+void FPoE2SkillSystem_CombatSimulatorSpec::Define()
+{
+    Describe("Headless combat simulation", [this]()
+    {
+        BeforeEach([this]()
+        {
+            Ability = NewObject<UTestSkillAbility>();
+
+            SkillAsset = NewObject<USkillDataAsset>();
+            SkillAsset->SkillId = TEXT("SimSkill");
+            SkillAsset->BaseDamage = 100.f;
+            SkillAsset->CastTime = 1.f;
+
+            SupportAsset = NewObject<USupportDataAsset>();
+            SupportAsset->SupportId = TEXT("SimSupport");
+            SupportAsset->SkillPatch.AdditiveModifiers.Add(TEXT("FinalDamage"), 20.f);
+            SupportAsset->SkillPatch.MultiplicativeModifiers.Add(TEXT("FinalDamage"), 0.5f);
+            SupportAsset->SkillPatch.MultiplicativeModifiers.Add(TEXT("NotASpecField"), 1.f);
+        });
+
+        It("should compose the same spec as BuildSkillSpec", [this]()
+        {
+            TArray<FPatch> Patches;
+            Patches.Add(SupportAsset->SkillPatch);
+            Patches.Add(SupportAsset->SkillPatch);
+
+            FSkillSpec AbilitySpec;
+            Ability->BuildSkillSpec(SkillAsset, Patches, AbilitySpec);
+
+            FSkillSpec BuilderSpec;
+            FSkillSpecBuilder::Build(SkillAsset, Patches, BuilderSpec, false);
+
+            TestEqual(TEXT("Same final damage"), BuilderSpec.FinalDamage, AbilitySpec.FinalDamage);
+            TestEqual(TEXT("Patches fold in order"), BuilderSpec.FinalDamage, ((100.f + 20.f) * 1.5f + 20.f) * 1.5f);
+        });
+
+        It("should resolve numeric field names to stable fields", [this]()
+        {
+            TestEqual(TEXT("FinalDamage"), SkillSpecNumericField::FromName(TEXT("FinalDamage")), ESkillSpecNumericField::FinalDamage);
+            TestEqual(TEXT("Lifetime"), SkillSpecNumericField::FromName(TEXT("Lifetime")), ESkillSpecNumericField::Lifetime);
+            TestEqual(TEXT("Unknown key"), SkillSpecNumericField::FromName(TEXT("NotASpecField")), ESkillSpecNumericField::Count);
+        });
+
+        It("should simulate hit DPS against a mitigating target", [this]()
+        {
+            FPoE2SimBuild Build;
+            Build.Skill = SkillAsset;
+            Build.Supports.Add(SupportAsset);
+
+            FPoE2SimTarget Target;
+            Target.Defence.Resistances[(int32)EPoE2DamageType::Physical] = 0.5f;
+            Target.Life = 300.f;
+
+            FPoE2SimSettings Settings;
+            Settings.Duration = 10.f;
+
+            const FPoE2SimResult Result = FPoE2CombatSimulator::SimulateBuild(Build, Target, Settings);
+
+            TestEqual(TEXT("Label"), Result.Label, FString(TEXT("SimSkill+SimSupport")));
+            TestEqual(TEXT("Mitigated hit"), Result.MitigatedHitDamage, 90.f);
+            TestEqual(TEXT("One use per second"), Result.UsesPerSecond, 1.f);
+            TestEqual(TEXT("DPS"), Result.DPS, 90.f, 0.01f);
+            TestEqual(TEXT("Killed on the fourth hit"), Result.TimeToKill, 3.1f, 0.05f);
+        });
+
+        It("should mitigate DoTs by the target's resistance to their type, but not by armour", [this]()
+        {
+            FSkillSpec Spec;
+            Spec.SkillId = TEXT("SimIgnite");
+            Spec.CastTime = 1.f;
+            Spec.SkillTags.AddTag(FPoE2Tags::Get().Damage_Type_Fire);
+            Spec.MechanicHandlers.Add(UMechanic_DOT::StaticClass());
+            Spec.SetCustomParam(UMechanic_DOT::DamagePerSecondKey, 100.f);
+            Spec.SetCustomParam(UMechanic_DOT::DurationKey, 1.f);
+
+            FPoE2SimTarget Target;
+            Target.Defence.Armour = 100000.f;
+            Target.Defence.Resistances[(int32)EPoE2DamageType::Fire] = 0.75f;
+
+            FPoE2SimSettings Settings;
+            Settings.Duration = 10.f;
+
+            const FPoE2SimResult Result = FPoE2CombatSimulator::SimulateSpec(Spec, Target, Settings);
+            TestEqual(TEXT("Resisted DoT per second"), Result.MitigatedDotDps, 25.f, 0.01f);
+            TestEqual(TEXT("One resisted DoT at a time"), Result.DotDamageDealt, 250.f, 0.5f);
+        });
+
+        It("should apply conditional modifiers that hold for the simulated target", [this]()
+        {
+            const FPoE2Tags& Tags = FPoE2Tags::Get();
+
+            FPoE2HitCondition Burning;
+            Burning.Type = EPoE2HitConditionType::TargetHasTag;
+            Burning.Tag = Tags.Status_Burning;
+
+            FPoE2HitCondition LowLife;
+            LowLife.Type = EPoE2HitConditionType::ValueAtLeast;
+            LowLife.Value = EPoE2HitValue::TargetLifeFraction;
+            LowLife.Threshold = 0.5f;
+            LowLife.bNegate = true;
+
+            FSkillSpec Spec;
+            Spec.SkillId = TEXT("SimConditional");
+            Spec.FinalDamage = 100.f;
+            Spec.CastTime = 1.f;
+            FPoE2ConditionalModifier& MoreIfBurning = Spec.ConditionalModifiers.AddDefaulted_GetRef();
+            MoreIfBurning.Conditions.Add(Burning);
+            MoreIfBurning.Op = EPoE2HitModifierOp::More;
+            MoreIfBurning.Value = 0.5f;
+
+            FPoE2ConditionalModifier& IncreasedOnLowLife = Spec.ConditionalModifiers.AddDefaulted_GetRef();
+            IncreasedOnLowLife.Conditions.Add(LowLife);
+            IncreasedOnLowLife.Op = EPoE2HitModifierOp::Increased;
+            IncreasedOnLowLife.Value = 1.f;
+            Spec.CompileHitConditions();
+
+            FPoE2SimTarget Target;
+            TestEqual(TEXT("Neither condition holds"), FPoE2CombatSimulator::SimulateSpec(Spec, Target, FPoE2SimSettings()).MitigatedHitDamage, 100.f, 0.01f);
+
+            Target.Tags.AddTag(Tags.Status_Burning);
+            TestEqual(TEXT("Burning target"), FPoE2CombatSimulator::SimulateSpec(Spec, Target, FPoE2SimSettings()).MitigatedHitDamage, 150.f, 0.01f);
+
+            Target.LifeFraction = 0.3f;
+            TestEqual(TEXT("Burning target on low life"), FPoE2CombatSimulator::SimulateSpec(Spec, Target, FPoE2SimSettings()).MitigatedHitDamage, 300.f, 0.01f);
+        });
+
+        It("should count whole uses over a long encounter without drifting", [this]()
+        {
+            FSkillSpec Spec;
+            Spec.SkillId = TEXT("SimLong");
+            Spec.FinalDamage = 1.f;
+            Spec.CastTime = 0.1f;
+
+            FPoE2SimSettings Settings;
+            Settings.Duration = 3600.f;
+            Settings.MinUseInterval = 0.f;
+
+            FPoE2SimTarget Target;
+            Target.Life = MAX_flt;
+
+            const FPoE2SimResult Result = FPoE2CombatSimulator::SimulateSpec(Spec, Target, Settings);
+            TestEqual(TEXT("Ten uses per second for an hour"), Result.HitDamageDealt, 36000.f, 1.f);
+        });
+
+        It("should simulate many builds in parallel in input order", [this]()
+        {
+            TArray<FPoE2SimBuild> Builds;
+            for (int32 SupportCount = 0; SupportCount < 3; ++SupportCount)
+            {
+                FPoE2SimBuild& Build = Builds.AddDefaulted_GetRef();
+                Build.Skill = SkillAsset;
+                for (int32 Index = 0; Index < SupportCount; ++Index)
+                {
+                    Build.Supports.Add(SupportAsset);
+                }
+            }
+
+            TArray<FPoE2SimResult> Results;
+            FPoE2CombatSimulator::SimulateBuilds(Builds, FPoE2SimTarget(), FPoE2SimSettings(), Results);
+
+            TestEqual(TEXT("One result per build"), Results.Num(), Builds.Num());
+            TestTrue(TEXT("More supports, more DPS"), Results[0].DPS < Results[1].DPS && Results[1].DPS < Results[2].DPS);
+            TestTrue(TEXT("CSV has a header and a row per build"), FPoE2CombatSimulator::ToCSV(Results).Contains(TEXT("SimSkill+SimSupport+SimSupport")));
+        });
+    });
+}
+
+BEGIN_DEFINE_SPEC(FPoE2SkillSystem_SupportSearchSpec, "PoE2.SkillSystem.Simulation.SupportSearch",
+                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+    USkillDataAsset* SkillAsset;
+    TArray<const USupportDataAsset*> Pool;
+
+    USupportDataAsset* MakeSupport(const TCHAR* Id, float AddedDamage, float IncreasedDamage)
+    {
+        USupportDataAsset* Support = NewObject<USupportDataAsset>();
+        Support->SupportId = Id;
+        if (AddedDamage != 0.f)
+        {
+            Support->SkillPatch.AdditiveModifiers.Add(TEXT("FinalDamage"), AddedDamage);
+        }
+        if (IncreasedDamage != 0.f)
+        {
+            Support->SkillPatch.MultiplicativeModifiers.Add(TEXT("FinalDamage"), IncreasedDamage);
+        }
+        return Support;
+    }
+
+    /** Reference: fold every combination of exactly Count supports from scratch. */
+    float BruteForceBest(int32 MaxCount) const
+    {
+        float Best = -1.f;
+        const int32 NumMasks = 1 << Pool.Num();
+        for (int32 Mask = 0; Mask < NumMasks; ++Mask)
+        {
+            if (FMath::CountBits(Mask) > MaxCount)
+            {
+                continue;
+            }
+
+            TArray<FPatch> Patches;
+            for (int32 Index = 0; Index < Pool.Num(); ++Index)
+            {
+                if (Mask & (1 << Index))
+                {
+                    Patches.Add(Pool[Index]->SkillPatch);
+                }
+            }
+
+            FSkillSpec Spec;
+            FSkillSpecBuilder::Build(SkillAsset, Patches, Spec, false);
+            Best = FMath::Max(Best, FPoE2SupportSearch::DefaultScore(Spec, 0.5f));
+        }
+        return Best;
+    }
+END_DEFINE_SPEC(FPoE2SkillSystem_SupportSearchSpec)
+
+void FPoE2SkillSystem_SupportSearchSpec::Define()
+{
+    Describe("Support combination ranking", [this]()
+    {
+        BeforeEach([this]()
+        {
+            SkillAsset = NewObject<USkillDataAsset>();
+            SkillAsset->SkillId = TEXT("SearchSkill");
+            SkillAsset->BaseDamage = 100.f;
+            SkillAsset->CastTime = 1.f;
+
+            Pool.Reset();
+            Pool.Add(MakeSupport(TEXT("Added"), 40.f, 0.f));
+            Pool.Add(MakeSupport(TEXT("More"), 0.f, 0.5f));
+            Pool.Add(MakeSupport(TEXT("Weak"), 5.f, 0.f));
+            Pool.Add(MakeSupport(TEXT("Both"), 20.f, 0.2f));
+            Pool.Add(MakeSupport(TEXT("Bad"), 0.f, -0.3f));
+            Pool.Add(MakeSupport(TEXT("Tiny"), 1.f, 0.01f));
+        });
+
+        It("should find the same best combination as brute force", [this]()
+        {
+            FPoE2SupportSearchSettings Settings;
+            Settings.MaxSupports = 3;
+            Settings.TopK = 5;
+
+            TArray<FPoE2SupportSearchResult> Results;
+            FPoE2SupportSearchStats Stats;
+            FPoE2SupportSearch::FindTopCombinations(SkillAsset, Pool, Settings, Results, &Stats);
+
+            TestEqual(TEXT("Top-K results returned"), Results.Num(), 5);
+            TestEqual(TEXT("Best score matches brute force"), Results[0].Score, BruteForceBest(3), 0.01f);
+            TestTrue(TEXT("Results sorted by score"), Results[0].Score >= Results[1].Score && Results[3].Score >= Results[4].Score);
+            TestTrue(TEXT("Combinations respect the support limit"), Results[0].Supports.Num() <= 3);
+            TestTrue(TEXT("Weak subtrees pruned"), Stats.SubtreesPruned > 0);
+
+            FSkillSpec Rebuilt;
+            TArray<FPatch> Patches;
+            for (const USupportDataAsset* Support : Results[0].Supports)
+            {
+                Patches.Add(Support->SkillPatch);
+            }
+            FSkillSpecBuilder::Build(SkillAsset, Patches, Rebuilt, false);
+            TestEqual(TEXT("Memoized fold matches a full fold"), Results[0].Spec.FinalDamage, Rebuilt.FinalDamage);
+        });
+
+        It("should skip supports that are incompatible with the skill", [this]()
+        {
+            const FGameplayTag PierceTag = FGameplayTag::RequestGameplayTag(TEXT("Mechanic.Pierce"));
+            const_cast<USupportDataAsset*>(Pool[1])->RequiredSkillTags.AddTag(PierceTag);
+
+            FPoE2SupportSearchSettings Settings;
+            Settings.MaxSupports = 5;
+            Settings.TopK = 100;
+
+            TArray<FPoE2SupportSearchResult> Results;
+            FPoE2SupportSearch::FindTopCombinations(SkillAsset, Pool, Settings, Results);
+
+            const bool bAnyUsesIncompatible = Results.ContainsByPredicate([this](const FPoE2SupportSearchResult& Result)
+            {
+                return Result.Supports.Contains(Pool[1]);
+            });
+            TestFalse(TEXT("Support requiring Mechanic.Pierce never used"), bAnyUsesIncompatible);
+        });
+
+        It("should judge compatibility on the folded spec, like LinkSupportToSkill", [this]()
+        {
+            // The damage type is not among the asset's SkillTags; it only reaches the spec's tags
+            SkillAsset->DamageType = FPoE2Tags::Get().Damage_Type_Fire;
+            USupportDataAsset* FireOnly = const_cast<USupportDataAsset*>(Pool[1]);
+            FireOnly->RequiredSkillTags.AddTag(FPoE2Tags::Get().Damage_Type_Fire);
+
+            FSkillSpec BaseSpec;
+            FSkillSpecBuilder::Build(SkillAsset, {}, BaseSpec, false);
+            TestTrue(TEXT("Fire support can support the fire skill"), FireOnly->CanSupport(BaseSpec));
+            TestFalse(TEXT("The asset's own tags would reject it"), FireOnly->IsCompatibleWith(SkillAsset->SkillTags));
+
+            FPoE2SupportSearchSettings Settings;
+            Settings.MaxSupports = 2;
+            Settings.TopK = 100;
+
+            TArray<FPoE2SupportSearchResult> Results;
+            FPoE2SupportSearch::FindTopCombinations(SkillAsset, Pool, Settings, Results);
+            TestTrue(TEXT("Search uses the fire support"), Results.ContainsByPredicate([FireOnly](const FPoE2SupportSearchResult& Result)
+            {
+                return Result.Supports.Contains(FireOnly);
+            }));
+        });
+
+        It("should rank by a custom score without pruning", [this]()
+        {
+            FPoE2SupportSearchSettings Settings;
+            Settings.MaxSupports = 2;
+            Settings.TopK = 1;
+            Settings.Score = [](const FSkillSpec& Spec) { return -Spec.FinalDamage; };
+
+            TArray<FPoE2SupportSearchResult> Results;
+            FPoE2SupportSearchStats Stats;
+            FPoE2SupportSearch::FindTopCombinations(SkillAsset, Pool, Settings, Results, &Stats);
+
+            TestEqual(TEXT("Lowest damage wins"), Results[0].Spec.FinalDamage, 70.f);
+            TestEqual(TEXT("Every combination scored"), Stats.CombinationsScored, (int64)(1 + 6 + 15));
+        });
+    });
+}
+
+BEGIN_DEFINE_SPEC(FPoE2SkillSystem_SkillRegistrySpec, "PoE2.SkillSystem.Registry",
+                  EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+    TArray<USkillDataAsset*> Skills;
+    TArray<USupportDataAsset*> Supports;
+END_DEFINE_SPEC(FPoE2SkillSystem_SkillRegistrySpec)
+
+void FPoE2SkillSystem_SkillRegistrySpec::Define()
+{
+    Describe("Skill registry", [this]()
+    {
+        auto MakeEntries = []()
+        {
+            TArray<FPoE2AssetCatalog::FEntry> Entries;
+            for (const TCHAR* Name : { TEXT("Spark"), TEXT("Arc"), TEXT("Fireball"), TEXT("IceNova") })
+            {
+                FPoE2AssetCatalog::FEntry& Entry = Entries.AddDefaulted_GetRef();
+                Entry.AssetId = FPrimaryAssetId(TEXT("Skill"), FName(FString::Printf(TEXT("DA_%s"), Name)));
+                Entry.Key = Name;
+            }
+            return Entries;
+        };
+
+        It("should assign the same dense indices regardless of scan order", [this, MakeEntries]()
+        {
+            TArray<FPoE2AssetCatalog::FEntry> Forward = MakeEntries();
+            TArray<FPoE2AssetCatalog::FEntry> Reversed = MakeEntries();
+            Algo::Reverse(Reversed);
+
+            FPoE2AssetCatalog Server;
+            Server.Build(Forward);
+            FPoE2AssetCatalog Client;
+            Client.Build(Reversed);
+
+            TestEqual(TEXT("Entry count"), Server.Num(), 4);
+            TestEqual(TEXT("Hashes agree"), Server.GetHash(), Client.GetHash());
+            for (const FPoE2AssetCatalog::FEntry& Entry : Forward)
+            {
+                TestEqual(*FString::Printf(TEXT("%s index agrees"), *Entry.Key.ToString()), Server.FindByKey(Entry.Key).Value, Client.FindByKey(Entry.Key).Value);
+            }
+            TestEqual(TEXT("Indices are dense and start at 1"), Server.FindByKey(TEXT("Arc")).Value, (uint16)1);
+        });
+
+        It("should look up both ways", [this, MakeEntries]()
+        {
+            FPoE2AssetCatalog Catalog;
+            Catalog.Build(MakeEntries());
+
+            const FPoE2AssetIndex Index = Catalog.FindByAssetId(FPrimaryAssetId(TEXT("Skill"), TEXT("DA_Fireball")));
+            TestTrue(TEXT("Asset found"), Index.IsValid());
+            TestEqual(TEXT("Key and asset id agree"), Index.Value, Catalog.FindByKey(TEXT("Fireball")).Value);
+
+            const FPoE2AssetCatalog::FEntry* Entry = Catalog.Get(Index);
+            TestTrue(TEXT("Entry resolved"), Entry != nullptr);
+            if (Entry)
+            {
+                TestEqual(TEXT("Round trip key"), Entry->Key, FName(TEXT("Fireball")));
+            }
+
+            TestFalse(TEXT("Unknown key is invalid"), Catalog.FindByKey(TEXT("Unknown")).IsValid());
+            TestTrue(TEXT("Invalid index resolves to nothing"), Catalog.Get(FPoE2AssetIndex()) == nullptr);
+        });
+
+        It("should change the hash when an id moves to a different asset", [this, MakeEntries]()
+        {
+            TArray<FPoE2AssetCatalog::FEntry> Moved = MakeEntries();
+            Moved[0].AssetId = FPrimaryAssetId(TEXT("Skill"), TEXT("DA_SparkRework"));
+
+            FPoE2AssetCatalog Original;
+            Original.Build(MakeEntries());
+            FPoE2AssetCatalog Reworked;
+            Reworked.Build(MoveTemp(Moved));
+
+            TestNotEqual(TEXT("Same keys, different assets"), Original.GetHash(), Reworked.GetHash());
+        });
+    });
+
+    Describe("Baked skill database", [this]()
+    {
+        BeforeEach([this]()
+        {
+            USkillDataAsset* Fireball = NewObject<USkillDataAsset>(GetTransientPackage(), TEXT("DA_BakeFireball"));
+            Fireball->SkillId = TEXT("Fireball");
+            Fireball->BaseDamage = 40.f;
+            Fireball->Cooldown = 1.5f;
+            Fireball->Speed = 900.f;
+            Fireball->SummonCount = 2;
+            Fireball->DamageType = FGameplayTag::RequestGameplayTag(TEXT("Damage.Type.Fire"));
+            Fireball->ProjectileClass = APoE2ProjectileBase::StaticClass();
+            Fireball->DefaultHandlers.Add(UMechanic_Pierce::StaticClass());
+            Fireball->BakedCustomParams.Add(FCustomParam(UMechanic_Pierce::PierceCountKey, 2.f));
+
+            USkillDataAsset* Arc = NewObject<USkillDataAsset>(GetTransientPackage(), TEXT("DA_BakeArc"));
+            Arc->SkillId = TEXT("Arc");
+            Arc->BaseDamage = 25.f;
+
+            USupportDataAsset* Added = NewObject<USupportDataAsset>(GetTransientPackage(), TEXT("DA_BakeAddedDamage"));
+            Added->SupportId = TEXT("AddedDamage");
+            Added->SkillPatch.AdditiveModifiers.Add(TEXT("FinalDamage"), 10.f);
+            Added->SkillPatch.MultiplicativeModifiers.Add(TEXT("FinalDamage"), 0.5f);
+            Added->SkillPatch.TagsToAdd.AddTag(FGameplayTag::RequestGameplayTag(TEXT("Mechanic.Pierce")));
+            Added->SkillPatch.EffectsToAdd.Add(UGameplayEffect::StaticClass());
+
+            USupportDataAsset* PierceOnly = NewObject<USupportDataAsset>(GetTransientPackage(), TEXT("DA_BakePierceOnly"));
+            PierceOnly->SupportId = TEXT("PierceOnly");
+            PierceOnly->RequiredSkillTags.AddTag(FGameplayTag::RequestGameplayTag(TEXT("Mechanic.Pierce")));
+
+            Skills = { Fireball, Arc };
+            Supports = { Added, PierceOnly };
+        });
+
+        It("should rebuild the same specs as the data assets", [this]()
+        {
+            TArray64<uint8> Bytes;
+            FPoE2SkillDatabase::Bake(TArray<const USkillDataAsset*>(Skills), TArray<const USupportDataAsset*>(Supports), Bytes);
+
+            FPoE2SkillDatabase Database;
+            TestTrue(TEXT("Image validates"), Database.OpenFromMemory(MoveTemp(Bytes)));
+            TestEqual(TEXT("Skill count"), Database.GetSkillCatalog().Num(), 2);
+
+            const FPoE2AssetIndex FireballIndex = Database.GetSkillCatalog().FindByKey(TEXT("Fireball"));
+            const FPoE2AssetIndex AddedIndex = Database.GetSupportCatalog().FindByKey(TEXT("AddedDamage"));
+
+            FSkillSpec Baked;
+            TestTrue(TEXT("Base spec built"), Database.BuildBaseSpec(FireballIndex, Baked));
+            const FSkillSpec Expected = Skills[0]->CreateBaseSkillSpec();
+
+            TestEqual(TEXT("SkillId"), Baked.SkillId, Expected.SkillId);
+            TestEqual(TEXT("Damage"), Baked.FinalDamage, Expected.FinalDamage);
+            TestEqual(TEXT("Cooldown"), Baked.Cooldown, Expected.Cooldown);
+            TestEqual(TEXT("Speed"), Baked.ProjectileSpeed, Expected.ProjectileSpeed);
+            TestEqual(TEXT("Summon count"), Baked.SummonCount, Expected.SummonCount);
+            TestTrue(TEXT("Tags"), Baked.SkillTags == Expected.SkillTags);
+            TestEqual(TEXT("Projectile class"), Baked.ProjectileClass.Get(), APoE2ProjectileBase::StaticClass());
+            TestTrue(TEXT("Handlers"), Baked.MechanicHandlers == Expected.MechanicHandlers);
+            TestEqual(TEXT("Custom param"), Baked.GetCustomParam(UMechanic_Pierce::PierceCountKey), 2.f);
+
+            FSkillSpec Patched = Expected;
+            FSkillSpecBuilder::ApplyPatch(Patched, Supports[0]->SkillPatch);
+            TestTrue(TEXT("Support applied"), Database.ApplySupport(AddedIndex, Baked));
+            TestEqual(TEXT("Patched damage"), Baked.FinalDamage, Patched.FinalDamage);
+            TestTrue(TEXT("Patched tags"), Baked.SkillTags == Patched.SkillTags);
+            TestTrue(TEXT("Patched effects"), Baked.AppliedEffects == Patched.AppliedEffects);
+
+            const FPoE2AssetIndex PierceOnlyIndex = Database.GetSupportCatalog().FindByKey(TEXT("PierceOnly"));
+            TestEqual(TEXT("Compatibility matches the asset"), Database.IsSupportCompatible(PierceOnlyIndex, Expected.SkillTags), Supports[1]->IsCompatibleWith(Expected.SkillTags));
+            TestTrue(TEXT("Compatible once the tag is added"), Database.IsSupportCompatible(PierceOnlyIndex, Baked.SkillTags));
+        });
+
+        It("should reject corrupt images", [this]()
+        {
+            TArray64<uint8> Bytes;
+            FPoE2SkillDatabase::Bake(TArray<const USkillDataAsset*>(Skills), TArray<const USupportDataAsset*>(Supports), Bytes);
+
+            TArray64<uint8> Truncated(Bytes.GetData(), Bytes.Num() - 8);
+            TArray64<uint8> BadMagic = Bytes;
+            BadMagic[0] ^= 0xFF;
+
+            FPoE2SkillDatabase Database;
+            TestFalse(TEXT("Truncated image rejected"), Database.OpenFromMemory(MoveTemp(Truncated)));
+            TestFalse(TEXT("Bad magic rejected"), Database.OpenFromMemory(MoveTemp(BadMagic)));
+            TestFalse(TEXT("Nothing left open"), Database.IsOpen());
+        });
+
+        AfterEach([this]()
+        {
+            Skills.Reset();
+            Supports.Reset();
+        });
+    });
+}
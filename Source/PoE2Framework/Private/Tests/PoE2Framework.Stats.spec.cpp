@@ -0,0 +1,280 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+#include "Stats/PoE2StatGraph.h"
+#include "Spec/SkillSpec.h"
+#include "Data/PassiveSkillDataAsset.h"
+#include "Data/PoE2PassiveTree.h"
+#include "Data/SkillDataAsset.h"
+#include "AbilitySystem/PoE2_AbilitySystemComponent.h"
+
+BEGIN_DEFINE_SPEC(FPoE2Stats_StatGraphSpec, "PoE2.Stats.Graph",
+                  EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+    const FName Strength = TEXT("Strength");
+    const FName Life = TEXT("MaxLife");
+    const FName FinalDamage = GET_MEMBER_NAME_CHECKED(FSkillSpec, FinalDamage);
+    const FName AreaRadius = GET_MEMBER_NAME_CHECKED(FSkillSpec, AreaRadius);
+    const FName Cooldown = GET_MEMBER_NAME_CHECKED(FSkillSpec, Cooldown);
+    const FName CastTime = GET_MEMBER_NAME_CHECKED(FSkillSpec, CastTime);
+    const FName ResourceCost = GET_MEMBER_NAME_CHECKED(FSkillSpec, ResourceCost);
+
+END_DEFINE_SPEC(FPoE2Stats_StatGraphSpec)
+
+void FPoE2Stats_StatGraphSpec::Define()
+{
+    Describe("Stat graph", [this]()
+    {
+        It("should fold flat, increased and more modifiers and derived stats", [this]()
+        {
+            FPoE2StatGraph Graph;
+            Graph.SetBaseValue(Life, 100.0f);
+            Graph.SetBaseValue(Strength, 20.0f);
+            TestTrue(TEXT("Derivation accepted"), Graph.AddDerivation(Strength, Life, EPoE2StatModOp::Flat, 0.5f));
+
+            Graph.AddSource({ FPoE2StatModifier(Life, EPoE2StatModOp::Flat, 40.0f), FPoE2StatModifier(Life, EPoE2StatModOp::Increased, 0.5f) });
+            Graph.AddSource({ FPoE2StatModifier(Life, EPoE2StatModOp::More, 0.1f), FPoE2StatModifier(Strength, EPoE2StatModOp::Flat, 10.0f) });
+
+            // (100 + 40 + 30 * 0.5) * 1.5 * 1.1
+            TestEqual(TEXT("Life"), Graph.GetValue(Life), 155.0f * 1.5f * 1.1f, 1.e-3f);
+            TestFalse(TEXT("Cycles are rejected"), Graph.AddDerivation(Life, Strength, EPoE2StatModOp::Flat, 1.0f));
+        });
+
+        It("should dirty only the consumers that read a changed stat", [this]()
+        {
+            FPoE2StatGraph Graph;
+            const int32 DamageReader = Graph.AddConsumer();
+            const int32 AreaReader = Graph.AddConsumer();
+            Graph.SetConsumerStats(DamageReader, { FinalDamage });
+            Graph.SetConsumerStats(AreaReader, { AreaRadius });
+            Graph.ClearConsumerDirty(DamageReader);
+            Graph.ClearConsumerDirty(AreaReader);
+
+            FPoE2StatSourceHandle Ring = Graph.AddSource({ FPoE2StatModifier(FinalDamage, EPoE2StatModOp::Increased, 0.2f) });
+            TestTrue(TEXT("Damage reader is dirty"), Graph.IsConsumerDirty(DamageReader));
+            TestFalse(TEXT("Area reader is clean"), Graph.IsConsumerDirty(AreaReader));
+
+            Graph.ClearConsumerDirty(DamageReader);
+            const int32 RecomputesBefore = Graph.GetRecomputeCount();
+            Graph.RemoveSource(Ring);
+            TestTrue(TEXT("Removing the ring dirties the damage reader again"), Graph.IsConsumerDirty(DamageReader));
+            TestFalse(TEXT("Area reader is still clean"), Graph.IsConsumerDirty(AreaReader));
+
+            Graph.ClearConsumerDirty(DamageReader);
+            TestEqual(TEXT("Only the changed stat is recomputed"), Graph.GetRecomputeCount() - RecomputesBefore, 1);
+            TestFalse(TEXT("Removed source is gone"), Graph.HasSource(Ring));
+        });
+
+        It("should scale only the numeric fields a spec has", [this]()
+        {
+            FPoE2StatGraph Graph;
+            Graph.AddSource({ FPoE2StatModifier(FinalDamage, EPoE2StatModOp::Flat, 10.0f), FPoE2StatModifier(FinalDamage, EPoE2StatModOp::Increased, 1.0f),
+                              FPoE2StatModifier(AreaRadius, EPoE2StatModOp::Increased, 0.5f) });
+
+            FSkillSpec Spec;
+            Spec.FinalDamage = 20.0f;
+
+            TArray<FName> SpecStats;
+            FPoE2StatGraph::GetSpecStats(Spec, SpecStats);
+            TestTrue(TEXT("The spec reads only its damage"), SpecStats == TArray<FName>({ FinalDamage }));
+
+            Graph.ApplyToSpec(Spec);
+            TestEqual(TEXT("Damage is scaled"), Spec.FinalDamage, 60.0f, 1.e-4f);
+            TestEqual(TEXT("A missing area stays missing"), Spec.AreaRadius, 0.0f);
+        });
+
+        It("should shorten cooldown, cast time and cost when their stats increase", [this]()
+        {
+            FPoE2StatGraph Graph;
+            Graph.AddSource({ FPoE2StatModifier(Cooldown, EPoE2StatModOp::Increased, 0.25f), FPoE2StatModifier(CastTime, EPoE2StatModOp::More, 1.0f),
+                              FPoE2StatModifier(ResourceCost, EPoE2StatModOp::Flat, -2.0f), FPoE2StatModifier(ResourceCost, EPoE2StatModOp::Increased, 1.0f) });
+
+            FSkillSpec Spec;
+            Spec.Cooldown = 5.0f;
+            Spec.CastTime = 1.0f;
+            Spec.ResourceCost = 10.0f;
+
+            Graph.ApplyToSpec(Spec);
+            TestEqual(TEXT("Cooldown recovers 25% faster"), Spec.Cooldown, 4.0f, 1.e-4f);
+            TestEqual(TEXT("Cast time halves"), Spec.CastTime, 0.5f, 1.e-4f);
+            TestEqual(TEXT("Cost drops by the flat amount, then halves"), Spec.ResourceCost, 4.0f, 1.e-4f);
+        });
+    });
+}
+
+BEGIN_DEFINE_SPEC(FPoE2Stats_PassiveTreeSpec, "PoE2.Stats.PassiveTree",
+                  EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+    // Start - A - B - C - OtherStart, with D hanging off A
+    TArray<UPassiveSkillDataAsset*> Nodes;
+    TSharedPtr<const FPoE2PassiveTree> Tree;
+
+    const FName Life = TEXT("MaxLife");
+
+    UPassiveSkillDataAsset* MakeNode(float LifeBonus)
+    {
+        UPassiveSkillDataAsset* Node = NewObject<UPassiveSkillDataAsset>();
+        if (LifeBonus != 0.0f)
+        {
+            Node->StatModifiers.Add(FPoE2StatModifier(Life, EPoE2StatModOp::Flat, LifeBonus));
+        }
+        Nodes.Add(Node);
+        return Node;
+    }
+
+END_DEFINE_SPEC(FPoE2Stats_PassiveTreeSpec)
+
+void FPoE2Stats_PassiveTreeSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        Nodes.Reset();
+        UPassiveSkillDataAsset* Start = MakeNode(0.0f);
+        UPassiveSkillDataAsset* A = MakeNode(10.0f);
+        UPassiveSkillDataAsset* B = MakeNode(20.0f);
+        UPassiveSkillDataAsset* C = MakeNode(30.0f);
+        UPassiveSkillDataAsset* D = MakeNode(40.0f);
+        Start->bIsStartNode = true;
+        Start->ConnectedNodes.Add(A);
+        A->ConnectedNodes.Add(B);
+        B->ConnectedNodes.Add(C);
+        D->ConnectedNodes.Add(A);
+
+        UPassiveSkillDataAsset* OtherStart = MakeNode(0.0f);
+        OtherStart->bIsStartNode = true;
+        OtherStart->ConnectedNodes.Add(C);
+
+        Tree = FPoE2PassiveTree::Compile(TArray<const UPassiveSkillDataAsset*>(Nodes));
+    });
+
+    Describe("Compiled passive tree", [this]()
+    {
+        It("should find the shortest path from the allocation", [this]()
+        {
+            if (!TestTrue(TEXT("Tree compiled"), Tree.IsValid()))
+            {
+                return;
+            }
+
+            TArray<int32> Path;
+            TestTrue(TEXT("C is reachable"), Tree->FindPath(FPoE2PassiveAllocation(), 0, 3, Path));
+            TestTrue(TEXT("Path runs from the start node"), Path == TArray<int32>({ 0, 1, 2, 3 }));
+
+            FPoE2PassiveAllocation Allocated;
+            Allocated.Add(0);
+            Allocated.Add(1);
+            TestTrue(TEXT("D is reachable"), Tree->FindPath(Allocated, 0, 4, Path));
+            TestTrue(TEXT("Only D needs allocating"), Path == TArray<int32>({ 4 }));
+        });
+
+        It("should validate connectivity and refunds", [this]()
+        {
+            FPoE2PassiveAllocation Allocated;
+            Allocated.Add(0);
+            Allocated.Add(1);
+            Allocated.Add(2);
+            Allocated.Add(4);
+            TestTrue(TEXT("Connected"), Tree->IsConnected(Allocated, 0));
+            TestFalse(TEXT("A holds up B and D"), Tree->CanDeallocate(Allocated, 0, 1));
+            TestTrue(TEXT("B is a leaf"), Tree->CanDeallocate(Allocated, 0, 2));
+            TestFalse(TEXT("The start node cannot be refunded"), Tree->CanDeallocate(Allocated, 0, 0));
+
+            Allocated.Remove(1);
+            TestFalse(TEXT("Orphaned nodes are disconnected"), Tree->IsConnected(Allocated));
+        });
+
+        It("should push only the respec difference into the stat graph", [this]()
+        {
+            FPoE2StatGraph Graph;
+            FPoE2PassiveTreeState State;
+            TestTrue(TEXT("Allocated C"), State.AllocatePath(Tree, 0, 3, Graph));
+            TestEqual(TEXT("Life from A, B and C"), Graph.GetValue(Life), 60.0f);
+
+            // Respec B and C into D: A's source stays, two are removed, one added
+            FPoE2PassiveAllocation Respec;
+            Respec.Add(0);
+            Respec.Add(1);
+            Respec.Add(4);
+            const uint32 RevisionBefore = Graph.GetRevision();
+            TestTrue(TEXT("Respec accepted"), State.SetAllocation(Tree, 0, Respec, Graph));
+            TestEqual(TEXT("Three source changes"), Graph.GetRevision() - RevisionBefore, 3u);
+            TestEqual(TEXT("Life from A and D"), Graph.GetValue(Life), 50.0f);
+
+            FPoE2PassiveAllocation Disconnected;
+            Disconnected.Add(4);
+            TestFalse(TEXT("Disconnected allocations are rejected"), State.SetAllocation(Tree, 0, Disconnected, Graph));
+            TestTrue(TEXT("Rejected respec changes nothing"), State.GetAllocation() == Respec);
+        });
+
+        It("should root the allocation at the character's class start only", [this]()
+        {
+            FPoE2PassiveAllocation Allocated;
+            Allocated.Add(5);
+            TestFalse(TEXT("Another class's start is not a root"), Tree->IsConnected(Allocated, 0));
+
+            Allocated.Add(0);
+            TestFalse(TEXT("Another class's start cannot be allocated"), Tree->IsConnected(Allocated, 0));
+
+            TArray<int32> Path;
+            TestFalse(TEXT("Another class's start is not a target"), Tree->FindPath(FPoE2PassiveAllocation(), 0, 5, Path));
+            TestTrue(TEXT("C is reachable from the other start"), Tree->FindPath(FPoE2PassiveAllocation(), 5, 3, Path));
+            TestTrue(TEXT("The path starts at the other start"), Path == TArray<int32>({ 5, 3 }));
+        });
+
+        It("should reject allocations over the point budget", [this]()
+        {
+            FPoE2StatGraph Graph;
+            FPoE2PassiveTreeState State;
+            TestFalse(TEXT("C needs three points"), State.AllocatePath(Tree, 0, 3, Graph, 2));
+            TestTrue(TEXT("Nothing was allocated"), State.GetAllocation().IsEmpty());
+
+            TestTrue(TEXT("B fits in two points"), State.AllocatePath(Tree, 0, 2, Graph, 2));
+            TestEqual(TEXT("Two points spent"), State.GetSpentPoints(), 2);
+            TestFalse(TEXT("D would be a third point"), State.AllocatePath(Tree, 0, 4, Graph, 2));
+        });
+    });
+}
+
+BEGIN_DEFINE_SPEC(FPoE2Stats_SharedSkillSpecSpec, "PoE2.Stats.SharedSkillSpec",
+                  EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FPoE2Stats_SharedSkillSpecSpec)
+
+void FPoE2Stats_SharedSkillSpecSpec::Define()
+{
+    It("should hand holders one live spec that versions on stat changes", [this]()
+    {
+        UPoE2_AbilitySystemComponent* ASC = NewObject<UPoE2_AbilitySystemComponent>(GetTransientPackage());
+        USkillDataAsset* Skill = NewObject<USkillDataAsset>(GetTransientPackage());
+        Skill->SkillId = TEXT("RaiseZombie");
+        Skill->BaseDamage = 100.0f;
+        ASC->EquipSkill(Skill);
+
+        FSkillSpec Snapshot;
+        if (!TestTrue(TEXT("Skill equipped"), ASC->GetSkillSpec(Skill, Snapshot)))
+        {
+            return;
+        }
+
+        const TSharedPtr<const FPoE2SharedSkillSpec> Shared = ASC->FindSharedSkillSpec(Snapshot);
+        if (!TestTrue(TEXT("Found the live spec"), Shared.IsValid()))
+        {
+            return;
+        }
+        const uint32 Version = Shared->GetVersion();
+
+        ASC->UpdateSharedSkillSpec(*Shared);
+        TestEqual(TEXT("No change, no new version"), Shared->GetVersion(), Version);
+
+        ASC->AddStatSource({ FPoE2StatModifier(GET_MEMBER_NAME_CHECKED(FSkillSpec, FinalDamage), EPoE2StatModOp::Increased, 1.0f) });
+        ASC->UpdateSharedSkillSpec(*Shared);
+        TestNotEqual(TEXT("Stat change bumps the version"), Shared->GetVersion(), Version);
+        TestEqual(TEXT("Holders see the new damage"), Shared->Get().FinalDamage, Snapshot.FinalDamage * 2.0f, 1.e-3f);
+
+        FSkillSpec Edited = Snapshot;
+        Edited.FinalDamage += 1.0f;
+        TestFalse(TEXT("A spec that differs from the live one gets no link"), ASC->FindSharedSkillSpec(Edited).IsValid());
+    });
+}
@@ -0,0 +1,286 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+#include "Targeting/PoE2SpatialHash.h"
+#include "Targeting/PoE2TargetingSubsystem.h"
+#include "AbilitySystem/PoE2SwarmAbilitySystemComponent.h"
+#include "AbilitySystem/Actors/PoE2MinionBase.h"
+#include "Attributes/AttributeSet_Core.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/StaticMeshActor.h"
+
+BEGIN_DEFINE_SPEC(FPoE2Targeting_SpatialHashSpec, "PoE2.Targeting.SpatialHash",
+                  EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+    static TArray<int32> Query(const FPoE2SpatialHash& Hash, const FVector& Origin, float Radius)
+    {
+        TArray<int32> Found;
+        Hash.ForEachInRadius(Origin, Radius, [&Found](int32 Index) { Found.Add(Index); });
+        Found.Sort();
+        return Found;
+    }
+
+END_DEFINE_SPEC(FPoE2Targeting_SpatialHashSpec)
+
+void FPoE2Targeting_SpatialHashSpec::Define()
+{
+    Describe("Spatial hash", [this]()
+    {
+        It("should find exactly the points within the radius, across cells and negative coordinates", [this]()
+        {
+            FPoE2SpatialHash Hash(100.0f, 64);
+            const TArray<FVector> Points = {
+                FVector(0, 0, 0), FVector(90, 0, 0), FVector(-150, 40, 0), FVector(0, 260, 0), FVector(0, 0, 400)
+            };
+            Hash.Build(Points);
+
+            TestTrue(TEXT("Neighbouring cells, not too far up"), Query(Hash, FVector(10, 10, 0), 200.0f) == TArray<int32>({ 0, 1, 2 }));
+            TestTrue(TEXT("Height counts for the radius"), Query(Hash, FVector(0, 0, 300), 150.0f) == TArray<int32>({ 4 }));
+            TestTrue(TEXT("Nothing in range"), Query(Hash, FVector(5000, 5000, 0), 100.0f).Num() == 0);
+        });
+
+        It("should visit each point once whether it scans cells or falls back to every point", [this]()
+        {
+            // As many buckets as occupied cells, so some cells share a bucket
+            FPoE2SpatialHash Hash(100.0f, 16);
+            TArray<FVector> Points;
+            for (int32 Index = 0; Index < 100; ++Index)
+            {
+                Points.Add(FVector((Index % 10) * 40.0f, (Index / 10) * 40.0f, 0.0f));
+            }
+            Hash.Build(Points);
+
+            TArray<int32> All;
+            for (int32 Index = 0; Index < Points.Num(); ++Index)
+            {
+                All.Add(Index);
+            }
+            TestTrue(TEXT("Large radius finds every point once"), Query(Hash, FVector(180, 180, 0), 1000.0f) == All);
+            TestTrue(TEXT("Small radius finds its neighbours once"), Query(Hash, FVector(40, 40, 0), 45.0f) == TArray<int32>({ 1, 10, 11, 12, 21 }));
+        });
+    });
+}
+
+BEGIN_DEFINE_SPEC(FPoE2Targeting_SubsystemSpec, "PoE2.Targeting.Subsystem",
+                  EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+    UWorld* World;
+    UPoE2TargetingSubsystem* Targeting;
+    AActor* Instigator;
+
+    AActor* SpawnTarget(const FVector& Location)
+    {
+        // Untouched swarm life reads as full; the component registers its avatar itself
+        AActor* Actor = World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator);
+        UPoE2SwarmAbilitySystemComponent* ASC = NewObject<UPoE2SwarmAbilitySystemComponent>(Actor);
+        ASC->RegisterComponent();
+        ASC->InitAbilityActorInfo(Actor, Actor);
+        return Actor;
+    }
+
+    void Kill(AActor* Actor)
+    {
+        UPoE2SwarmAbilitySystemComponent* ASC = Actor->FindComponentByClass<UPoE2SwarmAbilitySystemComponent>();
+        ASC->EnsureAttributeSetFor(UAttributeSet_Core::GetHealthAttribute());
+        ASC->SetNumericAttributeBase(UAttributeSet_Core::GetHealthAttribute(), 0.0f);
+    }
+
+    void Request(const FVector& Origin, float Radius, AActor*& OutTarget, bool& bOutAnswered, TArrayView<AActor* const> Exclude = {})
+    {
+        FPoE2TargetRequest Request;
+        Request.Origin = Origin;
+        Request.Radius = Radius;
+        Request.Instigator = Instigator;
+        for (AActor* Excluded : Exclude)
+        {
+            Request.Exclude.Add(Excluded);
+        }
+        Targeting->RequestTarget(MoveTemp(Request), [&OutTarget, &bOutAnswered](AActor* Target)
+        {
+            OutTarget = Target;
+            bOutAnswered = true;
+        });
+    }
+END_DEFINE_SPEC(FPoE2Targeting_SubsystemSpec)
+
+void FPoE2Targeting_SubsystemSpec::Define()
+{
+    Describe("Targeting subsystem", [this]()
+    {
+        BeforeEach([this]()
+        {
+            // The service only runs in game worlds
+            World = UWorld::CreateWorld(EWorldType::Game, false);
+            GEngine->CreateNewWorldContext(EWorldType::Game).SetCurrentWorld(World);
+            Targeting = World->GetSubsystem<UPoE2TargetingSubsystem>();
+            Instigator = World->SpawnActor<AStaticMeshActor>(FVector::ZeroVector, FRotator::ZeroRotator);
+            TestNotNull(TEXT("Targeting subsystem"), Targeting);
+        });
+
+        It("should answer with the nearest target in the subsystem's next tick", [this]()
+        {
+            SpawnTarget(FVector(300.0f, 0.0f, 0.0f));
+            AActor* Nearest = SpawnTarget(FVector(100.0f, 0.0f, 0.0f));
+            SpawnTarget(FVector(2000.0f, 0.0f, 0.0f));
+
+            AActor* Found = nullptr;
+            bool bAnswered = false;
+            Request(FVector::ZeroVector, 1000.0f, Found, bAnswered);
+            TestFalse(TEXT("Not answered before the tick"), bAnswered);
+            TestEqual(TEXT("Request waits"), Targeting->GetNumPendingRequests(), 1);
+
+            Targeting->Tick(0.0f);
+            TestTrue(TEXT("Answered in the tick"), bAnswered);
+            TestTrue(TEXT("Nearest in range"), Found == Nearest);
+            TestEqual(TEXT("Queue drained"), Targeting->GetNumPendingRequests(), 0);
+
+            AActor* OutOfRange = Nearest;
+            bool bOutOfRangeAnswered = false;
+            Request(FVector(5000.0f, 5000.0f, 0.0f), 100.0f, OutOfRange, bOutOfRangeAnswered);
+            Targeting->Tick(0.0f);
+            TestTrue(TEXT("Answered with nothing in range"), bOutOfRangeAnswered && OutOfRange == nullptr);
+        });
+
+        It("should coalesce requests from one team in one cell into one gather", [this]()
+        {
+            SpawnTarget(FVector(100.0f, 0.0f, 0.0f));
+            SpawnTarget(FVector(200.0f, 0.0f, 0.0f));
+            SpawnTarget(FVector(300.0f, 0.0f, 0.0f));
+
+            AActor* FoundA = nullptr;
+            AActor* FoundB = nullptr;
+            bool bAnsweredA = false;
+            bool bAnsweredB = false;
+            Request(FVector(10.0f, 10.0f, 0.0f), 1000.0f, FoundA, bAnsweredA);
+            Request(FVector(50.0f, 50.0f, 0.0f), 1000.0f, FoundB, bAnsweredB);
+            Targeting->Tick(0.0f);
+
+            TestTrue(TEXT("Both answered"), bAnsweredA && bAnsweredB && FoundA && FoundA == FoundB);
+            TestEqual(TEXT("One group"), Targeting->GetNumLastBatchGroups(), 1);
+            TestEqual(TEXT("Each candidate checked once"), Targeting->GetNumLastBatchChecks(), 3);
+
+            // A far cell, and another team in the same cell, each need their own gather
+            AActor* FoundFar = nullptr;
+            AActor* FoundOther = nullptr;
+            bool bAnsweredFar = false;
+            bool bAnsweredOther = false;
+            Request(FVector(10.0f, 10.0f, 0.0f), 1000.0f, FoundA, bAnsweredA);
+            Request(FVector(5000.0f, 5000.0f, 0.0f), 100.0f, FoundFar, bAnsweredFar);
+            Instigator = World->SpawnActor<AStaticMeshActor>(FVector::ZeroVector, FRotator::ZeroRotator);
+            Request(FVector(10.0f, 10.0f, 0.0f), 1000.0f, FoundOther, bAnsweredOther);
+            Targeting->Tick(0.0f);
+
+            TestEqual(TEXT("One group per team and cell"), Targeting->GetNumLastBatchGroups(), 3);
+            TestEqual(TEXT("Nothing gathered in the far cell"), Targeting->GetNumLastBatchChecks(), 6);
+        });
+
+        It("should leave requests made from a callback for the next batch", [this]()
+        {
+            AActor* Target = SpawnTarget(FVector(100.0f, 0.0f, 0.0f));
+
+            AActor* FollowUpFound = nullptr;
+            bool bFollowUpAnswered = false;
+            bool bFirstAnswered = false;
+            FPoE2TargetRequest First;
+            First.Origin = FVector::ZeroVector;
+            First.Radius = 1000.0f;
+            First.Instigator = Instigator;
+            Targeting->RequestTarget(MoveTemp(First), [this, &bFirstAnswered, &FollowUpFound, &bFollowUpAnswered](AActor*)
+            {
+                bFirstAnswered = true;
+                Request(FVector::ZeroVector, 1000.0f, FollowUpFound, bFollowUpAnswered);
+            });
+
+            Targeting->Tick(0.0f);
+            TestTrue(TEXT("First answered"), bFirstAnswered);
+            TestFalse(TEXT("Follow-up not answered in the same batch"), bFollowUpAnswered);
+            TestEqual(TEXT("Follow-up waits"), Targeting->GetNumPendingRequests(), 1);
+
+            Targeting->Tick(0.0f);
+            TestTrue(TEXT("Follow-up answered in the next batch"), bFollowUpAnswered && FollowUpFound == Target);
+        });
+
+        It("should never return excluded targets", [this]()
+        {
+            AActor* Nearest = SpawnTarget(FVector(100.0f, 0.0f, 0.0f));
+            AActor* Next = SpawnTarget(FVector(200.0f, 0.0f, 0.0f));
+
+            AActor* Found = nullptr;
+            bool bAnswered = false;
+            Request(FVector::ZeroVector, 1000.0f, Found, bAnswered, { Nearest });
+
+            AActor* NoneLeft = Nearest;
+            bool bNoneLeftAnswered = false;
+            Request(FVector::ZeroVector, 1000.0f, NoneLeft, bNoneLeftAnswered, { Nearest, Next });
+
+            Targeting->Tick(0.0f);
+            TestTrue(TEXT("Next nearest instead"), Found == Next);
+            TestTrue(TEXT("Nothing when all are excluded"), bNoneLeftAnswered && NoneLeft == nullptr);
+        });
+
+        It("should skip the instigator, its minions, the dead and actors without life", [this]()
+        {
+            UPoE2SwarmAbilitySystemComponent* InstigatorASC = NewObject<UPoE2SwarmAbilitySystemComponent>(Instigator);
+            InstigatorASC->RegisterComponent();
+            InstigatorASC->InitAbilityActorInfo(Instigator, Instigator);
+
+            APoE2MinionBase* Minion = World->SpawnActor<APoE2MinionBase>(FVector(50.0f, 0.0f, 0.0f), FRotator::ZeroRotator);
+            UPoE2SwarmAbilitySystemComponent* MinionASC = NewObject<UPoE2SwarmAbilitySystemComponent>(Minion);
+            MinionASC->RegisterComponent();
+            MinionASC->InitAbilityActorInfo(Minion, Minion);
+            Minion->InitFromSpec(FSkillSpec(), InstigatorASC, {});
+
+            Kill(SpawnTarget(FVector(100.0f, 0.0f, 0.0f)));
+            Targeting->RegisterTarget(World->SpawnActor<AStaticMeshActor>(FVector(150.0f, 0.0f, 0.0f), FRotator::ZeroRotator));
+            AActor* Enemy = SpawnTarget(FVector(400.0f, 0.0f, 0.0f));
+
+            TestFalse(TEXT("Own minion is not hostile"), UPoE2TargetingSubsystem::IsHostileTarget(Instigator, Minion));
+            TestTrue(TEXT("Minion fights for its owner"), UPoE2TargetingSubsystem::GetTeamOwner(Minion) == Instigator);
+
+            AActor* Found = nullptr;
+            bool bAnswered = false;
+            Request(FVector::ZeroVector, 1000.0f, Found, bAnswered);
+            Targeting->Tick(0.0f);
+            TestTrue(TEXT("Only the living enemy"), Found == Enemy);
+        });
+
+        It("should find swarm avatars and drop them when the avatar changes", [this]()
+        {
+            AActor* Owner = World->SpawnActor<AStaticMeshActor>(FVector(100.0f, 0.0f, 0.0f), FRotator::ZeroRotator);
+            AActor* Avatar = World->SpawnActor<AStaticMeshActor>(FVector(200.0f, 0.0f, 0.0f), FRotator::ZeroRotator);
+            UPoE2SwarmAbilitySystemComponent* ASC = NewObject<UPoE2SwarmAbilitySystemComponent>(Owner);
+            ASC->RegisterComponent();
+            ASC->InitAbilityActorInfo(Owner, Owner);
+            TestEqual(TEXT("Registered once"), Targeting->GetNumTargets(), 1);
+
+            AActor* Found = nullptr;
+            bool bAnswered = false;
+            Request(FVector::ZeroVector, 1000.0f, Found, bAnswered);
+            Targeting->Tick(0.0f);
+            TestTrue(TEXT("Swarm avatar returned"), Found == Owner);
+
+            // The owner still carries a living ability system, so only its unregistration keeps it out of the answer
+            ASC->InitAbilityActorInfo(Owner, Avatar);
+            TestEqual(TEXT("Old avatar replaced"), Targeting->GetNumTargets(), 1);
+            bAnswered = false;
+            Request(FVector::ZeroVector, 1000.0f, Found, bAnswered);
+            Targeting->Tick(0.0f);
+            TestTrue(TEXT("Old avatar no longer returned"), bAnswered && Found == nullptr);
+        });
+
+        AfterEach([this]()
+        {
+            if (World)
+            {
+                GEngine->DestroyWorldContext(World);
+                World->DestroyWorld(false);
+            }
+            World = nullptr;
+            Targeting = nullptr;
+            Instigator = nullptr;
+        });
+    });
+}
@@ -4,6 +4,8 @@
 #include "GameFramework/Actor.h"
 #include "Spec/SkillSpec.h"
 #include "AbilitySystem/Handlers/MechanicHandler.h"
+#include "AbilitySystem/Handlers/MechanicHandlerSet.h"
+#include "Effects/PoE2DamageTypes.h"
 #include "PoE2AreaEffectBase.generated.h"
 
 class UAbilitySystemComponent;
@@ -28,6 +30,10 @@ public:
     UFUNCTION(BlueprintPure, Category = "AreaEffect|Mechanics")
     int32 GetActiveHandlerCount() const;
 
+    /** The mechanic handler instances bound to this carrier, in pipeline order. */
+    UFUNCTION(BlueprintPure, Category = "AreaEffect|Mechanics")
+    TArray<TScriptInterface<IMechanicHandler>> GetActiveHandlers() const { return ActiveHandlers.GetHandlers(); }
+
 protected:
     UFUNCTION(BlueprintCallable, Category = "AreaEffect", meta=(BlueprintProtected="true"))
     void HandleAreaPulse();
@@ -45,7 +51,11 @@ protected:
     TObjectPtr<UAbilitySystemComponent> OwnerASC;
 
     UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "AreaEffect")
-    TArray<TScriptInterface<IMechanicHandler>> ActiveHandlers;
+    FMechanicHandlerSet ActiveHandlers;
+
+    /** Outgoing damage of one hit, resolved (type and conversion) once from CurrentSpec. */
+    UPROPERTY(VisibleInstanceOnly, Category = "AreaEffect")
+    FPoE2DamageVector HitDamage;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AreaEffect")
     float DamageTickInterval;
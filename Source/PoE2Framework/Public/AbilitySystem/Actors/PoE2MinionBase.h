@@ -3,10 +3,14 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
 #include "Spec/SkillSpec.h"
+#include "Spec/SharedSkillSpec.h"
 #include "AbilitySystem/Handlers/MechanicHandler.h"
+#include "AbilitySystem/Handlers/MechanicHandlerSet.h"
+#include "Minions/PoE2MinionSignificance.h"
 #include "PoE2MinionBase.generated.h"
 
 class UAbilitySystemComponent;
+class UPoE2MinionSignificanceSubsystem;
 
 UCLASS(BlueprintType)
 class POE2FRAMEWORK_API APoE2MinionBase : public APawn
@@ -27,7 +31,39 @@ public:
     UFUNCTION(BlueprintPure, Category = "Minion|Mechanics")
     int32 GetActiveHandlerCount() const;
 
+    /** The mechanic handler instances bound to this carrier, in pipeline order. */
+    UFUNCTION(BlueprintPure, Category = "Minion|Mechanics")
+    TArray<TScriptInterface<IMechanicHandler>> GetActiveHandlers() const { return ActiveHandlers.GetHandlers(); }
+
+    /**
+     * The summoning skill's current spec. On the server this reads through the owner's shared spec, so buffs
+     * and gear changes reach existing minions; elsewhere, or for specs the owner does not hold, it is the
+     * snapshot taken at summon time.
+     */
+    const FSkillSpec& GetSpec();
+
+    UAbilitySystemComponent* GetOwnerASC() const { return OwnerASC; }
+    float GetMoveSpeed() const { return MoveSpeed; }
+    float GetCrowdRadius() const { return CrowdRadius; }
+
+    /** Called by UPoE2MinionSignificanceSubsystem when the minion changes tier */
+    virtual void ApplySignificance(EPoE2MinionTier Tier, const FPoE2MinionTierSettings& TierSettings);
+
+    UFUNCTION(BlueprintPure, Category = "Minion|Significance")
+    EPoE2MinionTier GetSignificanceTier() const { return SignificanceTier; }
+
 protected:
+    /** Called from GetSpec when the owner's shared spec has been rebuilt since the last read */
+    virtual void OnSpecUpdated() {}
+
+    /** Movement is driven by the owner's crowd (UPoE2MinionCrowdSubsystem), not by a controller */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Minion|Movement")
+    float MoveSpeed = 450.0f;
+
+    /** Radius the crowd keeps clear around this minion */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Minion|Movement")
+    float CrowdRadius = 40.0f;
+
     UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Replicated, Category = "Minion")
     FSkillSpec CurrentSpec;
 
@@ -35,5 +71,20 @@ protected:
     TObjectPtr<UAbilitySystemComponent> OwnerASC;
 
     UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Minion")
-    TArray<TScriptInterface<IMechanicHandler>> ActiveHandlers;
+    FMechanicHandlerSet ActiveHandlers;
+
+    UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Minion|Significance")
+    EPoE2MinionTier SignificanceTier = EPoE2MinionTier::High;
+
+private:
+    UPROPERTY(Transient)
+    TObjectPtr<UPoE2MinionSignificanceSubsystem> Significance;
+
+    /** The owner's live spec; null when CurrentSpec is a snapshot */
+    TSharedPtr<const FPoE2SharedSkillSpec> SharedSpec;
+    uint32 SeenSpecVersion = 0;
+
+    /** Handler OnTick runs once this much time has built up; the handlers see the whole span as one DeltaTime */
+    float HandlerTickInterval = 0.0f;
+    float PendingHandlerDeltaTime = 0.0f;
 };
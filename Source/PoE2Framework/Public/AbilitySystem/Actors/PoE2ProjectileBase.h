@@ -7,6 +7,8 @@
 #include "GameFramework/Actor.h"
 #include "Spec/SkillSpec.h"
 #include "AbilitySystem/Handlers/MechanicHandler.h"
+#include "AbilitySystem/Handlers/MechanicHandlerSet.h"
+#include "Effects/PoE2DamageTypes.h"
 #include "PoE2ProjectileBase.generated.h"
 
 class UProjectileMovementComponent;
@@ -50,10 +52,23 @@ protected:
         UFUNCTION()
         virtual void OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 
+        /**
+         * @brief Handles a Chain decision on HitActor: asks the targeting service for the nearest enemy within
+         * ChainRadius that the chain has not hit yet and flies on toward it, or is destroyed if there is none.
+         */
+        void ChainFrom(AActor* HitActor);
+
+        /** Turns the projectile toward NextTarget and restarts its movement; destroys it when NextTarget is null. */
+        void RedirectTo(AActor* NextTarget);
+
 public:
         UFUNCTION(BlueprintPure, Category = "Projectile|Mechanics")
         int32 GetActiveHandlerCount() const;
 
+        /** The mechanic handler instances bound to this projectile, in pipeline order. */
+        UFUNCTION(BlueprintPure, Category = "Projectile|Mechanics")
+        TArray<TScriptInterface<IMechanicHandler>> GetActiveHandlers() const { return ActiveHandlers.GetHandlers(); }
+
 public:
         UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement")
         TObjectPtr<UProjectileMovementComponent> MovementComponent;
@@ -68,7 +83,21 @@ public:
 
         /** Runtime mechanic handler instances bound to this projectile. */
         UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Projectile")
-        TArray<TScriptInterface<IMechanicHandler>> ActiveHandlers;
+        FMechanicHandlerSet ActiveHandlers;
+
+        /** Outgoing damage of one hit, resolved (type and conversion) once from CurrentSpec. */
+        UPROPERTY(VisibleInstanceOnly, Category = "Projectile")
+        FPoE2DamageVector HitDamage;
+
+        /** How far a Chain decision looks for the next target. */
+        UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Projectile|Mechanics", meta = (ClampMin = "0"))
+        float ChainRadius = 1000.0f;
+
+private:
+        /** Targets this projectile has chained from; never chained to again. */
+        TArray<TWeakObjectPtr<const AActor>> ChainedTargets;
+
+public:
 
 	// TODO:
 	// 1. Replication Strategy: Determine if custom replication is needed for smoother movement, especially for networked games.
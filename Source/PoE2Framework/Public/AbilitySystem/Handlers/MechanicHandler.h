@@ -17,9 +17,38 @@ enum class EHitHandlerResult : uint8
     Continue,    // Continue with normal hit processing
     Stop,        // Stop processing this hit
     Pierce,      // Pierce through the target and continue
-    Chain        // Chain to another target
+    Chain        // Chain to another target (projectiles fly on to the nearest enemy not yet hit, or end if there is none)
 };
 
+/**
+ * The phase a handler's OnHit runs in. Hits are resolved phase by phase, in this order:
+ * Filter handlers may reject the hit (any result other than Continue), Modify handlers run for their side effects
+ * on accepted hits, and the first Decide handler returning something other than Continue decides what the carrier does.
+ */
+UENUM(BlueprintType)
+enum class EMechanicHandlerPhase : uint8
+{
+    Filter,
+    Modify,
+    Decide
+};
+
+/**
+ * Bitmask of the IMechanicHandler hooks a handler class actually implements.
+ * Carriers use it to skip no-op hooks and to decide whether they need to tick at all.
+ */
+enum class EMechanicHandlerHooks : uint8
+{
+    None  = 0,
+    Cast  = 1 << 0,
+    Spawn = 1 << 1,
+    Hit   = 1 << 2,
+    Tick  = 1 << 3,
+    End   = 1 << 4,
+    All   = Cast | Spawn | Hit | Tick | End
+};
+ENUM_CLASS_FLAGS(EMechanicHandlerHooks);
+
 UINTERFACE(MinimalAPI, BlueprintType, Blueprintable)
 class UMechanicHandler : public UInterface
 {
@@ -57,4 +86,63 @@ public:
     virtual EHitHandlerResult OnHit_Implementation(AActor* OwnerActor, AActor* Target, const FHitResult& HitResult, const FSkillSpec& SkillSpec) { return EHitHandlerResult::Continue; }
     virtual void OnTick_Implementation(AActor* OwnerActor, float DeltaTime, const FSkillSpec& SkillSpec) {}
     virtual void OnEnd_Implementation(AActor* OwnerActor, const FSkillSpec& SkillSpec) {}
-};
\ No newline at end of file
+
+    /**
+     * Hooks overridden natively by this class. Defaults to All so plain IMechanicHandler implementers that
+     * don't declare their hooks keep receiving every callback. Use MechanicHandlerHooks::DeriveNative to implement;
+     * UMechanicHandlerBase subclasses may narrow it with POE2_MECHANIC_HANDLER_HOOKS().
+     */
+    virtual EMechanicHandlerHooks GetNativeHandlerHooks() const { return EMechanicHandlerHooks::All; }
+
+    /** Phase this handler's OnHit runs in. Queried once on the class default object when a spec's pipeline is compiled. */
+    virtual EMechanicHandlerPhase GetHitPhase() const { return EMechanicHandlerPhase::Decide; }
+
+    /** Ordering within a phase. Higher priorities run first; ties keep the order in which handlers were added. */
+    virtual int32 GetHandlerPriority() const { return 0; }
+};
+
+namespace MechanicHandlerHooks
+{
+    /**
+     * Derives the hooks HandlerType overrides natively, relative to NoOpBase.
+     * A hook counts as implemented when HandlerType (or any class between it and NoOpBase) redeclares its _Implementation.
+     */
+    template<typename HandlerType, typename NoOpBase = IMechanicHandler>
+    EMechanicHandlerHooks DeriveNative()
+    {
+        EMechanicHandlerHooks Hooks = EMechanicHandlerHooks::None;
+        if constexpr (!std::is_same_v<decltype(&HandlerType::OnCast_Implementation), decltype(&NoOpBase::OnCast_Implementation)>)
+        {
+            Hooks |= EMechanicHandlerHooks::Cast;
+        }
+        if constexpr (!std::is_same_v<decltype(&HandlerType::OnSpawn_Implementation), decltype(&NoOpBase::OnSpawn_Implementation)>)
+        {
+            Hooks |= EMechanicHandlerHooks::Spawn;
+        }
+        if constexpr (!std::is_same_v<decltype(&HandlerType::OnHit_Implementation), decltype(&NoOpBase::OnHit_Implementation)>)
+        {
+            Hooks |= EMechanicHandlerHooks::Hit;
+        }
+        if constexpr (!std::is_same_v<decltype(&HandlerType::OnTick_Implementation), decltype(&NoOpBase::OnTick_Implementation)>)
+        {
+            Hooks |= EMechanicHandlerHooks::Tick;
+        }
+        if constexpr (!std::is_same_v<decltype(&HandlerType::OnEnd_Implementation), decltype(&NoOpBase::OnEnd_Implementation)>)
+        {
+            Hooks |= EMechanicHandlerHooks::End;
+        }
+        return Hooks;
+    }
+
+    /**
+     * Returns the hooks implemented by a handler class, combining its native declaration with any
+     * Blueprint implementations. Computed once per class and cached. Game thread only.
+     */
+    POE2FRAMEWORK_API EMechanicHandlerHooks GetClassHooks(const UClass* HandlerClass);
+
+    /** Returns only the hooks a handler class implements in Blueprint. Shares the GetClassHooks cache. */
+    POE2FRAMEWORK_API EMechanicHandlerHooks GetClassScriptHooks(const UClass* HandlerClass);
+
+    /** Convenience overload for handler instances. */
+    POE2FRAMEWORK_API EMechanicHandlerHooks GetHooks(const UObject* Handler);
+}
\ No newline at end of file
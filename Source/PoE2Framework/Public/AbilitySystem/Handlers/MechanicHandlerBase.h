@@ -9,6 +9,19 @@
 #include "MechanicHandler.h"
 #include "MechanicHandlerBase.generated.h"
 
+/**
+ * Optional, in the class body of a native UMechanicHandlerBase subclass: narrows its hooks to the ones it overrides
+ * (derived at compile time from its _Implementation functions), so the base's no-op hooks are skipped. A native
+ * subclass without it receives every hook, as does a native subclass of it that doesn't repeat the macro.
+ */
+#define POE2_MECHANIC_HANDLER_HOOKS() \
+    virtual EMechanicHandlerHooks GetNativeHandlerHooks() const override \
+    { \
+        return IsNearestNativeClass(ThisClass::StaticClass()) \
+            ? MechanicHandlerHooks::DeriveNative<ThisClass, UMechanicHandlerBase>() | GetBaseHandlerHooks() \
+            : EMechanicHandlerHooks::All; \
+    }
+
 // Forward Declarations
 class UAbilitySystemComponent;
 class AActor;
@@ -37,7 +50,7 @@ public:
     /** Called from the skill's carrier actor during its initialization. */
     virtual void OnSpawn_Implementation(AActor* OwnerActor, const FSkillSpec& SkillSpec) override;
 
-    /** Called from the skill's carrier actor when it hits a target. */
+    /** Called from the skill's carrier actor when it hits a target. Returns Continue, so a Filter subclass accepts by default. */
     virtual EHitHandlerResult OnHit_Implementation(AActor* OwnerActor, AActor* Target, const FHitResult& HitResult, const FSkillSpec& SkillSpec) override;
 
     /** Called every frame on the skill's carrier actor. */
@@ -46,7 +59,22 @@ public:
     /** Called from the skill's carrier actor right before it is destroyed. */
     virtual void OnEnd_Implementation(AActor* OwnerActor, const FSkillSpec& SkillSpec) override;
 
+    /**
+     * The base hooks only log, so the base and its Blueprint subclasses report GetBaseHandlerHooks(); Blueprint
+     * events are detected from the class. Native subclasses get All unless they narrow it with POE2_MECHANIC_HANDLER_HOOKS().
+     */
+    virtual EMechanicHandlerHooks GetNativeHandlerHooks() const override;
+
+    virtual EMechanicHandlerPhase GetHitPhase() const override { return HitPhase; }
+    virtual int32 GetHandlerPriority() const override { return HandlerPriority; }
+
 protected:
+    /** Hooks the base itself needs: None, or All while bDebugLogging is set on the class defaults. */
+    EMechanicHandlerHooks GetBaseHandlerHooks() const;
+
+    /** Whether DeclaringClass is the closest native class of this object, i.e. no native subclass sits in between. */
+    bool IsNearestNativeClass(const UClass* DeclaringClass) const;
+
     //================================================================================
     // Helper Properties
     //================================================================================
@@ -58,4 +86,12 @@ protected:
     /** Whether this handler should log its lifecycle events for debugging. */
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Debug")
     bool bDebugLogging = false;
+
+    /** Phase this handler's OnHit runs in. Lets Blueprint subclasses declare their phase. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Pipeline")
+    EMechanicHandlerPhase HitPhase = EMechanicHandlerPhase::Decide;
+
+    /** Ordering within the phase. Higher priorities run first. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Pipeline")
+    int32 HandlerPriority = 0;
 };
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilitySystem/Handlers/MechanicHandler.h"
+
+/**
+ * A resolved mechanic handler, ready for dispatch.
+ * NativeInterface is set when the object implements IMechanicHandler in C++; ScriptHooks lists the hooks
+ * overridden in Blueprint, which must keep going through reflection.
+ */
+struct POE2FRAMEWORK_API FMechanicHandlerRef
+{
+    FMechanicHandlerRef() = default;
+    explicit FMechanicHandlerRef(UObject* InObject);
+
+    UObject* Object = nullptr;
+    IMechanicHandler* NativeInterface = nullptr;
+    EMechanicHandlerHooks Hooks = EMechanicHandlerHooks::None;
+    EMechanicHandlerHooks ScriptHooks = EMechanicHandlerHooks::None;
+
+    /** True when Hook can be called directly through the _Implementation virtual. */
+    FORCEINLINE bool IsNative(EMechanicHandlerHooks Hook) const
+    {
+        return NativeInterface && !EnumHasAnyFlags(ScriptHooks, Hook);
+    }
+
+    FORCEINLINE bool IsValid() const { return Object != nullptr; }
+};
+
+/**
+ * Hook dispatch with a native fast path.
+ * Pure C++ handlers are called through their _Implementation virtuals; Blueprint implementations
+ * keep the reflective Execute_ path (ProcessEvent).
+ */
+namespace MechanicHandlerDispatch
+{
+    FORCEINLINE void OnCast(const FMechanicHandlerRef& Handler, UAbilitySystemComponent* CasterASC, const FSkillSpec& SkillSpec)
+    {
+        if (Handler.IsNative(EMechanicHandlerHooks::Cast))
+        {
+            Handler.NativeInterface->OnCast_Implementation(CasterASC, SkillSpec);
+        }
+        else
+        {
+            IMechanicHandler::Execute_OnCast(Handler.Object, CasterASC, SkillSpec);
+        }
+    }
+
+    FORCEINLINE void OnSpawn(const FMechanicHandlerRef& Handler, AActor* OwnerActor, const FSkillSpec& SkillSpec)
+    {
+        if (Handler.IsNative(EMechanicHandlerHooks::Spawn))
+        {
+            Handler.NativeInterface->OnSpawn_Implementation(OwnerActor, SkillSpec);
+        }
+        else
+        {
+            IMechanicHandler::Execute_OnSpawn(Handler.Object, OwnerActor, SkillSpec);
+        }
+    }
+
+    FORCEINLINE EHitHandlerResult OnHit(const FMechanicHandlerRef& Handler, AActor* OwnerActor, AActor* Target, const FHitResult& HitResult, const FSkillSpec& SkillSpec)
+    {
+        if (Handler.IsNative(EMechanicHandlerHooks::Hit))
+        {
+            return Handler.NativeInterface->OnHit_Implementation(OwnerActor, Target, HitResult, SkillSpec);
+        }
+        return IMechanicHandler::Execute_OnHit(Handler.Object, OwnerActor, Target, HitResult, SkillSpec);
+    }
+
+    FORCEINLINE void OnTick(const FMechanicHandlerRef& Handler, AActor* OwnerActor, float DeltaTime, const FSkillSpec& SkillSpec)
+    {
+        if (Handler.IsNative(EMechanicHandlerHooks::Tick))
+        {
+            Handler.NativeInterface->OnTick_Implementation(OwnerActor, DeltaTime, SkillSpec);
+        }
+        else
+        {
+            IMechanicHandler::Execute_OnTick(Handler.Object, OwnerActor, DeltaTime, SkillSpec);
+        }
+    }
+
+    FORCEINLINE void OnEnd(const FMechanicHandlerRef& Handler, AActor* OwnerActor, const FSkillSpec& SkillSpec)
+    {
+        if (Handler.IsNative(EMechanicHandlerHooks::End))
+        {
+            Handler.NativeInterface->OnEnd_Implementation(OwnerActor, SkillSpec);
+        }
+        else
+        {
+            IMechanicHandler::Execute_OnEnd(Handler.Object, OwnerActor, SkillSpec);
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SubclassOf.h"
+#include "AbilitySystem/Handlers/MechanicHandler.h"
+
+/** One compiled handler slot of a FMechanicHandlerPipeline. */
+struct POE2FRAMEWORK_API FMechanicHandlerPipelineEntry
+{
+    /** Handler class. Kept alive by the owning spec's MechanicHandlers property. */
+    TSubclassOf<UObject> HandlerClass;
+
+    EMechanicHandlerPhase Phase = EMechanicHandlerPhase::Decide;
+    int32 Priority = 0;
+    EMechanicHandlerHooks Hooks = EMechanicHandlerHooks::None;
+};
+
+/**
+ * The compiled, immutable handler list of a skill spec.
+ * Built once when the spec is composed: handler classes are deduplicated (first occurrence wins) and stably
+ * sorted by hit phase, then by descending priority. The pipeline is shared by every carrier spawned from
+ * the spec; carriers only own the per-instance handler objects laid out in pipeline order.
+ */
+class POE2FRAMEWORK_API FMechanicHandlerPipeline
+{
+public:
+    /**
+     * Compiles a pipeline from an unordered handler class list. Game thread only (reads class default objects).
+     * @param HandlerClasses Handler classes in the order they were contributed (skill defaults first, then patches).
+     */
+    static TSharedRef<const FMechanicHandlerPipeline> Compile(TConstArrayView<TSubclassOf<UObject>> HandlerClasses);
+
+    const TArray<FMechanicHandlerPipelineEntry>& GetEntries() const { return Entries; }
+
+    int32 Num() const { return Entries.Num(); }
+
+    /** Index of the entry for HandlerClass, or INDEX_NONE. */
+    int32 IndexOf(const UClass* HandlerClass) const;
+
+    /** Handler classes in pipeline order. */
+    void GetHandlerClasses(TArray<TSubclassOf<UObject>>& OutHandlerClasses) const;
+
+    EMechanicHandlerHooks GetCombinedHooks() const { return CombinedHooks; }
+
+private:
+    FMechanicHandlerPipeline() = default;
+
+    TArray<FMechanicHandlerPipelineEntry> Entries;
+    EMechanicHandlerHooks CombinedHooks = EMechanicHandlerHooks::None;
+};
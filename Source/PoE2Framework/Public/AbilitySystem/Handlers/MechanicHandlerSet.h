@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ScriptInterface.h"
+#include "AbilitySystem/Handlers/MechanicHandler.h"
+#include "AbilitySystem/Handlers/MechanicHandlerDispatch.h"
+#include "MechanicHandlerSet.generated.h"
+
+class AActor;
+class FMechanicHandlerPipeline;
+struct FSkillSpec;
+
+/**
+ * The mechanic handler instances owned by one carrier actor (projectile, area or minion).
+ * Instances are laid out in the order of the spec's shared FMechanicHandlerPipeline and bucketed per hook
+ * and hit phase, so carriers only dispatch to handlers that implement a hook and only tick when one needs it.
+ * Dispatch goes through MechanicHandlerDispatch, so native handlers skip ProcessEvent.
+ */
+USTRUCT(BlueprintType)
+struct POE2FRAMEWORK_API FMechanicHandlerSet
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * Duplicates the prototypes into OwnerActor in pipeline order, fires OnSpawn on the instances that implement it and builds the hook lists.
+     * Uses the spec's frozen pipeline, or compiles one from the prototype classes if the spec has none.
+     * @param OwnerActor The carrier that will own the handler instances.
+     * @param SkillSpec The spec the carrier was initialized from.
+     * @param HandlerPrototypes Mechanic handler instances cloned from the ability.
+     */
+    void Initialize(AActor* OwnerActor, const FSkillSpec& SkillSpec, const TArray<TScriptInterface<IMechanicHandler>>& HandlerPrototypes);
+
+    /** Calls OnTick on the handlers that implement it. */
+    void DispatchTick(AActor* OwnerActor, float DeltaTime, const FSkillSpec& SkillSpec) const;
+
+    /** Calls OnEnd on the handlers that implement it and releases every instance. */
+    void DispatchEndAndReset(AActor* OwnerActor, const FSkillSpec& SkillSpec);
+
+    /**
+     * Runs the Filter phase for a hit. Stops at the first filter that does not return Continue.
+     * @return False if the hit was rejected and the carrier should ignore the target.
+     */
+    bool RunHitFilters(AActor* OwnerActor, AActor* Target, const FHitResult& HitResult, const FSkillSpec& SkillSpec) const;
+
+    /**
+     * Runs the Modify and Decide phases for an accepted hit.
+     * @return The first non-Continue result of a Decide handler, or Continue if no handler made a decision.
+     */
+    EHitHandlerResult ResolveHit(AActor* OwnerActor, AActor* Target, const FHitResult& HitResult, const FSkillSpec& SkillSpec) const;
+
+    /** True when at least one handler implements any of the given hooks. */
+    bool HasHook(EMechanicHandlerHooks Hook) const { return EnumHasAnyFlags(CombinedHooks, Hook); }
+
+    int32 Num() const { return Handlers.Num(); }
+
+    /** Every handler instance, in pipeline order. */
+    const TArray<TScriptInterface<IMechanicHandler>>& GetHandlers() const { return Handlers; }
+
+    void Reset();
+
+private:
+    /** Every handler instance owned by the carrier, in pipeline order. Keeps the instances referenced for GC. */
+    UPROPERTY(VisibleInstanceOnly, Category = "Mechanics")
+    TArray<TScriptInterface<IMechanicHandler>> Handlers;
+
+    // Per-hook and per-phase views into Handlers. Not UPROPERTYs: Handlers already keeps the objects alive.
+    TArray<FMechanicHandlerRef> FilterHitHandlers;
+    TArray<FMechanicHandlerRef> ModifyHitHandlers;
+    TArray<FMechanicHandlerRef> DecideHitHandlers;
+    TArray<FMechanicHandlerRef> TickHandlers;
+    TArray<FMechanicHandlerRef> EndHandlers;
+
+    /** The pipeline the instances were laid out from. Shared with every other carrier of the same spec. */
+    TSharedPtr<const FMechanicHandlerPipeline> Pipeline;
+
+    EMechanicHandlerHooks CombinedHooks = EMechanicHandlerHooks::None;
+};
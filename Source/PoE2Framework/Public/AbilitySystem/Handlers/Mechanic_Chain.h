@@ -11,4 +11,6 @@ class POE2FRAMEWORK_API UMechanic_Chain : public UObject, public IMechanicHandle
 
 public:
     // TODO: Implement chain mechanic
+
+    virtual EMechanicHandlerHooks GetNativeHandlerHooks() const override { return MechanicHandlerHooks::DeriveNative<UMechanic_Chain>(); }
 };
\ No newline at end of file
@@ -4,11 +4,25 @@
 #include "MechanicHandler.h"
 #include "Mechanic_DOT.generated.h"
 
+/**
+ * @class UMechanic_DOT
+ * @brief Registers a damage-over-time instance with the world's DoT ledger on every hit.
+ * The handler itself keeps no state; damage is applied by UPoE2DotSubsystem.
+ */
 UCLASS(BlueprintType)
 class POE2FRAMEWORK_API UMechanic_DOT : public UObject, public IMechanicHandler
 {
     GENERATED_BODY()
 
 public:
-    // TODO: Implement DOT mechanic
-};
\ No newline at end of file
+    static const FName DamagePerSecondKey;
+    static const FName DurationKey;
+    // > 0 means only the strongest instance from this skill deals damage on a target
+    static const FName StrongestOnlyKey;
+
+    // IMechanicHandler interface
+    virtual EHitHandlerResult OnHit_Implementation(AActor* OwnerActor, AActor* Target, const FHitResult& HitResult, const FSkillSpec& SkillSpec) override;
+    virtual EMechanicHandlerHooks GetNativeHandlerHooks() const override { return MechanicHandlerHooks::DeriveNative<UMechanic_DOT>(); }
+    // DoTs never decide the carrier's fate, so they run before pierce/chain
+    virtual EMechanicHandlerPhase GetHitPhase() const override { return EMechanicHandlerPhase::Modify; }
+};
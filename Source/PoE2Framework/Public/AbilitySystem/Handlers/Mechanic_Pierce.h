@@ -26,6 +26,7 @@ public:
 
 	// IMechanicHandler interface
 	virtual EHitHandlerResult OnHit_Implementation(AActor* OwnerActor, AActor* Target, const FHitResult& HitResult, const FSkillSpec& SkillSpec) override;
+	virtual EMechanicHandlerHooks GetNativeHandlerHooks() const override;
 
 private:
 	// Static map to track how many pierces each projectile has used
@@ -0,0 +1,21 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilitySystemGlobals.h"
+#include "PoE2AbilitySystemGlobals.generated.h"
+
+/**
+ * Project AbilitySystemGlobals. Set as AbilitySystemGlobalsClassName in DefaultGame.ini.
+ */
+UCLASS(Config = Game)
+class POE2FRAMEWORK_API UPoE2AbilitySystemGlobals : public UAbilitySystemGlobals
+{
+    GENERATED_BODY()
+
+public:
+    /** Every context carries the damage vector (FPoE2GameplayEffectContext). */
+    virtual FGameplayEffectContext* AllocGameplayEffectContext() const override;
+};
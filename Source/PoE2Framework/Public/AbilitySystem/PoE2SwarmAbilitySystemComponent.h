@@ -0,0 +1,54 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilitySystemComponent.h"
+#include "Attributes/PoE2LazyAttributeSetProvider.h"
+#include "PoE2SwarmAbilitySystemComponent.generated.h"
+
+class UAttributeSet;
+
+/**
+ * 群体实体（杂兵、召唤物）用的轻量 ASC。成百上千个实体同屏时，按实体计的内存与带宽才是大头：
+ * - GE 复制使用 Minimal 模式：只复制标签与 Cue，不复制活动 GE 本身；
+ * - 属性集懒创建：首个需要某属性集的 GE（修改或从目标捕获其属性）应用前才在服务器上创建，
+ *   从未被打过的实体没有属性集对象，也不占复制的子对象；
+ * - 默认属性集为 UAttributeSet_SwarmCore，生命值量化为一个字节复制。
+ * 直接继承 UAbilitySystemComponent：玩家 ASC 的装备技能、属性图、天赋树等状态群体实体用不上，每个实例都带着是浪费。
+ */
+UCLASS(ClassGroup = AbilitySystem, meta = (BlueprintSpawnableComponent))
+class POE2FRAMEWORK_API UPoE2SwarmAbilitySystemComponent : public UAbilitySystemComponent, public IPoE2LazyAttributeSetProvider
+{
+    GENERATED_BODY()
+
+public:
+    UPoE2SwarmAbilitySystemComponent();
+
+    //~ Begin UAbilitySystemComponent Interface
+    virtual FActiveGameplayEffectHandle ApplyGameplayEffectSpecToSelf(const FGameplayEffectSpec& GameplayEffect, FPredictionKey PredictionKey = FPredictionKey()) override;
+    /** 与玩家 ASC 相同，化身登记为目标服务的候选目标，换化身时撤销旧的 */
+    virtual void InitAbilityActorInfo(AActor* InOwnerActor, AActor* InAvatarActor) override;
+    //~ End UAbilitySystemComponent Interface
+
+    /** 确保该属性所在的懒创建属性集已存在（仅服务器）；不经过 GE 直接改属性前调用 */
+    void EnsureAttributeSetFor(const FGameplayAttribute& Attribute);
+
+    //~ Begin IPoE2LazyAttributeSetProvider Interface
+    /** 尚未创建时读属性用：返回能承载 SetClass 属性的懒创建属性集的类默认对象，没有则返回 nullptr */
+    virtual const UAttributeSet* GetLazyAttributeSetDefaults(TSubclassOf<UAttributeSet> SetClass) const override;
+    //~ End IPoE2LazyAttributeSetProvider Interface
+
+    /** 按需创建的属性集；能承载某属性的第一个类胜出，所以子类（如 UAttributeSet_SwarmCore）可代替其父类 */
+    UPROPERTY(EditDefaultsOnly, Category = "Swarm")
+    TArray<TSubclassOf<UAttributeSet>> LazyAttributeSets;
+
+protected:
+    //~ Begin UAbilitySystemComponent Interface
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    //~ End UAbilitySystemComponent Interface
+
+private:
+    TSubclassOf<UAttributeSet> FindLazyAttributeSetClass(TSubclassOf<UAttributeSet> SetClass) const;
+};
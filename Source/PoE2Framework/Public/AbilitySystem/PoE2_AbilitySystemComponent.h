@@ -4,11 +4,19 @@
 
 #include "CoreMinimal.h"
 #include "AbilitySystemComponent.h"
-#include "Data/Patch.h" // 需要包含 Patch.h
+#include "Spec/Patch.h" // 需要包含 Patch.h
+#include "Engine/StreamableManager.h"
+#include "Spec/SkillSpec.h"
+#include "Spec/SharedSkillSpec.h"
+#include "Stats/PoE2StatGraph.h"
+#include "Spec/SkillModifierIndex.h"
+#include "Data/PoE2PassiveTree.h"
 #include "PoE2_AbilitySystemComponent.generated.h"
 
 class USkillDataAsset;
 class USupportDataAsset;
+class UPassiveTreeDataAsset;
+class UPassiveSkillDataAsset;
 
 // 用一个结构体来清晰地表示一个主动技能及其链接的辅助宝石
 USTRUCT(BlueprintType)
@@ -21,6 +29,22 @@ struct FActiveSkillLink
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     TArray<TObjectPtr<USupportDataAsset>> LinkedSupports;
+
+    /** 技能的资源包已加载完毕、能力已授予 */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    bool bAssetsLoaded = false;
+
+    /** 持有资源包加载句柄，技能装备期间保持资源常驻 */
+    TSharedPtr<FStreamableHandle> LoadHandle;
+
+    /** 在属性图中的消费者，读取的属性变化时标脏 */
+    int32 StatConsumer = INDEX_NONE;
+
+    /** 缓存的最终 SkillSpec（辅助 + 物品技能修正 + 角色属性），仅在标脏后原地重建；召唤物等承载体共享引用 */
+    TSharedPtr<FPoE2SharedSkillSpec> SharedSpec;
+
+    /** 上次重建时应用辅助后的标签；物品增删时据此判断技能是否受影响，无需重建 */
+    FPoE2SkillModifierTarget ModifierTarget;
 };
 
 UCLASS()
@@ -41,9 +65,154 @@ public:
     UFUNCTION(BlueprintPure, Category="Skills")
     TArray<FPatch> GetPatchesForSkill(const USkillDataAsset* SkillToFind) const;
     
+    /**
+     * 装备技能：异步加载技能所需的资源包，加载完成后才授予能力
+     * 在加载完成之前技能无法激活
+     */
     UFUNCTION(BlueprintCallable, Category="Skills")
     void EquipSkill(USkillDataAsset* NewSkill);
 
+    /** 技能的资源包是否已加载完毕：服务器看装备记录，客户端看复制能力的加载句柄；只读缓存状态，可每帧调用 */
+    UFUNCTION(BlueprintPure, Category="Skills")
+    bool IsSkillReady(const USkillDataAsset* Skill) const;
+
+    /** 已装备技能当前的常驻内存（字节），未加载的引用不计入 */
+    UFUNCTION(BlueprintCallable, Category="Skills")
+    int64 GetSkillResidentMemory(const USkillDataAsset* Skill) const;
+
     UFUNCTION(BlueprintCallable, Category="Skills")
     void LinkSupportToSkill(USupportDataAsset* Support, USkillDataAsset* TargetSkill);
+
+    /**
+     * 已装备技能的最终 SkillSpec：辅助宝石 Patch + 物品技能修正 + 角色属性。
+     * 只有读取的属性、链接的辅助或匹配的物品修正变化后才重建，否则直接返回缓存。
+     * @return 技能未装备时返回 false
+     */
+    UFUNCTION(BlueprintCallable, Category="Skills")
+    bool GetSkillSpec(const USkillDataAsset* Skill, FSkillSpec& OutSpec);
+
+    /**
+     * 与 Spec 同源的已装备技能的共享 Spec（按 SkillId 查找，且当前内容必须与 Spec 一致）。
+     * 承载体持有它而不是拷贝，属性变化后按版本号惰性获取。找不到时返回空，调用方退回快照。
+     */
+    TSharedPtr<const FPoE2SharedSkillSpec> FindSharedSkillSpec(const FSkillSpec& Spec);
+
+    /** 共享 Spec 对应的属性已变化时原地重建并递增版本号；未变化时只是一次标脏检查 */
+    void UpdateSharedSkillSpec(const FPoE2SharedSkillSpec& Shared);
+
+    //================================================================================
+    // 角色属性（物品、天赋、Buff 等来源）
+    //================================================================================
+
+    /** 添加一个属性来源（如一件装备），返回用于移除的句柄。只影响读取这些属性的技能 */
+    UFUNCTION(BlueprintCallable, Category="Stats")
+    FPoE2StatSourceHandle AddStatSource(const TArray<FPoE2StatModifier>& Modifiers);
+
+    UFUNCTION(BlueprintCallable, Category="Stats")
+    void RemoveStatSource(UPARAM(ref) FPoE2StatSourceHandle& Source);
+
+    UFUNCTION(BlueprintPure, Category="Stats")
+    float GetStatValue(FName Stat) const;
+
+    FPoE2StatGraph& GetStatGraph() { return StatGraph; }
+    const FPoE2StatGraph& GetStatGraph() const { return StatGraph; }
+
+    //================================================================================
+    // 物品技能修正（"+1 投射物技能等级"、"20% 范围扩大" 等按技能标签筛选的 Patch）
+    //================================================================================
+
+    /**
+     * 添加一组技能修正（如一件装备的全部修正），返回用于移除的句柄。
+     * 只有标签匹配的已装备技能会被标脏重建。属性类词缀仍通过 AddStatSource 添加。
+     */
+    UFUNCTION(BlueprintCallable, Category="Stats")
+    FPoE2SkillModifierSourceHandle AddSkillModifierSource(const TArray<FPoE2SkillModifier>& Modifiers);
+
+    UFUNCTION(BlueprintCallable, Category="Stats")
+    void RemoveSkillModifierSource(UPARAM(ref) FPoE2SkillModifierSourceHandle& Source);
+
+    const FPoE2SkillModifierIndex& GetSkillModifierIndex() const { return SkillModifiers; }
+
+    //================================================================================
+    // 天赋树（加点、退点、洗点仅服务器）
+    //================================================================================
+
+    /** 本角色职业的起点节点；只有它能作为天赋树的根。更换时洗掉全部天赋 */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Passives")
+    TObjectPtr<const UPassiveSkillDataAsset> PassiveClassStart;
+
+    /** 可分配的天赋点数（不含职业起点） */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Passives")
+    int32 PassivePoints = 0;
+
+    UFUNCTION(BlueprintCallable, Category="Passives")
+    void SetPassiveClassStart(const UPassiveSkillDataAsset* ClassStart);
+
+    /** 点数减少不会自动退点，只是之后的加点按新预算校验 */
+    UFUNCTION(BlueprintCallable, Category="Passives")
+    void SetPassivePoints(int32 Points);
+
+    UFUNCTION(BlueprintPure, Category="Passives")
+    int32 GetUnspentPassivePoints() const;
+
+    /** 从职业起点沿最短路径点亮节点，路径超出剩余点数时失败；换树时先洗掉旧树。只把新增节点的属性送入属性图 */
+    UFUNCTION(BlueprintCallable, Category="Passives")
+    bool AllocatePassive(const UPassiveTreeDataAsset* Tree, const UPassiveSkillDataAsset* Node);
+
+    /** 退点；会使其他节点断开连接时失败 */
+    UFUNCTION(BlueprintCallable, Category="Passives")
+    bool DeallocatePassive(const UPassiveSkillDataAsset* Node);
+
+    UFUNCTION(BlueprintPure, Category="Passives")
+    bool IsPassiveAllocated(const UPassiveSkillDataAsset* Node) const;
+
+    UFUNCTION(BlueprintCallable, Category="Passives")
+    void ResetPassives();
+
+    /** 整体洗点（如读档）：须连通到职业起点且不超出点数；只对差异节点增删属性来源 */
+    bool SetPassiveAllocation(const UPassiveTreeDataAsset* Tree, const FPoE2PassiveAllocation& Allocation);
+
+    const FPoE2PassiveTreeState& GetPassiveTreeState() const { return PassiveTreeState; }
+
+    //~ Begin UAbilitySystemComponent Interface
+    /** 化身同时登记为目标服务的候选目标，换化身时撤销旧的 */
+    virtual void InitAbilityActorInfo(AActor* InOwnerActor, AActor* InAvatarActor) override;
+    //~ End UAbilitySystemComponent Interface
+
+protected:
+    //~ Begin UAbilitySystemComponent Interface
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+    virtual void OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+    //~ End UAbilitySystemComponent Interface
+
+    /** 本地玩家的客户端上报内容目录哈希；与服务器不一致时两端的技能/辅助索引指向不同资产，服务器踢出该玩家 */
+    UFUNCTION(Server, Reliable)
+    void ServerVerifyCatalogHash(int32 ClientCatalogHash);
+
+private:
+    /** 请求技能所需资源包，完成后回调 OnSkillAssetsLoaded */
+    TSharedPtr<FStreamableHandle> RequestSkillBundles(USkillDataAsset* Skill, FStreamableDelegate OnLoaded) const;
+
+    void OnSkillAssetsLoaded(TWeakObjectPtr<USkillDataAsset> WeakSkill);
+
+    /** 重建技能的缓存 Spec，并按其数值字段更新在属性图中的依赖 */
+    void RebuildSkillSpec(FActiveSkillLink& Link);
+
+    /** 把受该技能修正来源影响的已装备技能标脏 */
+    void MarkSkillsAffectedBy(FPoE2SkillModifierSourceHandle Source);
+
+    /** 属性来源只存在于本地：服务器与预测的自主客户端各自添加 */
+    FPoE2StatGraph StatGraph;
+
+    /** 与属性来源相同，只存在于本地 */
+    FPoE2SkillModifierIndex SkillModifiers;
+
+    FPoE2PassiveTreeState PassiveTreeState;
+
+    /** 客户端上复制过来的技能也需要加载资源包（含表现资源），否则预测激活会被拦截 */
+    TMap<TObjectKey<USkillDataAsset>, TSharedPtr<FStreamableHandle>> ReplicatedSkillLoadHandles;
+
+    /** 目录哈希每个组件只上报一次 */
+    bool bCatalogHashReported = false;
 };
@@ -3,13 +3,56 @@
 #include "CoreMinimal.h"
 #include "AttributeSet.h"
 #include "AbilitySystemComponent.h"
+#include "Attributes/AttributeSet_Core.h"
 #include "AttributeSet_Combat.generated.h"
 
+/**
+ * @class UAttributeSet_Combat
+ * @brief Defensive attributes consumed by the damage kernel. Resistances are fractions (0.75 = 75%).
+ */
 UCLASS(BlueprintType)
 class POE2FRAMEWORK_API UAttributeSet_Combat : public UAttributeSet
 {
     GENERATED_BODY()
 
 public:
-    // TODO: Define combat attributes (Damage, Critical, etc.)
-};
\ No newline at end of file
+    UAttributeSet_Combat();
+
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Attributes|Defence", ReplicatedUsing = OnRep_Armour)
+    FGameplayAttributeData Armour;
+    ATTRIBUTE_ACCESSORS(UAttributeSet_Combat, Armour)
+
+    UPROPERTY(BlueprintReadOnly, Category = "Attributes|Resistance", ReplicatedUsing = OnRep_FireResistance)
+    FGameplayAttributeData FireResistance;
+    ATTRIBUTE_ACCESSORS(UAttributeSet_Combat, FireResistance)
+
+    UPROPERTY(BlueprintReadOnly, Category = "Attributes|Resistance", ReplicatedUsing = OnRep_ColdResistance)
+    FGameplayAttributeData ColdResistance;
+    ATTRIBUTE_ACCESSORS(UAttributeSet_Combat, ColdResistance)
+
+    UPROPERTY(BlueprintReadOnly, Category = "Attributes|Resistance", ReplicatedUsing = OnRep_LightningResistance)
+    FGameplayAttributeData LightningResistance;
+    ATTRIBUTE_ACCESSORS(UAttributeSet_Combat, LightningResistance)
+
+    UPROPERTY(BlueprintReadOnly, Category = "Attributes|Resistance", ReplicatedUsing = OnRep_ChaosResistance)
+    FGameplayAttributeData ChaosResistance;
+    ATTRIBUTE_ACCESSORS(UAttributeSet_Combat, ChaosResistance)
+
+protected:
+    UFUNCTION()
+    virtual void OnRep_Armour(const FGameplayAttributeData& OldArmour);
+
+    UFUNCTION()
+    virtual void OnRep_FireResistance(const FGameplayAttributeData& OldFireResistance);
+
+    UFUNCTION()
+    virtual void OnRep_ColdResistance(const FGameplayAttributeData& OldColdResistance);
+
+    UFUNCTION()
+    virtual void OnRep_LightningResistance(const FGameplayAttributeData& OldLightningResistance);
+
+    UFUNCTION()
+    virtual void OnRep_ChaosResistance(const FGameplayAttributeData& OldChaosResistance);
+};
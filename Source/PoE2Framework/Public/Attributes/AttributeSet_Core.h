@@ -8,6 +8,12 @@
 #include "AbilitySystemComponent.h"
 #include "AttributeSet_Core.generated.h"
 
+// Set to 1 to log every replicated attribute change. Off by default: with a few hundred replicated
+// entities the OnRep logging alone shows up in client frame time.
+#ifndef POE2_LOG_ATTRIBUTE_REPNOTIFY
+#define POE2_LOG_ATTRIBUTE_REPNOTIFY 0
+#endif
+
 // Macro to define attribute accessors
 #define ATTRIBUTE_ACCESSORS(ClassName, PropertyName) \
 	GAMEPLAYATTRIBUTE_PROPERTY_GETTER(ClassName, PropertyName) \
@@ -28,6 +34,12 @@ public:
 	UAttributeSet_Core();
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/**
+	 * Reads life from any ASC. An ASC that creates its core set lazily (IPoE2LazyAttributeSetProvider) and has
+	 * not needed it yet reports the set's defaults. False if the ASC has no life at all.
+	 */
+	static bool GetLife(const UAbilitySystemComponent* ASC, float& OutLife, float& OutMaxLife);
 	
 	//~ Begin UAttributeSet Interface
 	virtual void PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue) override;
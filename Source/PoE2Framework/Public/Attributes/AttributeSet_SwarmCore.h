@@ -0,0 +1,43 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Attributes/AttributeSet_Core.h"
+#include "AttributeSet_SwarmCore.generated.h"
+
+/**
+ * @class UAttributeSet_SwarmCore
+ * @brief Core attributes for swarm entities. Health replicates as one byte, a fraction of MaxHealth, instead of
+ * a full FGameplayAttributeData with an OnRep on every change; clients only need it for health bars and
+ * death. Zero and full health survive quantization exactly, and any life left quantizes to at least one step.
+ */
+UCLASS()
+class POE2FRAMEWORK_API UAttributeSet_SwarmCore : public UAttributeSet_Core
+{
+    GENERATED_BODY()
+
+public:
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+    //~ Begin UAttributeSet Interface
+    virtual void PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) override;
+    //~ End UAttributeSet Interface
+
+    static uint8 QuantizeHealth(float Health, float MaxHealth);
+    static float DequantizeHealth(uint8 Quantized, float MaxHealth);
+
+protected:
+    virtual void OnRep_MaxHealth(const FGameplayAttributeData& OldMaxHealth) override;
+
+    UFUNCTION()
+    void OnRep_QuantizedHealth();
+
+private:
+    /** Rebuilds Health from QuantizedHealth and the current MaxHealth on a client. */
+    void ApplyQuantizedHealth();
+
+    UPROPERTY(ReplicatedUsing = OnRep_QuantizedHealth)
+    uint8 QuantizedHealth = MAX_uint8;
+};
@@ -0,0 +1,31 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "Templates/SubclassOf.h"
+#include "PoE2LazyAttributeSetProvider.generated.h"
+
+class UAttributeSet;
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UPoE2LazyAttributeSetProvider : public UInterface
+{
+    GENERATED_BODY()
+};
+
+/**
+ * Implemented by ability system components that create attribute sets only once an effect needs them.
+ * Readers that find no set on such a component read the set's defaults instead, which is what the set
+ * would hold had it been created up front.
+ */
+class POE2FRAMEWORK_API IPoE2LazyAttributeSetProvider
+{
+    GENERATED_BODY()
+
+public:
+    /** Class default object of the lazily created set that can hold SetClass's attributes, or null if there is none. */
+    virtual const UAttributeSet* GetLazyAttributeSetDefaults(TSubclassOf<UAttributeSet> SetClass) const = 0;
+};
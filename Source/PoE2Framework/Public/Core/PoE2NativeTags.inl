@@ -0,0 +1,53 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+
+// Every gameplay tag the framework declares, in one place.
+// Expanded by FPoE2Tags into a typed member and a native registration per entry:
+//   POE2_NATIVE_TAG(MemberName, "Tag.Name", "Developer comment")
+// No include guard: this file is meant to be included more than once with different definitions.
+
+// Attribute Tags
+POE2_NATIVE_TAG(Attributes_Core_Health,             "Attributes.Core.Health",           "The current health of an actor")
+POE2_NATIVE_TAG(Attributes_Core_MaxHealth,          "Attributes.Core.MaxHealth",        "The maximum health of an actor")
+
+// Ability Tags
+POE2_NATIVE_TAG(Ability,                            "Ability",                          "Root of ability classification tags")
+POE2_NATIVE_TAG(Ability_Skill,                      "Ability.Skill",                    "Base tag for all skills")
+POE2_NATIVE_TAG(Ability_Support,                    "Ability.Support",                  "Base tag for support gems")
+POE2_NATIVE_TAG(Ability_Passive,                    "Ability.Passive",                  "Base tag for passive skills")
+
+// Damage Tags
+POE2_NATIVE_TAG(Damage,                             "Damage",                           "Root of damage tags")
+POE2_NATIVE_TAG(Damage_Base,                        "Damage.Base",                      "Base damage tag for all damage types")
+POE2_NATIVE_TAG(Damage_Type,                        "Damage.Type",                      "Parent tag for all damage types")
+POE2_NATIVE_TAG(Damage_Type_Physical,               "Damage.Type.Physical",             "Physical damage type")
+POE2_NATIVE_TAG(Damage_Type_Lightning,              "Damage.Type.Lightning",            "Lightning damage type")
+POE2_NATIVE_TAG(Damage_Type_Cold,                   "Damage.Type.Cold",                 "Cold damage type")
+POE2_NATIVE_TAG(Damage_Type_Fire,                   "Damage.Type.Fire",                 "Fire damage type")
+POE2_NATIVE_TAG(Damage_Type_Chaos,                  "Damage.Type.Chaos",                "Chaos damage type")
+POE2_NATIVE_TAG(Damage_OverTime,                    "Damage.OverTime",                  "Damage over time; resistances apply, armour does not")
+
+// Effect Tags
+POE2_NATIVE_TAG(Effect_Damage,                      "Effect.Damage",                    "Base tag for damage effects")
+
+// Mechanic Tags
+POE2_NATIVE_TAG(Mechanic,                           "Mechanic",                         "Root of skill mechanic tags")
+POE2_NATIVE_TAG(Mechanic_Pierce,                    "Mechanic.Pierce",                  "Pierce mechanic")
+POE2_NATIVE_TAG(Mechanic_Chain,                     "Mechanic.Chain",                   "Chain mechanic")
+POE2_NATIVE_TAG(Mechanic_DOT,                       "Mechanic.DOT",                     "Damage over time mechanic")
+
+// Status Tags
+POE2_NATIVE_TAG(Status,                             "Status",                           "Root of status tags conditional modifiers test at hit time")
+POE2_NATIVE_TAG(Status_Bleeding,                    "Status.Bleeding",                  "Taking physical damage over time")
+POE2_NATIVE_TAG(Status_Burning,                     "Status.Burning",                   "Taking fire damage over time")
+POE2_NATIVE_TAG(Status_Chilled,                     "Status.Chilled",                   "Slowed by cold damage")
+POE2_NATIVE_TAG(Status_Shocked,                     "Status.Shocked",                   "Taking increased damage from shock")
+POE2_NATIVE_TAG(Status_Poisoned,                    "Status.Poisoned",                  "Taking chaos damage over time")
+
+// Data Tags
+POE2_NATIVE_TAG(Data_Damage,                        "Data.Damage",                      "Tag used for SetByCaller damage values")
+POE2_NATIVE_TAG(Data_HitCount,                      "Data.HitCount",                    "SetByCaller number of hits folded into one aggregated damage execution")
+
+// Cue Tags
+POE2_NATIVE_TAG(GameplayCue_Projectile_Impact,      "GameplayCue.Projectile.Impact",    "Played where a projectile hits")
@@ -0,0 +1,177 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+struct FSkillSpec;
+
+/**
+ * Fixed-width bitset over the tags FPoE2TagBitTable maps (Ability.*, Mechanic.*, Damage.*, Status.*).
+ * Holds explicit tags only; parent matching is folded into the masks FPoE2TagQuery is compiled with.
+ */
+struct POE2FRAMEWORK_API FPoE2TagBits
+{
+    static constexpr int32 NumWords = 2;
+    static constexpr int32 NumBits = NumWords * 64;
+
+    uint64 Words[NumWords] = {};
+
+    void SetBit(int32 Bit)
+    {
+        check(Bit >= 0 && Bit < NumBits);
+        Words[Bit >> 6] |= uint64(1) << (Bit & 63);
+    }
+
+    bool HasBit(int32 Bit) const
+    {
+        check(Bit >= 0 && Bit < NumBits);
+        return (Words[Bit >> 6] & (uint64(1) << (Bit & 63))) != 0;
+    }
+
+    void Append(const FPoE2TagBits& Other)
+    {
+        for (int32 Word = 0; Word < NumWords; ++Word)
+        {
+            Words[Word] |= Other.Words[Word];
+        }
+    }
+
+    void Remove(const FPoE2TagBits& Other)
+    {
+        for (int32 Word = 0; Word < NumWords; ++Word)
+        {
+            Words[Word] &= ~Other.Words[Word];
+        }
+    }
+
+    bool HasAny(const FPoE2TagBits& Other) const
+    {
+        uint64 Common = 0;
+        for (int32 Word = 0; Word < NumWords; ++Word)
+        {
+            Common |= Words[Word] & Other.Words[Word];
+        }
+        return Common != 0;
+    }
+
+    bool IsEmpty() const
+    {
+        uint64 Any = 0;
+        for (int32 Word = 0; Word < NumWords; ++Word)
+        {
+            Any |= Words[Word];
+        }
+        return Any == 0;
+    }
+
+    void Reset()
+    {
+        for (int32 Word = 0; Word < NumWords; ++Word)
+        {
+            Words[Word] = 0;
+        }
+    }
+
+    bool operator==(const FPoE2TagBits& Other) const
+    {
+        for (int32 Word = 0; Word < NumWords; ++Word)
+        {
+            if (Words[Word] != Other.Words[Word])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool operator!=(const FPoE2TagBits& Other) const { return !(*this == Other); }
+
+    friend uint32 GetTypeHash(const FPoE2TagBits& Bits)
+    {
+        uint32 Hash = 0;
+        for (int32 Word = 0; Word < NumWords; ++Word)
+        {
+            Hash = HashCombineFast(Hash, ::GetTypeHash(Bits.Words[Word]));
+        }
+        return Hash;
+    }
+};
+
+/**
+ * Assigns one bit to every registered tag under the Ability, Mechanic, Damage and Status roots, in lexical order,
+ * once native tags are done registering. The assignment is process-local and never replicated or saved.
+ *
+ * If more tags exist than FPoE2TagBits holds the table is marked incomplete and every query falls back to
+ * the tag container, so adding tags can slow compatibility checks down but never make them wrong.
+ */
+class POE2FRAMEWORK_API FPoE2TagBitTable
+{
+public:
+    static const FPoE2TagBitTable& Get() { return Table; }
+
+    /** Builds the table now if native tags are done, otherwise as soon as they are. Called at module startup. */
+    static void Initialize();
+
+    /** True when every tag under the mapped roots has a bit. */
+    bool IsComplete() const { return Generation != 0; }
+
+    /** Changes whenever bits are reassigned (editor tag edits); 0 while the table is incomplete. Bits from another generation are meaningless. */
+    uint32 GetGeneration() const { return Generation; }
+
+    int32 Num() const { return BitTags.Num(); }
+
+    /** Bit of Tag, or INDEX_NONE if the tag is outside the mapped roots or did not fit. */
+    int32 FindBit(const FGameplayTag& Tag) const;
+
+    FGameplayTag GetTag(int32 Bit) const { return BitTags.IsValidIndex(Bit) ? BitTags[Bit] : FGameplayTag(); }
+
+    /** Bits of Tag and every mapped tag below it: a spec "has" Tag when its explicit bits intersect this. */
+    const FPoE2TagBits& GetDescendantMask(int32 Bit) const { return DescendantMasks[Bit]; }
+
+    /** Explicit bits of the container's tags. Tags without a bit are skipped and clear bOutAllMapped. */
+    FPoE2TagBits FromContainer(const FGameplayTagContainer& Tags, bool* bOutAllMapped = nullptr) const;
+
+private:
+    void Rebuild();
+
+    static FPoE2TagBitTable Table;
+
+    TArray<FGameplayTag> BitTags;
+    TArray<FPoE2TagBits> DescendantMasks;
+    TMap<FGameplayTag, int32> TagToBit;
+    uint32 Generation = 0;
+};
+
+/**
+ * Required/excluded tag test of a support, compiled once into masks. Equal to
+ * Tags.HasAll(Required) && !Tags.HasAny(Excluded) on the spec's container.
+ */
+struct POE2FRAMEWORK_API FPoE2TagQuery
+{
+    static FPoE2TagQuery Compile(const FGameplayTagContainer& RequiredTags, const FGameplayTagContainer& ExcludedTags);
+
+    bool Matches(const FSkillSpec& Spec) const;
+
+    /** Same test on tags and bits kept apart from a spec, e.g. a cached skill's tags. */
+    bool Matches(const FGameplayTagContainer& Tags, const FPoE2TagBits& Bits, uint32 BitsGeneration) const;
+
+    /** True when Matches runs on bits alone for specs whose bits are current. */
+    bool IsExact() const { return Generation != 0; }
+
+private:
+    /** One mask per required tag: each must intersect the spec's bits. */
+    TArray<FPoE2TagBits, TInlineAllocator<2>> RequiredMasks;
+
+    /** Union of the excluded tags' masks: must not intersect the spec's bits. */
+    FPoE2TagBits ExcludedMask;
+
+    /** Table generation the masks were compiled against, 0 if some tag had no bit. */
+    uint32 Generation = 0;
+
+    // Fallback when a tag has no bit
+    FGameplayTagContainer Required;
+    FGameplayTagContainer Excluded;
+};
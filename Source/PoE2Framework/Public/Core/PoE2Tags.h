@@ -3,24 +3,23 @@
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
 
+/**
+ * Typed handles for every framework tag. The list lives in PoE2NativeTags.inl; each entry becomes a member
+ * here and a native registration at module startup, so code never looks a framework tag up by string.
+ */
 class POE2FRAMEWORK_API FPoE2Tags
 {
 public:
     static void InitializeNativeTags();
     static const FPoE2Tags& Get() { return GameplayTags; }
 
-    // Attribute Tags
-    FGameplayTag Attributes_Core_Health;
-    FGameplayTag Attributes_Core_MaxHealth;
+    /** Visits every native tag with its declared name, in declaration order. */
+    static void ForEachNativeTag(TFunctionRef<void(const FGameplayTag& Tag, const TCHAR* TagName)> Visitor);
 
-    // Damage Tags
-    FGameplayTag Damage_Base;
-    FGameplayTag Damage_Type_Fire; // Example for future use
-    FGameplayTag Damage_Type_Cold; // Example for future use
-
-    // Data Tags
-    FGameplayTag Data_Damage;
+#define POE2_NATIVE_TAG(Member, TagName, Comment) FGameplayTag Member;
+#include "Core/PoE2NativeTags.inl"
+#undef POE2_NATIVE_TAG
 
 private:
     static FPoE2Tags GameplayTags;
-};
\ No newline at end of file
+};
@@ -2,13 +2,76 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "GameplayTagContainer.h"
+#include "Stats/PoE2StatTypes.h"
+#include "Spec/SkillModifier.h"
 #include "AffixDataAsset.generated.h"
 
-UCLASS(BlueprintType)
+UENUM(BlueprintType)
+enum class EPoE2AffixType : uint8
+{
+    Prefix,
+    Suffix
+};
+
+/** A stat an affix grants, rolled uniformly in [Min, Max] when the item drops. */
+USTRUCT(BlueprintType)
+struct POE2FRAMEWORK_API FPoE2AffixStatRange
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Affix")
+    FName Stat;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Affix")
+    EPoE2StatModOp Op = EPoE2StatModOp::Flat;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Affix")
+    float Min = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Affix")
+    float Max = 0.0f;
+};
+
+/**
+ * One rollable item modifier (one tier). Rolling is compiled by FPoE2AffixRoller; nothing here is read per roll.
+ */
+UCLASS(BlueprintType, meta=(DisplayName="PoE2 Affix DataAsset"))
 class POE2FRAMEWORK_API UAffixDataAsset : public UPrimaryDataAsset
 {
     GENERATED_BODY()
 
 public:
-    // TODO: Define affix data properties
-};
\ No newline at end of file
+    //~ Begin UPrimaryDataAsset Interface
+    virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+    //~ End UPrimaryDataAsset Interface
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, AssetRegistrySearchable, Category = "Identity")
+    FName AffixId;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Roll")
+    EPoE2AffixType Type = EPoE2AffixType::Prefix;
+
+    /** Affixes sharing a group are mutually exclusive on one item (e.g. all tiers of "+# to maximum Life"). None: only excludes itself. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Roll")
+    FName ModGroup;
+
+    /** Lowest item level this affix can roll on. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Roll", meta=(ClampMin=0))
+    int32 RequiredItemLevel = 0;
+
+    /** Relative chance among the affixes an item can roll. 0 never rolls. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Roll", meta=(ClampMin=0))
+    int32 SpawnWeight = 1000;
+
+    /** Item bases with any of these tags can roll the affix. Empty: every base. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Roll")
+    FGameplayTagContainer SpawnTags;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+    TArray<FPoE2AffixStatRange> Stats;
+
+    /** Patches for matching skills (e.g. "+1 to level of all projectile skills"). Not rolled: every tier states its own. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+    TArray<FPoE2SkillModifier> SkillModifiers;
+};
@@ -2,13 +2,43 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "GameplayTagContainer.h"
+#include "Stats/PoE2StatTypes.h"
+#include "Spec/SkillModifier.h"
 #include "ItemBaseDataAsset.generated.h"
 
-UCLASS(BlueprintType)
+/** An item base type (e.g. "Ruby Ring"): what it always grants and which affixes it can roll. */
+UCLASS(BlueprintType, meta=(DisplayName="PoE2 Item Base DataAsset"))
 class POE2FRAMEWORK_API UItemBaseDataAsset : public UPrimaryDataAsset
 {
     GENERATED_BODY()
 
 public:
-    // TODO: Define item base data properties
-};
\ No newline at end of file
+    //~ Begin UPrimaryDataAsset Interface
+    virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+    //~ End UPrimaryDataAsset Interface
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, AssetRegistrySearchable, Category = "Identity")
+    FName BaseId;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Identity")
+    FText DisplayName;
+
+    /** Matched against UAffixDataAsset::SpawnTags. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Roll")
+    FGameplayTagContainer ItemTags;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Roll", meta=(ClampMin=0, ClampMax=6))
+    int32 MaxPrefixes = 3;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Roll", meta=(ClampMin=0, ClampMax=6))
+    int32 MaxSuffixes = 3;
+
+    /** Stats every item of this base has, before affixes. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+    TArray<FPoE2StatModifier> ImplicitModifiers;
+
+    /** Skill patches every item of this base has, before affixes. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+    TArray<FPoE2SkillModifier> ImplicitSkillModifiers;
+};
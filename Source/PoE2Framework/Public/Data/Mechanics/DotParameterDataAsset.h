@@ -0,0 +1,32 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/ParameterDataAsset.h"
+#include "DotParameterDataAsset.generated.h"
+
+/**
+ * Defines the parameters for the DOT mechanic.
+ */
+UCLASS(BlueprintType, meta=(DisplayName="Params: DOT"))
+class POE2FRAMEWORK_API UDotParameterDataAsset : public UParameterDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    /** Damage dealt per second by each DoT instance. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="DOT")
+    float DamagePerSecond = 10.0f;
+
+    /** How long each DoT instance lasts, in seconds. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="DOT")
+    float Duration = 4.0f;
+
+    /** If true, only the strongest instance of this skill on a target deals damage (ignite-style). */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="DOT")
+    bool bStrongestOnly = false;
+
+    virtual void ContributeToParameterMap(TMap<FName, float>& InOutMap) const override;
+};
@@ -23,4 +23,7 @@ public:
      * @param InOutMap The map to contribute parameters to. Keys should be unique and descriptive (e.g., "Chain.Count").
      */
     virtual void ContributeToParameterMap(TMap<FName, float>& InOutMap) const PURE_VIRTUAL(UParameterDataAsset::ContributeToParameterMap, );
+
+    /** Parameters are baked into USkillDataAsset::BakedCustomParams, so the objects themselves never ship. */
+    virtual bool IsEditorOnly() const override { return true; }
 };
\ No newline at end of file
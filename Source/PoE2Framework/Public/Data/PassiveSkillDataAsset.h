@@ -2,13 +2,35 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "Stats/PoE2StatTypes.h"
 #include "PassiveSkillDataAsset.generated.h"
 
-UCLASS(BlueprintType)
+/**
+ * One node of the passive tree: the stats it grants and the nodes it connects to.
+ * Trees are assembled by UPassiveTreeDataAsset and compiled into FPoE2PassiveTree for runtime queries.
+ */
+UCLASS(BlueprintType, meta=(DisplayName="PoE2 Passive Skill DataAsset"))
 class POE2FRAMEWORK_API UPassiveSkillDataAsset : public UPrimaryDataAsset
 {
     GENERATED_BODY()
 
 public:
-    // TODO: Define passive skill data properties
-};
\ No newline at end of file
+    //~ Begin UPrimaryDataAsset Interface
+    virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+    //~ End UPrimaryDataAsset Interface
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Identity")
+    FText DisplayName;
+
+    /** Stats granted while the node is allocated. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+    TArray<FPoE2StatModifier> StatModifiers;
+
+    /** Neighbouring nodes. Edges are undirected; listing an edge on either end is enough. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Tree")
+    TArray<TObjectPtr<UPassiveSkillDataAsset>> ConnectedNodes;
+
+    /** Class start: allocated for free and the root every other allocated node must connect back to. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Tree")
+    bool bIsStartNode = false;
+};
@@ -0,0 +1,36 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "PassiveTreeDataAsset.generated.h"
+
+class UPassiveSkillDataAsset;
+class FPoE2PassiveTree;
+
+/** The set of passive nodes that form one tree. Node order here is the dense index order of the compiled tree. */
+UCLASS(BlueprintType, meta=(DisplayName="PoE2 Passive Tree DataAsset"))
+class POE2FRAMEWORK_API UPassiveTreeDataAsset : public UPrimaryDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    //~ Begin UPrimaryDataAsset Interface
+    virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+    //~ End UPrimaryDataAsset Interface
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Tree")
+    TArray<TObjectPtr<UPassiveSkillDataAsset>> Nodes;
+
+    /** Compiled on first use and shared by every character using this tree. Null if the tree does not compile. */
+    TSharedPtr<const FPoE2PassiveTree> GetCompiledTree() const;
+
+private:
+    mutable TSharedPtr<const FPoE2PassiveTree> CompiledTree;
+};
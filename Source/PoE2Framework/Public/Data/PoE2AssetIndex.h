@@ -0,0 +1,30 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PoE2AssetIndex.generated.h"
+
+/**
+ * Dense 16-bit index of a skill or support in the registry. 0 is invalid.
+ * Cheap to hash, compare and replicate; stable for a given content build on every machine.
+ */
+USTRUCT(BlueprintType)
+struct POE2FRAMEWORK_API FPoE2AssetIndex
+{
+    GENERATED_BODY()
+
+    FPoE2AssetIndex() = default;
+    explicit FPoE2AssetIndex(uint16 InValue) : Value(InValue) {}
+
+    UPROPERTY(VisibleAnywhere, Category = "Registry")
+    uint16 Value = 0;
+
+    bool IsValid() const { return Value != 0; }
+
+    bool operator==(const FPoE2AssetIndex& Other) const { return Value == Other.Value; }
+    bool operator!=(const FPoE2AssetIndex& Other) const { return Value != Other.Value; }
+
+    friend uint32 GetTypeHash(const FPoE2AssetIndex& Index) { return Index.Value; }
+};
@@ -0,0 +1,26 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "PoE2BakeSkillDatabaseCommandlet.generated.h"
+
+/**
+ * Bakes every skill and support primary asset into the read-only database dedicated servers map at startup.
+ * Run it before cooking; the output directory is staged as loose files so it stays mappable.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd <Project> -run=PoE2BakeSkillDatabase [-Output=<path.bin>]
+ */
+UCLASS()
+class POE2FRAMEWORK_API UPoE2BakeSkillDatabaseCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UPoE2BakeSkillDatabaseCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
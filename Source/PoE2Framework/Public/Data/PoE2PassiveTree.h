@@ -0,0 +1,206 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "Stats/PoE2StatTypes.h"
+
+class UPassiveSkillDataAsset;
+class FPoE2StatGraph;
+
+/** Fixed-size set of allocated passive nodes, one bit per dense node index. */
+struct POE2FRAMEWORK_API FPoE2PassiveAllocation
+{
+    static constexpr int32 MaxNodes = 2048;
+    static constexpr int32 NumWords = MaxNodes / 64;
+
+    uint64 Words[NumWords] = {};
+
+    void Add(int32 Node)
+    {
+        check(Node >= 0 && Node < MaxNodes);
+        Words[Node >> 6] |= uint64(1) << (Node & 63);
+    }
+
+    void Remove(int32 Node)
+    {
+        check(Node >= 0 && Node < MaxNodes);
+        Words[Node >> 6] &= ~(uint64(1) << (Node & 63));
+    }
+
+    bool Contains(int32 Node) const
+    {
+        return Node >= 0 && Node < MaxNodes && (Words[Node >> 6] & (uint64(1) << (Node & 63))) != 0;
+    }
+
+    int32 Num() const
+    {
+        int32 Count = 0;
+        for (const uint64 Word : Words)
+        {
+            Count += static_cast<int32>(FPlatformMath::CountBits(Word));
+        }
+        return Count;
+    }
+
+    bool IsEmpty() const
+    {
+        uint64 Any = 0;
+        for (const uint64 Word : Words)
+        {
+            Any |= Word;
+        }
+        return Any == 0;
+    }
+
+    void Union(const FPoE2PassiveAllocation& Other)
+    {
+        for (int32 Word = 0; Word < NumWords; ++Word)
+        {
+            Words[Word] |= Other.Words[Word];
+        }
+    }
+
+    void Intersect(const FPoE2PassiveAllocation& Other)
+    {
+        for (int32 Word = 0; Word < NumWords; ++Word)
+        {
+            Words[Word] &= Other.Words[Word];
+        }
+    }
+
+    void Subtract(const FPoE2PassiveAllocation& Other)
+    {
+        for (int32 Word = 0; Word < NumWords; ++Word)
+        {
+            Words[Word] &= ~Other.Words[Word];
+        }
+    }
+
+    bool operator==(const FPoE2PassiveAllocation& Other) const
+    {
+        return FMemory::Memcmp(Words, Other.Words, sizeof(Words)) == 0;
+    }
+
+    bool operator!=(const FPoE2PassiveAllocation& Other) const { return !(*this == Other); }
+
+    /** Calls Visitor(NodeIndex) for every allocated node in ascending order. */
+    template<typename VisitorType>
+    void ForEachNode(VisitorType&& Visitor) const
+    {
+        for (int32 Word = 0; Word < NumWords; ++Word)
+        {
+            uint64 Bits = Words[Word];
+            while (Bits)
+            {
+                Visitor(Word * 64 + static_cast<int32>(FPlatformMath::CountTrailingZeros64(Bits)));
+                Bits &= Bits - 1;
+            }
+        }
+    }
+};
+
+/**
+ * Passive tree compiled for queries: nodes indexed densely in tree order, adjacency in CSR form and every
+ * node's stat modifiers in one flat array. Immutable once built and shared by every character on the tree.
+ *
+ * Set-valued queries (connectivity, reachability, respec diffs) run on FPoE2PassiveAllocation word ops;
+ * only the frontier expansion walks CSR rows.
+ */
+class POE2FRAMEWORK_API FPoE2PassiveTree
+{
+public:
+    /** Null if there are more than FPoE2PassiveAllocation::MaxNodes nodes. Null entries and unknown neighbours are skipped. */
+    static TSharedPtr<const FPoE2PassiveTree> Compile(TConstArrayView<const UPassiveSkillDataAsset*> Nodes);
+
+    int32 Num() const { return NodeAssets.Num(); }
+
+    int32 FindNode(const UPassiveSkillDataAsset* Node) const;
+    const UPassiveSkillDataAsset* GetNode(int32 Node) const { return NodeAssets.IsValidIndex(Node) ? NodeAssets[Node].Get() : nullptr; }
+
+    TConstArrayView<uint16> GetNeighbours(int32 Node) const
+    {
+        return TConstArrayView<uint16>(Adjacency.GetData() + AdjacencyOffsets[Node], AdjacencyOffsets[Node + 1] - AdjacencyOffsets[Node]);
+    }
+
+    TConstArrayView<FPoE2StatModifier> GetModifiers(int32 Node) const
+    {
+        return TConstArrayView<FPoE2StatModifier>(Modifiers.GetData() + ModifierOffsets[Node], ModifierOffsets[Node + 1] - ModifierOffsets[Node]);
+    }
+
+    const FPoE2PassiveAllocation& GetStartNodes() const { return StartNodes; }
+
+    /**
+     * StartNode (the character's class start) is allocated, no other class start is, and every allocated node
+     * reaches StartNode through allocated nodes.
+     */
+    bool IsConnected(const FPoE2PassiveAllocation& Allocated, int32 StartNode) const;
+
+    /** Whether Node can be refunded without orphaning other allocated nodes. */
+    bool CanDeallocate(const FPoE2PassiveAllocation& Allocated, int32 StartNode, int32 Node) const;
+
+    /**
+     * Fewest unallocated nodes to allocate so Target connects to the allocation, ordered from the allocation
+     * outwards and ending with Target. Paths start at StartNode when nothing is allocated and never run
+     * through another class start.
+     * @return false if Target is unreachable; OutPath is empty if Target is already allocated.
+     */
+    bool FindPath(const FPoE2PassiveAllocation& Allocated, int32 StartNode, int32 Target, TArray<int32>& OutPath) const;
+
+    /** Nodes a respec from From to To allocates and refunds. */
+    static void Diff(const FPoE2PassiveAllocation& From, const FPoE2PassiveAllocation& To, FPoE2PassiveAllocation& OutAdded, FPoE2PassiveAllocation& OutRemoved);
+
+private:
+    /** OutNeighbours = every node adjacent to a node in Frontier. */
+    void Expand(const FPoE2PassiveAllocation& Frontier, FPoE2PassiveAllocation& OutNeighbours) const;
+
+    TArray<TWeakObjectPtr<const UPassiveSkillDataAsset>> NodeAssets;
+    TMap<FObjectKey, int32> NodeIndices;
+
+    TArray<int32> AdjacencyOffsets;
+    TArray<uint16> Adjacency;
+
+    TArray<int32> ModifierOffsets;
+    TArray<FPoE2StatModifier> Modifiers;
+
+    FPoE2PassiveAllocation StartNodes;
+};
+
+/**
+ * One character's allocation on one tree, mirrored into a stat graph as one source per allocated node.
+ * A respec touches only the nodes that differ, so only their stats (and the skills reading them) go dirty.
+ */
+struct POE2FRAMEWORK_API FPoE2PassiveTreeState
+{
+    /**
+     * Switches to NewAllocation rooted at the character's class start (added implicitly). Changing trees or
+     * class start refunds everything first.
+     * @param MaxPoints Most nodes the allocation may hold besides the class start.
+     * @return false, changing nothing, if the allocation is not connected or over budget.
+     */
+    bool SetAllocation(const TSharedPtr<const FPoE2PassiveTree>& InTree, int32 InStartNode, const FPoE2PassiveAllocation& NewAllocation, FPoE2StatGraph& Graph, int32 MaxPoints = MAX_int32);
+
+    /** Allocates Node along the shortest path from the current allocation; fails if the path is over budget. */
+    bool AllocatePath(const TSharedPtr<const FPoE2PassiveTree>& InTree, int32 InStartNode, int32 Node, FPoE2StatGraph& Graph, int32 MaxPoints = MAX_int32);
+
+    /** Refunds Node if nothing else depends on it. The class start cannot be refunded. */
+    bool Deallocate(int32 Node, FPoE2StatGraph& Graph);
+
+    /** Refunds everything and forgets the tree. */
+    void Reset(FPoE2StatGraph& Graph);
+
+    const TSharedPtr<const FPoE2PassiveTree>& GetTree() const { return Tree; }
+    const FPoE2PassiveAllocation& GetAllocation() const { return Allocation; }
+    int32 GetStartNode() const { return StartNode; }
+
+    /** Allocated nodes besides the class start. */
+    int32 GetSpentPoints() const { return Allocation.IsEmpty() ? 0 : Allocation.Num() - 1; }
+
+private:
+    TSharedPtr<const FPoE2PassiveTree> Tree;
+    int32 StartNode = INDEX_NONE;
+    FPoE2PassiveAllocation Allocation;
+    TMap<int32, FPoE2StatSourceHandle> NodeSources;
+};
@@ -0,0 +1,225 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Data/PoE2SkillRegistry.h"
+#include "Spec/SkillSpecBuilder.h"
+
+class USkillDataAsset;
+class USupportDataAsset;
+class IMappedFileHandle;
+class IMappedFileRegion;
+struct FSkillSpec;
+
+/**
+ * On-disk layout of the baked skill database. Every record is plain old data with fixed-size fields,
+ * addressed by offsets from the start of the file, so the file is used in place straight from the mapping.
+ * Little-endian only; a byte-swapped magic is rejected.
+ */
+namespace PoE2SkillDatabase
+{
+    constexpr uint32 Magic = 0x42445350; // "PSDB"
+    constexpr uint32 FormatVersion = 3;
+
+    /** Index 0 of the string table is the empty string and stands for "none". */
+    constexpr uint32 NoString = 0;
+
+    struct FSection
+    {
+        uint32 Offset;
+        uint32 Count;
+    };
+
+    struct FRange
+    {
+        uint32 First;
+        uint32 Num;
+    };
+
+    struct FHeader
+    {
+        uint32 Magic;
+        uint32 FormatVersion;
+        uint32 NumericFieldCount;
+        uint32 CatalogHash;
+        uint32 TotalSize;
+        uint32 Padding;
+
+        /** uint32 offsets into StringData, one per string. */
+        FSection Strings;
+
+        /** Null-terminated UTF-8; Count is the size in bytes. */
+        FSection StringData;
+
+        FSection Skills;
+        FSection Supports;
+        FSection Ops;
+
+        /** uint32 string indices referenced by tag and class ranges. */
+        FSection Refs;
+
+        FSection Params;
+    };
+
+    struct FSkillRecord
+    {
+        uint32 Key;
+        uint32 AssetName;
+
+        /** Indexed by ESkillSpecNumericField. */
+        float Numerics[SkillSpecNumericField::Num];
+        int32 SummonCount;
+
+        uint32 AbilityClass;
+        uint32 DamageEffectClass;
+        uint32 ProjectileClass;
+        uint32 SummonClass;
+        uint32 Padding;
+
+        FRange Tags;
+        FRange Effects;
+        FRange Handlers;
+        FRange Params;
+    };
+
+    struct FSupportRecord
+    {
+        uint32 Key;
+        uint32 AssetName;
+
+        FRange Additive;
+        FRange Multiplicative;
+
+        FRange TagsToAdd;
+        FRange TagsToRemove;
+        FRange RequiredSkillTags;
+        FRange ExcludedSkillTags;
+        FRange Effects;
+        FRange Handlers;
+
+        uint32 ProjectileClassOverride;
+        uint32 Padding;
+    };
+
+    struct FOpRecord
+    {
+        uint8 Field;
+        uint8 Padding[3];
+        float Value;
+    };
+
+    struct FParamRecord
+    {
+        uint32 Key;
+        float Value;
+    };
+
+    static_assert(sizeof(FHeader) == 80, "Baked header layout changed, bump FormatVersion");
+    static_assert(sizeof(FSkillRecord) == 96, "Baked skill layout changed, bump FormatVersion");
+    static_assert(sizeof(FSupportRecord) == 80, "Baked support layout changed, bump FormatVersion");
+    static_assert(sizeof(FOpRecord) == 8 && sizeof(FParamRecord) == 8, "Baked record layout changed, bump FormatVersion");
+}
+
+/**
+ * Read-only, memory-mapped table of every skill's base numbers, tags and class references and every
+ * support's compiled patch. Written offline by UPoE2BakeSkillDatabaseCommandlet; dedicated servers open it
+ * instead of loading the DataAssets. The mapping is shared through the OS page cache by every server
+ * process on the host.
+ *
+ * Indices match UPoE2SkillRegistry: both sort the same keys the same way.
+ */
+class POE2FRAMEWORK_API FPoE2SkillDatabase
+{
+public:
+    FPoE2SkillDatabase();
+    ~FPoE2SkillDatabase();
+
+    FPoE2SkillDatabase(const FPoE2SkillDatabase&) = delete;
+    FPoE2SkillDatabase& operator=(const FPoE2SkillDatabase&) = delete;
+
+    /** Where the bake commandlet writes and servers look. Staged as a loose file so it can be mapped. */
+    static FString GetDefaultPath();
+
+    /** Serializes the given assets into the baked format. Asset order does not matter. */
+    static void Bake(TConstArrayView<const USkillDataAsset*> Skills, TConstArrayView<const USupportDataAsset*> Supports, TArray64<uint8>& OutBytes);
+
+    /** Maps the file read-only. Falls back to reading it into memory where mapping is unsupported. */
+    bool Open(const FString& Path);
+
+    /** Takes ownership of an in-memory image (tests, platforms without mapped files). */
+    bool OpenFromMemory(TArray64<uint8>&& Bytes);
+
+    void Close();
+
+    bool IsOpen() const { return Header != nullptr; }
+    bool IsMapped() const { return MappedRegion.IsValid(); }
+
+    /** Size of the image; with a mapping this is shared, not per-process, memory. */
+    int64 GetImageSize() const { return Header ? Header->TotalSize : 0; }
+
+    const FPoE2AssetCatalog& GetSkillCatalog() const { return SkillCatalog; }
+    const FPoE2AssetCatalog& GetSupportCatalog() const { return SupportCatalog; }
+
+    /** Base spec of a skill, equal to USkillDataAsset::CreateBaseSkillSpec. Class references resolve only if loaded. */
+    bool BuildBaseSpec(FPoE2AssetIndex Skill, FSkillSpec& OutSpec) const;
+
+    /**
+     * Applies a support's baked patch: its numeric and tag edits, as FSkillSpecBuilder::ApplyPatch would.
+     * Conditional (per-hit) modifiers are not baked and are dropped, so callers that need them must build from
+     * the support asset.
+     */
+    bool ApplySupport(FPoE2AssetIndex Support, FSkillSpec& Spec) const;
+
+    /** Equal to USupportDataAsset::IsCompatibleWith. */
+    bool IsSupportCompatible(FPoE2AssetIndex Support, const FGameplayTagContainer& SkillTags) const;
+
+    /** Base spec plus supports in order. Does not freeze the handler pipeline. */
+    bool BuildSpec(FPoE2AssetIndex Skill, TConstArrayView<FPoE2AssetIndex> Supports, FSkillSpec& OutSpec) const;
+
+private:
+    bool Attach(const uint8* Data, int64 Size);
+
+    const PoE2SkillDatabase::FSkillRecord* GetSkillRecord(FPoE2AssetIndex Index) const;
+    const PoE2SkillDatabase::FSupportRecord* GetSupportRecord(FPoE2AssetIndex Index) const;
+
+    template<typename RecordType>
+    const RecordType* GetSection(const PoE2SkillDatabase::FSection& Section) const
+    {
+        return reinterpret_cast<const RecordType*>(Base + Section.Offset);
+    }
+
+    void AppendTags(const PoE2SkillDatabase::FRange& Range, FGameplayTagContainer& OutTags) const;
+    void RemoveTags(const PoE2SkillDatabase::FRange& Range, FGameplayTagContainer& OutTags) const;
+    UClass* ResolveClass(uint32 StringIndex) const;
+
+    template<typename ClassType>
+    void AppendClasses(const PoE2SkillDatabase::FRange& Range, TArray<TSubclassOf<ClassType>>& OutClasses) const
+    {
+        const uint32* Refs = GetSection<uint32>(Header->Refs);
+        for (uint32 Index = Range.First; Index < Range.First + Range.Num; ++Index)
+        {
+            if (UClass* Class = ResolveClass(Refs[Index]))
+            {
+                OutClasses.Add(Class);
+            }
+        }
+    }
+
+    TUniquePtr<IMappedFileHandle> MappedFile;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+    TArray64<uint8> OwnedBytes;
+
+    const uint8* Base = nullptr;
+    const PoE2SkillDatabase::FHeader* Header = nullptr;
+
+    // Per-string lookups resolved once at open
+    TArray<FName> Names;
+    TArray<FGameplayTag> Tags;
+    TArray<FSoftObjectPath> ClassPaths;
+
+    FPoE2AssetCatalog SkillCatalog;
+    FPoE2AssetCatalog SupportCatalog;
+};
@@ -0,0 +1,123 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "UObject/PrimaryAssetId.h"
+#include "Data/PoE2AssetIndex.h"
+#include "PoE2SkillRegistry.generated.h"
+
+class USkillDataAsset;
+class USupportDataAsset;
+class FPoE2SkillDatabase;
+
+/**
+ * One id space (skills or supports): entries sorted by key so every process that scans the same
+ * content assigns the same indices. Lookups are a hash probe one way and an array index the other.
+ */
+struct POE2FRAMEWORK_API FPoE2AssetCatalog
+{
+    struct FEntry
+    {
+        FPrimaryAssetId AssetId;
+
+        /** Gameplay id (SkillId / SupportId); falls back to the asset name when unset. */
+        FName Key;
+    };
+
+    static constexpr int32 MaxEntries = MAX_uint16;
+
+    /** Replaces the catalog. Input order does not matter. */
+    void Build(TArray<FEntry> InEntries);
+
+    void Reset();
+
+    FPoE2AssetIndex FindByKey(FName Key) const;
+    FPoE2AssetIndex FindByAssetId(const FPrimaryAssetId& AssetId) const;
+
+    /** nullptr for the invalid or an out-of-range index. */
+    const FEntry* Get(FPoE2AssetIndex Index) const;
+
+    int32 Num() const { return FMath::Max(0, Entries.Num() - 1); }
+
+    /** CRC of the sorted keys and their asset ids. Equal hashes mean equal index assignments. */
+    uint32 GetHash() const { return Hash; }
+
+private:
+    // Slot 0 is a placeholder so an index addresses the array directly
+    TArray<FEntry> Entries;
+    TMap<FName, uint16> KeyToIndex;
+    TMap<FPrimaryAssetId, uint16> AssetIdToIndex;
+    uint32 Hash = 0;
+};
+
+/**
+ * Assigns dense indices to every skill and support primary asset once the Asset Manager finishes its
+ * initial scan. Reads ids from asset registry tags, so no asset is loaded to build it.
+ *
+ * Dedicated servers open the baked skill database instead (see FPoE2SkillDatabase) and take the
+ * catalogs from it; -NoBakedSkillDatabase opts out, -BakedSkillDatabase opts in elsewhere. Once the initial
+ * scan completes the bake is checked against the scanned assets, and a bake that does not match is dropped
+ * in favour of the scan.
+ */
+UCLASS()
+class POE2FRAMEWORK_API UPoE2SkillRegistry : public UEngineSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UPoE2SkillRegistry* Get();
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    /** Rescans the Asset Manager. Called automatically after the initial scan. Drops a baked database the scan disagrees with. */
+    void Rebuild();
+
+    UFUNCTION(BlueprintPure, Category = "PoE2|Registry")
+    FPoE2AssetIndex GetSkillIndex(const USkillDataAsset* Skill) const;
+
+    UFUNCTION(BlueprintPure, Category = "PoE2|Registry")
+    FPoE2AssetIndex GetSkillIndexById(FName SkillId) const { return Skills.FindByKey(SkillId); }
+
+    UFUNCTION(BlueprintPure, Category = "PoE2|Registry")
+    FName GetSkillId(FPoE2AssetIndex Index) const;
+
+    /** The skill asset if it is loaded, nullptr otherwise. */
+    UFUNCTION(BlueprintPure, Category = "PoE2|Registry")
+    USkillDataAsset* GetSkill(FPoE2AssetIndex Index) const;
+
+    UFUNCTION(BlueprintPure, Category = "PoE2|Registry")
+    FPoE2AssetIndex GetSupportIndex(const USupportDataAsset* Support) const;
+
+    /** The support asset if it is loaded, nullptr otherwise. */
+    UFUNCTION(BlueprintPure, Category = "PoE2|Registry")
+    USupportDataAsset* GetSupport(FPoE2AssetIndex Index) const;
+
+    const FPoE2AssetCatalog& GetSkillCatalog() const { return Skills; }
+    const FPoE2AssetCatalog& GetSupportCatalog() const { return Supports; }
+
+    /** The mapped baked database, or nullptr when the catalogs come from the Asset Manager. */
+    const FPoE2SkillDatabase* GetBakedDatabase() const { return BakedDatabase.Get(); }
+
+    /**
+     * Combined hash of both catalogs. Clients report it when their ASC initializes and the server kicks a client
+     * whose hash differs (UPoE2_AbilitySystemComponent::ServerVerifyCatalogHash).
+     */
+    UFUNCTION(BlueprintPure, Category = "PoE2|Registry")
+    int32 GetCatalogHash() const;
+
+private:
+    static void GatherEntries(FPrimaryAssetType AssetType, FName KeyTag, TArray<FPoE2AssetCatalog::FEntry>& OutEntries);
+
+    static bool ShouldUseBakedDatabase();
+
+    bool OpenBakedDatabase();
+
+    FPoE2AssetCatalog Skills;
+    FPoE2AssetCatalog Supports;
+
+    TSharedPtr<FPoE2SkillDatabase> BakedDatabase;
+};
@@ -6,6 +6,7 @@
 #include "Engine/DataAsset.h"
 #include "GameplayTagContainer.h"
 #include "Data/ParameterDataAsset.h"
+#include "Spec/SkillSpec.h"
 #include "SkillDataAsset.generated.h"
 
 // Forward Declarations
@@ -15,13 +16,15 @@ class UAnimMontage;
 class UMechanicHandler;
 class APoE2ProjectileBase;
 class APoE2MinionBase;
-struct FSkillSpec;
 
 /**
  * Defines a single skill in a data-driven way.
  * This asset contains all the base stats, effects, cues, and logic for a skill
  * before any modifications from support gems, items, or talents are applied.
  * It serves as the source data to create a FSkillSpec.
+ *
+ * Classes and montages are soft references grouped into Asset Manager bundles, so loading the
+ * skill catalogue only loads numbers and tags. Bundles are streamed in when a skill is equipped.
  */
 UCLASS(BlueprintType, meta=(DisplayName="PoE2 Skill DataAsset"))
 class POE2FRAMEWORK_API USkillDataAsset : public UPrimaryDataAsset
@@ -39,13 +42,46 @@ public:
     virtual FPrimaryAssetId GetPrimaryAssetId() const override;
     //~ End UPrimaryDataAsset Interface
 
+    /** Asset Manager bundle with everything needed to execute the skill (ability, effects, carriers, handlers). */
+    static const FName GameplayBundle;
+
+    /** Asset Manager bundle with presentation-only assets. Never loaded on dedicated servers. */
+    static const FName CosmeticBundle;
+
+    /** The bundles this process must load before the skill can be activated. */
+    static TArray<FName> GetRequiredBundles();
+
+    /** Collects the non-null soft references tagged with any of the given bundles. */
+    void GatherBundleReferences(TConstArrayView<FName> Bundles, TArray<FSoftObjectPath>& OutPaths) const;
+
+    /** True when every soft reference in the given bundles is resident. */
+    bool AreBundlesLoaded(TConstArrayView<FName> Bundles) const;
+
+    /**
+     * Resident memory of this asset plus every currently loaded object its bundles reference.
+     * Unloaded references contribute nothing, so this reflects what the skill actually costs right now.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Skill|Loading")
+    int64 GetResidentMemoryBytes() const;
+
     /**
      * Creates a base FSkillSpec snapshot from this DataAsset.
      * This represents the initial state of a skill before any patches are applied.
+     * The spec's SkillTags are SkillTags plus DamageType.
      * @return A FSkillSpec struct populated with the base data from this asset.
      */
     virtual FSkillSpec CreateBaseSkillSpec() const;
 
+    virtual void PostLoad() override;
+
+#if WITH_EDITOR
+    virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
+    /** Flattens CustomMechanicParameters into BakedCustomParams, sorted by key. */
+    void BakeCustomParams();
+#endif
+
 public:
     //================================================================================
     // Fields
@@ -54,8 +90,8 @@ public:
     // Category: Identity & Classification
     //--------------------------------------------------------------------------------
     
-    /** The unique identifier for this skill. Should be unique across all skills. */
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Identity")
+    /** The unique identifier for this skill. Should be unique across all skills. Searchable so the skill registry can index without loading. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, AssetRegistrySearchable, Category = "Identity")
     FName SkillId;
 
     /** The name of the skill displayed in the UI. */
@@ -70,17 +106,21 @@ public:
     //--------------------------------------------------------------------------------
 
     /** The Gameplay Ability class that executes the skill's logic. Should be a subclass of GA_SkillBase. */
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Logic")
-    TSubclassOf<UGameplayAbility> AbilityClass;
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Logic", meta = (AssetBundles = "Gameplay"))
+    TSoftClassPtr<UGameplayAbility> AbilityClass;
     
     /** The animation montage to play when casting this skill. */
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Logic")
-    TObjectPtr<UAnimMontage> CastMontage;
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Logic", meta = (AssetBundles = "Cosmetic"))
+    TSoftObjectPtr<UAnimMontage> CastMontage;
     
     // Category: Base Numerical Stats
     //--------------------------------------------------------------------------------
 
-    /** The Gameplay Tag defining the type of damage (e.g., Damage.Type.Fire). */
+    /**
+     * The Gameplay Tag defining the type of damage (e.g., Damage.Type.Fire).
+     * CreateBaseSkillSpec also adds it to the spec's SkillTags: the damage kernel reads the type from there,
+     * and supports can require or exclude it like any other skill tag.
+     */
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats", meta = (Categories = "Damage"))
     FGameplayTag DamageType;
 
@@ -89,8 +129,8 @@ public:
     float BaseDamage = 0.f;
 
     /** The Gameplay Effect class to use for applying damage. This should use an ExecutionCalculation like Exec_Damage. */
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
-    TSubclassOf<UGameplayEffect> DamageEffectClass;
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats", meta = (AssetBundles = "Gameplay"))
+    TSoftClassPtr<UGameplayEffect> DamageEffectClass;
 
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
     float Cooldown = 0.f;
@@ -120,12 +160,12 @@ public:
     //--------------------------------------------------------------------------------
 
     /** The projectile actor to spawn, if this is a projectile skill. */
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Actors")
-    TSubclassOf<APoE2ProjectileBase> ProjectileClass;
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Actors", meta = (AssetBundles = "Gameplay"))
+    TSoftClassPtr<APoE2ProjectileBase> ProjectileClass;
     
     /** The minion actor to spawn, if this is a summoning skill. */
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Actors")
-    TSubclassOf<APoE2MinionBase> SummonClass;
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Actors", meta = (AssetBundles = "Gameplay"))
+    TSoftClassPtr<APoE2MinionBase> SummonClass;
     
     /** The base number of minions to summon. */
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Actors")
@@ -153,17 +193,24 @@ public:
     //--------------------------------------------------------------------------------
 
     /** List of Gameplay Effects to apply on hit by default. */
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Defaults")
-    TArray<TSubclassOf<UGameplayEffect>> DefaultEffects;
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Defaults", meta = (AssetBundles = "Gameplay"))
+    TArray<TSoftClassPtr<UGameplayEffect>> DefaultEffects;
 
     /** List of default mechanic handlers for this skill (e.g., Pierce, Chain). */
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Defaults", meta=(MustImplement="/Script/PoE2Framework.MechanicHandler"))
-    TArray<TSubclassOf<UObject>> DefaultHandlers;
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Defaults", meta=(MustImplement="/Script/PoE2Framework.MechanicHandler", AssetBundles = "Gameplay"))
+    TArray<TSoftClassPtr<UObject>> DefaultHandlers;
 
+#if WITH_EDITORONLY_DATA
     /**
      * A list of data assets that define custom parameters for the skill's mechanics.
      * This provides a structured, UI-friendly way to configure complex mechanics.
+     * Editor only: the values are baked into BakedCustomParams and the objects are stripped on cook.
      */
-    UPROPERTY(EditDefaultsOnly, Instanced, BlueprintReadOnly, Category = "Defaults", meta=(DisplayName="Custom Mechanic Parameters"))
+    UPROPERTY(EditDefaultsOnly, Instanced, Category = "Defaults", meta=(DisplayName="Custom Mechanic Parameters"))
     TArray<TObjectPtr<UParameterDataAsset>> CustomMechanicParameters;
+#endif
+
+    /** CustomMechanicParameters flattened and sorted by key. Rebuilt in the editor on load, edit and save; copied as-is into every base spec. */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Defaults", AdvancedDisplay)
+    TArray<FCustomParam> BakedCustomParams;
 };
\ No newline at end of file
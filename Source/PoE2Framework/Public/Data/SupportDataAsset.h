@@ -5,8 +5,11 @@
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
 #include "Spec/Patch.h"
+#include "Core/PoE2TagBits.h"
 #include "SupportDataAsset.generated.h"
 
+struct FSkillSpec;
+
 /**
  * Defines a Support Gem in a data-driven way.
  * A support gem's primary purpose is to provide an FPatch that modifies a base skill.
@@ -35,8 +38,8 @@ public:
     // Category: Identity
     //--------------------------------------------------------------------------------
 
-    /** The unique identifier for this support gem. */
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Identity")
+    /** The unique identifier for this support gem. Searchable so the skill registry can index without loading. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, AssetRegistrySearchable, Category = "Identity")
     FName SupportId;
 
     /** The name of the support gem displayed in the UI. */
@@ -50,6 +53,31 @@ public:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Patch")
     FPatch SkillPatch;
 
+    // Category: Compatibility
+    //--------------------------------------------------------------------------------
+
+    /** The supported skill must have all of these tags (e.g. Skill.Projectile). */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Compatibility")
+    FGameplayTagContainer RequiredSkillTags;
+
+    /** The support cannot be linked to a skill with any of these tags. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Compatibility")
+    FGameplayTagContainer ExcludedSkillTags;
+
+    /** Whether this support can modify a skill with the given tags. */
+    UFUNCTION(BlueprintPure, Category = "Compatibility")
+    bool IsCompatibleWith(const FGameplayTagContainer& SkillTags) const;
+
+    /**
+     * The link rule: tests the spec of the skill with the supports linked before this one already folded in,
+     * so the skill's DamageType and tags added by earlier supports count. Used by LinkSupportToSkill, the
+     * support search and the build simulator alike.
+     */
+    bool CanSupport(const FSkillSpec& Spec) const;
+
+    /** CanSupport compiled to tag bits, for testing many specs against this support. */
+    FPoE2TagQuery CompileCompatibilityQuery() const;
+
     //================================================================================
     // TODO for Claude
     //================================================================================
@@ -10,7 +10,8 @@
 /**
  * @class UExec_Damage
  * @brief A GameplayEffectExecutionCalculation for applying damage.
- * This class calculates the final damage amount based on various factors and applies it to the target's Health attribute.
+ * Reads the per-type damage vector from FPoE2GameplayEffectContext (or Data.Damage as a fallback), mitigates it
+ * against the target's UAttributeSet_Combat through PoE2DamageKernel and applies the total to Health.
  */
 UCLASS()
 class POE2FRAMEWORK_API UExec_Damage : public UGameplayEffectExecutionCalculation
@@ -24,6 +25,5 @@ public:
 
 	// TODO:
 	// 1. Critical Strike Calculation: Implement logic to determine if the damage is a critical strike and apply a damage multiplier accordingly.
-	// 2. Resistance and Mitigation: Factor in target's resistances (e.g., armor, elemental resistances) to reduce the incoming damage.
-	// 3. Damage Conversion: Handle cases where damage type gets converted (e.g., Physical to Fire).
+	// Resistances, armour and conversion are handled by PoE2DamageKernel.
 };
\ No newline at end of file
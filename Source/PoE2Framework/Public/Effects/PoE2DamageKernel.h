@@ -0,0 +1,74 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Effects/PoE2DamageTypes.h"
+
+struct FSkillSpec;
+struct FPoE2HitConditionContext;
+class FPoE2HitConditionProgram;
+
+/**
+ * Conversion and "gained as extra" tables, indexed [From][To] as fractions (0.5 = 50%).
+ * Only entries with From < To (see EPoE2DamageType) have an effect.
+ */
+struct POE2FRAMEWORK_API FPoE2DamageConversion
+{
+    float Convert[PoE2DamageType::Num][PoE2DamageType::Num] = {};
+    float GainAsExtra[PoE2DamageType::Num][PoE2DamageType::Num] = {};
+
+    bool bIsIdentity = true;
+
+    /**
+     * Reads "Damage.Conversion.<From>To<To>" and "Damage.GainAsExtra.<From>To<To>" custom params
+     * (e.g. Damage.Conversion.PhysicalToFire = 0.5).
+     */
+    static FPoE2DamageConversion FromSkillSpec(const FSkillSpec& Spec);
+};
+
+/** Target-side defences consumed by the kernel. Resistances are fractions (0.75 = 75%). */
+struct POE2FRAMEWORK_API FPoE2DefenceProfile
+{
+    float Armour = 0.0f;
+    float Resistances[PoE2DamageType::Num] = {};
+};
+
+/**
+ * Damage resolution kernel shared by UExec_Damage and batch callers (simulation, DoT previews).
+ * All stages are fixed-trip loops over the damage lanes with no allocation or lookups.
+ */
+namespace PoE2DamageKernel
+{
+    /** Hard cap applied to any resistance, and to the armour reduction of a single hit. */
+    constexpr float MaxResistance = 0.9f;
+    constexpr float MaxArmourReduction = 0.9f;
+
+    /** Applies conversion and gained-as-extra in one forward pass over the damage types. */
+    POE2FRAMEWORK_API FPoE2DamageVector ApplyConversion(const FPoE2DamageVector& Damage, const FPoE2DamageConversion& Conversion);
+
+    /** Fraction of a physical hit prevented by armour: A / (A + 10 * D), capped. */
+    POE2FRAMEWORK_API float ArmourDamageReduction(float Armour, float PhysicalDamage);
+
+    /** Applies armour to the physical lane, then resistances to every lane. */
+    POE2FRAMEWORK_API FPoE2DamageVector Mitigate(const FPoE2DamageVector& Damage, const FPoE2DefenceProfile& Defence);
+
+    /**
+     * Mitigates each hit on its own against one defence snapshot and sums the results.
+     * Armour depends on the size of the hit, so mitigating the summed hits would let armour do too little.
+     */
+    POE2FRAMEWORK_API FPoE2DamageVector MitigateHits(TConstArrayView<FPoE2DamageVector> Hits, const FPoE2DefenceProfile& Defence);
+
+    /** Builds the outgoing (pre-mitigation) damage of one hit of the skill: FinalDamage of the skill's damage type, converted. */
+    POE2FRAMEWORK_API FPoE2DamageVector MakeHitDamage(const FSkillSpec& Spec);
+
+    /** Scales a hit by the skill's conditional modifiers that hold for this attacker and target. */
+    POE2FRAMEWORK_API FPoE2DamageVector ApplyHitConditions(const FPoE2DamageVector& Damage, const FPoE2HitConditionProgram& Conditions, const FPoE2HitConditionContext& Context);
+
+    /**
+     * Resolves many hits at once: Out[i] = Mitigate(ApplyConversion(In[i], Conversion), Defences[i]).
+     * Defences may hold a single entry, which is then used for every hit.
+     */
+    POE2FRAMEWORK_API void ResolveBatch(TConstArrayView<FPoE2DamageVector> In, const FPoE2DamageConversion& Conversion, TConstArrayView<FPoE2DefenceProfile> Defences, TArrayView<FPoE2DamageVector> Out);
+}
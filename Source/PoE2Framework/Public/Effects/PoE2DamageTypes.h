@@ -0,0 +1,106 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "PoE2DamageTypes.generated.h"
+
+/**
+ * Damage types, in conversion order: damage can only be converted to a type that comes later in this list
+ * (physical -> lightning -> cold -> fire -> chaos), which lets conversion run as a single forward pass.
+ */
+UENUM(BlueprintType)
+enum class EPoE2DamageType : uint8
+{
+    Physical,
+    Lightning,
+    Cold,
+    Fire,
+    Chaos,
+    Count UMETA(Hidden)
+};
+
+namespace PoE2DamageType
+{
+    constexpr int32 Num = static_cast<int32>(EPoE2DamageType::Count);
+
+    /** Maps a Damage.Type.* tag to its damage type. Untyped or unknown tags are physical. */
+    POE2FRAMEWORK_API EPoE2DamageType FromTag(const FGameplayTag& Tag);
+
+    /** The Damage.Type.* tag for a damage type. */
+    POE2FRAMEWORK_API FGameplayTag ToTag(EPoE2DamageType Type);
+
+    POE2FRAMEWORK_API const TCHAR* ToString(EPoE2DamageType Type);
+
+    /** Returns the first Damage.Type.* tag in Tags, or an empty tag. */
+    POE2FRAMEWORK_API FGameplayTag FindDamageTypeTag(const FGameplayTagContainer& Tags);
+}
+
+/**
+ * Fixed-width damage vector, one lane per EPoE2DamageType.
+ * Kept as a plain float array so per-type math is a straight loop over five lanes.
+ */
+USTRUCT(BlueprintType)
+struct POE2FRAMEWORK_API FPoE2DamageVector
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, Category = "Damage")
+    float Values[5] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+    FPoE2DamageVector() = default;
+
+    static FPoE2DamageVector Single(EPoE2DamageType Type, float Amount)
+    {
+        FPoE2DamageVector Result;
+        Result[Type] = Amount;
+        return Result;
+    }
+
+    FORCEINLINE float& operator[](EPoE2DamageType Type) { return Values[static_cast<int32>(Type)]; }
+    FORCEINLINE float operator[](EPoE2DamageType Type) const { return Values[static_cast<int32>(Type)]; }
+
+    FORCEINLINE float Total() const
+    {
+        float Sum = 0.0f;
+        for (int32 Index = 0; Index < PoE2DamageType::Num; ++Index)
+        {
+            Sum += Values[Index];
+        }
+        return Sum;
+    }
+
+    FORCEINLINE bool IsZero() const
+    {
+        for (int32 Index = 0; Index < PoE2DamageType::Num; ++Index)
+        {
+            if (Values[Index] != 0.0f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    FORCEINLINE FPoE2DamageVector& operator+=(const FPoE2DamageVector& Other)
+    {
+        for (int32 Index = 0; Index < PoE2DamageType::Num; ++Index)
+        {
+            Values[Index] += Other.Values[Index];
+        }
+        return *this;
+    }
+
+    FORCEINLINE FPoE2DamageVector& operator*=(float Scale)
+    {
+        for (int32 Index = 0; Index < PoE2DamageType::Num; ++Index)
+        {
+            Values[Index] *= Scale;
+        }
+        return *this;
+    }
+};
+
+static_assert(sizeof(FPoE2DamageVector::Values) / sizeof(float) == PoE2DamageType::Num, "FPoE2DamageVector must have one lane per damage type");
@@ -0,0 +1,141 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "GameplayTagContainer.h"
+#include "Effects/PoE2DamageTypes.h"
+#include "PoE2DotLedger.generated.h"
+
+class UAbilitySystemComponent;
+
+/** How multiple DoT instances in the same stack group on one target combine. */
+UENUM(BlueprintType)
+enum class EPoE2DotStacking : uint8
+{
+    /** Only the instance with the highest damage per second deals damage (e.g. ignite). */
+    StrongestOnly,
+    /** Every instance deals damage (e.g. poison). */
+    Unlimited
+};
+
+/** A single DoT application, as handed to the ledger. */
+USTRUCT(BlueprintType)
+struct POE2FRAMEWORK_API FPoE2DotApplication
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadWrite, Category = "DoT")
+    TObjectPtr<UAbilitySystemComponent> Target = nullptr;
+
+    UPROPERTY(BlueprintReadWrite, Category = "DoT")
+    TObjectPtr<UAbilitySystemComponent> Source = nullptr;
+
+    UPROPERTY(BlueprintReadWrite, Category = "DoT")
+    float DamagePerSecond = 0.0f;
+
+    UPROPERTY(BlueprintReadWrite, Category = "DoT")
+    float Duration = 0.0f;
+
+    /** Damage.Type.* tag the target's resistance applies against. Untyped damage is physical. */
+    UPROPERTY(BlueprintReadWrite, Category = "DoT")
+    FGameplayTag DamageType;
+
+    /** Instances sharing a group on the same target stack according to Stacking. */
+    UPROPERTY(BlueprintReadWrite, Category = "DoT")
+    FName StackGroup = NAME_None;
+
+    UPROPERTY(BlueprintReadWrite, Category = "DoT")
+    EPoE2DotStacking Stacking = EPoE2DotStacking::Unlimited;
+};
+
+/** Aggregated DoT damage for one target over one ledger tick. */
+struct FPoE2DotTargetDamage
+{
+    TWeakObjectPtr<UAbilitySystemComponent> Target;
+    TWeakObjectPtr<UAbilitySystemComponent> Source;
+
+    /** Pre-mitigation damage per type. */
+    FPoE2DamageVector Damage;
+};
+
+/** A target started or stopped having at least one DoT instance of a damage type. */
+struct FPoE2DotTypeChange
+{
+    TWeakObjectPtr<UAbilitySystemComponent> Target;
+    EPoE2DamageType Type = EPoE2DamageType::Physical;
+    bool bActive = false;
+};
+
+/**
+ * Structure-of-arrays store of every active damage-over-time instance in a world.
+ * Instances are plain rows (no GameplayEffects); Tick integrates all of them in one pass and
+ * emits at most one aggregated damage value per target.
+ */
+class POE2FRAMEWORK_API FPoE2DotLedger
+{
+public:
+    /** Adds a DoT instance starting at Now. Returns false if the application is invalid. */
+    bool Add(const FPoE2DotApplication& Application, double Now);
+
+    /**
+     * Integrates every instance over (Now - DeltaTime, Now], aggregates per target, then drops expired rows.
+     * @param OutDamage Receives one entry per target that took damage this tick.
+     */
+    void Tick(double Now, float DeltaTime, TArray<FPoE2DotTargetDamage>& OutDamage);
+
+    /** Removes every instance on Target (e.g. on death). */
+    void RemoveTarget(const UAbilitySystemComponent* Target);
+
+    void Reset();
+
+    /** Number of active instances. */
+    int32 Num() const { return DamagePerSecond.Num(); }
+
+    /** Number of active instances on Target. */
+    int32 NumOnTarget(const UAbilitySystemComponent* Target) const;
+
+    /** Whether Target has at least one active instance of Type. */
+    bool HasDamageType(const UAbilitySystemComponent* Target, EPoE2DamageType Type) const;
+
+    /**
+     * Moves out, in order, every change of the damage types present on a target since the last call
+     * (from Add, Tick, RemoveTarget and Reset), so the owner can mirror them as status tags.
+     */
+    void ConsumeTypeChanges(TArray<FPoE2DotTypeChange>& OutChanges);
+
+private:
+    int32 AcquireTargetSlot(UAbilitySystemComponent* Target);
+    void ReleaseTargetSlot(int32 Slot);
+    void RemoveInstanceAtSwap(int32 Index);
+
+    int32& GetTypeCount(int32 Slot, EPoE2DamageType Type) { return TargetTypeCounts[Slot * PoE2DamageType::Num + static_cast<int32>(Type)]; }
+
+    // Instance rows (structure of arrays, all the same length)
+    TArray<int32> TargetSlots;
+    TArray<TWeakObjectPtr<UAbilitySystemComponent>> Sources;
+    TArray<float> DamagePerSecond;
+    TArray<double> StartTimes;
+    TArray<double> ExpiryTimes;
+    TArray<FName> StackGroups;
+    TArray<EPoE2DotStacking> StackingRules;
+    TArray<EPoE2DamageType> DamageTypes;
+
+    // Dense target table so aggregation indexes arrays instead of hashing per instance
+    TArray<TWeakObjectPtr<UAbilitySystemComponent>> TargetTable;
+    TArray<TObjectKey<UAbilitySystemComponent>> TargetKeys;
+    TArray<int32> TargetRefCounts;
+
+    /** Instances per (target slot, damage type), PoE2DamageType::Num entries per slot. */
+    TArray<int32> TargetTypeCounts;
+    TArray<FPoE2DotTypeChange> PendingTypeChanges;
+    TArray<int32> FreeTargetSlots;
+    TMap<TObjectKey<UAbilitySystemComponent>, int32> TargetSlotLookup;
+
+    // Per-tick scratch buffers, kept to avoid reallocating every frame
+    TArray<FPoE2DamageVector> ScratchTargetDamage;
+    TArray<int32> ScratchTargetSource;
+    TMap<TPair<int32, FName>, int32> ScratchStrongest;
+};
@@ -0,0 +1,59 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Effects/PoE2DotLedger.h"
+#include "PoE2DotSubsystem.generated.h"
+
+/**
+ * Owns the world's damage-over-time ledger and applies its aggregated damage once per frame on the server.
+ * Replaces per-instance GameplayEffects / timers for DoTs: one UGE_Damage execution per target per frame,
+ * regardless of how many DoT instances are stacked on it. The execution is tagged Damage.OverTime, so
+ * UExec_Damage applies resistances but not armour, and PostGameplayEffectExecute and cues run as for hits.
+ * While a target has DoT instances of a type it carries the matching status as a replicated loose tag:
+ * Status.Bleeding (physical), Status.Burning (fire) or Status.Poisoned (chaos).
+ */
+UCLASS()
+class POE2FRAMEWORK_API UPoE2DotSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Registers a DoT instance. Ignored on clients. */
+    UFUNCTION(BlueprintCallable, Category = "PoE2|DoT")
+    bool ApplyDot(const FPoE2DotApplication& Application);
+
+    /** Clears every DoT on the target (e.g. on death or cleanse). */
+    UFUNCTION(BlueprintCallable, Category = "PoE2|DoT")
+    void RemoveDotsOnTarget(UAbilitySystemComponent* Target);
+
+    UFUNCTION(BlueprintPure, Category = "PoE2|DoT")
+    int32 GetActiveDotCount() const { return Ledger.Num(); }
+
+    // FTickableGameObject interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    bool IsServerWorld() const;
+
+    static void ApplyDamage(const FPoE2DotTargetDamage& Entry);
+
+    /** Mirrors the ledger's damage type changes onto the targets' status tags. */
+    void ApplyStatusChanges();
+
+    /** The status a DoT of Type inflicts, or an empty tag if it has none. */
+    static FGameplayTag GetStatusTag(EPoE2DamageType Type);
+
+    FPoE2DotLedger Ledger;
+
+    // Reused every tick
+    TArray<FPoE2DotTargetDamage> PendingDamage;
+    TArray<FPoE2DotTypeChange> PendingTypeChanges;
+};
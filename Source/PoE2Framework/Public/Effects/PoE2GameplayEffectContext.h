@@ -0,0 +1,54 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffectTypes.h"
+#include "Effects/PoE2DamageTypes.h"
+#include "PoE2GameplayEffectContext.generated.h"
+
+/**
+ * GameplayEffect context carrying the outgoing per-type damage vector, so UExec_Damage reads one struct
+ * instead of one SetByCaller per damage type. Allocated by UPoE2AbilitySystemGlobals.
+ */
+USTRUCT()
+struct POE2FRAMEWORK_API FPoE2GameplayEffectContext : public FGameplayEffectContext
+{
+    GENERATED_BODY()
+
+public:
+    /** Returns the PoE2 context behind a handle, or null if the handle holds a different context type. */
+    static FPoE2GameplayEffectContext* Get(FGameplayEffectContextHandle& Handle);
+    static const FPoE2GameplayEffectContext* Get(const FGameplayEffectContextHandle& Handle);
+
+    const FPoE2DamageVector& GetDamage() const { return Damage; }
+    void SetDamage(const FPoE2DamageVector& InDamage) { Damage = InDamage; }
+    bool HasDamage() const { return !Damage.IsZero(); }
+
+    /** Damage of each hit folded into an aggregated execution; empty for a single hit. Server-only, never replicated. */
+    TConstArrayView<FPoE2DamageVector> GetHitDamages() const { return HitDamages; }
+    void SetHitDamages(TArray<FPoE2DamageVector>&& InHitDamages) { HitDamages = MoveTemp(InHitDamages); }
+
+    //~ Begin FGameplayEffectContext Interface
+    virtual UScriptStruct* GetScriptStruct() const override { return StaticStruct(); }
+    virtual FGameplayEffectContext* Duplicate() const override;
+    virtual bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess) override;
+    //~ End FGameplayEffectContext Interface
+
+protected:
+    UPROPERTY()
+    FPoE2DamageVector Damage;
+
+    TArray<FPoE2DamageVector> HitDamages;
+};
+
+template<>
+struct TStructOpsTypeTraits<FPoE2GameplayEffectContext> : public TStructOpsTypeTraitsBase2<FPoE2GameplayEffectContext>
+{
+    enum
+    {
+        WithNetSerializer = true,
+        WithCopy = true,
+    };
+};
@@ -0,0 +1,113 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Engine/HitResult.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Effects/PoE2DamageTypes.h"
+#include "PoE2HitAccumulator.generated.h"
+
+class UAbilitySystemComponent;
+class UGameplayEffect;
+struct FSkillSpec;
+
+/** One damaging hit, as submitted by a carrier. */
+struct FPoE2HitRecord
+{
+    TWeakObjectPtr<UAbilitySystemComponent> SourceASC;
+    TWeakObjectPtr<UAbilitySystemComponent> TargetASC;
+    TWeakObjectPtr<UObject> SourceObject;
+    TSubclassOf<UGameplayEffect> EffectClass;
+    FGameplayTag DamageType;
+    FPoE2DamageVector Damage;
+    FHitResult HitResult;
+};
+
+/** All hits of one frame sharing (source, target, effect class, damage type), applied as a single execution. */
+struct FPoE2HitBatch
+{
+    TWeakObjectPtr<UAbilitySystemComponent> SourceASC;
+    TWeakObjectPtr<UAbilitySystemComponent> TargetASC;
+    TSubclassOf<UGameplayEffect> EffectClass;
+    FGameplayTag DamageType;
+    FPoE2DamageVector TotalDamage;
+
+    /** The individual hits, in submission order. */
+    TArray<FPoE2HitRecord> Hits;
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPoE2HitBatchApplied, const FPoE2HitBatch&);
+
+/**
+ * Collects damaging hits during the frame and flushes them once per (source, target, effect class, damage type)
+ * after actors have ticked. A volley, chain and area landing on the same target in one frame then cost one
+ * GameplayEffect execution, one PostGameplayEffectExecute and one attribute replication instead of one per hit.
+ *
+ * Handlers still see every hit immediately (carriers run OnHit before queueing); the per-hit records are also
+ * passed to OnHitBatchApplied for cues or systems that need them after the damage has landed.
+ */
+UCLASS()
+class POE2FRAMEWORK_API UPoE2HitAccumulatorSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * Queues a hit from a carrier, or applies it immediately if the world has no accumulator.
+     * Does nothing on clients, or without a source ASC, target ASC or damage effect.
+     * @param HitDamage Outgoing damage of one hit, usually PoE2DamageKernel::MakeHitDamage(Spec) cached by the carrier.
+     */
+    static void SubmitHit(UObject* SourceObject, UAbilitySystemComponent* SourceASC, UAbilitySystemComponent* TargetASC, const FSkillSpec& Spec, const FPoE2DamageVector& HitDamage, const FHitResult& HitResult);
+
+    /** Queues a hit for the end-of-frame flush. */
+    void QueueHit(FPoE2HitRecord&& Hit);
+
+    /** Applies every queued batch now. Called automatically once per frame. */
+    void Flush();
+
+    int32 GetNumPendingHits() const { return NumPendingHits; }
+    int32 GetNumPendingBatches() const { return Batches.Num(); }
+
+    /** Broadcast after each batch has been applied. */
+    FOnPoE2HitBatchApplied OnHitBatchApplied;
+
+    // FTickableGameObject interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    virtual void Deinitialize() override;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    static void ApplyBatch(const FPoE2HitBatch& Batch);
+
+    struct FBatchKey
+    {
+        const UAbilitySystemComponent* SourceASC;
+        const UAbilitySystemComponent* TargetASC;
+        const UClass* EffectClass;
+        FGameplayTag DamageType;
+
+        bool operator==(const FBatchKey& Other) const
+        {
+            return SourceASC == Other.SourceASC && TargetASC == Other.TargetASC && EffectClass == Other.EffectClass && DamageType == Other.DamageType;
+        }
+
+        friend uint32 GetTypeHash(const FBatchKey& Key)
+        {
+            uint32 Hash = HashCombine(PointerHash(Key.SourceASC), PointerHash(Key.TargetASC));
+            Hash = HashCombine(Hash, PointerHash(Key.EffectClass));
+            return HashCombine(Hash, GetTypeHash(Key.DamageType));
+        }
+    };
+
+    TMap<FBatchKey, int32> BatchLookup;
+    TArray<FPoE2HitBatch> Batches;
+    TArray<FPoE2HitBatch> FlushingBatches;
+    int32 NumPendingHits = 0;
+};
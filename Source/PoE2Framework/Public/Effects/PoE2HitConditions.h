@@ -0,0 +1,167 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Core/PoE2TagBits.h"
+#include "PoE2HitConditions.generated.h"
+
+class UAbilitySystemComponent;
+
+UENUM(BlueprintType)
+enum class EPoE2HitConditionType : uint8
+{
+    /** The attacker (the skill's owner) has Tag. */
+    SourceHasTag,
+    /** The target has Tag, e.g. Status.Burning. */
+    TargetHasTag,
+    /** Value >= Threshold. */
+    ValueAtLeast
+};
+
+/** Per-hit numbers a condition can compare against a threshold. */
+UENUM(BlueprintType)
+enum class EPoE2HitValue : uint8
+{
+    SourceLife,
+    SourceLifeFraction,
+    TargetLife,
+    TargetLifeFraction,
+    Count UMETA(Hidden)
+};
+
+UENUM(BlueprintType)
+enum class EPoE2HitModifierOp : uint8
+{
+    Increased,
+    More
+};
+
+USTRUCT(BlueprintType)
+struct POE2FRAMEWORK_API FPoE2HitCondition
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Condition")
+    EPoE2HitConditionType Type = EPoE2HitConditionType::TargetHasTag;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Condition", meta=(EditCondition="Type != EPoE2HitConditionType::ValueAtLeast"))
+    FGameplayTag Tag;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Condition", meta=(EditCondition="Type == EPoE2HitConditionType::ValueAtLeast"))
+    EPoE2HitValue Value = EPoE2HitValue::TargetLifeFraction;
+
+    /** Full life is TargetLifeFraction at least 1; low life is SourceLifeFraction at least 0.35, negated. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Condition", meta=(EditCondition="Type == EPoE2HitConditionType::ValueAtLeast"))
+    float Threshold = 0.0f;
+
+    /** Holds when the test fails ("against enemies that are not burning"). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Condition")
+    bool bNegate = false;
+
+    bool operator==(const FPoE2HitCondition& Other) const
+    {
+        return Type == Other.Type && Tag == Other.Tag && Value == Other.Value && Threshold == Other.Threshold && bNegate == Other.bNegate;
+    }
+};
+
+/** Hit damage scaling that only applies when every condition holds, e.g. "40% more damage against burning enemies". */
+USTRUCT(BlueprintType)
+struct POE2FRAMEWORK_API FPoE2ConditionalModifier
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Conditional")
+    TArray<FPoE2HitCondition> Conditions;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Conditional")
+    EPoE2HitModifierOp Op = EPoE2HitModifierOp::Increased;
+
+    /** Fraction: 0.4 = 40%. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Conditional")
+    float Value = 0.0f;
+
+    bool operator==(const FPoE2ConditionalModifier& Other) const
+    {
+        return Op == Other.Op && Value == Other.Value && Conditions == Other.Conditions;
+    }
+};
+
+/** What the conditions of one hit are tested against, gathered once per hit however many modifiers there are. */
+struct POE2FRAMEWORK_API FPoE2HitConditionContext
+{
+    FPoE2TagBits SourceBits;
+    FPoE2TagBits TargetBits;
+    uint32 BitsGeneration = 0;
+
+    /** Used only when the bit table is incomplete; must outlive the evaluation. */
+    const FGameplayTagContainer* SourceTags = nullptr;
+    const FGameplayTagContainer* TargetTags = nullptr;
+
+    float Values[static_cast<int32>(EPoE2HitValue::Count)] = {};
+
+    /** Owned tags and life of both sides. Either ASC may be null (its tags are empty and its life fraction 1). */
+    static FPoE2HitConditionContext Gather(const UAbilitySystemComponent* Source, const UAbilitySystemComponent* Target);
+
+    /** The same from plain values, for sides without an ASC such as a simulated target. The containers must outlive the evaluation. */
+    static FPoE2HitConditionContext Make(const FGameplayTagContainer& SourceTags, float SourceLife, float SourceMaxLife, const FGameplayTagContainer& TargetTags, float TargetLife, float TargetMaxLife);
+};
+
+/**
+ * A spec's conditional modifiers compiled into flat terms: each condition is a mask test on one side's tag
+ * bits or a threshold on one value, and a modifier applies when all of its terms pass. Evaluation computes
+ * every term as 0/1 arithmetic and scales each modifier by its result, so a hit costs a few word ANDs and
+ * compares per condition with no tag container queries or data-dependent branches.
+ *
+ * Tags outside the bit table are still honoured, by testing the context's containers instead.
+ */
+class POE2FRAMEWORK_API FPoE2HitConditionProgram
+{
+public:
+    /** Null when there is nothing to evaluate. */
+    static TSharedPtr<const FPoE2HitConditionProgram> Compile(TConstArrayView<FPoE2ConditionalModifier> Modifiers);
+
+    /** Damage multiplier of one hit: (1 + sum of passing increased) * product of passing more. */
+    float Evaluate(const FPoE2HitConditionContext& Context) const;
+
+    int32 NumModifiers() const { return Modifiers.Num(); }
+    int32 NumTerms() const { return Terms.Num(); }
+
+private:
+    enum class EOperand : uint8
+    {
+        SourceTags,
+        TargetTags,
+        Value
+    };
+
+    struct FTerm
+    {
+        FPoE2TagBits Mask;
+        float Threshold = 0.0f;
+        EOperand Operand = EOperand::Value;
+        uint8 ValueIndex = 0;
+        uint8 bNegate = 0;
+
+        /** For the container fallback. */
+        FGameplayTag Tag;
+    };
+
+    struct FModifier
+    {
+        int32 FirstTerm;
+        int32 NumTerms;
+        float Increased;
+        float More;
+    };
+
+    uint32 TermsPassed(const FModifier& Modifier, const FPoE2HitConditionContext& Context, bool bUseBits) const;
+
+    TArray<FTerm> Terms;
+    TArray<FModifier> Modifiers;
+
+    /** Bit table generation of the masks; 0 if some tag had no bit. */
+    uint32 Generation = 0;
+};
@@ -0,0 +1,27 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "PoE2AffixRollBenchmarkCommandlet.generated.h"
+
+/**
+ * Compiles every item base and affix into an FPoE2AffixRoller and reports roll throughput, single-threaded
+ * and batched, in items per second and items per second per core.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd <Project> -run=PoE2AffixRollBenchmark [-Count=1000000] [-ItemLevel=100] [-Base=<BaseId>]
+ *       [-Seed=1]
+ */
+UCLASS()
+class POE2FRAMEWORK_API UPoE2AffixRollBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UPoE2AffixRollBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
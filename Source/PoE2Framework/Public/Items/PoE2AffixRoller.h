@@ -0,0 +1,161 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "UObject/ObjectKey.h"
+#include "Stats/PoE2StatTypes.h"
+#include "Spec/SkillModifier.h"
+
+class UAffixDataAsset;
+class UItemBaseDataAsset;
+
+/** One affix on a rolled item: the affix's dense index in the roller and its rolled stat values. */
+struct FPoE2RolledAffix
+{
+    static constexpr int32 MaxValues = 4;
+
+    uint16 Affix = 0;
+    uint8 NumValues = 0;
+    float Values[MaxValues] = {};
+};
+
+/** A rolled item: compact, self-contained and cheap to copy across threads. */
+struct FPoE2RolledItem
+{
+    int32 Base = INDEX_NONE;
+    int32 ItemLevel = 0;
+    TArray<FPoE2RolledAffix, TInlineAllocator<6>> Affixes;
+};
+
+struct FPoE2AffixRollSettings
+{
+    /** Inclusive affix count range; clamped to the base's prefix and suffix limits. */
+    int32 MinAffixes = 1;
+    int32 MaxAffixes = 6;
+};
+
+/**
+ * Affix roll engine. Compile builds, for every distinct set of affixes a base can spawn (bases sharing
+ * tags share it) and every item level band, one alias table per side, so drawing an affix is one random
+ * number and two array reads however many affixes exist.
+ *
+ * Mod-group exclusion uses a bitmask over the pool's local groups; excluded draws are rejected and
+ * redrawn, which samples exactly the remaining weights. Prefix or suffix is chosen by the sides' total
+ * weights. Immutable once compiled, so any number of threads can roll at once.
+ */
+class POE2FRAMEWORK_API FPoE2AffixRoller
+{
+public:
+    /**
+     * Null entries and zero weights are skipped. Affixes past a pool's 256 local groups are dropped and stats
+     * past FPoE2RolledAffix::MaxValues ignored, both with a warning. Null if there are more than 65535 affixes.
+     */
+    static TSharedPtr<const FPoE2AffixRoller> Compile(TConstArrayView<const UItemBaseDataAsset*> Bases, TConstArrayView<const UAffixDataAsset*> Affixes);
+
+    int32 NumBases() const { return BaseAssets.Num(); }
+    int32 NumAffixes() const { return AffixInfos.Num(); }
+    int32 NumPools() const { return Pools.Num(); }
+
+    int32 FindBase(const UItemBaseDataAsset* Base) const;
+    int32 FindAffix(const UAffixDataAsset* Affix) const;
+    const UAffixDataAsset* GetAffix(int32 Affix) const { return AffixAssets.IsValidIndex(Affix) ? AffixAssets[Affix].Get() : nullptr; }
+
+    /** Rolls one item. Returns false if the base is unknown or nothing can roll at this item level. */
+    bool Roll(int32 Base, int32 ItemLevel, const FPoE2AffixRollSettings& Settings, FRandomStream& Random, FPoE2RolledItem& OutItem) const;
+
+    /**
+     * Rolls Count items of one base across worker threads. Deterministic for a given Seed regardless of
+     * thread count: item I is always rolled from the same stream.
+     */
+    void RollBatch(int32 Base, int32 ItemLevel, const FPoE2AffixRollSettings& Settings, int32 Count, int32 Seed, TArray<FPoE2RolledItem>& OutItems) const;
+
+    /** The stat modifiers of a rolled item, implicits first. Feed to FPoE2StatGraph::AddSource. */
+    void GetModifiers(const FPoE2RolledItem& Item, TArray<FPoE2StatModifier>& OutModifiers) const;
+
+    /** The skill modifiers of a rolled item, implicits first. Feed to FPoE2SkillModifierIndex::AddSource. */
+    void GetSkillModifiers(const FPoE2RolledItem& Item, TArray<FPoE2SkillModifier>& OutModifiers) const;
+
+private:
+    struct FStatRange
+    {
+        FName Stat;
+        EPoE2StatModOp Op;
+        float Min;
+        float Max;
+    };
+
+    struct FAffixInfo
+    {
+        int32 FirstRange;
+        uint8 NumRanges;
+        uint8 Side;
+        int32 RequiredItemLevel;
+        int32 Weight;
+        int32 Group;
+        int32 FirstSkillModifier;
+        int32 NumSkillModifiers;
+    };
+
+    struct FGroupMask
+    {
+        static constexpr int32 MaxGroups = 256;
+        uint64 Words[MaxGroups / 64] = {};
+
+        void Add(int32 Group) { Words[Group >> 6] |= uint64(1) << (Group & 63); }
+        bool Contains(int32 Group) const { return (Words[Group >> 6] & (uint64(1) << (Group & 63))) != 0; }
+    };
+
+    /** Vose alias table over one side of one pool. */
+    struct FAliasTable
+    {
+        TArray<float> Probability;
+        TArray<uint16> Alias;
+        TArray<uint16> Affixes;
+        TArray<uint8> LocalGroups;
+        TArray<float> Weights;
+        float TotalWeight = 0.0f;
+
+        void Build();
+        int32 Num() const { return Affixes.Num(); }
+
+        /** Entry index not in Excluded, drawn in proportion to weight, or INDEX_NONE if every entry is excluded. */
+        int32 Sample(FRandomStream& Random, const FGroupMask& Excluded) const;
+    };
+
+    struct FPool
+    {
+        FAliasTable Sides[2];
+    };
+
+    struct FBaseInfo
+    {
+        int32 MaxPerSide[2];
+        int32 FirstImplicit;
+        int32 NumImplicits;
+        int32 FirstSkillModifier;
+        int32 NumSkillModifiers;
+
+        /** First of this base's pools, one per item level band. */
+        int32 FirstPool;
+    };
+
+    void RollAffixValues(int32 Affix, FRandomStream& Random, FPoE2RolledAffix& OutAffix) const;
+
+    TArray<TWeakObjectPtr<const UItemBaseDataAsset>> BaseAssets;
+    TArray<TWeakObjectPtr<const UAffixDataAsset>> AffixAssets;
+    TMap<FObjectKey, int32> BaseIndices;
+    TMap<FObjectKey, int32> AffixIndices;
+
+    TArray<FBaseInfo> BaseInfos;
+    TArray<FPoE2StatModifier> Implicits;
+    TArray<FAffixInfo> AffixInfos;
+    TArray<FStatRange> StatRanges;
+    TArray<FPoE2SkillModifier> SkillModifiers;
+
+    /** Ascending distinct RequiredItemLevel values; band B admits affixes requiring at most BandLevels[B]. */
+    TArray<int32> BandLevels;
+    TArray<FPool> Pools;
+};
@@ -0,0 +1,109 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PoE2MinionCrowd.generated.h"
+
+/** Tuning shared by every minion crowd in a world. */
+USTRUCT(BlueprintType)
+struct POE2FRAMEWORK_API FPoE2MinionCrowdSettings
+{
+    GENERATED_BODY()
+
+    /** Minions idle on a ring of this radius around their owner. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd")
+    float FollowRadius = 250.0f;
+
+    /** Minions stop on a ring of this radius around their target. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd")
+    float EngageRadius = 120.0f;
+
+    /** A waypoint counts as reached within this distance. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd")
+    float WaypointRadius = 80.0f;
+
+    /** Minions slow down within this distance of their slot. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd")
+    float SlowdownRadius = 150.0f;
+
+    /** Extra gap kept between two minions' radii. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd")
+    float SeparationPadding = 20.0f;
+
+    /** Strength of the push away from overlapping neighbours, relative to seeking. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd")
+    float SeparationWeight = 1.5f;
+
+    /** The shared path is rebuilt when the goal moves this far... */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd")
+    float RepathDistance = 200.0f;
+
+    /** ...or at least this often (seconds), so the path follows the terrain the crowd has since crossed. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd")
+    float RepathInterval = 1.0f;
+
+    /** Enemies within this distance of the crowd's centre are considered. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd")
+    float AcquireRadius = 1200.0f;
+
+    /** Seconds between the crowd's target queries. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd")
+    float AcquireInterval = 0.25f;
+
+    /** The target is dropped once it is this far from the owner. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd")
+    float LeashRadius = 1800.0f;
+
+    /** How far from a minion's next position the navmesh may be to stand it on the floor there. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crowd")
+    FVector ProjectionExtent = FVector(50.0f, 50.0f, 250.0f);
+};
+
+/** One minion as seen by the crowd: copied in before steering, velocity and path progress read back after. */
+struct FPoE2CrowdAgent
+{
+    FVector Location = FVector::ZeroVector;
+    FVector Velocity = FVector::ZeroVector;
+    float MaxSpeed = 0.0f;
+    float Radius = 0.0f;
+
+    /** Next waypoint of the shared path this agent is heading for. */
+    int32 PathIndex = 0;
+};
+
+/**
+ * Steering for all minions of one owner. The crowd follows one shared path to its goal; each agent walks
+ * the path at its own progress, then spreads onto its own slot on a ring around the goal. Agents push
+ * apart from overlapping neighbours, so a whole summoner army costs one path query and one O(n^2) pass
+ * over a few dozen positions per frame, with no per-minion controller, perception or pathfinding.
+ *
+ * Steering is on the ground plane: velocities have no Z, and height comes from the navmesh when the minion
+ * moves. Separation only sees the agents of this crowd; minions of other crowds are kept apart by collision.
+ */
+class POE2FRAMEWORK_API FPoE2MinionCrowd
+{
+public:
+    /** Replaces the shared path (Points.Last() is the goal) and restarts every agent's progress along it. */
+    void SetPath(TArray<FVector>&& Points, TArrayView<FPoE2CrowdAgent> Agents);
+
+    const TArray<FVector>& GetPath() const { return Path; }
+    bool HasPath() const { return Path.Num() > 0; }
+    void ResetPath() { Path.Reset(); }
+
+    /** Where the agent at Index (of Num) stands once it reaches the goal. */
+    static FVector GetSlotLocation(const FVector& Goal, float SlotRadius, int32 Index, int32 Num);
+
+    /**
+     * Writes every agent's horizontal Velocity and advances its PathIndex. Agents stop on their slot SlotRadius
+     * away from the path's goal. Without a path every agent stops.
+     */
+    void Steer(TArrayView<FPoE2CrowdAgent> Agents, float SlotRadius, const FPoE2MinionCrowdSettings& Settings) const;
+
+    /** Mean location of the agents; zero if there are none. */
+    static FVector GetCentroid(TConstArrayView<FPoE2CrowdAgent> Agents);
+
+private:
+    TArray<FVector> Path;
+};
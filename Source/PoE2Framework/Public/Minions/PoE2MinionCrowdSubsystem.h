@@ -0,0 +1,92 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Minions/PoE2MinionCrowd.h"
+#include "PoE2MinionCrowdSubsystem.generated.h"
+
+class APoE2MinionBase;
+class UAbilitySystemComponent;
+
+/**
+ * Drives every minion in the world from one crowd per owner, on the server. A crowd makes at most one target
+ * request (answered by UPoE2TargetingSubsystem in its next batch) and one path query per frame for all of
+ * its minions, then steers and moves them directly;
+ * minions have no AI controller, behaviour tree or perception of their own. Movement reaches clients
+ * through ordinary movement replication.
+ */
+UCLASS(config = Game)
+class POE2FRAMEWORK_API UPoE2MinionCrowdSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Adds the minion to its owner's crowd. Ignored on clients. */
+    void RegisterMinion(APoE2MinionBase* Minion, UAbilitySystemComponent* OwnerASC);
+
+    void UnregisterMinion(APoE2MinionBase* Minion);
+
+    /** Overrides the crowd's automatic target (e.g. a player-ordered focus). Null returns to automatic. */
+    UFUNCTION(BlueprintCallable, Category = "PoE2|Minions")
+    void SetCrowdTarget(UAbilitySystemComponent* OwnerASC, AActor* Target);
+
+    UFUNCTION(BlueprintPure, Category = "PoE2|Minions")
+    AActor* GetCrowdTarget(const UAbilitySystemComponent* OwnerASC) const;
+
+    UFUNCTION(BlueprintPure, Category = "PoE2|Minions")
+    int32 GetNumMinions(const UAbilitySystemComponent* OwnerASC) const;
+
+    UFUNCTION(BlueprintPure, Category = "PoE2|Minions")
+    int32 GetNumCrowds() const { return Crowds.Num(); }
+
+    UPROPERTY(EditAnywhere, Config, BlueprintReadWrite, Category = "PoE2|Minions")
+    FPoE2MinionCrowdSettings Settings;
+
+    // FTickableGameObject interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FCrowdState
+    {
+        TWeakObjectPtr<UAbilitySystemComponent> OwnerASC;
+        TArray<TWeakObjectPtr<APoE2MinionBase>> Minions;
+        TArray<FPoE2CrowdAgent> Agents;
+        FPoE2MinionCrowd Crowd;
+
+        TWeakObjectPtr<AActor> Target;
+        bool bTargetOrdered = false;
+
+        /** Answer to the last target request, taken up on the crowd's next tick. */
+        TWeakObjectPtr<AActor> AcquiredTarget;
+        bool bAcquirePending = false;
+        bool bAcquireAnswered = false;
+
+        FVector PathGoal = FVector::ZeroVector;
+        float NextRepathTime = 0.0f;
+        float NextAcquireTime = 0.0f;
+    };
+
+    /** Drops dead minions and copies the rest into the crowd's agents; false if none are left. */
+    bool GatherAgents(FCrowdState& State) const;
+
+    /** One target request for the whole crowd: the living enemy nearest the crowd's centre. */
+    void RequestTarget(FCrowdState& State, const AActor* OwnerActor, const FVector& Centroid);
+
+    bool IsValidTarget(const AActor* OwnerActor, const AActor* Candidate) const;
+
+    void UpdatePath(FCrowdState& State, const FVector& Centroid, const FVector& Goal, float Now) const;
+
+    void MoveMinions(FCrowdState& State, float DeltaTime) const;
+
+    bool IsServerWorld() const;
+
+    TMap<TObjectKey<UAbilitySystemComponent>, FCrowdState> Crowds;
+};
@@ -0,0 +1,100 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PoE2MinionSignificance.generated.h"
+
+/** How much of a minion's per-frame work runs, from full rate down to barely alive. */
+UENUM(BlueprintType)
+enum class EPoE2MinionTier : uint8
+{
+    High,
+    Medium,
+    Low,
+    Count UMETA(Hidden)
+};
+
+/** What a minion in one tier updates, and how often. Intervals of 0 mean every frame. */
+USTRUCT(BlueprintType)
+struct POE2FRAMEWORK_API FPoE2MinionTierSettings
+{
+    GENERATED_BODY()
+
+    FPoE2MinionTierSettings() = default;
+
+    FPoE2MinionTierSettings(float InTickInterval, float InHandlerTickInterval, float InAnimTickInterval, float InNetUpdateFrequency)
+        : TickInterval(InTickInterval)
+        , HandlerTickInterval(InHandlerTickInterval)
+        , AnimTickInterval(InAnimTickInterval)
+        , NetUpdateFrequency(InNetUpdateFrequency)
+    {
+    }
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+    float TickInterval = 0.0f;
+
+    /** Handler OnTick runs at most this often and receives the time since its last run. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+    float HandlerTickInterval = 0.0f;
+
+    /** Tick interval of the minion's skeletal meshes, i.e. its animation update rate. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+    float AnimTickInterval = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+    float NetUpdateFrequency = 30.0f;
+};
+
+USTRUCT(BlueprintType)
+struct POE2FRAMEWORK_API FPoE2MinionSignificanceSettings
+{
+    GENERATED_BODY()
+
+    /** Minions farther than this from every player drop to Medium... */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+    float MediumDistance = 1500.0f;
+
+    /** ...and farther than this to Low. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+    float LowDistance = 3500.0f;
+
+    /** A minion in combat scores as if this much closer (0.5 = half the distance). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance", meta = (ClampMin = "0", ClampMax = "1"))
+    float CombatDistanceScale = 0.5f;
+
+    /** Fraction of a tier distance a minion must cross beyond it before changing tier, so it does not flicker on the boundary. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance", meta = (ClampMin = "0", ClampMax = "0.5"))
+    float Hysteresis = 0.15f;
+
+    /** Seconds between re-scoring every minion. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+    float UpdateInterval = 0.25f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+    FPoE2MinionTierSettings High;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+    FPoE2MinionTierSettings Medium = FPoE2MinionTierSettings(0.05f, 0.1f, 0.033f, 10.0f);
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+    FPoE2MinionTierSettings Low = FPoE2MinionTierSettings(0.25f, 0.5f, 0.2f, 2.0f);
+
+    const FPoE2MinionTierSettings& GetTier(EPoE2MinionTier Tier) const
+    {
+        return Tier == EPoE2MinionTier::High ? High : (Tier == EPoE2MinionTier::Medium ? Medium : Low);
+    }
+};
+
+namespace PoE2MinionSignificance
+{
+    /** Distance to the nearest player, shortened while the minion is in combat. */
+    POE2FRAMEWORK_API float Score(float DistanceToNearestPlayer, bool bInCombat, const FPoE2MinionSignificanceSettings& Settings);
+
+    /**
+     * Tier for a score given the minion's current tier. A boundary is crossed outwards only past
+     * (1 + Hysteresis) times its distance and inwards only inside (1 - Hysteresis) times it.
+     */
+    POE2FRAMEWORK_API EPoE2MinionTier SelectTier(float Score, EPoE2MinionTier Current, const FPoE2MinionSignificanceSettings& Settings);
+}
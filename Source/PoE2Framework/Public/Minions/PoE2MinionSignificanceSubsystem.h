@@ -0,0 +1,73 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Minions/PoE2MinionSignificance.h"
+#include "PoE2MinionSignificanceSubsystem.generated.h"
+
+class APoE2MinionBase;
+
+/**
+ * Scores every minion by its distance to the nearest player (closer while in combat) a few times a second
+ * and moves it between significance tiers with hysteresis. A tier change rescales the minion's actor tick,
+ * handler OnTick, animation and net update rates; nothing is touched while a minion stays in its tier.
+ * Runs on the server and on clients, each against the players it knows about.
+ */
+UCLASS(config = Game)
+class POE2FRAMEWORK_API UPoE2MinionSignificanceSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Starts the minion at High so it is never under-updated before its first score. */
+    void RegisterMinion(APoE2MinionBase* Minion);
+
+    void UnregisterMinion(APoE2MinionBase* Minion);
+
+    /** Cost of one full minion tick, fed into the saved-time estimate. */
+    void RecordTickCost(uint32 Cycles);
+
+    UFUNCTION(BlueprintPure, Category = "PoE2|Minions")
+    int32 GetNumInTier(EPoE2MinionTier Tier) const;
+
+    /** Of GetNumInTier, the minions whose actor tick is enabled; drives the saved-time estimate. */
+    UFUNCTION(BlueprintPure, Category = "PoE2|Minions")
+    int32 GetNumTickingInTier(EPoE2MinionTier Tier) const;
+
+    /**
+     * Estimated actor tick time saved this frame against running every minion every frame: the average
+     * measured minion tick times the ticks that lower tiers skipped. Animation savings are not included.
+     */
+    UFUNCTION(BlueprintPure, Category = "PoE2|Minions")
+    float GetEstimatedSavedMs() const { return SavedMs; }
+
+    UPROPERTY(EditAnywhere, Config, BlueprintReadWrite, Category = "PoE2|Minions")
+    FPoE2MinionSignificanceSettings Settings;
+
+    // FTickableGameObject interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void UpdateTiers();
+
+    TArray<TWeakObjectPtr<APoE2MinionBase>> Minions;
+
+    // Reused every update
+    TArray<FVector> PlayerLocations;
+
+    int32 TierCounts[static_cast<int32>(EPoE2MinionTier::Count)] = {};
+
+    /** Of TierCounts, the minions whose actor tick is enabled */
+    int32 TickingCounts[static_cast<int32>(EPoE2MinionTier::Count)] = {};
+
+    float TimeUntilUpdate = 0.0f;
+    double AverageTickMs = 0.0;
+    float SavedMs = 0.0f;
+};
@@ -0,0 +1,124 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Spec/SkillSpec.h"
+#include "AbilitySystem/Handlers/MechanicHandler.h"
+#include "PoE2SummonSpawnSubsystem.generated.h"
+
+class APoE2MinionBase;
+class UAbilitySystemComponent;
+struct FNavigationProjectionWork;
+
+USTRUCT(BlueprintType)
+struct POE2FRAMEWORK_API FPoE2SummonFormationSettings
+{
+    GENERATED_BODY()
+
+    /** Distance between neighbouring slots, across and between rows. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Formation")
+    float Spacing = 100.0f;
+
+    /** Summons per row; further rows line up behind the first. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Formation", meta = (ClampMin = "1"))
+    int32 MaxPerRow = 5;
+
+    /** How far from a slot the navmesh may be to snap onto it. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Formation")
+    FVector ProjectionExtent = FVector(100.0f, 100.0f, 250.0f);
+};
+
+namespace PoE2SummonFormation
+{
+    /**
+     * Count slots in rows centred on Forward, the first row Spacing in front of Origin and each further row
+     * Spacing behind the one before. Slots face Forward.
+     */
+    POE2FRAMEWORK_API void ComputeSlots(const FVector& Origin, const FVector& Forward, int32 Count, const FPoE2SummonFormationSettings& Settings, TArray<FTransform>& OutSlots);
+
+    /**
+     * Moves each slot to its projection (Projections[i], as filled by a batched navmesh query) lifted by HalfHeight,
+     * since navmesh points are on the floor. A slot whose projection failed goes to Fallback, which is taken to be
+     * an actor location already.
+     */
+    POE2FRAMEWORK_API void PlaceProjectedSlots(TConstArrayView<FNavigationProjectionWork> Projections, const FVector& Fallback, float HalfHeight, TArray<FTransform>& Slots);
+}
+
+/** A formation still waiting for (part of) its spawn budget. */
+USTRUCT()
+struct FPoE2PendingSummons
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TWeakObjectPtr<AActor> Summoner;
+
+    UPROPERTY()
+    TObjectPtr<UAbilitySystemComponent> OwnerASC = nullptr;
+
+    UPROPERTY()
+    FSkillSpec Spec;
+
+    /** Kept referenced here until the last summon of the formation has taken its own copies. */
+    UPROPERTY()
+    TArray<TScriptInterface<IMechanicHandler>> HandlerPrototypes;
+
+    /** Actor locations: projected onto the navmesh and lifted by the summon's half height, or at summoner height. */
+    TArray<FTransform> Slots;
+    int32 NextSlot = 0;
+};
+
+/**
+ * Spawns summons in formation. All slots of a cast are projected onto the navmesh in one batched query when
+ * the cast is queued; the actors themselves are spawned under a per-frame budget shared by every caster, so
+ * raising ten minions at once spreads its SpawnActor cost over a few frames instead of one.
+ */
+UCLASS(config = Game)
+class POE2FRAMEWORK_API UPoE2SummonSpawnSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Queues Spec.SummonCount summons in front of Summoner. As many as the frame's budget allows spawn before this returns. */
+    void QueueFormation(AActor* Summoner, const FSkillSpec& Spec, UAbilitySystemComponent* OwnerASC, const TArray<TScriptInterface<IMechanicHandler>>& HandlerPrototypes);
+
+    UFUNCTION(BlueprintPure, Category = "PoE2|Minions")
+    int32 GetNumPendingSpawns() const;
+
+    /** Formations with summons still to spawn; a formation leaves the queue once its last summon has spawned. */
+    UFUNCTION(BlueprintPure, Category = "PoE2|Minions")
+    int32 GetNumPendingFormations() const { return Pending.Num(); }
+
+    UPROPERTY(EditAnywhere, Config, BlueprintReadWrite, Category = "PoE2|Minions")
+    FPoE2SummonFormationSettings Formation;
+
+    /** Summon actors spawned per frame across all casters; the rest wait for the next frames. */
+    UPROPERTY(EditAnywhere, Config, BlueprintReadWrite, Category = "PoE2|Minions", meta = (ClampMin = "1"))
+    int32 MaxSpawnsPerFrame = 4;
+
+    // FTickableGameObject interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /**
+     * Snaps every slot onto the navmesh in one batch (see PoE2SummonFormation::PlaceProjectedSlots). A slot with
+     * no navmesh nearby falls back to the summoner's location.
+     */
+    void ProjectSlots(const AActor* Summoner, float HalfHeight, TArray<FTransform>& Slots) const;
+
+    /** Spawns queued summons in order until the frame's budget runs out. */
+    void SpawnPending();
+
+    UPROPERTY()
+    TArray<FPoE2PendingSummons> Pending;
+
+    int32 SpawnsThisFrame = 0;
+    uint64 BudgetFrame = 0;
+};
@@ -0,0 +1,91 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Spec/Patch.h"
+#include "Spec/SkillSpec.h"
+#include "Effects/PoE2DamageKernel.h"
+
+class USkillDataAsset;
+class USupportDataAsset;
+
+/** One build to evaluate: a skill, its supports and any extra patches (passives, items). */
+struct POE2FRAMEWORK_API FPoE2SimBuild
+{
+    const USkillDataAsset* Skill = nullptr;
+    TArray<const USupportDataAsset*> Supports;
+    TArray<FPatch> ExtraPatches;
+
+    /** "Skill+SupportA+SupportB", used as the CSV row label. */
+    FString GetLabel() const;
+};
+
+/** The dummy the build is fighting. */
+struct POE2FRAMEWORK_API FPoE2SimTarget
+{
+    FPoE2DefenceProfile Defence;
+    float Life = 10000.0f;
+
+    /** Tags the target carries for the skill's conditional modifiers, e.g. Status.Burning. */
+    FGameplayTagContainer Tags;
+
+    /** Fraction of Life the target is held at when conditional modifiers are tested (1 = full life). */
+    float LifeFraction = 1.0f;
+};
+
+struct POE2FRAMEWORK_API FPoE2SimSettings
+{
+    /** Encounter length in seconds. */
+    float Duration = 60.0f;
+
+    /** Time per use when the skill has neither cast time nor cooldown (attack/cast speed floor). */
+    float MinUseInterval = 0.5f;
+
+    /** Integration step for damage over time. The encounter is cut into whole steps, the last one shortened to fit. */
+    float TimeStep = 0.1f;
+};
+
+struct POE2FRAMEWORK_API FPoE2SimResult
+{
+    FString Label;
+    FSkillSpec Spec;
+
+    /** Damage of one hit after the target's conditional modifiers and mitigation. */
+    float MitigatedHitDamage = 0.0f;
+
+    /** Damage per second of one DoT instance after the target's resistance; armour does not apply to DoTs. */
+    float MitigatedDotDps = 0.0f;
+    float UsesPerSecond = 0.0f;
+    float HitDamageDealt = 0.0f;
+    float DotDamageDealt = 0.0f;
+    float TotalDamage = 0.0f;
+    float DPS = 0.0f;
+
+    /** Seconds until the target's life reaches zero, or negative if it survives the encounter. */
+    float TimeToKill = -1.0f;
+};
+
+/**
+ * World-free combat simulation. Specs are composed through FSkillSpecBuilder (same fold as BuildSkillSpec); hits
+ * go through the spec's conditional modifiers and both hits and DoTs through PoE2DamageKernel mitigation (same
+ * math as UPoE2HitAccumulatorSubsystem and UExec_Damage), so results match in-game numbers.
+ */
+class POE2FRAMEWORK_API FPoE2CombatSimulator
+{
+public:
+    /** Simulates a fixed-duration encounter against Target. Composes the spec from the build's assets, so game thread only. */
+    static FPoE2SimResult SimulateBuild(const FPoE2SimBuild& Build, const FPoE2SimTarget& Target, const FPoE2SimSettings& Settings);
+
+    /** Simulates an already composed spec. */
+    static FPoE2SimResult SimulateSpec(const FSkillSpec& Spec, const FPoE2SimTarget& Target, const FPoE2SimSettings& Settings);
+
+    /** Composes every build on the calling (game) thread, then simulates them in parallel. OutResults[i] belongs to Builds[i]. */
+    static void SimulateBuilds(TConstArrayView<FPoE2SimBuild> Builds, const FPoE2SimTarget& Target, const FPoE2SimSettings& Settings, TArray<FPoE2SimResult>& OutResults);
+
+    /** Collects the patches of a build in application order: supports, then extra patches. */
+    static void GatherPatches(const FPoE2SimBuild& Build, TArray<FPatch>& OutPatches);
+
+    static FString ToCSV(TConstArrayView<FPoE2SimResult> Results);
+};
@@ -0,0 +1,26 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "PoE2SimulateBuildsCommandlet.generated.h"
+
+/**
+ * Simulates every skill with every combination of up to N supports and writes the results as CSV.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd <Project> -run=PoE2SimulateBuilds [-MaxSupports=2] [-Duration=60] [-Armour=0]
+ *       [-Resist=0] [-Life=10000] [-Skills=SkillA,SkillB] [-Output=<path.csv>]
+ */
+UCLASS()
+class POE2FRAMEWORK_API UPoE2SimulateBuildsCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UPoE2SimulateBuildsCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,70 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Spec/SkillSpec.h"
+
+class USkillDataAsset;
+class USupportDataAsset;
+
+/** Scores a composed spec; higher is better. Called from worker threads, so it must not touch mutable shared state. */
+using FPoE2SupportScoreFunction = TFunction<float(const FSkillSpec& Spec)>;
+
+/**
+ * Upper bound of the best score reachable from a partial combination by adding up to RemainingSlots of the supports
+ * in RemainingSupports. Used for pruning; it must never underestimate or results may be lost.
+ */
+using FPoE2SupportBoundFunction = TFunction<float(const FSkillSpec& PartialSpec, TConstArrayView<const USupportDataAsset*> RemainingSupports, int32 RemainingSlots)>;
+
+struct POE2FRAMEWORK_API FPoE2SupportSearchSettings
+{
+    /** Largest number of supports in a combination (combinations of 0..MaxSupports are ranked). */
+    int32 MaxSupports = 5;
+
+    /** How many results to keep. */
+    int32 TopK = 10;
+
+    /** Floor for the skill's use interval in DefaultScore. */
+    float MinUseInterval = 0.5f;
+
+    /** Score to rank by. Defaults to DefaultScore. */
+    FPoE2SupportScoreFunction Score;
+
+    /** Optional bound for Score. Without one, the default bound is used for the default score and pruning is off otherwise. */
+    FPoE2SupportBoundFunction UpperBound;
+};
+
+struct POE2FRAMEWORK_API FPoE2SupportSearchResult
+{
+    TArray<const USupportDataAsset*> Supports;
+    FSkillSpec Spec;
+    float Score = 0.0f;
+};
+
+struct FPoE2SupportSearchStats
+{
+    /** Combinations whose spec was folded and scored. */
+    int64 CombinationsScored = 0;
+    /** Subtrees skipped because their bound could not beat the current top-K. */
+    int64 SubtreesPruned = 0;
+};
+
+/**
+ * Ranks every legal combination of supports for one skill.
+ *
+ * Combinations are enumerated depth-first in pool order. Each depth keeps the spec folded so far, so a child
+ * combination costs one FSkillSpecBuilder::ApplyPatch instead of re-folding every patch. Patches are applied
+ * in pool order, the same fold BuildSkillSpec performs for supports linked in that order.
+ * First-level subtrees run in parallel; subtrees whose bound cannot enter the top-K are skipped.
+ * A support is legal if it is compatible with the tags of the spec it is added to.
+ */
+class POE2FRAMEWORK_API FPoE2SupportSearch
+{
+public:
+    static void FindTopCombinations(const USkillDataAsset* Skill, TConstArrayView<const USupportDataAsset*> SupportPool, const FPoE2SupportSearchSettings& Settings, TArray<FPoE2SupportSearchResult>& OutResults, FPoE2SupportSearchStats* OutStats = nullptr);
+
+    /** Hit damage per second without target mitigation: FinalDamage / max(CastTime, Cooldown, MinUseInterval). */
+    static float DefaultScore(const FSkillSpec& Spec, float MinUseInterval);
+};
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
+#include "Effects/PoE2HitConditions.h"
 #include "Patch.generated.h"
 
 // Forward Declarations
@@ -64,6 +65,13 @@ public:
     /** Mechanic Handlers to add to the skill's logic. */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Patch|Assets", meta=(MustImplement="/Script/PoE2Framework.MechanicHandler"))
     TArray<TSubclassOf<UObject>> HandlersToAdd;
+
+    // Category: Conditional Modifiers
+    //--------------------------------------------------------------------------------
+
+    /** Damage modifiers tested per hit against the attacker and target (e.g. "40% more damage against burning enemies"). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Patch|Conditional")
+    TArray<FPoE2ConditionalModifier> ConditionalModifiersToAdd;
     
     // Category: Overrides
     // Use these to completely replace a property on the skill.
@@ -0,0 +1,34 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Spec/SkillSpec.h"
+
+/**
+ * The live spec of one equipped skill, owned by UPoE2_AbilitySystemComponent and shared by reference with
+ * whatever the skill leaves in the world (e.g. minions). The owner rebuilds it in place and bumps Version;
+ * holders read through it and compare versions to notice changes, so a stat change costs the owner one
+ * rebuild however many holders there are, and each holder nothing until it next reads.
+ *
+ * Holders should call UPoE2_AbilitySystemComponent::UpdateSharedSkillSpec before reading: rebuilds are lazy,
+ * and that is what turns a pending stat change into a new version.
+ */
+class POE2FRAMEWORK_API FPoE2SharedSkillSpec
+{
+public:
+    const FSkillSpec& Get() const { return Spec; }
+
+    /** Changes every time the spec is rebuilt; 0 until the first build. */
+    uint32 GetVersion() const { return Version; }
+
+private:
+    friend class UPoE2_AbilitySystemComponent;
+
+    FSkillSpec Spec;
+    uint32 Version = 0;
+
+    /** The owning skill's consumer in the owner's stat graph, for the dirty check. */
+    int32 StatConsumer = INDEX_NONE;
+};
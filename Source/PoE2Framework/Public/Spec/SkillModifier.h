@@ -0,0 +1,45 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Spec/Patch.h"
+#include "SkillModifier.generated.h"
+
+/**
+ * A patch that applies to every skill with matching tags, e.g. "20% increased area of effect" for all
+ * Ability.Area skills. Items carry these; unlike a support's patch it is not linked to one skill.
+ */
+USTRUCT(BlueprintType)
+struct POE2FRAMEWORK_API FPoE2SkillModifier
+{
+    GENERATED_BODY()
+
+    /** The skill must have all of these tags. Empty: every skill. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SkillModifier")
+    FGameplayTagContainer RequiredSkillTags;
+
+    /** The skill must have none of these tags. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SkillModifier")
+    FGameplayTagContainer ExcludedSkillTags;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SkillModifier")
+    FPatch Patch;
+};
+
+/** Identifies the skill modifiers one source (e.g. an item) added to an FPoE2SkillModifierIndex. */
+USTRUCT(BlueprintType)
+struct POE2FRAMEWORK_API FPoE2SkillModifierSourceHandle
+{
+    GENERATED_BODY()
+
+    uint32 Id = 0;
+
+    bool IsValid() const { return Id != 0; }
+    void Reset() { Id = 0; }
+
+    bool operator==(const FPoE2SkillModifierSourceHandle& Other) const { return Id == Other.Id; }
+    friend uint32 GetTypeHash(const FPoE2SkillModifierSourceHandle& Handle) { return ::GetTypeHash(Handle.Id); }
+};
@@ -0,0 +1,85 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Spec/SkillModifier.h"
+#include "Spec/SkillSpecBuilder.h"
+
+/** The tags skill modifiers are matched against, kept so a skill can be re-tested without rebuilding its spec. */
+struct POE2FRAMEWORK_API FPoE2SkillModifierTarget
+{
+    FGameplayTagContainer Tags;
+    FPoE2TagBits Bits;
+    uint32 BitsGeneration = 0;
+
+    static FPoE2SkillModifierTarget FromSpec(const FSkillSpec& Spec);
+};
+
+/**
+ * The skill modifiers of every equipped item, compiled once when the item is added and bucketed by the first
+ * tag they require. A skill only visits the buckets whose tag it has (one mask test each) and tests just the
+ * modifiers inside, so a character with many items pays nothing for modifiers aimed at other skill types.
+ *
+ * Modifiers apply in the order they were added, after supports and before character stats.
+ */
+class POE2FRAMEWORK_API FPoE2SkillModifierIndex
+{
+public:
+    FPoE2SkillModifierSourceHandle AddSource(TConstArrayView<FPoE2SkillModifier> Modifiers);
+    void RemoveSource(FPoE2SkillModifierSourceHandle Source);
+    bool HasSource(FPoE2SkillModifierSourceHandle Source) const { return Sources.Contains(Source.Id); }
+
+    /** Whether any modifier of Source applies to a skill with Target's tags: the skills to rebuild when it changes. */
+    bool Affects(FPoE2SkillModifierSourceHandle Source, const FPoE2SkillModifierTarget& Target) const;
+
+    /** Appends the modifiers that apply to Target, in the order they were added. */
+    void GatherModifiers(const FPoE2SkillModifierTarget& Target, TArray<const FPoE2SkillModifier*>& OutModifiers) const;
+
+    /** Applies every modifier matching the spec's current tags. Returns how many applied. */
+    int32 Apply(FSkillSpec& Spec) const;
+
+    int32 NumModifiers() const { return Entries.Num(); }
+
+private:
+    struct FEntry
+    {
+        FPoE2SkillModifier Modifier;
+        FPoE2TagQuery Query;
+        FCompiledPatch Compiled;
+
+        /** Increases with every entry added; application order. */
+        uint32 Order = 0;
+        int32 Bucket = INDEX_NONE;
+    };
+
+    struct FBucket
+    {
+        FGameplayTag Tag;
+
+        /** Descendant mask of Tag in generation MaskGeneration (0: test the container). */
+        FPoE2TagBits Mask;
+        uint32 MaskGeneration = 0;
+
+        TArray<int32> Entries;
+    };
+
+    /** Indices of the entries matching Target, in application order. */
+    void GatherEntries(const FPoE2SkillModifierTarget& Target, TArray<int32, TInlineAllocator<16>>& OutEntries) const;
+
+    bool BucketMatches(const FBucket& Bucket, const FPoE2SkillModifierTarget& Target) const;
+    int32 FindOrAddBucket(const FGameplayTag& Tag);
+
+    TSparseArray<FEntry> Entries;
+    TMap<uint32, TArray<int32>> Sources;
+
+    TArray<FBucket> Buckets;
+
+    /** Entries requiring no tag, tested against every skill. */
+    TArray<int32> Unbucketed;
+
+    uint32 NextSourceId = 1;
+    uint32 NextOrder = 0;
+};
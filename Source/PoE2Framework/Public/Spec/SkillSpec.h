@@ -3,6 +3,9 @@
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
 #include "Engine/NetSerialization.h"
+#include "Data/PoE2AssetIndex.h"
+#include "Core/PoE2TagBits.h"
+#include "Effects/PoE2HitConditions.h"
 #include "SkillSpec.generated.h"
 
 class UGameplayAbility;
@@ -12,6 +15,7 @@ class UPackageMap;
 class APoE2ProjectileBase;
 class APoE2AreaEffectBase;
 class APoE2MinionBase;
+class FMechanicHandlerPipeline;
 
 /**
  * Network-friendly key-value pair for custom parameters
@@ -73,12 +77,16 @@ public:
     }
 
     // 版本号（用于网络兼容性）
-    static constexpr uint8 SKILLSPEC_VERSION = 1;
+    static constexpr uint8 SKILLSPEC_VERSION = 2;
 
     // 基础标识与绑定
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category="SkillSpec")
     FName SkillId;
 
+    /** 技能注册表中的稠密索引；已注册的技能在网络上只发送这 16 位 */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category="SkillSpec")
+    FPoE2AssetIndex SkillIndex;
+
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category="SkillSpec", meta=(AllowAbstract=false))
     TSubclassOf<UGameplayAbility> AbilityClass;
 
@@ -128,6 +136,12 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category="SkillSpec")
     FGameplayTagContainer SkillTags;
 
+    /** SkillTags 的位集镜像（仅显式标签），供支援兼容性检查按字运算；不参与复制，接收端重新计算 */
+    FPoE2TagBits TagBits;
+
+    /** TagBits 所对应的 FPoE2TagBitTable 代数；0 或与当前表不一致时位集无效，查询回退到容器 */
+    uint32 TagBitsGeneration = 0;
+
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category="SkillSpec")
     TArray<TSubclassOf<UGameplayEffect>> AppliedEffects;
 
@@ -135,6 +149,10 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category="SkillSpec", meta=(MustImplement="MechanicHandler", AllowAbstract=false))
     TArray<TSubclassOf<UObject>> MechanicHandlers;
 
+    /** 命中时按攻击者/目标状态生效的伤害修正；伤害只在服务器结算，不参与复制 */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category="SkillSpec")
+    TArray<FPoE2ConditionalModifier> ConditionalModifiers;
+
     // 额外参数（自定义数据）- 使用网络友好的数组结构
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category="SkillSpec")
     TArray<FCustomParam> CustomParams;
@@ -170,8 +188,43 @@ public:
         return GetCustomParam(Key);
     }
 
+    /**
+     * Compiles MechanicHandlers into the shared handler pipeline and rewrites MechanicHandlers in pipeline order
+     * (deduplicated, sorted by phase and priority). Called once when the spec is built.
+     */
+    void FreezeHandlerPipeline();
+
+    /** The frozen handler pipeline, or null if FreezeHandlerPipeline has not run (e.g. specs received over the network). */
+    const TSharedPtr<const FMechanicHandlerPipeline>& GetHandlerPipeline() const { return HandlerPipeline; }
+
+    /** Compiles ConditionalModifiers into the program evaluated per hit. Called once when the spec is built. */
+    void CompileHitConditions();
+
+    /** The compiled conditional modifiers, or null if the spec has none (or CompileHitConditions has not run). */
+    const TSharedPtr<const FPoE2HitConditionProgram>& GetHitConditions() const { return HitConditions; }
+
+    /** Recomputes TagBits from SkillTags. Call after editing SkillTags directly. */
+    void RefreshTagBits();
+
+    /**
+     * Cheap hash of everything that affects execution: identity, numbers, tag bits and class references.
+     * Meant as a cache key for derived data; equal specs hash equal, unequal specs almost always differ.
+     */
+    uint32 GetCacheHash() const;
+
+    /** 逐字段比较执行所需的全部内容（不含位集、编译产物等派生数据）；哈希相同时用它确认 */
+    bool operator==(const FSkillSpec& Other) const;
+    bool operator!=(const FSkillSpec& Other) const { return !(*this == Other); }
+
     // 网络序列化支持
     bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+private:
+    // 编译后的处理器管线，所有承载体共享（不参与复制）
+    TSharedPtr<const FMechanicHandlerPipeline> HandlerPipeline;
+
+    // 编译后的条件修正程序，与管线一样只读共享
+    TSharedPtr<const FPoE2HitConditionProgram> HitConditions;
 };
 
 template<>
@@ -0,0 +1,92 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/PoE2TagBits.h"
+
+class USkillDataAsset;
+struct FSkillSpec;
+struct FPatch;
+
+/**
+ * The float fields of FSkillSpec that FPatch numeric modifiers can target, in a stable order.
+ * Patch keys (FName) are resolved to these once instead of a FindFProperty per modifier per build.
+ */
+enum class ESkillSpecNumericField : uint8
+{
+    FinalDamage,
+    Cooldown,
+    ResourceCost,
+    CastTime,
+    AreaRadius,
+    ProjectileSpeed,
+    MaxRange,
+    Lifetime,
+    Count
+};
+
+namespace SkillSpecNumericField
+{
+    constexpr int32 Num = static_cast<int32>(ESkillSpecNumericField::Count);
+
+    /** Resolves a patch key to its field, or Count if the key does not name a numeric FSkillSpec field. */
+    POE2FRAMEWORK_API ESkillSpecNumericField FromName(FName Name);
+
+    POE2FRAMEWORK_API FName ToName(ESkillSpecNumericField Field);
+
+    /** Fields where a smaller value is the stronger skill: cooldown, cost and cast time. */
+    POE2FRAMEWORK_API bool IsLowerBetter(ESkillSpecNumericField Field);
+
+    POE2FRAMEWORK_API float& Get(FSkillSpec& Spec, ESkillSpecNumericField Field);
+    POE2FRAMEWORK_API float Get(const FSkillSpec& Spec, ESkillSpecNumericField Field);
+}
+
+/** An FPatch with its numeric keys resolved to fields and its tag edits resolved to bits. */
+struct POE2FRAMEWORK_API FCompiledPatch
+{
+    struct FOp
+    {
+        ESkillSpecNumericField Field;
+        float Value;
+    };
+
+    TArray<FOp, TInlineAllocator<4>> Additive;
+    TArray<FOp, TInlineAllocator<4>> Multiplicative;
+
+    FPoE2TagBits TagsToAdd;
+    FPoE2TagBits TagsToRemove;
+
+    /** FPoE2TagBitTable generation the tag bits belong to; 0 if the table was incomplete. */
+    uint32 TagBitsGeneration = 0;
+
+    static FCompiledPatch Compile(const FPatch& Patch);
+
+    /** Additive ops first, then multiplicative ("increased") ops, matching BuildSkillSpec. */
+    void ApplyNumerics(FSkillSpec& Spec) const;
+
+    /** Applies the tag edits to the container and, when both are current, to the spec's bits as word ops. */
+    void ApplyTags(FSkillSpec& Spec, const FPatch& Patch) const;
+};
+
+/**
+ * Pure SkillSpec composition: SkillDA base data plus patches, folded in order.
+ * This is the implementation behind UGA_SkillBase::BuildSkillSpec, usable without an ability or world
+ * (offline simulation, support search). Build reads the skill asset (soft references, the registry) and must run on the
+ * game thread; ApplyPatch only touches the spec and is safe to call from worker threads.
+ */
+struct POE2FRAMEWORK_API FSkillSpecBuilder
+{
+    /**
+     * Builds the final spec of SkillDA with Patches applied in order.
+     * @param bFreezeHandlerPipeline Compile the handler pipeline (game thread only, see FSkillSpec::FreezeHandlerPipeline).
+     */
+    static void Build(const USkillDataAsset* SkillDA, TConstArrayView<FPatch> Patches, FSkillSpec& OutSpec, bool bFreezeHandlerPipeline = true);
+
+    /** Applies one patch: numeric modifiers, tags, effects, handlers and overrides. */
+    static void ApplyPatch(FSkillSpec& Spec, const FPatch& Patch);
+
+    /** Same as ApplyPatch, with the patch already compiled. */
+    static void ApplyPatch(FSkillSpec& Spec, const FPatch& Patch, const FCompiledPatch& Compiled);
+};
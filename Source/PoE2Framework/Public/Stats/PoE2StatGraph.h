@@ -0,0 +1,140 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/PoE2StatTypes.h"
+
+struct FSkillSpec;
+
+/**
+ * Incremental stat aggregation for one character: sources -> stats -> consumers (skill specs).
+ *
+ * Sources add modifiers to stats; stats can feed other stats through derivations ("+1 life per strength").
+ * Changing a source dirties only the stats it touches, the stats derived from them and the consumers that
+ * read any of those. Stat values are recomputed lazily when read; consumers poll IsConsumerDirty and
+ * rebuild only then, so swapping one ring rebuilds only the skills that read a stat the ring changed.
+ *
+ * Game thread only.
+ */
+class POE2FRAMEWORK_API FPoE2StatGraph
+{
+public:
+    //~ Sources
+
+    FPoE2StatSourceHandle AddSource(TConstArrayView<FPoE2StatModifier> Modifiers);
+
+    /** Replaces a source's modifiers in place; dirties the union of old and new stats. */
+    void UpdateSource(FPoE2StatSourceHandle Source, TConstArrayView<FPoE2StatModifier> Modifiers);
+
+    void RemoveSource(FPoE2StatSourceHandle Source);
+
+    bool HasSource(FPoE2StatSourceHandle Source) const { return SourceStats.Contains(Source.Id); }
+
+    //~ Stats
+
+    void SetBaseValue(FName Stat, float Value);
+
+    /**
+     * Makes To receive From's final value times PerPoint, combined as Op.
+     * @return false if the edge would close a cycle; nothing is added then.
+     */
+    bool AddDerivation(FName From, FName To, EPoE2StatModOp Op, float PerPoint);
+
+    float GetValue(FName Stat) const;
+
+    /** Folded modifiers of Stat; the identity for stats nothing modifies. */
+    FPoE2StatAggregate GetAggregate(FName Stat) const;
+
+    //~ Consumers
+
+    /** Registers a consumer; it starts dirty and reads no stats. */
+    int32 AddConsumer();
+
+    void RemoveConsumer(int32 Consumer);
+
+    /** Replaces the stats the consumer reads and marks it dirty. */
+    void SetConsumerStats(int32 Consumer, TConstArrayView<FName> Stats);
+
+    bool IsConsumerDirty(int32 Consumer) const;
+
+    /** Marks the consumer dirty for reasons outside the graph (e.g. its supports changed). */
+    void MarkConsumerDirty(int32 Consumer);
+
+    /** Brings the consumer's stats up to date and clears its dirty flag. Call after rebuilding from them. */
+    void ClearConsumerDirty(int32 Consumer);
+
+    //~ Skill specs
+
+    /** Stats a spec reads: one per numeric field the spec has (non-zero). */
+    static void GetSpecStats(const FSkillSpec& Spec, TArray<FName>& OutStats);
+
+    /**
+     * Scales every non-zero numeric field of the spec by the stat of the same name. On lower-is-better fields
+     * (SkillSpecNumericField::IsLowerBetter) increased and more divide instead of multiply, so a positive stat
+     * always makes the skill stronger; flat still adds.
+     */
+    void ApplyToSpec(FSkillSpec& Spec) const;
+
+    /** Incremented by every change; a cheap "anything changed" check. */
+    uint32 GetRevision() const { return Revision; }
+
+    /** Stats recomputed since construction, for tests and profiling. */
+    int32 GetRecomputeCount() const { return RecomputeCount; }
+
+private:
+    struct FContribution
+    {
+        uint32 Source;
+        EPoE2StatModOp Op;
+        float Value;
+    };
+
+    struct FDerivation
+    {
+        int32 From;
+        EPoE2StatModOp Op;
+        float PerPoint;
+    };
+
+    struct FStatNode
+    {
+        FName Name;
+        float BaseValue = 0.0f;
+        TArray<FContribution> Contributions;
+        TArray<FDerivation> Inputs;
+        TArray<int32> DerivedStats;
+        TArray<int32> Consumers;
+
+        mutable FPoE2StatAggregate Cached;
+        mutable bool bDirty = true;
+    };
+
+    struct FConsumer
+    {
+        TArray<int32> Stats;
+        bool bDirty = true;
+        bool bAlive = false;
+    };
+
+    int32 FindOrAddStat(FName Stat);
+    void MarkStatDirty(int32 StatIndex);
+    const FPoE2StatAggregate& Evaluate(int32 StatIndex) const;
+    bool IsReachable(int32 From, int32 To) const;
+    void AddModifiers(uint32 SourceId, TConstArrayView<FPoE2StatModifier> Modifiers);
+    void RemoveModifiers(uint32 SourceId);
+
+    TArray<FStatNode> Stats;
+    TMap<FName, int32> StatIndices;
+
+    /** Stats each source contributes to, for removal. */
+    TMap<uint32, TArray<int32>> SourceStats;
+
+    TArray<FConsumer> Consumers;
+    TArray<int32> FreeConsumers;
+
+    uint32 NextSourceId = 1;
+    uint32 Revision = 0;
+    mutable int32 RecomputeCount = 0;
+};
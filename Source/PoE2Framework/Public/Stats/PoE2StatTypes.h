@@ -0,0 +1,84 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PoE2StatTypes.generated.h"
+
+/** How a modifier combines into a stat: (Base + Flat) * (1 + sum of Increased) * product of (1 + More). */
+UENUM(BlueprintType)
+enum class EPoE2StatModOp : uint8
+{
+    Flat,
+    Increased,
+    More
+};
+
+/**
+ * One modifier a source (item, passive, talent, buff) grants to a character stat.
+ * Stats named after a numeric FSkillSpec field ("FinalDamage", "AreaRadius", ...) also scale every skill
+ * that has that field, the same keys FPatch uses.
+ */
+USTRUCT(BlueprintType)
+struct POE2FRAMEWORK_API FPoE2StatModifier
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stat")
+    FName Stat;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stat")
+    EPoE2StatModOp Op = EPoE2StatModOp::Flat;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stat")
+    float Value = 0.0f;
+
+    FPoE2StatModifier() = default;
+
+    FPoE2StatModifier(FName InStat, EPoE2StatModOp InOp, float InValue)
+        : Stat(InStat), Op(InOp), Value(InValue)
+    {
+    }
+};
+
+/** Identifies the modifiers one source added to a stat graph, so they can be removed together. */
+USTRUCT(BlueprintType)
+struct POE2FRAMEWORK_API FPoE2StatSourceHandle
+{
+    GENERATED_BODY()
+
+    uint32 Id = 0;
+
+    bool IsValid() const { return Id != 0; }
+    void Reset() { Id = 0; }
+
+    bool operator==(const FPoE2StatSourceHandle& Other) const { return Id == Other.Id; }
+    friend uint32 GetTypeHash(const FPoE2StatSourceHandle& Handle) { return ::GetTypeHash(Handle.Id); }
+};
+
+/** The folded modifiers of one stat. */
+struct FPoE2StatAggregate
+{
+    float Base = 0.0f;
+    float Flat = 0.0f;
+    float Increased = 0.0f;
+    float More = 1.0f;
+
+    float GetValue() const { return Apply(Base); }
+
+    /** Scales a value the way this stat scales its own base. */
+    float Apply(float InValue) const { return (InValue + Flat) * (1.0f + Increased) * More; }
+
+    void Add(EPoE2StatModOp Op, float Value)
+    {
+        switch (Op)
+        {
+        case EPoE2StatModOp::Flat:      Flat += Value; break;
+        case EPoE2StatModOp::Increased: Increased += Value; break;
+        case EPoE2StatModOp::More:      More *= (1.0f + Value); break;
+        }
+    }
+
+    bool IsIdentity() const { return Flat == 0.0f && Increased == 0.0f && More == 1.0f; }
+};
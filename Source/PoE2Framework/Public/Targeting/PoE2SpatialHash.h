@@ -0,0 +1,45 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Uniform 2D grid over a set of points, rebuilt from scratch whenever the points move. Cells are hashed into a
+ * fixed number of buckets and the points sorted by bucket into one flat array, so a rebuild is two passes and
+ * no allocation once the arrays have grown, and a radius query touches only the cells the radius overlaps.
+ * Height is ignored for bucketing but not for the radius test.
+ */
+class POE2FRAMEWORK_API FPoE2SpatialHash
+{
+public:
+    explicit FPoE2SpatialHash(float InCellSize = 500.0f, int32 InNumBuckets = 1024);
+
+    void Build(TConstArrayView<FVector> Points);
+
+    /** Calls Visitor with the index (into the array given to Build) of every point within Radius of Origin, each once. */
+    void ForEachInRadius(const FVector& Origin, float Radius, TFunctionRef<void(int32 Index)> Visitor) const;
+
+    float GetCellSize() const { return CellSize; }
+    FIntPoint GetCell(const FVector& Location) const;
+
+    int32 Num() const { return Entries.Num(); }
+
+private:
+    struct FEntry
+    {
+        FVector Location;
+        FIntPoint Cell;
+        int32 Index;
+    };
+
+    int32 GetBucket(const FIntPoint& Cell) const;
+
+    float CellSize;
+    int32 NumBuckets;
+
+    /** Entries of bucket B are Entries[BucketStarts[B], BucketStarts[B + 1]). */
+    TArray<int32> BucketStarts;
+    TArray<FEntry> Entries;
+};
@@ -0,0 +1,118 @@
+// Copyright 2025 liufucheng. All rights reserved.
+// Use of this source code is governed by a MIT license that can be
+// found in the LICENSE file.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Targeting/PoE2SpatialHash.h"
+#include "PoE2TargetingSubsystem.generated.h"
+
+/** "Best enemy near Origin within Radius", as asked by minion AI, homing or chaining. */
+struct FPoE2TargetRequest
+{
+    FVector Origin = FVector::ZeroVector;
+    float Radius = 0.0f;
+
+    /** Whose enemies to look for. Requests are coalesced per team, so this also decides which batch the request joins. */
+    TWeakObjectPtr<const AActor> Instigator;
+
+    /** Never returned, e.g. the targets a chain has already hit. */
+    TArray<TWeakObjectPtr<const AActor>, TInlineAllocator<4>> Exclude;
+};
+
+/** Receives the living hostile target nearest the request's origin, or null if there is none in range. */
+using FPoE2TargetCallback = TUniqueFunction<void(AActor* Target)>;
+
+/**
+ * Answers target requests from every system in one batch per frame. Registered targets are bucketed into a
+ * spatial hash once per batch; requests from the same team whose origins share a cell are evaluated as one
+ * group, so the hostility and life checks run once per candidate per group rather than once per requester.
+ *
+ * Latency contract: a request is answered in the subsystem's next tick. That is the same frame when the
+ * request is made before the tickable pass, and the frame after otherwise (including requests made from
+ * other tickables or from a callback); callers must not rely on either. The target is valid when the
+ * callback runs, but nothing keeps it so: re-check it before acting on it in a later frame.
+ */
+UCLASS(config = Game)
+class POE2FRAMEWORK_API UPoE2TargetingSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Makes Target findable by requests. Ability system components register their avatars themselves. */
+    UFUNCTION(BlueprintCallable, Category = "PoE2|Targeting")
+    void RegisterTarget(AActor* Target);
+
+    UFUNCTION(BlueprintCallable, Category = "PoE2|Targeting")
+    void UnregisterTarget(AActor* Target);
+
+    /**
+     * Moves an ability system component's registration from PreviousAvatar to NewAvatar in World's service, if
+     * it has one. Called after InitAbilityActorInfo, and with a null NewAvatar when the component ends play.
+     */
+    static void UpdateAvatarTarget(const UWorld* World, AActor* PreviousAvatar, AActor* NewAvatar);
+
+    void RequestTarget(FPoE2TargetRequest&& Request, FPoE2TargetCallback&& OnResult);
+
+    UFUNCTION(BlueprintPure, Category = "PoE2|Targeting")
+    int32 GetNumTargets() const { return Targets.Num(); }
+
+    UFUNCTION(BlueprintPure, Category = "PoE2|Targeting")
+    int32 GetNumPendingRequests() const { return Pending.Num(); }
+
+    /** Request groups of the last batch: one per team and cell among the requests answered. */
+    UFUNCTION(BlueprintPure, Category = "PoE2|Targeting")
+    int32 GetNumLastBatchGroups() const { return LastBatchGroups; }
+
+    /** Candidates the last batch tested for hostility and life, summed over its groups. */
+    UFUNCTION(BlueprintPure, Category = "PoE2|Targeting")
+    int32 GetNumLastBatchChecks() const { return LastBatchChecks; }
+
+    /**
+     * Whether Candidate is alive and an enemy of Instigator. Team attitude decides when both sides' team owners
+     * (see GetTeamOwner) have a team; otherwise everything outside the instigator's team owner is hostile.
+     * A null instigator treats every living candidate as hostile.
+     */
+    static bool IsHostileTarget(const AActor* Instigator, const AActor* Candidate);
+
+    /** The actor whose team Actor fights for: a minion's owner, or Actor itself. */
+    static const AActor* GetTeamOwner(const AActor* Actor);
+
+    /** Size of a hash cell, which is also the size of the area whose requests are coalesced. */
+    UPROPERTY(EditAnywhere, Config, BlueprintReadWrite, Category = "PoE2|Targeting", meta = (ClampMin = "50"))
+    float CellSize = 500.0f;
+
+    // FTickableGameObject interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+protected:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FPendingRequest
+    {
+        FPoE2TargetRequest Request;
+        FPoE2TargetCallback OnResult;
+    };
+
+    /** Drops dead registrations and rebuilds the hash from the rest's current locations. */
+    void BuildHash();
+
+    /** Answers every request in Batch; results are collected first and handed out after the last group. */
+    void ProcessBatch(TArray<FPendingRequest>& Batch);
+
+    TArray<TWeakObjectPtr<AActor>> Targets;
+
+    /** Parallel to the hash's indices after BuildHash. */
+    TArray<AActor*> LiveTargets;
+    TArray<FVector> TargetLocations;
+    FPoE2SpatialHash Hash;
+
+    TArray<FPendingRequest> Pending;
+
+    int32 LastBatchGroups = 0;
+    int32 LastBatchChecks = 0;
+};